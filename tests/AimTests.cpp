@@ -0,0 +1,85 @@
+#include <math.h>
+#include <zero/AimSolver.h>
+#include <zero/behavior/nodes/AimNode.h>
+
+#include <random>
+
+#include "Test.h"
+#include "TestWorld.h"
+
+namespace zero {
+namespace test {
+
+constexpr u16 kSelfId = 1;
+constexpr u16 kTargetId = 2;
+
+static void CreateAimWorld(TestWorld& world) {
+  world.LoadTiles({MakeTile(0, 0, 1)});
+
+  ArenaSettings& settings = world.game->connection.settings;
+
+  for (size_t i = 0; i < 8; ++i) {
+    settings.ShipSettings[i].Radius = 14;
+    settings.ShipSettings[i].InitialThrust = 16;
+  }
+
+  world.GetPlayerManager().player_id = kSelfId;
+
+  world.AddPlayer(kSelfId, 0, 0, Vector2f(512, 512));
+  world.AddPlayer(kTargetId, 0, 1, Vector2f(530, 512));
+}
+
+// Four weapons fill one vector of candidates and three are solved by the scalar loop, so both must give the same aim
+// position as CalculateShot.
+ZERO_TEST(aim_solver_matches_calculate_shot) {
+  TestWorld world;
+  CreateAimWorld(world);
+
+  Player& self = *world.GetPlayerManager().GetSelf();
+  Player& target = *world.GetPlayerManager().GetPlayerById(kTargetId);
+  Player* targets[] = {&target};
+
+  std::mt19937 rng(1357);
+  std::uniform_real_distribution<float> offset(-20.0f, 20.0f);
+  std::uniform_real_distribution<float> velocity(-5.0f, 5.0f);
+  std::uniform_real_distribution<float> speed(20.0f, 60.0f);
+
+  AimSolver solver;
+  size_t solved_count = 0;
+
+  for (size_t i = 0; i < 500; ++i) {
+    world.SetPlayerPosition(self, Vector2f(512, 512), Vector2f(velocity(rng), velocity(rng)));
+    world.SetPlayerPosition(target, Vector2f(512 + offset(rng), 512 + offset(rng)),
+                            Vector2f(velocity(rng), velocity(rng)));
+
+    AimWeapon weapon;
+
+    weapon.speed = speed(rng);
+    weapon.alive_time = 5.0f;
+
+    AimWeapon weapons[] = {weapon, weapon, weapon, weapon};
+
+    auto expected = behavior::CalculateShot(self.position, target.position, self.velocity, target.velocity,
+                                            weapon.speed);
+
+    for (size_t weapon_count : {(size_t)4, (size_t)3}) {
+      AimShot shot;
+
+      bool solved = solver.Solve(*world.game, self, targets, 1, weapons, weapon_count, 0, &shot);
+
+      EXPECT(solved == expected.has_value());
+      if (!solved || !expected) continue;
+
+      EXPECT(shot.target == &target);
+      EXPECT(shot.bounces == 0);
+      EXPECT(shot.aim_position.Distance(*expected) < 0.01f);
+
+      ++solved_count;
+    }
+  }
+
+  EXPECT(solved_count > 500);
+}
+
+}  // namespace test
+}  // namespace zero
@@ -0,0 +1,240 @@
+#include <stdio.h>
+#include <zero/behavior/BehaviorTree.h>
+#include <zero/game/Clock.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Test.h"
+
+namespace zero {
+namespace test {
+
+using namespace behavior;
+
+// Marks the custom sequence in the trace so it can be told apart from the leaves.
+constexpr u32 kCustomTag = 0x80000000;
+
+static u32 HashCall(u32 id, u32 call) {
+  u32 hash = id * 0x9E3779B1 + call * 0x85EBCA77;
+
+  hash ^= hash >> 15;
+  hash *= 0x2C1B3C6D;
+  hash ^= hash >> 12;
+
+  return hash;
+}
+
+// Records each time it runs and returns a result that depends on its id and how many times it ran, so two copies of a
+// tree only stay in step if they call their leaves in the same order.
+struct ScriptedNode : public BehaviorNode {
+  ScriptedNode(u32 id, u32 running_chance, std::vector<u32>* trace)
+      : id(id), running_chance(running_chance), trace(trace) {}
+
+  ExecuteResult Execute(ExecuteContext& ctx) override {
+    if (trace) trace->push_back(id);
+
+    u32 roll = HashCall(id, call_count++) % 100;
+
+    if (roll < running_chance) return ExecuteResult::Running;
+    if (roll < running_chance + 35) return ExecuteResult::Failure;
+
+    return ExecuteResult::Success;
+  }
+
+  u32 id;
+  u32 running_chance;
+  u32 call_count = 0;
+  std::vector<u32>* trace;
+};
+
+// A subclass of a composite that the compiled tree has to run through its own Execute.
+struct CustomSequenceNode : public SequenceNode {
+  CustomSequenceNode(u32 id, std::vector<u32>* trace) : id(id), trace(trace) {}
+
+  ExecuteResult Execute(ExecuteContext& ctx) override {
+    if (trace) trace->push_back(id | kCustomTag);
+
+    return SequenceNode::Execute(ctx);
+  }
+
+  u32 id;
+  std::vector<u32>* trace;
+};
+
+struct TreeGenerator {
+  std::mt19937 rng;
+  std::vector<u32>* trace;
+  u32 running_chance;
+  u32 next_id = 0;
+  u32 leaf_count = 0;
+
+  TreeGenerator(u32 seed, std::vector<u32>* trace, u32 running_chance)
+      : rng(seed), trace(trace), running_chance(running_chance) {}
+
+  template <typename T>
+  std::unique_ptr<BehaviorNode> Composite(std::unique_ptr<T> node, int depth) {
+    // Some composites are left empty.
+    size_t count = std::uniform_int_distribution<size_t>(0, 4)(rng);
+
+    for (size_t i = 0; i < count; ++i) {
+      node->children_.push_back(Generate(depth + 1));
+    }
+
+    return node;
+  }
+
+  std::unique_ptr<BehaviorNode> Generate(int depth) {
+    int type = std::uniform_int_distribution<int>(0, 9)(rng);
+
+    if (depth >= 6 || type >= 6) {
+      ++leaf_count;
+      return std::make_unique<ScriptedNode>(next_id++, running_chance, trace);
+    }
+
+    switch (type) {
+      case 0: {
+        return Composite(std::make_unique<SequenceNode>(), depth);
+      } break;
+      case 1: {
+        return Composite(std::make_unique<SelectorNode>(), depth);
+      } break;
+      case 2: {
+        return Composite(std::make_unique<ParallelNode>(), depth);
+      } break;
+      case 3: {
+        return Composite(std::make_unique<CustomSequenceNode>(next_id++, trace), depth);
+      } break;
+      case 4: {
+        auto node = std::make_unique<SuccessNode>();
+
+        if (std::uniform_int_distribution<int>(0, 9)(rng) > 0) {
+          node->Child(Generate(depth + 1));
+        }
+
+        return node;
+      } break;
+      default: {
+        auto node = std::make_unique<InvertNode>();
+
+        if (std::uniform_int_distribution<int>(0, 9)(rng) > 0) {
+          node->Child(Generate(depth + 1));
+        }
+
+        return node;
+      } break;
+    }
+  }
+};
+
+// Both trees are generated from the same seed, so they have the same structure and leaves. Leaves that return running
+// make the sequences resume from the running child on the next execution.
+ZERO_TEST(behavior_compiled_matches_recursive) {
+  size_t running_count = 0;
+  size_t leaf_count = 0;
+
+  for (u32 seed = 1; seed <= 300; ++seed) {
+    std::vector<u32> recursive_trace;
+    std::vector<u32> compiled_trace;
+
+    TreeGenerator recursive_generator(seed, &recursive_trace, 15);
+    TreeGenerator compiled_generator(seed, &compiled_trace, 15);
+
+    std::unique_ptr<BehaviorNode> recursive = recursive_generator.Generate(0);
+    std::unique_ptr<BehaviorNode> compiled = CompileTree(compiled_generator.Generate(0));
+
+    ExecuteContext recursive_ctx;
+    ExecuteContext compiled_ctx;
+
+    for (int tick = 0; tick < 20; ++tick) {
+      ExecuteResult expected = recursive->Execute(recursive_ctx);
+      ExecuteResult result = compiled->Execute(compiled_ctx);
+
+      EXPECT(result == expected);
+      if (expected == ExecuteResult::Running) ++running_count;
+    }
+
+    EXPECT(compiled_trace == recursive_trace);
+    leaf_count += recursive_trace.size();
+  }
+
+  EXPECT(running_count > 500);
+  EXPECT(leaf_count > 10000);
+}
+
+// The debug printer has to show the same tree for both.
+ZERO_TEST(behavior_compiled_prints_like_recursive) {
+  TreePrinter* previous_printer = gDebugTreePrinter;
+
+  for (u32 seed = 1; seed <= 50; ++seed) {
+    TreeGenerator recursive_generator(seed, nullptr, 15);
+    TreeGenerator compiled_generator(seed, nullptr, 15);
+
+    std::unique_ptr<BehaviorNode> recursive = recursive_generator.Generate(0);
+    std::unique_ptr<BehaviorNode> compiled = CompileTree(compiled_generator.Generate(0));
+
+    ExecuteContext recursive_ctx;
+    ExecuteContext compiled_ctx;
+
+    for (int tick = 0; tick < 5; ++tick) {
+      TreePrinter recursive_printer;
+      TreePrinter compiled_printer;
+
+      gDebugTreePrinter = &recursive_printer;
+      ExecuteResult expected = recursive->Execute(recursive_ctx);
+
+      gDebugTreePrinter = &compiled_printer;
+      ExecuteResult result = compiled->Execute(compiled_ctx);
+
+      EXPECT(result == expected);
+      EXPECT(compiled_printer.output == recursive_printer.output);
+      EXPECT(compiled_printer.depth == recursive_printer.depth);
+    }
+  }
+
+  gDebugTreePrinter = previous_printer;
+}
+
+static double MeasureTree(BehaviorNode& tree, int executions) {
+  ExecuteContext ctx;
+
+  u64 start = GetMicrosecondTick();
+
+  for (int i = 0; i < executions; ++i) {
+    tree.Execute(ctx);
+  }
+
+  return (double)(GetMicrosecondTick() - start) / executions;
+}
+
+// Executing a large generated tree recursively and from the flattened array.
+ZERO_BENCHMARK(behavior_compiled_tree) {
+  constexpr int kExecutions = 20000;
+
+  for (u32 seed : {11, 12, 13}) {
+    TreeGenerator recursive_generator(seed, nullptr, 0);
+    TreeGenerator compiled_generator(seed, nullptr, 0);
+
+    // Wrapped in a parallel node so most of the tree runs every time.
+    auto recursive = std::make_unique<ParallelNode>();
+    auto compiled_root = std::make_unique<ParallelNode>();
+
+    for (int i = 0; i < 128; ++i) {
+      recursive->Child(recursive_generator.Generate(1));
+      compiled_root->Child(compiled_generator.Generate(1));
+    }
+
+    std::unique_ptr<BehaviorNode> compiled = CompileTree(std::move(compiled_root));
+
+    double recursive_time = MeasureTree(*recursive, kExecutions);
+    double compiled_time = MeasureTree(*compiled, kExecutions);
+
+    printf("  %u leaves: recursive %.2f us, compiled %.2f us (%.2fx)\n", recursive_generator.leaf_count, recursive_time,
+           compiled_time, recursive_time / compiled_time);
+  }
+}
+
+}  // namespace test
+}  // namespace zero
@@ -0,0 +1,235 @@
+#include <stdio.h>
+#include <string.h>
+#include <zero/behavior/Blackboard.h>
+#include <zero/game/Clock.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Test.h"
+
+namespace zero {
+namespace test {
+
+using behavior::Blackboard;
+using behavior::BlackboardKey;
+
+// Too large for the inline storage, so it's stored on the heap.
+struct LargeValue {
+  int values[32];
+
+  bool operator==(const LargeValue& other) const { return memcmp(values, other.values, sizeof(values)) == 0; }
+};
+
+ZERO_TEST(blackboard_interns_keys) {
+  BlackboardKey first("blackboard_test_first");
+  BlackboardKey second("blackboard_test_second");
+  std::string first_name = "blackboard_test_first";
+
+  EXPECT(first.IsValid());
+  EXPECT(first == BlackboardKey(first_name));
+  EXPECT(first != second);
+  EXPECT(strcmp(first.GetName(), "blackboard_test_first") == 0);
+
+  BlackboardKey invalid(nullptr);
+
+  EXPECT(!invalid.IsValid());
+  EXPECT(!BlackboardKey().IsValid());
+  EXPECT(strcmp(invalid.GetName(), "") == 0);
+
+  // Setting an invalid key is ignored.
+  Blackboard bb;
+
+  bb.Set<int>(invalid, 5);
+
+  EXPECT(!bb.Has(invalid));
+  EXPECT(!bb.Get<int>(invalid));
+}
+
+ZERO_TEST(blackboard_versions) {
+  Blackboard bb;
+  BlackboardKey key("blackboard_test_version");
+
+  EXPECT(bb.GetVersion(key) == 0);
+  EXPECT(!bb.Has(key));
+
+  bb.Set<int>(key, 5);
+  u32 version = bb.GetVersion(key);
+
+  EXPECT(bb.Has(key));
+  EXPECT(version != 0);
+
+  // The same value again isn't a change.
+  bb.Set<int>(key, 5);
+  EXPECT(bb.GetVersion(key) == version);
+
+  bb.Set<int>(key, 6);
+  EXPECT(bb.GetVersion(key) != version);
+  version = bb.GetVersion(key);
+
+  // Changing the type is always a change.
+  bb.Set<float>(key, 6.0f);
+  EXPECT(bb.GetVersion(key) != version);
+  version = bb.GetVersion(key);
+
+  bb.Erase(key);
+  EXPECT(!bb.Has(key));
+  EXPECT(bb.GetVersion(key) != version);
+  version = bb.GetVersion(key);
+
+  // Erasing a missing value doesn't change anything.
+  bb.Erase(key);
+  EXPECT(bb.GetVersion(key) == version);
+
+  // Setting it after erasing has to change the version even if it's the value from before.
+  bb.Set<float>(key, 6.0f);
+  EXPECT(bb.GetVersion(key) != version);
+}
+
+ZERO_TEST(blackboard_typed_slots) {
+  Blackboard bb;
+  BlackboardKey key("blackboard_test_typed");
+  BlackboardKey missing("blackboard_test_missing");
+
+  bb.Set<int>(key, 7);
+
+  EXPECT(bb.Get<int>(key) && *bb.Get<int>(key) == 7);
+  EXPECT(!bb.Get<float>(key));
+  EXPECT(!bb.Value<u32>(key));
+  EXPECT(bb.ValueOr<float>(key, 2.0f) == 2.0f);
+  EXPECT(bb.ValueOr<int>(key, 2) == 7);
+  EXPECT(!bb.Value<int>(missing));
+
+  bb.Set<std::string>(key, std::string("text"));
+
+  EXPECT(!bb.Get<int>(key));
+  EXPECT(bb.Value<std::string>(key) == std::string("text"));
+
+  // String literals decay to pointers.
+  bb.Set(key, "literal");
+
+  EXPECT(bb.Get<const char*>(key) && strcmp(*bb.Get<const char*>(key), "literal") == 0);
+}
+
+ZERO_TEST(blackboard_large_values) {
+  Blackboard bb;
+  BlackboardKey key("blackboard_test_large");
+
+  LargeValue value = {};
+
+  for (int i = 0; i < 32; ++i) {
+    value.values[i] = i;
+  }
+
+  bb.Set(key, value);
+
+  LargeValue* stored = bb.Get<LargeValue>(key);
+
+  EXPECT(stored && *stored == value);
+
+  // Setting the same type reuses the allocation.
+  value.values[31] = 100;
+  bb.Set(key, value);
+
+  EXPECT(bb.Get<LargeValue>(key) == stored);
+  EXPECT(stored->values[31] == 100);
+
+  std::vector<int> list(100, 3);
+
+  bb.Set(key, list);
+
+  EXPECT(!bb.Get<LargeValue>(key));
+  EXPECT(bb.Get<std::vector<int>>(key) && bb.Get<std::vector<int>>(key)->size() == 100);
+
+  // Setting a new key grows the slots, which moves the value that is being copied from.
+  for (int i = 0; i < 64; ++i) {
+    BlackboardKey next("blackboard_test_grow_" + std::to_string(i));
+
+    bb.Set(next, *bb.Get<std::vector<int>>(key));
+
+    EXPECT(bb.Value<std::vector<int>>(next) == list);
+  }
+}
+
+// Values are destroyed when they are replaced, erased, cleared, or when the blackboard is destroyed.
+ZERO_TEST(blackboard_destroys_values) {
+  auto shared = std::make_shared<int>(1);
+  BlackboardKey inline_key("blackboard_test_destroy_inline");
+  BlackboardKey heap_key("blackboard_test_destroy_heap");
+
+  struct HeapValue {
+    std::shared_ptr<int> value;
+    char padding[64];
+  };
+
+  {
+    Blackboard bb;
+
+    bb.Set(inline_key, shared);
+    bb.Set(heap_key, HeapValue{shared});
+
+    EXPECT(shared.use_count() == 3);
+
+    bb.Set<int>(inline_key, 0);
+    EXPECT(shared.use_count() == 2);
+
+    bb.Erase(heap_key);
+    EXPECT(shared.use_count() == 1);
+
+    bb.Set(inline_key, shared);
+    bb.Set(heap_key, HeapValue{shared});
+    bb.Clear();
+
+    EXPECT(shared.use_count() == 1);
+    EXPECT(!bb.Has(inline_key));
+    EXPECT(!bb.Has(heap_key));
+
+    bb.Set(inline_key, shared);
+    bb.Set(heap_key, HeapValue{shared});
+  }
+
+  EXPECT(shared.use_count() == 1);
+}
+
+// Reading a value by interned key compared to the string keyed calls that intern on every lookup.
+ZERO_BENCHMARK(blackboard_lookup) {
+  constexpr int kLookups = 1000000;
+
+  Blackboard bb;
+  std::vector<std::string> names;
+  std::vector<BlackboardKey> keys;
+
+  for (int i = 0; i < 32; ++i) {
+    names.push_back("blackboard_bench_" + std::to_string(i));
+    keys.push_back(BlackboardKey(names.back()));
+    bb.Set<int>(keys.back(), i);
+  }
+
+  int key_sum = 0;
+  int string_sum = 0;
+
+  u64 start = GetMicrosecondTick();
+
+  for (int i = 0; i < kLookups; ++i) {
+    key_sum += bb.ValueOr<int>(keys[i & 31], 0);
+  }
+
+  u64 key_time = GetMicrosecondTick() - start;
+
+  start = GetMicrosecondTick();
+
+  for (int i = 0; i < kLookups; ++i) {
+    string_sum += bb.ValueOr<int>(names[i & 31].c_str(), 0);
+  }
+
+  u64 string_time = GetMicrosecondTick() - start;
+
+  EXPECT(key_sum == string_sum);
+
+  printf("  %d lookups: key %.2f ns/lookup, string %.2f ns/lookup (%.2fx)\n", kLookups,
+         key_time * 1000.0 / kLookups, string_time * 1000.0 / kLookups, (double)string_time / key_time);
+}
+
+}  // namespace test
+}  // namespace zero
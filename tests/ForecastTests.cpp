@@ -0,0 +1,127 @@
+#include <math.h>
+#include <zero/game/DangerForecast.h>
+#include <zero/game/WeaponManager.h>
+
+#include "Test.h"
+#include "TestClock.h"
+#include "TestWorld.h"
+
+namespace zero {
+namespace test {
+
+constexpr u16 kSelfId = 1;
+constexpr u16 kEnemyId = 2;
+constexpr u16 kOtherEnemyId = 3;
+
+// An empty map with the self ship in the middle and enemies that fire 200 damage bullets at it.
+static void CreateForecastWorld(TestWorld& world) {
+  world.LoadTiles({MakeTile(0, 0, 1)});
+
+  ArenaSettings& settings = world.game->connection.settings;
+
+  settings.BulletAliveTime = 500;
+  settings.BulletDamageLevel = 200 * 1000;
+  settings.BulletDamageUpgrade = 0;
+
+  for (size_t i = 0; i < 8; ++i) {
+    settings.ShipSettings[i].Radius = 14;
+  }
+
+  world.GetPlayerManager().player_id = kSelfId;
+
+  world.AddPlayer(kSelfId, 0, 0, Vector2f(512, 512));
+  world.AddPlayer(kEnemyId, 0, 1, Vector2f(400, 400));
+  world.AddPlayer(kOtherEnemyId, 0, 1, Vector2f(600, 600));
+}
+
+ZERO_TEST(forecast_bullet_hits_self) {
+  TestWorld world;
+  CreateForecastWorld(world);
+
+  // One tile every five ticks, so the bullet covers the ten tiles to the ship in about fifty ticks.
+  world.AddWeapon(MakeWeapon(WeaponType::Bullet, kEnemyId, 1, Vector2f(502, 512.5f), 3200, 0, 500));
+  // Same distance away, but flying away from the ship.
+  world.AddWeapon(MakeWeapon(WeaponType::Bullet, kEnemyId, 1, Vector2f(512.5f, 502), 0, -3200, 500));
+  // Friendly weapons are never part of the forecast.
+  world.AddWeapon(MakeWeapon(WeaponType::Bullet, kSelfId, 0, Vector2f(522, 512.5f), -3200, 0, 500));
+
+  DangerForecast& forecast = world.game->danger_forecast;
+  Vector2f self(512.5f, 512.5f);
+
+  EXPECT(forecast.IsValid(0));
+  EXPECT(!forecast.IsValid(1));
+
+  EXPECT(forecast.GetDamage(self, kForecastTicks - 1) == 200.0f);
+
+  u32 first_tick = forecast.GetFirstHitTick(self);
+  EXPECT(first_tick >= 40 && first_tick <= 50);
+
+  // The bullet hasn't reached the ship's cell in the first bucket.
+  EXPECT(forecast.GetDamage(self, 0) == 0.0f);
+
+  // Behind the ship is only reached after the ship's own cell.
+  EXPECT(forecast.GetFirstHitTick(self + Vector2f(6, 0)) > first_tick);
+  EXPECT(forecast.GetDamage(self + Vector2f(0, 20), kForecastTicks - 1) == 0.0f);
+}
+
+ZERO_TEST(forecast_safest_direction) {
+  TestWorld world;
+  CreateForecastWorld(world);
+
+  world.AddWeapon(MakeWeapon(WeaponType::Bullet, kEnemyId, 1, Vector2f(502, 512.5f), 3200, 0, 500));
+
+  DangerForecast& forecast = world.game->danger_forecast;
+  Vector2f self(512.5f, 512.5f);
+  float distance = 14.0f / 16.0f * 2.0f + kForecastCellSize;
+
+  // The bullet travels along x, so the only way out of its path is along y.
+  Vector2f side = forecast.GetSafestDirection(self, Vector2f(0, 0), distance, kForecastTicks - 1);
+
+  EXPECT(fabsf(side.y) > 0.5f);
+  EXPECT(forecast.GetDamage(self + side * distance, kForecastTicks - 1) == 0.0f);
+
+  // Moving up or down is equally safe, so the current velocity decides.
+  Vector2f down = forecast.GetSafestDirection(self, Vector2f(0, 1), distance, kForecastTicks - 1);
+  Vector2f up = forecast.GetSafestDirection(self, Vector2f(0, -1), distance, kForecastTicks - 1);
+
+  EXPECT(down.y > 0.5f);
+  EXPECT(up.y < -0.5f);
+
+  // Nothing to dodge away from a position that isn't hit.
+  Vector2f none = forecast.GetSafestDirection(self + Vector2f(0, 30), Vector2f(0, 0), distance, kForecastTicks - 1);
+  EXPECT(none.x == 0.0f && none.y == 0.0f);
+}
+
+// Replacing a weapon within a tick keeps the weapon count the same, so the forecast must notice the weapon generation.
+ZERO_TEST(forecast_rebuilds_on_weapon_change) {
+  TestWorld world;
+  CreateForecastWorld(world);
+
+  WeaponManager& weapon_manager = world.GetWeaponManager();
+  DangerForecast& forecast = world.game->danger_forecast;
+  Vector2f self(512.5f, 512.5f);
+
+  world.AddWeapon(MakeWeapon(WeaponType::Bullet, kEnemyId, 1, Vector2f(502, 512.5f), 3200, 0, 500));
+
+  EXPECT(forecast.GetDamage(self, kForecastTicks - 1) == 200.0f);
+
+  size_t weapon_count = weapon_manager.weapon_count;
+
+  world.AddWeapon(MakeWeapon(WeaponType::Bullet, kOtherEnemyId, 1, Vector2f(502, 502), -3200, 0, 500));
+  weapon_manager.ClearWeapons(*world.GetPlayerManager().GetPlayerById(kEnemyId));
+
+  EXPECT(weapon_manager.weapon_count == weapon_count);
+  EXPECT(forecast.GetDamage(self, kForecastTicks - 1) == 0.0f);
+  EXPECT(forecast.GetFirstHitTick(self) == kNoForecastHit);
+
+  // A new tick rebuilds it even without any weapon changes.
+  u32 generation = forecast.generation;
+
+  AdvanceTick(1);
+  forecast.Update();
+
+  EXPECT(forecast.generation != generation);
+}
+
+}  // namespace test
+}  // namespace zero
@@ -0,0 +1,474 @@
+#include <stdio.h>
+#include <zero/Steering.h>
+#include <zero/game/Clock.h>
+#include <zero/game/Map.h>
+#include <zero/game/PlayerManager.h>
+
+#include <random>
+#include <vector>
+
+#include "Test.h"
+#include "TestClock.h"
+#include "TestWorld.h"
+
+namespace zero {
+namespace test {
+
+// Random short walls around the middle of the map, so some paths are in the open and others run into a wall.
+static void CreatePlayerWorld(TestWorld& world, std::mt19937& rng) {
+  std::uniform_int_distribution<int> coord(400, 623);
+  std::uniform_int_distribution<int> length(1, 8);
+  std::uniform_int_distribution<int> chance(0, 99);
+
+  std::vector<Tile> tiles;
+
+  for (int i = 0; i < 250; ++i) {
+    int x = coord(rng);
+    int y = coord(rng);
+    int count = length(rng);
+    bool vertical = chance(rng) < 50;
+
+    for (int j = 0; j < count; ++j) {
+      tiles.push_back(MakeTile((u16)(vertical ? x : x + j), (u16)(vertical ? y + j : y), 1));
+    }
+  }
+
+  world.LoadTiles(tiles);
+
+  ArenaSettings& settings = world.game->connection.settings;
+
+  settings.BounceFactor = 22;
+
+  for (size_t i = 0; i < 8; ++i) {
+    settings.ShipSettings[i].Radius = 14;
+  }
+}
+
+// A player in an open spot of the map with a random velocity.
+static Player MakeOpenPlayer(Map& map, std::mt19937& rng) {
+  std::uniform_real_distribution<float> coord(400.0f, 624.0f);
+  std::uniform_real_distribution<float> velocity(-20.0f, 20.0f);
+
+  Player player = {};
+
+  player.id = 1;
+  player.ship = 0;
+
+  do {
+    player.position = Vector2f(coord(rng), coord(rng));
+  } while (!map.IsAreaOpen((s32)player.position.x - 1, (s32)player.position.y - 1, (s32)player.position.x + 1,
+                           (s32)player.position.y + 1));
+
+  player.velocity = Vector2f(velocity(rng), velocity(rng));
+
+  return player;
+}
+
+ZERO_TEST(player_extrapolate_open_matches_simulation) {
+  TestWorld world;
+  std::mt19937 rng(8642);
+
+  CreatePlayerWorld(world, rng);
+
+  PlayerManager& player_manager = world.GetPlayerManager();
+  Map& map = world.GetMap();
+
+  std::uniform_int_distribution<s32> ticks(1, 60);
+
+  size_t open_count = 0;
+  size_t blocked_count = 0;
+
+  for (size_t i = 0; i < 5000; ++i) {
+    Player start = MakeOpenPlayer(map, rng);
+    s32 tick_count = ticks(rng);
+
+    Player extrapolated = start;
+    Player simulated = start;
+
+    for (s32 j = 0; j < tick_count; ++j) {
+      player_manager.SimulatePlayer(simulated, 1.0f / 100.0f, true);
+    }
+
+    if (!player_manager.ExtrapolateOpen(extrapolated, tick_count)) {
+      // Nothing is touched when the path isn't open.
+      EXPECT(extrapolated.position == start.position);
+      ++blocked_count;
+      continue;
+    }
+
+    // Open paths never bounce, so the steps must be exactly the same.
+    EXPECT(extrapolated.position == simulated.position);
+    EXPECT(extrapolated.velocity == simulated.velocity);
+    ++open_count;
+  }
+
+  EXPECT(open_count > 1000);
+  EXPECT(blocked_count > 1000);
+}
+
+// Every open area has to be free of solid tiles, and areas with a solid tile can't be open.
+ZERO_TEST(player_area_open_matches_tiles) {
+  TestWorld world;
+  std::mt19937 rng(9753);
+
+  CreatePlayerWorld(world, rng);
+
+  Map& map = world.GetMap();
+
+  std::uniform_int_distribution<s32> coord(390, 630);
+  std::uniform_int_distribution<s32> size(0, 12);
+
+  size_t open_count = 0;
+
+  for (size_t i = 0; i < 5000; ++i) {
+    s32 start_x = coord(rng);
+    s32 start_y = coord(rng);
+    s32 end_x = start_x + size(rng);
+    s32 end_y = start_y + size(rng);
+
+    bool solid = false;
+
+    for (s32 y = start_y; y <= end_y && !solid; ++y) {
+      for (s32 x = start_x; x <= end_x && !solid; ++x) {
+        solid = map.IsSolid((u16)x, (u16)y, 0);
+      }
+    }
+
+    bool open = map.IsAreaOpen(start_x, start_y, end_x, end_y);
+
+    EXPECT(!(open && solid));
+    if (open) ++open_count;
+  }
+
+  EXPECT(open_count > 1000);
+}
+
+// Players spread over the middle of the map on four frequencies, with some of them in spectator mode or respawning.
+static void AddRandomPlayers(TestWorld& world, std::mt19937& rng, u16 count) {
+  std::uniform_real_distribution<float> coord(400.0f, 624.0f);
+  std::uniform_real_distribution<float> velocity(-10.0f, 10.0f);
+  std::uniform_int_distribution<int> frequency(0, 3);
+  std::uniform_int_distribution<int> ship(0, 8);
+  std::uniform_int_distribution<int> chance(0, 99);
+
+  for (u16 id = 1; id <= count; ++id) {
+    Player* player = world.AddPlayer(id, (u8)ship(rng), (u16)frequency(rng), Vector2f(coord(rng), coord(rng)));
+    if (!player) continue;
+
+    player->energy = (float)chance(rng) * 10.0f;
+    player->togglables = (u8)chance(rng);
+
+    if (chance(rng) < 10) {
+      player->enter_delay = 1.0f;
+    }
+
+    world.SetPlayerPosition(*player, player->position, Vector2f(velocity(rng), velocity(rng)));
+  }
+}
+
+// Same as Steering::AvoidEnemy, but reads the full player records instead of the hot view.
+static Vector2f GetAvoidEnemyForce(PlayerManager& player_manager, float dist) {
+  Player* self = player_manager.GetSelf();
+  Vector2f avoid_force;
+  float count = 0.0f;
+  u32 current_tick = GetCurrentTick();
+
+  for (size_t i = 0; i < player_manager.player_count; ++i) {
+    Player& player = player_manager.players[i];
+
+    if (player.frequency == self->frequency) continue;
+    if (player.id == self->id) continue;
+    if (player.IsRespawning()) continue;
+    if (player.position == Vector2f(0, 0)) continue;
+    if (!player_manager.IsSynchronized(player, current_tick)) continue;
+
+    float dist_sq = player.position.DistanceSq(self->position);
+    if (dist_sq > dist * dist) continue;
+
+    float team_dist = sqrtf(dist_sq);
+    float diff = dist - team_dist;
+
+    avoid_force += Normalize(self->position - player.position) * (diff * diff);
+    ++count;
+  }
+
+  return count > 0 ? avoid_force / count : Vector2f(0, 0);
+}
+
+static bool HotViewMatches(PlayerManager& player_manager, size_t index) {
+  const PlayerHotView& hot = player_manager.hot;
+  const Player& player = player_manager.players[index];
+
+  return hot.id[index] == player.id && hot.frequency[index] == player.frequency && hot.ship[index] == player.ship &&
+         hot.togglables[index] == player.togglables && hot.timestamp[index] == player.timestamp &&
+         hot.x[index] == player.position.x && hot.y[index] == player.position.y &&
+         hot.velocity_x[index] == player.velocity.x && hot.velocity_y[index] == player.velocity.y &&
+         hot.energy[index] == player.energy && hot.enter_delay[index] == player.enter_delay;
+}
+
+// Removing players moves the last player into the removed slot, so the hot view has to follow it.
+ZERO_TEST(player_hot_view_matches_players) {
+  TestWorld world;
+  std::mt19937 rng(1122);
+
+  CreatePlayerWorld(world, rng);
+
+  PlayerManager& player_manager = world.GetPlayerManager();
+  player_manager.player_id = 1;
+
+  AddRandomPlayers(world, rng, 300);
+
+  std::uniform_int_distribution<int> remove_id(2, 300);
+
+  for (int i = 0; i < 60; ++i) {
+    Player* player = player_manager.GetPlayerById((u16)remove_id(rng));
+
+    if (player) {
+      player_manager.RemovePlayer(player);
+    }
+  }
+
+  EXPECT(player_manager.player_count < 300);
+
+  for (size_t i = 0; i < player_manager.player_count; ++i) {
+    EXPECT(HotViewMatches(player_manager, i));
+  }
+
+  Steering steering;
+
+  for (float dist : {5.0f, 30.0f, 100.0f}) {
+    steering.Reset();
+    steering.AvoidEnemy(*world.game, dist);
+
+    Vector2f expected = GetAvoidEnemyForce(player_manager, dist);
+
+    EXPECT(steering.force.Distance(expected) < 0.0001f);
+  }
+
+  // Enough enemies are nearby for the scans to find something.
+  EXPECT(GetAvoidEnemyForce(player_manager, 100.0f) != Vector2f(0, 0));
+}
+
+// Filtering every player by frequency, ship, and distance from the packed arrays compared to the full records.
+ZERO_BENCHMARK(player_hot_view_scan) {
+  constexpr int kScans = 5000;
+
+  TestWorld world;
+  std::mt19937 rng(3344);
+
+  CreatePlayerWorld(world, rng);
+
+  PlayerManager& player_manager = world.GetPlayerManager();
+  player_manager.player_id = 1;
+
+  AddRandomPlayers(world, rng, 1000);
+
+  Player& self = *player_manager.GetSelf();
+  const PlayerHotView& hot = player_manager.hot;
+  float radius_sq = 40.0f * 40.0f;
+
+  size_t hot_count = 0;
+  size_t direct_count = 0;
+
+  u64 start = GetMicrosecondTick();
+
+  for (int scan = 0; scan < kScans; ++scan) {
+    for (size_t i = 0; i < player_manager.player_count; ++i) {
+      if (hot.frequency[i] == self.frequency) continue;
+      if (hot.ship[i] >= 8) continue;
+      if (hot.IsRespawning(i)) continue;
+      if (hot.GetPosition(i).DistanceSq(self.position) > radius_sq) continue;
+
+      ++hot_count;
+    }
+  }
+
+  u64 hot_time = GetMicrosecondTick() - start;
+
+  start = GetMicrosecondTick();
+
+  for (int scan = 0; scan < kScans; ++scan) {
+    for (size_t i = 0; i < player_manager.player_count; ++i) {
+      Player& player = player_manager.players[i];
+
+      if (player.frequency == self.frequency) continue;
+      if (player.ship >= 8) continue;
+      if (player.IsRespawning()) continue;
+      if (player.position.DistanceSq(self.position) > radius_sq) continue;
+
+      ++direct_count;
+    }
+  }
+
+  u64 direct_time = GetMicrosecondTick() - start;
+
+  EXPECT(hot_count == direct_count);
+
+  printf("  %zu players: hot view %.2f us/scan, players %.2f us/scan (%.2fx)\n", player_manager.player_count,
+         (double)hot_time / kScans, (double)direct_time / kScans, (double)direct_time / hot_time);
+}
+
+// Positions every kTicksPerSample ticks for the whole prediction horizon, stepped one tick at a time.
+static std::vector<Vector2f> SimulateSamples(PlayerManager& player_manager, const Player& player, Vector2f* end_velocity) {
+  std::vector<Vector2f> samples = {player.position};
+  Player sim = player;
+
+  for (size_t i = 0; i < PlayerPrediction::kMaxSamples; ++i) {
+    for (s32 j = 0; j < PlayerPrediction::kTicksPerSample; ++j) {
+      player_manager.SimulatePlayer(sim, 1.0f / 100.0f, true);
+    }
+
+    samples.push_back(sim.position);
+  }
+
+  *end_velocity = sim.velocity;
+
+  return samples;
+}
+
+// Predictions are requested out of order so samples are added to a cached prediction, and players that share a cache
+// slot are mixed together.
+ZERO_TEST(player_predict_matches_simulation) {
+  constexpr float kSampleTime = PlayerPrediction::kTicksPerSample / 100.0f;
+
+  TestWorld world;
+  std::mt19937 rng(7531);
+
+  CreatePlayerWorld(world, rng);
+
+  PlayerManager& player_manager = world.GetPlayerManager();
+  Map& map = world.GetMap();
+
+  std::vector<Player*> players;
+
+  for (u16 id = 2; id < 42; ++id) {
+    players.push_back(world.AddPlayer(id, 0, 0, Vector2f(512, 512)));
+  }
+
+  std::uniform_int_distribution<size_t> pick(0, players.size() - 1);
+  std::uniform_int_distribution<size_t> sample_index(0, PlayerPrediction::kMaxSamples - 1);
+  std::uniform_int_distribution<int> chance(0, 99);
+
+  size_t bounce_count = 0;
+
+  for (size_t i = 0; i < 400; ++i) {
+    Player& player = *players[pick(rng)];
+    Player start = MakeOpenPlayer(map, rng);
+
+    world.SetPlayerPosition(player, start.position, start.velocity);
+
+    if (chance(rng) < 30) AdvanceTick(1);
+
+    Vector2f end_velocity;
+    std::vector<Vector2f> samples = SimulateSamples(player_manager, player, &end_velocity);
+
+    Vector2f straight = player.position + player.velocity * (PlayerPrediction::kMaxSamples * kSampleTime);
+    if (samples.back().Distance(straight) > 0.01f) ++bounce_count;
+
+    // Another player in the same cache slot is predicted in between.
+    Player& other = *players[(player.id - 2 + PlayerManager::kPredictionSlots) % (PlayerManager::kPredictionSlots * 2)];
+
+    for (size_t j = 0; j < 5; ++j) {
+      size_t index = sample_index(rng);
+
+      EXPECT(player_manager.PredictPosition(player, index * kSampleTime).Distance(samples[index]) < 0.001f);
+
+      Vector2f midpoint = samples[index] + (samples[index + 1] - samples[index]) * 0.5f;
+      EXPECT(player_manager.PredictPosition(player, (index + 0.5f) * kSampleTime).Distance(midpoint) < 0.001f);
+
+      if (chance(rng) < 30) player_manager.PredictPosition(other, 1.0f);
+    }
+
+    // Past the horizon it continues in a straight line from the last sample.
+    Vector2f beyond = samples.back() + end_velocity * 0.5f;
+    float horizon = PlayerPrediction::kMaxSamples * kSampleTime;
+
+    EXPECT(player_manager.PredictPosition(player, horizon + 0.5f).Distance(beyond) < 0.001f);
+
+    // A copy with the same movement gets the same prediction.
+    Player copy = player;
+    EXPECT(player_manager.PredictPosition(copy, horizon).Distance(samples.back()) < 0.001f);
+  }
+
+  EXPECT(bounce_count > 100);
+}
+
+// A bot asks for a handful of predictions of each nearby enemy every tick, such as when pursuing and aiming.
+ZERO_BENCHMARK(player_predict_position) {
+  constexpr int kTicks = 200;
+  constexpr size_t kTargets = 8;
+  constexpr size_t kQueriesPerTarget = 6;
+
+  TestWorld world;
+  std::mt19937 rng(9876);
+
+  CreatePlayerWorld(world, rng);
+
+  PlayerManager& player_manager = world.GetPlayerManager();
+  Map& map = world.GetMap();
+
+  std::vector<Player*> players;
+
+  for (u16 id = 2; id < 2 + kTargets; ++id) {
+    Player start = MakeOpenPlayer(map, rng);
+    Player* player = world.AddPlayer(id, 0, 0, start.position);
+
+    world.SetPlayerPosition(*player, start.position, start.velocity);
+    players.push_back(player);
+  }
+
+  std::uniform_real_distribution<float> seconds(0.0f, 2.0f);
+  std::vector<float> times;
+
+  for (size_t i = 0; i < kTicks * kTargets * kQueriesPerTarget; ++i) {
+    times.push_back(seconds(rng));
+  }
+
+  Vector2f predicted_sum;
+  Vector2f simulated_sum;
+  size_t time_index = 0;
+
+  u64 start = GetMicrosecondTick();
+
+  for (int tick = 0; tick < kTicks; ++tick) {
+    AdvanceTick(1);
+
+    for (Player* player : players) {
+      for (size_t i = 0; i < kQueriesPerTarget; ++i) {
+        predicted_sum += player_manager.PredictPosition(*player, times[time_index++]);
+      }
+    }
+  }
+
+  u64 predict_time = GetMicrosecondTick() - start;
+
+  time_index = 0;
+  start = GetMicrosecondTick();
+
+  for (int tick = 0; tick < kTicks; ++tick) {
+    for (Player* player : players) {
+      for (size_t i = 0; i < kQueriesPerTarget; ++i) {
+        Player sim = *player;
+        s32 ticks = (s32)(times[time_index++] * 100.0f);
+
+        for (s32 j = 0; j < ticks; ++j) {
+          player_manager.SimulatePlayer(sim, 1.0f / 100.0f, true);
+        }
+
+        simulated_sum += sim.position;
+      }
+    }
+  }
+
+  u64 simulate_time = GetMicrosecondTick() - start;
+
+  // The simulation stops at whole ticks while predictions interpolate, so the sums only roughly agree.
+  EXPECT(predicted_sum.Distance(simulated_sum) / (kTicks * kTargets * kQueriesPerTarget) < 1.0f);
+
+  printf("  %zu targets, %zu queries each per tick: predict %.2f us/tick, simulate %.2f us/tick (%.2fx)\n", kTargets,
+         kQueriesPerTarget, (double)predict_time / kTicks, (double)simulate_time / kTicks,
+         (double)simulate_time / predict_time);
+}
+
+}  // namespace test
+}  // namespace zero
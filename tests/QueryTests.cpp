@@ -0,0 +1,142 @@
+#include <zero/BotController.h>
+#include <zero/behavior/nodes/QueryNode.h>
+
+#include "Test.h"
+#include "TestWorld.h"
+
+namespace zero {
+namespace test {
+
+constexpr u16 kSelfId = 1;
+constexpr u16 kOtherId = 2;
+
+// Counts how many times the query actually runs.
+struct CountingQueryNode : public behavior::QueryNode {
+  CountingQueryNode(const char* player_key, bool tile_precision) {
+    DependOnKey(player_key);
+    DependOnPlayer(player_key, tile_precision);
+  }
+
+  CountingQueryNode(const std::vector<const char*>& keys) {
+    for (const char* key : keys) {
+      DependOnKey(key);
+    }
+  }
+
+  behavior::ExecuteResult Query(behavior::ExecuteContext& ctx) override {
+    ++query_count;
+    return behavior::ExecuteResult::Success;
+  }
+
+  size_t query_count = 0;
+};
+
+static void CreateQueryWorld(TestWorld& world) {
+  world.LoadTiles({MakeTile(0, 0, 1)});
+
+  world.GetPlayerManager().player_id = kSelfId;
+
+  world.AddPlayer(kSelfId, 0, 0, Vector2f(512.5f, 512.5f));
+  world.AddPlayer(kOtherId, 0, 1, Vector2f(520.5f, 512.5f));
+}
+
+ZERO_TEST(query_tracks_only_its_player) {
+  TestWorld world;
+  CreateQueryWorld(world);
+
+  TestBot test_bot(world);
+  behavior::ExecuteContext& bot_ctx = test_bot.GetContext();
+
+  Player& self = *world.GetPlayerManager().GetSelf();
+  Player& other = *world.GetPlayerManager().GetPlayerById(kOtherId);
+
+  CountingQueryNode self_query(nullptr, false);
+  CountingQueryNode self_tile_query(nullptr, true);
+  CountingQueryNode other_query("other", false);
+
+  bot_ctx.blackboard.Set<Player*>("other", &other);
+
+  self_query.Execute(bot_ctx);
+  self_tile_query.Execute(bot_ctx);
+  other_query.Execute(bot_ctx);
+
+  self_query.Execute(bot_ctx);
+  self_tile_query.Execute(bot_ctx);
+  other_query.Execute(bot_ctx);
+
+  EXPECT(self_query.query_count == 1);
+  EXPECT(self_tile_query.query_count == 1);
+  EXPECT(other_query.query_count == 1);
+
+  // Another player moving only runs the query that reads that player.
+  world.SetPlayerPosition(other, Vector2f(530.5f, 512.5f));
+
+  self_query.Execute(bot_ctx);
+  other_query.Execute(bot_ctx);
+
+  EXPECT(self_query.query_count == 1);
+  EXPECT(other_query.query_count == 2);
+
+  // Moving within the tile keeps the tile query's result.
+  world.SetPlayerPosition(self, Vector2f(512.25f, 512.75f));
+
+  self_query.Execute(bot_ctx);
+  self_tile_query.Execute(bot_ctx);
+
+  EXPECT(self_query.query_count == 2);
+  EXPECT(self_tile_query.query_count == 1);
+
+  world.SetPlayerPosition(self, Vector2f(513.25f, 512.75f));
+  self_tile_query.Execute(bot_ctx);
+
+  EXPECT(self_tile_query.query_count == 2);
+
+  // Changing frequency runs it again even without moving.
+  self.frequency = 3;
+  self_tile_query.Execute(bot_ctx);
+
+  EXPECT(self_tile_query.query_count == 3);
+
+  // The player key pointing at someone else runs it again.
+  bot_ctx.blackboard.Set<Player*>("other", &self);
+  other_query.Execute(bot_ctx);
+
+  EXPECT(other_query.query_count == 3);
+}
+
+ZERO_TEST(query_tracks_every_key) {
+  TestWorld world;
+  CreateQueryWorld(world);
+
+  TestBot test_bot(world);
+  behavior::ExecuteContext& bot_ctx = test_bot.GetContext();
+
+  std::vector<const char*> keys = {"key0", "key1", "key2", "key3", "key4", "key5", "key6", "key7"};
+
+  EXPECT(keys.size() == behavior::QueryNode::kMaxQueryKeys);
+
+  CountingQueryNode query(keys);
+
+  for (const char* key : keys) {
+    bot_ctx.blackboard.Set<int>(key, 0);
+  }
+
+  query.Execute(bot_ctx);
+  query.Execute(bot_ctx);
+
+  EXPECT(query.query_count == 1);
+
+  size_t expected_count = 1;
+
+  for (const char* key : keys) {
+    bot_ctx.blackboard.Set<int>(key, 1);
+
+    query.Execute(bot_ctx);
+    query.Execute(bot_ctx);
+
+    EXPECT(query.query_count == ++expected_count);
+  }
+}
+
+}  // namespace test
+}  // namespace zero
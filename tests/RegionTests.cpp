@@ -0,0 +1,354 @@
+#include <string.h>
+#include <zero/game/Map.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Test.h"
+#include "TestWorld.h"
+
+namespace zero {
+namespace test {
+
+// A region's tiles as a full map grid so it can be decoded and compared one tile at a time.
+struct SampleRegion {
+  std::string name;
+  std::vector<u8> grid;
+
+  SampleRegion(const char* name) : name(name), grid(1024 * 1024, 0) {}
+
+  inline bool Test(int x, int y) const { return grid[y * 1024 + x] != 0; }
+  inline void Set(int x, int y) { grid[y * 1024 + x] = 1; }
+
+  void Fill(int start_x, int start_y, int end_x, int end_y) {
+    for (int y = start_y; y <= end_y; ++y) {
+      for (int x = start_x; x <= end_x; ++x) {
+        Set(x, y);
+      }
+    }
+  }
+};
+
+static void PushU32(std::vector<u8>& data, u32 value) {
+  for (int i = 0; i < 4; ++i) {
+    data.push_back((u8)(value >> (i * 8)));
+  }
+}
+
+static void PushChunk(std::vector<u8>& data, const char* type, const std::vector<u8>& chunk) {
+  data.insert(data.end(), type, type + 4);
+  PushU32(data, (u32)chunk.size());
+  data.insert(data.end(), chunk.begin(), chunk.end());
+
+  while (data.size() % 4 != 0) {
+    data.push_back(0);
+  }
+}
+
+static bool IsRowEmpty(const SampleRegion& region, int y) {
+  const u8* row = &region.grid[y * 1024];
+  return std::find(row, row + 1024, 1) == row + 1024;
+}
+
+static bool IsRowRepeated(const SampleRegion& region, int y) {
+  return memcmp(&region.grid[y * 1024], &region.grid[(y - 1) * 1024], 1024) == 0;
+}
+
+// Encodes the region with the eLVL run-length encoding. The short and long forms of each sequence are picked randomly
+// so every sequence type gets decoded.
+static std::vector<u8> EncodeRegion(const SampleRegion& region, std::mt19937& rng) {
+  std::vector<u8> result;
+
+  auto emit = [&](int type, int count) {
+    while (count > 0) {
+      bool long_run = count > 32 || (rng() & 1);
+      int run = std::min(count, long_run ? 1024 : 32);
+
+      if (long_run) {
+        result.push_back((u8)(((type | 1) << 5) | ((run - 1) >> 8)));
+        result.push_back((u8)((run - 1) & 0xFF));
+      } else {
+        result.push_back((u8)((type << 5) | (run - 1)));
+      }
+
+      count -= run;
+    }
+  };
+
+  int y = 0;
+
+  while (y < 1024) {
+    int count = 1;
+
+    if (IsRowEmpty(region, y)) {
+      while (y + count < 1024 && IsRowEmpty(region, y + count)) ++count;
+      if (y + count >= 1024) break;
+
+      emit(4, count);
+    } else if (y > 0 && IsRowRepeated(region, y)) {
+      while (y + count < 1024 && IsRowRepeated(region, y + count)) ++count;
+
+      emit(6, count);
+    } else {
+      const u8* row = &region.grid[y * 1024];
+      count = 1;
+
+      for (int x = 0; x < 1024;) {
+        int length = 1;
+        while (x + length < 1024 && row[x + length] == row[x]) ++length;
+
+        emit(row[x] ? 2 : 0, length);
+        x += length;
+      }
+    }
+
+    y += count;
+  }
+
+  return result;
+}
+
+// Builds a level file with an eLVL section holding the regions followed by the tile data.
+static std::vector<u8> BuildLevel(const std::vector<SampleRegion>& regions, const std::vector<Tile>& tiles,
+                                  std::mt19937& rng) {
+  constexpr u32 kElvlOffset = 16;
+
+  std::vector<u8> elvl;
+
+  for (const SampleRegion& region : regions) {
+    std::vector<u8> regn;
+
+    PushChunk(regn, "rNAM", std::vector<u8>(region.name.begin(), region.name.end()));
+    PushChunk(regn, "rTIL", EncodeRegion(region, rng));
+
+    PushChunk(elvl, "REGN", regn);
+  }
+
+  std::vector<u8> data = {'B', 'M'};
+  u32 tile_offset = kElvlOffset + 12 + (u32)elvl.size();
+
+  PushU32(data, tile_offset);
+  PushU32(data, kElvlOffset);
+  data.resize(kElvlOffset, 0);
+
+  data.insert(data.end(), {'e', 'l', 'v', 'l'});
+  PushU32(data, 12 + (u32)elvl.size());
+  PushU32(data, 0);
+  data.insert(data.end(), elvl.begin(), elvl.end());
+
+  const u8* tile_data = (const u8*)tiles.data();
+  data.insert(data.end(), tile_data, tile_data + tiles.size() * sizeof(Tile));
+
+  return data;
+}
+
+// Decodes the tiles eagerly into a full grid one tile at a time. This is how regions were decoded before they were
+// decoded into runs, so the lazily decoded bitsets should contain exactly the same tiles.
+static SampleRegion DecodeEager(const std::string& name, const u8* data, size_t size) {
+  SampleRegion region(name.data());
+
+  int current_x = 0;
+  int current_y = 0;
+
+  auto set_tile = [&region](int x, int y) {
+    if (x < 1024 && y < 1024) region.Set(x, y);
+  };
+
+  const u8* end = data + size;
+
+  while (data < end) {
+    int type = data[0] >> 5;
+    bool long_run = type & 1;
+
+    if (long_run && data + 1 >= end) break;
+
+    int run = long_run ? ((((data[0] & 3) << 8) | data[1]) + 1) : ((data[0] & 0x1F) + 1);
+    data += long_run ? 2 : 1;
+
+    if (type <= 3) {
+      if (type >= 2) {
+        for (int i = 0; i < run; ++i) {
+          set_tile(current_x + i, current_y);
+        }
+      }
+
+      current_x += run;
+      if (current_x >= 1024) {
+        current_x = 0;
+        current_y++;
+      }
+    } else if (type <= 5) {
+      current_x = 0;
+      current_y += run;
+    } else {
+      current_x = 0;
+
+      for (int i = 0; i < run; ++i) {
+        for (int x = 0; x < 1024; ++x) {
+          if (current_y > 0 && current_y - 1 < 1024 && region.Test(x, current_y - 1)) {
+            set_tile(x, current_y + i);
+          }
+        }
+      }
+
+      current_y += run;
+    }
+  }
+
+  return region;
+}
+
+static std::vector<SampleRegion> CreateSampleRegions(std::mt19937& rng) {
+  std::vector<SampleRegion> regions;
+
+  regions.emplace_back("base");
+  regions.back().Fill(100, 100, 299, 199);
+  regions.back().Fill(150, 200, 180, 400);
+
+  regions.emplace_back("edges");
+  regions.back().Fill(0, 0, 1023, 0);
+  regions.back().Fill(1000, 0, 1023, 1023);
+  regions.back().Fill(0, 1023, 1023, 1023);
+
+  regions.emplace_back("circle");
+  for (int y = 412; y <= 612; ++y) {
+    for (int x = 412; x <= 612; ++x) {
+      if ((x - 512) * (x - 512) + (y - 512) * (y - 512) <= 100 * 100) {
+        regions.back().Set(x, y);
+      }
+    }
+  }
+
+  regions.emplace_back("overlap");
+  regions.back().Fill(250, 150, 600, 550);
+
+  regions.emplace_back("noise");
+  for (int i = 0; i < 20000; ++i) {
+    regions.back().Set(rng() % 1024, rng() % 1024);
+  }
+
+  regions.emplace_back("empty");
+
+  return regions;
+}
+
+ZERO_TEST(regions_decode_matches_eager) {
+  std::mt19937 rng(1234);
+  std::vector<SampleRegion> samples = CreateSampleRegions(rng);
+
+  std::vector<Tile> tiles = {MakeTile(512, 512, 1), MakeTile(10, 10, 2)};
+  std::vector<u8> level = BuildLevel(samples, tiles, rng);
+
+  TestWorld world;
+  EXPECT(world.LoadMap(level));
+
+  Map& map = world.GetMap();
+
+  EXPECT(map.GetTileId(512, 512) == 1);
+  EXPECT(map.GetTileId(10, 10) == 2);
+
+  // Decode every rTIL chunk of the level file again eagerly and compare against the regions that the map decoded.
+  size_t compared = 0;
+  u32 elvl_offset = 16;
+  const u8* current = level.data() + elvl_offset + 12;
+  const u8* elvl_end = level.data() + elvl_offset + *(u32*)(level.data() + elvl_offset + 4);
+
+  while (current < elvl_end) {
+    u32 chunk_size = *(u32*)(current + 4);
+    const u8* sub = current + 8;
+    const u8* sub_end = sub + chunk_size;
+
+    std::string name;
+    const u8* tile_data = nullptr;
+    u32 tile_size = 0;
+
+    while (sub < sub_end) {
+      u32 sub_size = *(u32*)(sub + 4);
+
+      if (memcmp(sub, "rNAM", 4) == 0) name.assign((const char*)sub + 8, sub_size);
+      if (memcmp(sub, "rTIL", 4) == 0) {
+        tile_data = sub + 8;
+        tile_size = sub_size;
+      }
+
+      sub += 8 + ((sub_size + 3) & ~3);
+    }
+
+    current += 8 + ((chunk_size + 3) & ~3);
+
+    const elvl::Region* region = map.GetRegionByName(name.data());
+    EXPECT(region != nullptr);
+    EXPECT(tile_data != nullptr);
+    if (!region || !tile_data) continue;
+
+    SampleRegion eager = DecodeEager(name, tile_data, tile_size);
+    auto sample = std::find_if(samples.begin(), samples.end(), [&](const auto& s) { return s.name == name; });
+
+    EXPECT(sample != samples.end() && sample->grid == eager.grid);
+
+    size_t mismatches = 0;
+    size_t eager_count = 0;
+
+    for (u16 y = 0; y < 1024; ++y) {
+      for (u16 x = 0; x < 1024; ++x) {
+        bool expected = eager.Test(x, y);
+
+        eager_count += expected;
+        mismatches += region->InRegion(x, y) != expected;
+      }
+    }
+
+    EXPECT(mismatches == 0);
+    EXPECT(map.GetRegionTiles(*region).size() == eager_count);
+
+    ++compared;
+  }
+
+  EXPECT(compared == samples.size());
+}
+
+ZERO_TEST(regions_index_matches_bitsets) {
+  std::mt19937 rng(4321);
+  std::vector<SampleRegion> samples = CreateSampleRegions(rng);
+
+  TestWorld world;
+  EXPECT(world.LoadMap(BuildLevel(samples, {MakeTile(1, 1, 1)}, rng)));
+
+  Map& map = world.GetMap();
+
+  std::vector<const elvl::Region*> regions;
+  for (const SampleRegion& sample : samples) {
+    const elvl::Region* region = map.GetRegionByName(sample.name.data());
+
+    EXPECT(region != nullptr);
+    if (region) regions.push_back(region);
+  }
+
+  size_t mismatches = 0;
+
+  for (u16 y = 0; y < 1024; ++y) {
+    for (u16 x = 0; x < 1024; ++x) {
+      elvl::RegionSet set = map.GetRegionSet(x, y);
+      size_t expected_count = 0;
+
+      for (const elvl::Region* region : regions) {
+        if (!region->InRegion(x, y)) continue;
+
+        ++expected_count;
+        mismatches += std::find(set.begin(), set.end(), region) == set.end();
+      }
+
+      mismatches += set.count != expected_count;
+    }
+  }
+
+  EXPECT(mismatches == 0);
+  EXPECT(map.InRegion("circle", 512, 512));
+  EXPECT(!map.InRegion("circle", 100, 100));
+  EXPECT(map.GetRegions(1023, 1023).size() == 1);
+}
+
+}  // namespace test
+}  // namespace zero
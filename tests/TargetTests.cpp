@@ -0,0 +1,295 @@
+#include <math.h>
+#include <stdio.h>
+#include <zero/HeuristicEnergyTracker.h>
+#include <zero/RegionRegistry.h>
+#include <zero/TargetTable.h>
+#include <zero/game/Clock.h>
+
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Test.h"
+#include "TestClock.h"
+#include "TestWorld.h"
+
+namespace zero {
+namespace test {
+
+constexpr u16 kSelfId = 1;
+
+// A closed room that is its own region, some safe tiles, and enemies spread around both.
+struct TargetWorld {
+  TestWorld world;
+  std::unique_ptr<RegionRegistry> region_registry = std::make_unique<RegionRegistry>();
+  std::unique_ptr<HeuristicEnergyTracker> energy_tracker;
+
+  TargetWorld(u32 seed, u16 player_count) {
+    std::vector<Tile> tiles;
+
+    for (u16 i = 440; i <= 470; ++i) {
+      tiles.push_back(MakeTile(i, 440, 1));
+      tiles.push_back(MakeTile(i, 470, 1));
+      tiles.push_back(MakeTile(440, i, 1));
+      tiles.push_back(MakeTile(470, i, 1));
+    }
+
+    for (u16 y = 480; y < 520; ++y) {
+      for (u16 x = 480; x < 520; ++x) {
+        tiles.push_back(MakeTile(x, y, (u8)kTileIdSafe));
+      }
+    }
+
+    world.LoadTiles(tiles);
+
+    ArenaSettings& settings = world.game->connection.settings;
+
+    for (size_t i = 0; i < 8; ++i) {
+      settings.ShipSettings[i].Radius = 14;
+    }
+
+    region_registry->CreateAll(world.GetMap(), 0.85f);
+
+    PlayerManager& player_manager = world.GetPlayerManager();
+
+    energy_tracker = std::make_unique<HeuristicEnergyTracker>(player_manager);
+    player_manager.player_id = kSelfId;
+
+    world.AddPlayer(kSelfId, 0, 0, Vector2f(520.5f, 520.5f));
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> coord(420.0f, 600.0f);
+    std::uniform_real_distribution<float> orientation(0.0f, 1.0f);
+    std::uniform_int_distribution<int> frequency(0, 3);
+    std::uniform_int_distribution<int> ship(0, 8);
+    std::uniform_int_distribution<int> chance(0, 99);
+
+    for (u16 id = kSelfId + 1; id <= player_count; ++id) {
+      Player* player = world.AddPlayer(id, (u8)ship(rng), (u16)frequency(rng), Vector2f(coord(rng), coord(rng)));
+      if (!player) continue;
+
+      player->orientation = orientation(rng);
+      player->energy = chance(rng) < 50 ? (float)(chance(rng) * 15) : 0.0f;
+
+      if (chance(rng) < 20) player->togglables |= Status_Stealth;
+      if (chance(rng) < 20) player->togglables |= Status_Cloak;
+      if (chance(rng) < 10) player->enter_delay = 1.0f;
+
+      // Packets stopped arriving for this player.
+      if (chance(rng) < 20) player->timestamp = (player->timestamp - 1000) & 0x7FFF;
+
+      world.SetPlayerPosition(*player, player->position);
+    }
+  }
+
+  Player& GetSelf() { return *world.GetPlayerManager().GetSelf(); }
+};
+
+struct ExpectedTarget {
+  Player* player;
+  TargetFlags flags;
+  float distance;
+  float energy;
+  float threat;
+};
+
+// Builds the same candidates that the table does, but from the full player records.
+static std::vector<ExpectedTarget> GetExpectedTargets(TargetWorld& target_world) {
+  Game& game = *target_world.world.game;
+  PlayerManager& player_manager = game.player_manager;
+  Player& self = target_world.GetSelf();
+  RegionIndex self_region = target_world.region_registry->GetRegionIndex(self.position);
+
+  std::vector<ExpectedTarget> targets;
+
+  for (size_t i = 0; i < player_manager.player_count; ++i) {
+    Player& player = player_manager.players[i];
+
+    if (player.ship >= 8) continue;
+    if (player.frequency == self.frequency) continue;
+    if (player.IsRespawning()) continue;
+    if (player.position == Vector2f(0, 0)) continue;
+
+    ExpectedTarget target = {&player, 0, 0.0f, 0.0f, 0.0f};
+
+    if (self_region != kUndefinedRegion &&
+        target_world.region_registry->GetRegionIndex(player.position) == self_region) {
+      target.flags |= TargetFlag_Connected;
+    }
+
+    bool synchronized = player_manager.IsSynchronized(player);
+
+    if (synchronized) target.flags |= TargetFlag_Synchronized;
+    if (synchronized || !game.radar.InRadarView(player.position)) target.flags |= TargetFlag_Remembered;
+    if (game.GetMap().GetTileId(player.position) == kTileIdSafe) target.flags |= TargetFlag_Safe;
+    if (IsPlayerVisible(game.connection.settings, self, player)) target.flags |= TargetFlag_Visible;
+
+    target.distance = player.position.Distance(self.position);
+    target.energy = target_world.energy_tracker->GetEnergy(player);
+
+    float facing = 1.0f;
+
+    if (target.distance > 0.0f) {
+      Vector2f heading = OrientationToHeading((u8)(player.orientation * 40.0f) % 40);
+
+      facing = heading.Dot(Normalize(self.position - player.position));
+    }
+
+    target.threat = fmaxf(facing, 0.0f) * 30.0f / (30.0f + target.distance);
+
+    targets.push_back(target);
+  }
+
+  return targets;
+}
+
+static Player* SelectExpected(const std::vector<ExpectedTarget>& targets, TargetFlags required, TargetFlags excluded,
+                              const TargetScoreWeights& weights) {
+  Player* best = nullptr;
+  float best_score = std::numeric_limits<float>::max();
+
+  for (const ExpectedTarget& target : targets) {
+    if ((target.flags & required) != required) continue;
+    if (target.flags & excluded) continue;
+
+    float score = target.distance * weights.distance + target.energy * weights.energy + target.threat * weights.threat;
+
+    if (score < best_score) {
+      best_score = score;
+      best = target.player;
+    }
+  }
+
+  return best;
+}
+
+ZERO_TEST(target_table_matches_players) {
+  TargetWorld target_world(4321, 400);
+  auto table = std::make_unique<TargetTable>();
+
+  table->Update(*target_world.world.game, *target_world.region_registry, 1, *target_world.energy_tracker);
+
+  std::vector<ExpectedTarget> expected = GetExpectedTargets(target_world);
+
+  EXPECT(table->count == expected.size());
+  if (table->count != expected.size()) return;
+
+  TargetFlags all_flags = 0;
+  TargetFlags any_missing = 0;
+
+  for (size_t i = 0; i < table->count; ++i) {
+    EXPECT(table->players[i] == expected[i].player);
+    EXPECT(table->flags[i] == expected[i].flags);
+    EXPECT(table->energy[i] == expected[i].energy);
+    EXPECT(fabsf(table->distance[i] - expected[i].distance) < 0.001f);
+    EXPECT(fabsf(table->threat[i] - expected[i].threat) < 0.0001f);
+
+    all_flags |= table->flags[i];
+    any_missing |= ~table->flags[i];
+  }
+
+  // Every flag is set for some players and missing for others, except remembered since the radar view is empty.
+  TargetFlags varied = TargetFlag_Connected | TargetFlag_Synchronized | TargetFlag_Safe | TargetFlag_Visible;
+
+  EXPECT((all_flags & varied) == varied);
+  EXPECT((any_missing & varied) == varied);
+
+  std::mt19937 rng(8765);
+  std::uniform_int_distribution<int> flag_mask(0, 31);
+  std::uniform_real_distribution<float> weight(-2.0f, 2.0f);
+
+  size_t selected_count = 0;
+
+  for (size_t i = 0; i < 2000; ++i) {
+    TargetFlags required = (TargetFlags)flag_mask(rng);
+    TargetFlags excluded = (TargetFlags)flag_mask(rng) & ~required;
+    TargetScoreWeights weights(weight(rng), weight(rng), weight(rng) * 100.0f);
+
+    Player* selected = table->Select(required, excluded, weights);
+
+    EXPECT(selected == SelectExpected(expected, required, excluded, weights));
+    if (selected) ++selected_count;
+  }
+
+  EXPECT(selected_count > 500);
+}
+
+ZERO_TEST(target_table_rebuilds_on_change) {
+  TargetWorld target_world(5678, 50);
+  Game& game = *target_world.world.game;
+  auto table = std::make_unique<TargetTable>();
+
+  table->Update(game, *target_world.region_registry, 1, *target_world.energy_tracker);
+  EXPECT(table->count > 0);
+
+  // Clearing the count shows whether the next update rebuilt the table.
+  table->count = 0;
+  table->Update(game, *target_world.region_registry, 1, *target_world.energy_tracker);
+  EXPECT(table->count == 0);
+
+  AdvanceTick(1);
+  table->Update(game, *target_world.region_registry, 1, *target_world.energy_tracker);
+  EXPECT(table->count > 0);
+
+  table->count = 0;
+  table->Update(game, *target_world.region_registry, 2, *target_world.energy_tracker);
+  EXPECT(table->count > 0);
+
+  table->count = 0;
+  Player& player = target_world.world.GetPlayerManager().players[1];
+  target_world.world.SetPlayerPosition(player, player.position + Vector2f(1, 0));
+  table->Update(game, *target_world.region_registry, 2, *target_world.energy_tracker);
+  EXPECT(table->count > 0);
+}
+
+// Building the table once and selecting from it compared to scanning every player for each target node.
+ZERO_BENCHMARK(target_table_select) {
+  constexpr int kTicks = 500;
+  constexpr int kSelectsPerTick = 4;
+
+  TargetWorld target_world(2468, 1000);
+  Game& game = *target_world.world.game;
+  auto table = std::make_unique<TargetTable>();
+  TargetScoreWeights weights(1.0f, 0.1f, -20.0f);
+  TargetFlags required = TargetFlag_Connected | TargetFlag_Visible;
+
+  size_t table_count = 0;
+  size_t direct_count = 0;
+
+  u64 start = GetMicrosecondTick();
+
+  for (int tick = 0; tick < kTicks; ++tick) {
+    AdvanceTick(1);
+    table->Update(game, *target_world.region_registry, 1, *target_world.energy_tracker);
+
+    for (int i = 0; i < kSelectsPerTick; ++i) {
+      if (table->Select(required, TargetFlag_Safe, weights)) ++table_count;
+    }
+  }
+
+  u64 table_time = GetMicrosecondTick() - start;
+
+  start = GetMicrosecondTick();
+
+  for (int tick = 0; tick < kTicks; ++tick) {
+    AdvanceTick(1);
+
+    for (int i = 0; i < kSelectsPerTick; ++i) {
+      std::vector<ExpectedTarget> targets = GetExpectedTargets(target_world);
+
+      if (SelectExpected(targets, required, TargetFlag_Safe, weights)) ++direct_count;
+    }
+  }
+
+  u64 direct_time = GetMicrosecondTick() - start;
+
+  EXPECT(table_count == direct_count);
+
+  printf("  %zu players, %d selects per tick: table %.2f us/tick, direct %.2f us/tick (%.2fx)\n",
+         game.player_manager.player_count, kSelectsPerTick, (double)table_time / kTicks, (double)direct_time / kTicks,
+         (double)direct_time / table_time);
+}
+
+}  // namespace test
+}  // namespace zero
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <zero/Types.h>
+
+#include <vector>
+
+namespace zero {
+namespace test {
+
+struct TestContext {
+  const char* name = nullptr;
+  size_t failures = 0;
+
+  void Fail(const char* file, int line, const char* expression);
+};
+
+using TestFunction = void (*)(TestContext& ctx);
+
+struct TestCase {
+  const char* name;
+  TestFunction function;
+  bool benchmark;
+};
+
+std::vector<TestCase>& GetTestCases();
+
+struct TestRegistration {
+  TestRegistration(const char* name, TestFunction function, bool benchmark) {
+    GetTestCases().push_back({name, function, benchmark});
+  }
+};
+
+// Benchmarks are only run when requested with --bench, so they can take longer than the tests that ctest runs.
+#define ZERO_TEST_CASE(name, benchmark)                                            \
+  static void name(zero::test::TestContext& ctx);                                  \
+  static zero::test::TestRegistration name##_registration(#name, name, benchmark); \
+  static void name(zero::test::TestContext& ctx)
+
+#define ZERO_TEST(name) ZERO_TEST_CASE(name, false)
+#define ZERO_BENCHMARK(name) ZERO_TEST_CASE(name, true)
+
+#define EXPECT(expression)                       \
+  do {                                           \
+    if (!(expression)) {                         \
+      ctx.Fail(__FILE__, __LINE__, #expression); \
+    }                                            \
+  } while (0)
+
+}  // namespace test
+}  // namespace zero
@@ -0,0 +1,31 @@
+#include "TestClock.h"
+
+#include <chrono>
+
+namespace zero {
+namespace test {
+
+static Tick current_tick = 100000;
+
+void SetCurrentTick(Tick tick) {
+  current_tick = MAKE_TICK(tick);
+}
+
+void AdvanceTick(s32 ticks) {
+  current_tick = MAKE_TICK(current_tick + ticks);
+}
+
+}  // namespace test
+
+Tick GetCurrentTick() {
+  return test::current_tick;
+}
+
+u64 GetMicrosecondTick() {
+  using micro = std::chrono::duration<u64, std::micro>;
+
+  auto now = std::chrono::high_resolution_clock::now();
+  return std::chrono::time_point_cast<micro>(now).time_since_epoch().count();
+}
+
+}  // namespace zero
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <zero/game/Clock.h>
+
+namespace zero {
+namespace test {
+
+// The tests link their own clock so the current tick only changes when a test advances it.
+void SetCurrentTick(Tick tick);
+void AdvanceTick(s32 ticks = 1);
+
+}  // namespace test
+}  // namespace zero
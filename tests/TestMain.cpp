@@ -0,0 +1,97 @@
+#include <stdio.h>
+#include <string.h>
+#include <zero/game/Logger.h>
+
+#include <string_view>
+#include <vector>
+
+#include "Test.h"
+
+namespace zero {
+
+// These are normally defined by the bot executable.
+const char* kSecurityServiceIp = "127.0.0.1";
+const char* kServerName = "test";
+
+namespace test {
+
+std::vector<TestCase>& GetTestCases() {
+  static std::vector<TestCase> cases;
+  return cases;
+}
+
+void TestContext::Fail(const char* file, int line, const char* expression) {
+  if (failures < 10) {
+    printf("  %s:%d: expected %s\n", file, line, expression);
+  }
+
+  ++failures;
+}
+
+static bool IsSelected(const TestCase& test_case, const std::vector<std::string_view>& filters) {
+  if (filters.empty()) return true;
+
+  std::string_view name = test_case.name;
+
+  for (std::string_view filter : filters) {
+    if (name.substr(0, filter.size()) == filter) return true;
+  }
+
+  return false;
+}
+
+}  // namespace test
+}  // namespace zero
+
+// Usage: zero_tests [--bench] [name prefix...]
+// Runs the tests, or the benchmarks with --bench, whose names start with any of the prefixes.
+int main(int argc, char* argv[]) {
+  using namespace zero::test;
+
+  bool benchmark = false;
+  std::vector<std::string_view> filters;
+
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--bench") == 0) {
+      benchmark = true;
+    } else {
+      filters.push_back(argv[i]);
+    }
+  }
+
+  zero::g_LogPrintLevel = zero::LogLevel::Error;
+
+  size_t run_count = 0;
+  size_t failed_count = 0;
+
+  for (const TestCase& test_case : GetTestCases()) {
+    if (test_case.benchmark != benchmark) continue;
+    if (!IsSelected(test_case, filters)) continue;
+
+    TestContext ctx;
+    ctx.name = test_case.name;
+
+    printf("[ RUN  ] %s\n", test_case.name);
+    fflush(stdout);
+
+    test_case.function(ctx);
+
+    if (ctx.failures > 0) {
+      printf("[ FAIL ] %s (%zu failures)\n", test_case.name, ctx.failures);
+      ++failed_count;
+    } else {
+      printf("[  OK  ] %s\n", test_case.name);
+    }
+
+    ++run_count;
+  }
+
+  printf("%zu run, %zu failed\n", run_count, failed_count);
+
+  if (run_count == 0) {
+    printf("No %s matched.\n", benchmark ? "benchmarks" : "tests");
+    return 1;
+  }
+
+  return failed_count > 0 ? 1 : 0;
+}
@@ -0,0 +1,165 @@
+#include "TestWorld.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zero/BotController.h>
+#include <zero/game/Buffer.h>
+#include <zero/game/Clock.h>
+
+#include <thread>
+
+namespace zero {
+namespace test {
+
+constexpr size_t kPermanentSize = Megabytes(64);
+constexpr size_t kTransientSize = Megabytes(32);
+constexpr size_t kWorkSize = Megabytes(4);
+
+TestWorld::TestWorld() : TestWorld(std::thread::hardware_concurrency()) {}
+
+TestWorld::TestWorld(size_t thread_count) {
+  perm_arena = MemoryArena((u8*)malloc(kPermanentSize), kPermanentSize);
+  temp_arena = MemoryArena((u8*)malloc(kTransientSize), kTransientSize);
+  work_arena = MemoryArena((u8*)malloc(kWorkSize), kWorkSize);
+
+  work_queue = new WorkQueue(work_arena);
+  thread_pool = new ThreadPool(thread_count);
+  game = new Game(perm_arena, temp_arena, *work_queue, *thread_pool, 1920, 1080);
+}
+
+TestWorld::~TestWorld() {
+  delete game;
+  delete thread_pool;
+  delete work_queue;
+
+  free(perm_arena.base);
+  free(temp_arena.base);
+  free(work_arena.base);
+}
+
+TestBot::TestBot(TestWorld& world) {
+  controller = new BotController(*world.game);
+
+  bot.game = world.game;
+  bot.bot_controller = controller;
+  bot.execute_ctx.bot = &bot;
+}
+
+TestBot::~TestBot() {
+  delete controller;
+}
+
+bool TestWorld::LoadMap(const std::vector<u8>& data) {
+  Connection& connection = game->connection;
+
+  connection.map_arena.Reset();
+  return connection.map.LoadFromMemory(connection.map_arena, "test.lvl", data.data(), data.size());
+}
+
+bool TestWorld::LoadTiles(const std::vector<Tile>& tiles) {
+  std::vector<u8> data(tiles.size() * sizeof(Tile));
+
+  if (!tiles.empty()) {
+    memcpy(data.data(), tiles.data(), data.size());
+  }
+
+  return LoadMap(data);
+}
+
+Player* TestWorld::AddPlayer(u16 id, u8 ship, u16 frequency, const Vector2f& position) {
+  PlayerManager& player_manager = game->player_manager;
+
+  char name[20] = {};
+  sprintf(name, "player%d", id);
+
+  u8 data[64];
+  NetworkBuffer buffer(data, sizeof(data));
+
+  buffer.WriteU8(0x03);
+  buffer.WriteU8(ship);
+  buffer.WriteU8(0);
+  buffer.WriteString(name, 20);
+  buffer.WriteString("", 20);
+  buffer.WriteU32(0);
+  buffer.WriteU32(0);
+  buffer.WriteU16(id);
+  buffer.WriteU16(frequency);
+  buffer.WriteU16(0);
+  buffer.WriteU16(0);
+  buffer.WriteU16(kInvalidPlayerId);
+  buffer.WriteU16(0);
+  buffer.WriteU8(0);
+
+  player_manager.OnPlayerEnter(data, buffer.GetSize());
+
+  Player* player = player_manager.GetPlayerById(id);
+  if (!player) return nullptr;
+
+  player->timestamp = GetCurrentTick() & 0x7FFF;
+  SetPlayerPosition(*player, position);
+
+  return player;
+}
+
+void TestWorld::SetPlayerPosition(Player& player, const Vector2f& position, const Vector2f& velocity) {
+  PlayerManager& player_manager = game->player_manager;
+
+  player.position = position;
+  player.velocity = velocity;
+  player.lerp_time = 0.0f;
+
+  ++player_manager.position_epoch;
+  player_manager.UpdatePlayerCell(player);
+  player_manager.UpdateHotPlayer(player);
+}
+
+Weapon* TestWorld::AddWeapon(const Weapon& weapon) {
+  WeaponManager& weapon_manager = game->weapon_manager;
+
+  if (weapon_manager.weapon_count >= kMaxWeapons) return nullptr;
+
+  size_t index = weapon_manager.weapon_count++;
+  Weapon* result = weapon_manager.weapons + index;
+
+  ++weapon_manager.weapon_generation;
+
+  *result = weapon;
+  result->UpdatePosition();
+
+  weapon_manager.grid.Update((u16)index, result->position);
+
+  if (result->link_id != kInvalidLink) {
+    weapon_manager.links.Insert((u16)index, result->link_id);
+  }
+
+  float speed = result->velocity.Length();
+  if (speed > weapon_manager.max_weapon_speed) {
+    weapon_manager.max_weapon_speed = speed;
+  }
+
+  return result;
+}
+
+Weapon MakeWeapon(WeaponType type, u16 player_id, u16 frequency, const Vector2f& position, s32 velocity_x,
+                  s32 velocity_y, u32 alive_ticks) {
+  Weapon weapon = {};
+
+  weapon.player_id = player_id;
+  weapon.frequency = frequency;
+  weapon.data.type = type;
+  weapon.x = (u32)(position.x * 16000);
+  weapon.y = (u32)(position.y * 16000);
+  weapon.velocity_x = velocity_x;
+  weapon.velocity_y = velocity_y;
+  weapon.last_tick = GetCurrentTick();
+  weapon.end_tick = weapon.last_tick + alive_ticks;
+  weapon.flags = WEAPON_FLAG_INITIAL_SIM;
+  weapon.link_id = kInvalidLink;
+  weapon.prox_hit_player_id = kInvalidPlayerId;
+
+  return weapon;
+}
+
+}  // namespace test
+}  // namespace zero
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <zero/Types.h>
+#include <zero/ZeroBot.h>
+#include <zero/behavior/BehaviorTree.h>
+#include <zero/game/Game.h>
+#include <zero/game/Map.h>
+#include <zero/game/Memory.h>
+#include <zero/game/ThreadPool.h>
+#include <zero/game/WorkQueue.h>
+
+#include <vector>
+
+namespace zero {
+namespace test {
+
+// An offline game that tests can load maps into and fill with players and weapons without a connection.
+struct TestWorld {
+  MemoryArena perm_arena;
+  MemoryArena temp_arena;
+  MemoryArena work_arena;
+
+  WorkQueue* work_queue = nullptr;
+  ThreadPool* thread_pool = nullptr;
+  Game* game = nullptr;
+
+  TestWorld();
+  // The thread pool is created with this many threads instead of one for each hardware thread.
+  explicit TestWorld(size_t thread_count);
+  ~TestWorld();
+
+  TestWorld(const TestWorld& other) = delete;
+  TestWorld& operator=(const TestWorld& other) = delete;
+
+  // Loads the raw level file data into the game's map.
+  bool LoadMap(const std::vector<u8>& data);
+  bool LoadTiles(const std::vector<Tile>& tiles);
+
+  // Adds a player through the enter packet and places it at the position. The player is synchronized at the current
+  // tick, so weapons can hit it.
+  Player* AddPlayer(u16 id, u8 ship, u16 frequency, const Vector2f& position);
+  // Moves an existing player and keeps the player grid and hot view up to date.
+  void SetPlayerPosition(Player& player, const Vector2f& position, const Vector2f& velocity = Vector2f(0, 0));
+
+  // Adds the weapon to the weapon manager as if it was fired at last_tick.
+  Weapon* AddWeapon(const Weapon& weapon);
+
+  inline Map& GetMap() { return game->connection.map; }
+  inline PlayerManager& GetPlayerManager() { return game->player_manager; }
+  inline WeaponManager& GetWeaponManager() { return game->weapon_manager; }
+};
+
+// A bot and controller around a test world so behavior nodes can be executed against it. The controller builds its
+// pathfinder and regions when the self player enters, so create this before adding the self player if nodes need them.
+struct TestBot {
+  ZeroBot bot;
+  BotController* controller = nullptr;
+
+  explicit TestBot(TestWorld& world);
+  ~TestBot();
+
+  TestBot(const TestBot& other) = delete;
+  TestBot& operator=(const TestBot& other) = delete;
+
+  inline behavior::ExecuteContext& GetContext() { return bot.execute_ctx; }
+};
+
+// A weapon fired at the current tick that lives for alive_ticks. Velocities are in the weapon's units of 1/16000 of a
+// tile per tick.
+Weapon MakeWeapon(WeaponType type, u16 player_id, u16 frequency, const Vector2f& position, s32 velocity_x,
+                  s32 velocity_y, u32 alive_ticks);
+
+inline Tile MakeTile(u16 x, u16 y, u8 id) {
+  Tile tile = {};
+
+  tile.x = x;
+  tile.y = y;
+  tile.id = id;
+
+  return tile;
+}
+
+}  // namespace test
+}  // namespace zero
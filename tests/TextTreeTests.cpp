@@ -0,0 +1,257 @@
+#include <string.h>
+#include <zero/behavior/TextTree.h>
+
+#include <string>
+#include <vector>
+
+#include "Test.h"
+
+namespace zero {
+namespace test {
+
+using namespace behavior;
+
+enum class TreeColor { Red, Blue };
+
+// Records its label when it runs and returns the result it was created with.
+struct LabelNode : public BehaviorNode {
+  LabelNode(const char* label) : LabelNode(label, true) {}
+  LabelNode(const char* label, bool success) : label(label), success(success) {}
+
+  ExecuteResult Execute(ExecuteContext& ctx) override {
+    std::vector<std::string>* trace = ctx.blackboard.Get<std::vector<std::string>>("trace");
+
+    if (trace) trace->push_back(label);
+
+    return success ? ExecuteResult::Success : ExecuteResult::Failure;
+  }
+
+  const char* label;
+  bool success;
+};
+
+// Stores whichever constructor arguments it was created with.
+struct ValueNode : public BehaviorNode {
+  ValueNode(float number) : number(number) {}
+  ValueNode(int integer, TreeColor color) : integer(integer), color(color) {}
+  ValueNode(Vector2f vector) : vector(vector) {}
+  ValueNode(Vector3f vector3) : vector3(vector3) {}
+
+  ExecuteResult Execute(ExecuteContext& ctx) override { return ExecuteResult::Success; }
+
+  float number = 0.0f;
+  int integer = 0;
+  TreeColor color = TreeColor::Red;
+  Vector2f vector;
+  Vector3f vector3;
+};
+
+static NodeRegistry CreateTestRegistry() {
+  NodeRegistry registry;
+
+  registry.Register<LabelNode, const char*>("LabelNode");
+  registry.Register<LabelNode, const char*, bool>("LabelNode");
+
+  registry.Register<ValueNode, float>("ValueNode");
+  registry.Register<ValueNode, int, TreeColor>("ValueNode");
+  registry.Register<ValueNode, Vector2f>("ValueNode");
+  registry.Register<ValueNode, Vector3f>("ValueNode");
+
+  registry.RegisterSymbol("TreeColor::Blue", TreeColor::Blue);
+  registry.RegisterConstant("kFive", 5);
+
+  return registry;
+}
+
+// Parses a tree with a single ValueNode line and returns the node or null if it fails.
+static ValueNode* ParseValueNode(const NodeRegistry& registry, const char* text, TextTree& tree) {
+  TextTreeParser parser(registry);
+
+  if (!parser.Parse(text, tree)) return nullptr;
+
+  return dynamic_cast<ValueNode*>(tree.root.get());
+}
+
+ZERO_TEST(text_tree_builds_nodes) {
+  NodeRegistry registry = CreateTestRegistry();
+  TextTreeParser parser(registry);
+  TextTree tree;
+
+  const char* text =
+      "# The root selector.\n"
+      "selector\n"
+      "  sequence\n"
+      "    LabelNode \"first\"   # Trailing comment\n"
+      "    invert LabelNode \"second\" true\n"
+      "    LabelNode \"skipped\"\n"
+      "\n"
+      "  success scheduled 25 parallel\n"
+      "    LabelNode \"third\" false\n"
+      "    LabelNode \"fourth\"\n"
+      "  LabelNode \"unreached\"\n";
+
+  EXPECT(parser.Parse(text, tree));
+  EXPECT(parser.error.empty());
+
+  SelectorNode* root = dynamic_cast<SelectorNode*>(tree.root.get());
+
+  EXPECT(root && root->children_.size() == 3);
+  if (!root || root->children_.size() != 3) return;
+
+  SequenceNode* sequence = dynamic_cast<SequenceNode*>(root->children_[0].get());
+
+  EXPECT(sequence && sequence->children_.size() == 3);
+  EXPECT(sequence && dynamic_cast<InvertNode*>(sequence->children_[1].get()));
+
+  // Decorators wrap in the order they are written.
+  SuccessNode* success = dynamic_cast<SuccessNode*>(root->children_[1].get());
+  ScheduledNode* scheduled = success ? dynamic_cast<ScheduledNode*>(success->child_.get()) : nullptr;
+
+  EXPECT(scheduled && scheduled->interval_ticks_ == 25);
+  EXPECT(scheduled && dynamic_cast<ParallelNode*>(scheduled->child_.get()));
+
+  ExecuteContext tree_ctx;
+
+  tree_ctx.blackboard.Set("trace", std::vector<std::string>());
+
+  EXPECT(tree.root->Execute(tree_ctx) == ExecuteResult::Success);
+
+  std::vector<std::string> expected = {"first", "second", "third", "fourth"};
+
+  EXPECT(tree_ctx.blackboard.Value<std::vector<std::string>>("trace") == expected);
+
+  // String arguments are interned so nodes can keep the pointer after the text is gone.
+  LabelNode* first = sequence ? dynamic_cast<LabelNode*>(sequence->children_[0].get()) : nullptr;
+
+  EXPECT(first && first->label == BlackboardKey("first").GetName());
+}
+
+ZERO_TEST(text_tree_converts_arguments) {
+  NodeRegistry registry = CreateTestRegistry();
+  TextTree tree;
+
+  ValueNode* node = ParseValueNode(registry, "ValueNode 2.5f", tree);
+  EXPECT(node && node->number == 2.5f);
+
+  node = ParseValueNode(registry, "ValueNode -3", tree);
+  EXPECT(node && node->number == -3.0f);
+
+  node = ParseValueNode(registry, "ValueNode kFive TreeColor::Blue", tree);
+  EXPECT(node && node->integer == 5 && node->color == TreeColor::Blue);
+
+  node = ParseValueNode(registry, "ValueNode 7 TreeColor::Blue", tree);
+  EXPECT(node && node->integer == 7);
+
+  node = ParseValueNode(registry, "ValueNode (512, 256.5)", tree);
+  EXPECT(node && node->vector == Vector2f(512, 256.5f));
+
+  node = ParseValueNode(registry, "ValueNode (1 2 3)", tree);
+  EXPECT(node && node->vector3.x == 1.0f && node->vector3.y == 2.0f && node->vector3.z == 3.0f);
+
+  // Integers can't come from floats or from typed symbols of another type, and enums can't come from constants.
+  EXPECT(!ParseValueNode(registry, "ValueNode 2.0 TreeColor::Blue", tree));
+  EXPECT(!ParseValueNode(registry, "ValueNode TreeColor::Blue TreeColor::Blue", tree));
+  EXPECT(!ParseValueNode(registry, "ValueNode 2 kFive", tree));
+  EXPECT(!ParseValueNode(registry, "ValueNode \"text\"", tree));
+}
+
+ZERO_TEST(text_tree_sets_values) {
+  NodeRegistry registry = CreateTestRegistry();
+  TextTreeParser parser(registry);
+  TextTree tree;
+
+  const char* text =
+      "set float \"text_tree_float\" 25\n"
+      "set int \"text_tree_int\" -4\n"
+      "set u32 \"text_tree_u32\" 7\n"
+      "set u16 \"text_tree_u16\" 3\n"
+      "set bool \"text_tree_bool\" true\n"
+      "set string \"text_tree_string\" \"hello world\"\n"
+      "set vector \"text_tree_vector\" (10 20)\n"
+      "LabelNode \"root\"\n";
+
+  EXPECT(parser.Parse(text, tree));
+  EXPECT(tree.values.size() == 7);
+
+  Blackboard bb;
+  tree.ApplyValues(bb);
+
+  EXPECT(bb.Value<float>("text_tree_float") == 25.0f);
+  EXPECT(bb.Value<int>("text_tree_int") == -4);
+  EXPECT(bb.Value<u32>("text_tree_u32") == 7u);
+  EXPECT(bb.Value<u16>("text_tree_u16") == (u16)3);
+  EXPECT(bb.Value<bool>("text_tree_bool") == true);
+  EXPECT(bb.Value<std::string>("text_tree_string") == std::string("hello world"));
+  EXPECT(bb.Value<Vector2f>("text_tree_vector") == Vector2f(10, 20));
+}
+
+// Each bad tree has to fail with the line that caused it.
+ZERO_TEST(text_tree_reports_errors) {
+  NodeRegistry registry = CreateTestRegistry();
+
+  struct BadTree {
+    const char* text;
+    const char* error_start;
+  };
+
+  BadTree bad_trees[] = {
+      {"", "Line 0: The tree is empty"},
+      {"# Only a comment\n\n", "Line 0: The tree is empty"},
+      {"sequence\n\tLabelNode \"a\"\n", "Line 2: Indent with spaces"},
+      {"sequence\n  MissingNode\n", "Line 2: Unknown node 'MissingNode'"},
+      {"sequence\n  LabelNode 5\n", "Line 2: No constructor of 'LabelNode'"},
+      {"LabelNode \"a\"\n  LabelNode \"b\"\n", "Line 2: Only composites can have children"},
+      {"LabelNode \"a\"\nLabelNode \"b\"\n", "Line 2: Only one root node is allowed"},
+      {"sequence \"a\"\n", "Line 1: Composites don't take arguments"},
+      {"LabelNode \"a\n", "Line 1: Missing closing quote"},
+      {"ValueNode (1 2\n", "Line 1: Missing closing parenthesis"},
+      {"ValueNode (1)\n", "Line 1: Vectors can only have 2 or 3 numbers"},
+      {"ValueNode (1 2 3 4)\n", "Line 1: Vectors can only have 2 or 3 numbers"},
+      {"ValueNode 1.2.3\n", "Line 1: Invalid number '1.2.3'"},
+      {"ValueNode 1, 2\n", "Line 1: Unexpected character ','"},
+      {"set float \"key\"\nLabelNode \"a\"\n", "Line 1: Expected 'set <type> \"key\" value'"},
+      {"set double \"key\" 2\nLabelNode \"a\"\n", "Line 1: Expected 'set <type> \"key\" value'"},
+      {"set int \"key\" 2.5\nLabelNode \"a\"\n", "Line 1: Value doesn't match the type int"},
+      {"set bool \"key\" 1\nLabelNode \"a\"\n", "Line 1: Value doesn't match the type bool"},
+      {"scheduled -5 LabelNode \"a\"\n", "Line 1: The scheduled interval must be"},
+      {"invert\n", "Line 1: Expected a node name"},
+      {"invert \"a\"\n", "Line 1: Expected a node name"},
+  };
+
+  for (BadTree& bad_tree : bad_trees) {
+    TextTreeParser parser(registry);
+    TextTree tree;
+
+    EXPECT(!parser.Parse(bad_tree.text, tree));
+    EXPECT(!tree.root);
+    EXPECT(strncmp(parser.error.c_str(), bad_tree.error_start, strlen(bad_tree.error_start)) == 0);
+  }
+}
+
+// The shared registry has to build the nodes that the zone trees use.
+ZERO_TEST(text_tree_shared_registry) {
+  TextTreeParser parser(GetNodeRegistry());
+  TextTree tree;
+
+  const char* text =
+      "set float \"leash_distance\" 25\n"
+      "selector\n"
+      "  sequence\n"
+      "    invert VisibilityQueryNode \"nearest_target_position\"\n"
+      "    GoToNode \"nearest_target_position\"\n"
+      "  scheduled 25 sequence\n"
+      "    NearestTargetNode \"nearest_target\"\n"
+      "    NearestTargetNode \"nearest_target\" true\n"
+      "    InputActionNode InputAction::Bullet\n"
+      "    ScalarThresholdNode<float> \"leash_distance\" 10.0f\n"
+      "    GoToNode (512 512)\n";
+
+  EXPECT(parser.Parse(text, tree));
+  EXPECT(parser.error.empty());
+
+  // Typed symbols from one enum can't be used for another.
+  EXPECT(!parser.Parse("InputActionNode WeaponType::Bullet\n", tree));
+}
+
+}  // namespace test
+}  // namespace zero
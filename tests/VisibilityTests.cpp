@@ -0,0 +1,191 @@
+#include <stdio.h>
+#include <zero/game/Clock.h>
+#include <zero/game/Map.h>
+#include <zero/game/VisibilitySet.h>
+
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "Test.h"
+#include "TestWorld.h"
+
+namespace zero {
+namespace test {
+
+// Border walls, thin wall segments with some doors, and a few solid blocks.
+static std::vector<Tile> CreateVisibilityTiles(std::mt19937& rng) {
+  std::vector<u8> grid(1024 * 1024, 0);
+
+  for (int i = 0; i < 1024; ++i) {
+    grid[i] = grid[1023 * 1024 + i] = grid[i * 1024] = grid[i * 1024 + 1023] = 1;
+  }
+
+  for (int i = 0; i < 900; ++i) {
+    int x = rng() % 1000;
+    int y = rng() % 1000;
+    int width = 1 + rng() % 40;
+    int height = 1 + rng() % 3;
+
+    if (rng() & 1) std::swap(width, height);
+
+    u8 id = (rng() % 10 == 0) ? kTileIdFirstDoor : 1;
+
+    for (int fill_y = y; fill_y < y + height; ++fill_y) {
+      for (int fill_x = x; fill_x < x + width; ++fill_x) {
+        grid[fill_y * 1024 + fill_x] = id;
+      }
+    }
+  }
+
+  for (int i = 0; i < 40; ++i) {
+    int x = rng() % 960;
+    int y = rng() % 960;
+
+    for (int fill_y = y; fill_y < y + 40; ++fill_y) {
+      for (int fill_x = x; fill_x < x + 40; ++fill_x) {
+        grid[fill_y * 1024 + fill_x] = 1;
+      }
+    }
+  }
+
+  std::vector<Tile> tiles;
+
+  for (u16 y = 0; y < 1024; ++y) {
+    for (u16 x = 0; x < 1024; ++x) {
+      if (grid[y * 1024 + x]) tiles.push_back(MakeTile(x, y, grid[y * 1024 + x]));
+    }
+  }
+
+  return tiles;
+}
+
+ZERO_TEST(visibility_matches_cast) {
+  std::mt19937 rng(3);
+
+  TestWorld world;
+  EXPECT(world.LoadTiles(CreateVisibilityTiles(rng)));
+
+  Map& map = world.GetMap();
+  map.checksum = 1234;
+
+  VisibilitySet set;
+  set.Build(map);
+
+  std::uniform_real_distribution<float> position(0.0f, 1023.99f);
+  std::uniform_real_distribution<float> offset(-80.0f, 80.0f);
+
+  size_t mismatches = 0;
+  size_t known = 0;
+
+  // Check with the doors in their loaded state and then with all of them open.
+  for (int pass = 0; pass < 2; ++pass) {
+    if (pass == 1) {
+      for (size_t i = 0; i < map.door_count; ++i) {
+        map.SetTileId(map.doors[i].x, map.doors[i].y, 170);
+      }
+    }
+
+    for (int i = 0; i < 200000; ++i) {
+      Vector2f from(position(rng), position(rng));
+      Vector2f to(from.x + offset(rng), from.y + offset(rng));
+
+      CellVisibility visibility = set.GetVisibility(from, to);
+      if (visibility == CellVisibility::Unknown) continue;
+
+      bool hit = map.CastTo(from, to, 0).hit;
+
+      mismatches += visibility == CellVisibility::Visible && hit;
+      mismatches += visibility == CellVisibility::Occluded && !hit;
+      ++known;
+    }
+  }
+
+  EXPECT(known > 0);
+  EXPECT(mismatches == 0);
+}
+
+ZERO_TEST(visibility_background_build) {
+  constexpr const char* kCacheFilename = "zero_tests_visibility.vis";
+
+  std::mt19937 rng(5);
+
+  TestWorld world;
+  EXPECT(world.LoadTiles(CreateVisibilityTiles(rng)));
+
+  Map& map = world.GetMap();
+  map.checksum = 5678;
+
+  remove(kCacheFilename);
+
+  VisibilitySet expected;
+  expected.Build(map);
+
+  VisibilitySetBuild build(map, kCacheFilename);
+
+  // The build has its own copy of the tiles, so changing the map while it runs doesn't change the result.
+  for (size_t i = 0; i < map.door_count; ++i) {
+    map.SetTileId(map.doors[i].x, map.doors[i].y, 170);
+  }
+
+  u64 start = GetMicrosecondTick();
+  while (!build.IsFinished() && GetMicrosecondTick() - start < 120 * 1000 * 1000) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  EXPECT(build.IsFinished());
+
+  std::unique_ptr<VisibilitySet> result = build.TakeResult();
+
+  EXPECT(result != nullptr);
+  EXPECT(result && result->checksum == 5678);
+  EXPECT(result && result->cells == expected.cells);
+
+  // The set was saved by moving a temporary file into place.
+  VisibilitySet loaded;
+  EXPECT(loaded.Load(kCacheFilename, 5678));
+  EXPECT(loaded.cells == expected.cells);
+  EXPECT(!loaded.Load(kCacheFilename, 1));
+
+  FILE* temp_file = fopen("zero_tests_visibility.vis.tmp", "rb");
+  EXPECT(temp_file == nullptr);
+  if (temp_file) fclose(temp_file);
+
+  remove(kCacheFilename);
+}
+
+ZERO_TEST(visibility_build_cancel) {
+  constexpr const char* kCacheFilename = "zero_tests_visibility_cancel.vis";
+
+  std::mt19937 rng(7);
+
+  TestWorld world;
+  EXPECT(world.LoadTiles(CreateVisibilityTiles(rng)));
+
+  remove(kCacheFilename);
+
+  u64 start = GetMicrosecondTick();
+
+  // Destroying a build that is still running cancels it instead of waiting for the full build.
+  {
+    VisibilitySetBuild build(world.GetMap(), kCacheFilename);
+  }
+
+  u64 cancel_time = GetMicrosecondTick() - start;
+
+  VisibilitySet expected;
+  start = GetMicrosecondTick();
+  expected.Build(world.GetMap());
+  u64 build_time = GetMicrosecondTick() - start;
+
+  EXPECT(cancel_time < build_time);
+
+  // A cancelled build never writes the cache.
+  FILE* f = fopen(kCacheFilename, "rb");
+  EXPECT(f == nullptr);
+  if (f) fclose(f);
+}
+
+}  // namespace test
+}  // namespace zero
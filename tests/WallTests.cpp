@@ -0,0 +1,130 @@
+#include <math.h>
+#include <zero/game/Map.h>
+#include <zero/game/WallSegments.h>
+#include <zero/zones/devastation/nodes/BounceShotQueryNode.h>
+
+#include <random>
+#include <vector>
+
+#include "Test.h"
+#include "TestWorld.h"
+
+namespace zero {
+namespace test {
+
+// Random walls and doors around the middle of the map.
+static void CreateWallWorld(TestWorld& world, std::mt19937& rng) {
+  std::uniform_int_distribution<int> coord(400, 623);
+  std::uniform_int_distribution<int> length(1, 12);
+  std::uniform_int_distribution<int> chance(0, 99);
+
+  std::vector<Tile> tiles;
+
+  for (int i = 0; i < 300; ++i) {
+    int x = coord(rng);
+    int y = coord(rng);
+    int count = length(rng);
+    bool vertical = chance(rng) < 50;
+    u8 id = chance(rng) < 10 ? (u8)kTileIdFirstDoor : 1;
+
+    for (int j = 0; j < count; ++j) {
+      tiles.push_back(MakeTile((u16)(vertical ? x : x + j), (u16)(vertical ? y + j : y), id));
+    }
+  }
+
+  world.LoadTiles(tiles);
+}
+
+// Rays that graze the exact corner of a tile can go either way depending on float error.
+static bool IsNearCorner(const Vector2f& position) {
+  constexpr float kTolerance = 1.0f / 256.0f;
+
+  return fabsf(position.x - roundf(position.x)) < kTolerance && fabsf(position.y - roundf(position.y)) < kTolerance;
+}
+
+ZERO_TEST(walls_cast_matches_map_cast) {
+  TestWorld world;
+  std::mt19937 rng(2468);
+
+  CreateWallWorld(world, rng);
+
+  Map& map = world.GetMap();
+  WallSegments segments;
+
+  segments.Build(map);
+  map.wall_segments = &segments;
+
+  std::uniform_real_distribution<float> coord(400.0f, 624.0f);
+  std::uniform_real_distribution<float> angle(0.0f, 2.0f * 3.14159265f);
+  std::uniform_real_distribution<float> distance(1.0f, 120.0f);
+
+  size_t cast_count = 0;
+  size_t hit_count = 0;
+  size_t mismatch_count = 0;
+
+  while (cast_count < 20000) {
+    Vector2f from(coord(rng), coord(rng));
+
+    if (map.IsSolid(from, 0)) continue;
+
+    float a = angle(rng);
+    Vector2f direction(cosf(a), sinf(a));
+    float max_distance = distance(rng);
+
+    CastResult expected = map.Cast(from, direction, max_distance, 0);
+    CastResult result = map.CastWalls(from, direction, max_distance, 0);
+
+    ++cast_count;
+
+    if (expected.hit) ++hit_count;
+    if (IsNearCorner(expected.position) || IsNearCorner(result.position)) continue;
+
+    bool match = expected.hit == result.hit && fabsf(expected.distance - result.distance) < 0.001f;
+
+    if (match && expected.hit) {
+      match = expected.normal.x == result.normal.x && expected.normal.y == result.normal.y;
+    }
+
+    if (!match) ++mismatch_count;
+  }
+
+  EXPECT(hit_count > cast_count / 4);
+  EXPECT(mismatch_count == 0);
+}
+
+ZERO_TEST(walls_bounce_off_corner) {
+  TestWorld world;
+
+  // A vertical wall at x = 510 that meets a horizontal wall at y = 510, forming an inside corner.
+  std::vector<Tile> tiles;
+
+  for (u16 i = 495; i <= 520; ++i) {
+    tiles.push_back(MakeTile(510, i, 1));
+    tiles.push_back(MakeTile(i, 510, 1));
+  }
+
+  world.LoadTiles(tiles);
+
+  Map& map = world.GetMap();
+  WallSegments segments;
+
+  segments.Build(map);
+  map.wall_segments = &segments;
+
+  deva::BounceShotQueryNode node(WeaponType::Bomb, "enemy");
+
+  // Fired straight into the corner, the game bounces it off of both walls, so it comes back toward the shooter.
+  Rectangle behind = Rectangle::FromPositionRadius(Vector2f(503, 503), 0.5f);
+
+  EXPECT(node.SimulateWeapon(map, deva::Particle(Vector2f(505, 505), Vector2f(10, 10), 0, 2.0f, 1), behind));
+
+  // Away from the corner only the wall that was hit is bounced off of.
+  Rectangle reflected = Rectangle::FromPositionRadius(Vector2f(500, 508.3f), 0.5f);
+  Rectangle mirrored = Rectangle::FromPositionRadius(Vector2f(500, 504.3f), 0.5f);
+
+  EXPECT(node.SimulateWeapon(map, deva::Particle(Vector2f(505, 505.3f), Vector2f(10, 2), 0, 2.0f, 1), reflected));
+  EXPECT(!node.SimulateWeapon(map, deva::Particle(Vector2f(505, 505.3f), Vector2f(10, 2), 0, 2.0f, 1), mirrored));
+}
+
+}  // namespace test
+}  // namespace zero
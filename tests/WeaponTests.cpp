@@ -0,0 +1,470 @@
+#include <math.h>
+#include <stdio.h>
+#include <zero/game/Clock.h>
+#include <zero/game/GameEvent.h>
+#include <zero/game/WeaponManager.h>
+
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "Test.h"
+#include "TestClock.h"
+#include "TestWorld.h"
+
+namespace zero {
+namespace test {
+
+struct WeaponEventCounter : EventHandler<WeaponHitEvent>, EventHandler<WeaponDestroyEvent> {
+  size_t hits = 0;
+  size_t destroys = 0;
+
+  void HandleEvent(const WeaponHitEvent& event) override { ++hits; }
+  void HandleEvent(const WeaponDestroyEvent& event) override { ++destroys; }
+};
+
+using WeaponState = std::tuple<u32, u32, s32, s32, u32, u32, u32, u32, u16>;
+
+// The weapons sorted by their state so two managers can be compared without depending on the order of the array.
+static std::vector<WeaponState> GetWeaponStates(WeaponManager& weapon_manager) {
+  std::vector<WeaponState> states;
+
+  for (size_t i = 0; i < weapon_manager.weapon_count; ++i) {
+    Weapon& weapon = weapon_manager.weapons[i];
+
+    states.emplace_back(weapon.x, weapon.y, weapon.velocity_x, weapon.velocity_y, weapon.last_tick, weapon.end_tick,
+                        weapon.bounces_remaining, (u32)weapon.data.type, weapon.frequency);
+  }
+
+  std::sort(states.begin(), states.end());
+  return states;
+}
+
+static void SetWeaponSettings(TestWorld& world) {
+  ArenaSettings& settings = world.game->connection.settings;
+
+  settings.BulletAliveTime = 550;
+  settings.BombAliveTime = 1200;
+  settings.ShrapnelSpeed = 2000;
+  settings.RepelDistance = 512;
+  settings.RepelSpeed = 5000;
+  settings.RepelTime = 225;
+  settings.ProximityDistance = 3;
+  settings.GravityBombs = 0;
+
+  for (size_t i = 0; i < 8; ++i) {
+    settings.ShipSettings[i].Radius = 14;
+  }
+}
+
+// Walls, wormholes, and the players are the same for every world that is created with the same seed.
+static void CreateWeaponWorld(TestWorld& world, u32 seed) {
+  std::mt19937 rng(seed);
+  std::vector<u8> grid(1024 * 1024, 0);
+
+  for (int i = 0; i < 1500; ++i) {
+    int x = rng() % 1000;
+    int y = rng() % 1000;
+    int width = 1 + rng() % 30;
+    int height = 1 + rng() % 3;
+
+    if (rng() & 1) std::swap(width, height);
+
+    for (int fill_y = y; fill_y < y + height; ++fill_y) {
+      for (int fill_x = x; fill_x < x + width; ++fill_x) {
+        grid[fill_y * 1024 + fill_x] = 1;
+      }
+    }
+  }
+
+  for (int i = 0; i < 30; ++i) {
+    grid[(rng() % 1024) * 1024 + rng() % 1024] = (u8)kTileIdWormhole;
+  }
+
+  std::vector<Tile> tiles;
+
+  for (u16 y = 0; y < 1024; ++y) {
+    for (u16 x = 0; x < 1024; ++x) {
+      if (grid[y * 1024 + x]) tiles.push_back(MakeTile(x, y, grid[y * 1024 + x]));
+    }
+  }
+
+  world.LoadTiles(tiles);
+  SetWeaponSettings(world);
+
+  std::uniform_real_distribution<float> position(40.0f, 980.0f);
+
+  for (u16 i = 0; i < 40; ++i) {
+    world.AddPlayer(i, (u8)(i % 8), i % 2, Vector2f(position(rng), position(rng)));
+  }
+}
+
+// Keeps every player synchronized so weapons can keep hitting them.
+static void RefreshPlayers(TestWorld& world) {
+  PlayerManager& player_manager = world.GetPlayerManager();
+
+  for (size_t i = 0; i < player_manager.player_count; ++i) {
+    Player& player = player_manager.players[i];
+
+    player.timestamp = GetCurrentTick() & 0x7FFF;
+    player_manager.UpdateHotPlayer(player);
+  }
+}
+
+// Adds a mix of bullets with some shrapnel bombs so explosions spawn new weapons during the update.
+static void AddRandomWeapons(TestWorld& world, std::mt19937& rng, size_t count, bool bombs) {
+  PlayerManager& player_manager = world.GetPlayerManager();
+  std::uniform_real_distribution<float> position(40.0f, 980.0f);
+
+  for (size_t i = 0; i < count; ++i) {
+    Player& owner = player_manager.players[rng() % player_manager.player_count];
+
+    WeaponType type = (rng() & 1) ? WeaponType::Bullet : WeaponType::BouncingBullet;
+    if (bombs && rng() % 20 == 0) type = WeaponType::Bomb;
+
+    Vector2f spawn = (i % 3 == 0) ? owner.position : Vector2f(position(rng), position(rng));
+    s32 velocity_x = (s32)(rng() % 8000) - 4000;
+    s32 velocity_y = (s32)(rng() % 8000) - 4000;
+
+    Weapon weapon = MakeWeapon(type, owner.id, owner.frequency, spawn, velocity_x, velocity_y, 100 + rng() % 500);
+
+    weapon.bounces_remaining = rng() % 3;
+    weapon.data.shrap = type == WeaponType::Bomb ? 4 : 0;
+    weapon.rng_seed = (u32)rng();
+
+    if (type != WeaponType::Bomb && rng() % 5 == 0) {
+      weapon.link_id = 100000 + (u32)(rng() % 200);
+    }
+
+    world.AddWeapon(weapon);
+  }
+}
+
+// Adds bullets that are fired at enemy players from a short distance away so most of them hit.
+static void AddAimedWeapons(TestWorld& world, std::mt19937& rng, size_t count) {
+  PlayerManager& player_manager = world.GetPlayerManager();
+  std::uniform_real_distribution<float> angle(0.0f, 6.28f);
+  std::uniform_real_distribution<float> distance(3.0f, 20.0f);
+
+  for (size_t i = 0; i < count; ++i) {
+    Player& owner = player_manager.players[rng() % player_manager.player_count];
+    Player& target = player_manager.players[rng() % player_manager.player_count];
+
+    if (owner.frequency == target.frequency) continue;
+
+    Vector2f direction(cosf(angle(rng)), sinf(angle(rng)));
+    Vector2f spawn = target.position + direction * distance(rng);
+    s32 velocity_x = (s32)(-direction.x * 3000);
+    s32 velocity_y = (s32)(-direction.y * 3000);
+
+    world.AddWeapon(MakeWeapon(WeaponType::Bullet, owner.id, owner.frequency, spawn, velocity_x, velocity_y, 200));
+  }
+}
+
+static void AddRandomRepels(TestWorld& world, std::mt19937& rng, size_t count) {
+  PlayerManager& player_manager = world.GetPlayerManager();
+  std::uniform_real_distribution<float> position(40.0f, 980.0f);
+
+  for (size_t i = 0; i < count; ++i) {
+    Player& owner = player_manager.players[rng() % player_manager.player_count];
+    Vector2f spawn(position(rng), position(rng));
+
+    world.AddWeapon(MakeWeapon(WeaponType::Repel, owner.id, owner.frequency, spawn, 0, 0, 100));
+  }
+}
+
+// Runs the same weapons through the fast paths and through the full simulation of every weapon and checks that they
+// end up in the same state with the same events.
+ZERO_TEST(weapons_fast_paths_match_scalar) {
+  TestWorld fast;
+  TestWorld scalar;
+
+  CreateWeaponWorld(fast, 11);
+  CreateWeaponWorld(scalar, 11);
+
+  scalar.GetWeaponManager().fast_paths_enabled = false;
+
+  std::mt19937 fast_rng(21);
+  std::mt19937 scalar_rng(21);
+
+  AddRandomWeapons(fast, fast_rng, 5000, true);
+  AddRandomWeapons(scalar, scalar_rng, 5000, true);
+
+  size_t mismatches = 0;
+  size_t event_mismatches = 0;
+  size_t total_hits = 0;
+  size_t total_lanes = 0;
+
+  for (int step = 0; step < 150; ++step) {
+    // Single tick updates go through the full simulation, so most updates cover enough ticks for the fast paths.
+    AdvanceTick(1 + 2 * (step % 3));
+
+    // New repels keep landing near weapons that are already in flight.
+    if (step % 10 == 0) {
+      AddRandomRepels(fast, fast_rng, 20);
+      AddRandomRepels(scalar, scalar_rng, 20);
+    }
+
+    if (step % 25 == 0) {
+      AddRandomWeapons(fast, fast_rng, 500, true);
+      AddRandomWeapons(scalar, scalar_rng, 500, true);
+    }
+
+    RefreshPlayers(fast);
+    RefreshPlayers(scalar);
+
+    // Events are dispatched to every registered handler, so each counter only exists during its own update.
+    size_t fast_hits = 0;
+    size_t fast_destroys = 0;
+    {
+      WeaponEventCounter events;
+      fast.GetWeaponManager().Update(0.01f);
+      fast_hits = events.hits;
+      fast_destroys = events.destroys;
+    }
+
+    size_t scalar_hits = 0;
+    size_t scalar_destroys = 0;
+    {
+      WeaponEventCounter events;
+      scalar.GetWeaponManager().Update(0.01f);
+      scalar_hits = events.hits;
+      scalar_destroys = events.destroys;
+    }
+
+    total_lanes += fast.GetWeaponManager().lanes.count;
+    total_hits += scalar_hits;
+
+    mismatches += GetWeaponStates(fast.GetWeaponManager()) != GetWeaponStates(scalar.GetWeaponManager());
+    event_mismatches += fast_hits != scalar_hits || fast_destroys != scalar_destroys;
+  }
+
+  EXPECT(mismatches == 0);
+  EXPECT(event_mismatches == 0);
+  EXPECT(total_hits > 0);
+  // The fast paths must actually be used for the comparison to mean anything.
+  EXPECT(total_lanes > 0);
+}
+
+// Weapons that were swapped into a removed weapon's slot must still be simulated on the same update.
+ZERO_TEST(weapons_removal_keeps_order) {
+  TestWorld world;
+
+  CreateWeaponWorld(world, 3);
+
+  std::mt19937 rng(4);
+  AddRandomWeapons(world, rng, 2000, true);
+
+  WeaponManager& weapon_manager = world.GetWeaponManager();
+
+  for (int step = 0; step < 50; ++step) {
+    AdvanceTick(3);
+    RefreshPlayers(world);
+
+    weapon_manager.Update(0.03f);
+
+    size_t stale = 0;
+    for (size_t i = 0; i < weapon_manager.weapon_count; ++i) {
+      stale += weapon_manager.weapons[i].last_tick != GetCurrentTick();
+    }
+
+    EXPECT(stale == 0);
+  }
+}
+
+// The ordered queries return the same weapons in the same order as scanning the weapon array, even after weapons have
+// moved between grid cells and been swapped around by removals.
+ZERO_TEST(weapons_ordered_queries_match_scan) {
+  TestWorld world;
+
+  CreateWeaponWorld(world, 5);
+
+  std::mt19937 rng(6);
+  AddRandomWeapons(world, rng, 3000, true);
+
+  WeaponManager& weapon_manager = world.GetWeaponManager();
+  std::uniform_real_distribution<float> position(0.0f, 1024.0f);
+  std::uniform_real_distribution<float> size(1.0f, 120.0f);
+  std::vector<Weapon*> weapons;
+  std::vector<Weapon*> expected;
+
+  size_t mismatches = 0;
+  size_t found = 0;
+
+  for (int step = 0; step < 20; ++step) {
+    AdvanceTick(1 + step % 4);
+    RefreshPlayers(world);
+    weapon_manager.Update(0.01f);
+
+    for (int i = 0; i < 200; ++i) {
+      Vector2f center(position(rng), position(rng));
+      float radius = size(rng);
+
+      Vector2f min = center - Vector2f(radius, radius * 0.5f);
+      Vector2f max = center + Vector2f(radius * 0.5f, radius);
+
+      expected.clear();
+      for (size_t j = 0; j < weapon_manager.weapon_count; ++j) {
+        if (BoxContainsPoint(min, max, weapon_manager.weapons[j].position)) {
+          expected.push_back(weapon_manager.weapons + j);
+        }
+      }
+
+      weapon_manager.GetWeaponsInRect(min, max, weapons);
+      mismatches += weapons != expected;
+      found += weapons.size();
+
+      expected.clear();
+      for (size_t j = 0; j < weapon_manager.weapon_count; ++j) {
+        if (weapon_manager.weapons[j].position.DistanceSq(center) <= radius * radius) {
+          expected.push_back(weapon_manager.weapons + j);
+        }
+      }
+
+      weapon_manager.GetWeaponsInRadius(center, radius, weapons);
+      mismatches += weapons != expected;
+      found += weapons.size();
+    }
+  }
+
+  EXPECT(found > 0);
+  EXPECT(mismatches == 0);
+}
+
+// Splitting the broadphase and lanes across any number of threads gives exactly the same weapons in the same order.
+ZERO_TEST(weapons_thread_count_deterministic) {
+  constexpr size_t kThreadCounts[] = {1, 2, 3, 8};
+
+  std::vector<std::vector<Weapon>> results[ZERO_ARRAY_SIZE(kThreadCounts)];
+  std::vector<size_t> pair_counts[ZERO_ARRAY_SIZE(kThreadCounts)];
+
+  u32 start_tick = GetCurrentTick();
+
+  for (size_t i = 0; i < ZERO_ARRAY_SIZE(kThreadCounts); ++i) {
+    SetCurrentTick(start_tick);
+
+    TestWorld world(kThreadCounts[i]);
+    CreateWeaponWorld(world, 13);
+
+    WeaponManager& weapon_manager = world.GetWeaponManager();
+    std::mt19937 rng(17);
+
+    AddRandomWeapons(world, rng, 6000, true);
+
+    for (int step = 0; step < 40; ++step) {
+      AdvanceTick(3 + step % 3);
+
+      if (step % 8 == 0) AddRandomRepels(world, rng, 10);
+      AddAimedWeapons(world, rng, 100);
+
+      RefreshPlayers(world);
+      weapon_manager.Update(0.03f);
+
+      results[i].emplace_back(weapon_manager.weapons, weapon_manager.weapons + weapon_manager.weapon_count);
+      pair_counts[i].push_back(weapon_manager.collision_pair_count);
+    }
+  }
+
+  size_t mismatches = 0;
+
+  for (size_t i = 1; i < ZERO_ARRAY_SIZE(kThreadCounts); ++i) {
+    EXPECT(pair_counts[i] == pair_counts[0]);
+
+    for (size_t step = 0; step < results[0].size(); ++step) {
+      const std::vector<Weapon>& expected = results[0][step];
+      const std::vector<Weapon>& actual = results[i][step];
+
+      if (expected.size() != actual.size()) {
+        ++mismatches;
+        continue;
+      }
+
+      for (size_t j = 0; j < expected.size(); ++j) {
+        mismatches += expected[j].x != actual[j].x || expected[j].y != actual[j].y ||
+                      expected[j].velocity_x != actual[j].velocity_x ||
+                      expected[j].velocity_y != actual[j].velocity_y || expected[j].last_tick != actual[j].last_tick ||
+                      expected[j].data.type != actual[j].data.type;
+      }
+    }
+  }
+
+  EXPECT(mismatches == 0);
+}
+
+static double MeasureWeaponUpdates(size_t thread_count, bool fast_paths, size_t weapon_count, int updates,
+                                   s32 ticks_per_update, size_t* lane_total) {
+  TestWorld world(thread_count);
+
+  CreateWeaponWorld(world, 31);
+
+  WeaponManager& weapon_manager = world.GetWeaponManager();
+  weapon_manager.fast_paths_enabled = fast_paths;
+
+  std::mt19937 rng(41);
+  u64 total = 0;
+
+  *lane_total = 0;
+
+  for (int i = 0; i < updates; ++i) {
+    AdvanceTick(ticks_per_update);
+    RefreshPlayers(world);
+
+    // Keep the weapon count steady as weapons time out and explode.
+    if (weapon_manager.weapon_count < weapon_count) {
+      AddRandomWeapons(world, rng, weapon_count - weapon_manager.weapon_count, false);
+    }
+
+    u64 start = GetMicrosecondTick();
+    weapon_manager.Update(0.01f);
+    total += GetMicrosecondTick() - start;
+
+    *lane_total += weapon_manager.lanes.count;
+  }
+
+  return (double)total / updates;
+}
+
+// 5000 bullets at 100 ticks per second. The bot usually updates once per tick, but a slow frame covers several ticks.
+ZERO_BENCHMARK(weapons_update_throughput) {
+  constexpr size_t kWeaponCount = 5000;
+  constexpr int kUpdates = 500;
+
+  printf("  %zu weapons, %d updates at 100 ticks/s on one thread\n", kWeaponCount, kUpdates);
+
+  for (s32 ticks_per_update : {1, 2, 4, 8}) {
+    size_t scalar_lanes = 0;
+    size_t fast_lanes = 0;
+
+    double scalar = MeasureWeaponUpdates(1, false, kWeaponCount, kUpdates, ticks_per_update, &scalar_lanes);
+    double fast = MeasureWeaponUpdates(1, true, kWeaponCount, kUpdates, ticks_per_update, &fast_lanes);
+
+    printf("  %d ticks/update: scalar %.1f us, fast %.1f us (%.2fx), %.0f weapons in lanes per update\n",
+           ticks_per_update, scalar, fast, scalar / fast, (double)fast_lanes / kUpdates);
+  }
+}
+
+// Update time with the broadphase and lanes split across more threads. Only those two parts run on the pool.
+ZERO_BENCHMARK(weapons_thread_scaling) {
+  constexpr size_t kWeaponCount = 12000;
+  constexpr int kUpdates = 300;
+  constexpr s32 kTicksPerUpdate = 4;
+
+  printf("  %zu weapons, %d ticks/update, %u hardware threads\n", kWeaponCount, kTicksPerUpdate,
+         std::thread::hardware_concurrency());
+
+  double single = 0.0;
+
+  for (size_t thread_count : {1, 2, 4, 8}) {
+    size_t lanes = 0;
+    double time = MeasureWeaponUpdates(thread_count, true, kWeaponCount, kUpdates, kTicksPerUpdate, &lanes);
+
+    if (thread_count == 1) single = time;
+
+    printf("  %zu threads: %.1f us/update (%.2fx)\n", thread_count, time, single / time);
+  }
+}
+
+}  // namespace test
+}  // namespace zero
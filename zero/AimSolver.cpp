@@ -0,0 +1,413 @@
+#include "AimSolver.h"
+
+#include <math.h>
+#include <xmmintrin.h>
+#include <zero/game/Game.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace zero {
+
+// Number of casts around the shooter when searching for walls to bounce off of.
+constexpr size_t kAimPlaneDirections = 16;
+// Walls further than this aren't considered for bounce shots.
+constexpr float kMaxAimPlaneDistance = 40.0f;
+// Stop it from projecting very far into the future.
+constexpr float kMaxAimTime = 5.0f;
+// Each bounce scales the hit probability since the bounce point is sensitive to small aiming errors.
+constexpr float kBounceReliability = 0.85f;
+// How far from the expected wall plane a cast can hit before the bounce is considered different.
+constexpr float kPlaneTolerance = 0.05f;
+
+AimWeapon GetAimWeapon(Game& game, const Player& player, WeaponType type) {
+  AimWeapon weapon;
+
+  weapon.type = type;
+
+  if (player.ship >= 8) return weapon;
+
+  ShipSettings& ship_settings = game.connection.settings.ShipSettings[player.ship];
+
+  switch (type) {
+    case WeaponType::Bomb:
+    case WeaponType::ProximityBomb: {
+      weapon.speed = ship_settings.BombSpeed / 16.0f / 10.0f;
+      weapon.bounces = ship_settings.BombBounceCount;
+    } break;
+    case WeaponType::Thor: {
+      weapon.speed = ship_settings.BombSpeed / 16.0f / 10.0f;
+    } break;
+    case WeaponType::Bullet: {
+      weapon.speed = ship_settings.BulletSpeed / 16.0f / 10.0f;
+    } break;
+    case WeaponType::BouncingBullet: {
+      weapon.speed = ship_settings.BulletSpeed / 16.0f / 10.0f;
+      weapon.bounces = 0xFFFF;
+    } break;
+    default: {
+    } break;
+  }
+
+  weapon.alive_time = game.weapon_manager.GetWeaponTotalAliveTime(type, false) / 100.0f;
+
+  return weapon;
+}
+
+inline Vector2f ReflectPoint(const Vector2f& point, u8 axis, float coord) {
+  Vector2f result = point;
+  result[axis] = 2.0f * coord - point[axis];
+  return result;
+}
+
+inline Vector2f ReflectVector(const Vector2f& v, u8 axis) {
+  Vector2f result = v;
+  result[axis] = -v[axis];
+  return result;
+}
+
+// Returns the fraction along the segment where it crosses the plane, or a negative value if it doesn't.
+inline float GetPlaneCrossing(const Vector2f& from, const Vector2f& to, u8 axis, float coord) {
+  float delta = to[axis] - from[axis];
+  if (delta == 0.0f) return -1.0f;
+
+  float fraction = (coord - from[axis]) / delta;
+  if (fraction <= 0.0f || fraction >= 1.0f) return -1.0f;
+
+  return fraction;
+}
+
+void AimSolver::UpdatePlanes(const Map& map, const Player& self, float max_distance) {
+  if (planes_valid && plane_position == self.position && plane_distance == max_distance &&
+      plane_frequency == self.frequency && plane_tile_epoch == map.tile_epoch) {
+    return;
+  }
+
+  planes_valid = true;
+  plane_position = self.position;
+  plane_distance = max_distance;
+  plane_frequency = self.frequency;
+  plane_tile_epoch = map.tile_epoch;
+
+  Plane found[kAimPlaneDirections];
+  float found_distance[kAimPlaneDirections];
+  size_t found_count = 0;
+
+  for (size_t i = 0; i < kAimPlaneDirections; ++i) {
+    float angle = (float)i * (2.0f * 3.14159265f / kAimPlaneDirections);
+    Vector2f direction(cosf(angle), sinf(angle));
+
+    CastResult cast = map.CastWalls(self.position, direction, max_distance, self.frequency);
+    if (!cast.hit || cast.distance <= 0.0f) continue;
+    if (cast.normal.x == 0.0f && cast.normal.y == 0.0f) continue;
+
+    Plane plane;
+    plane.axis = cast.normal.x != 0.0f ? 0 : 1;
+    // Walls are always on tile edges, so remove the error from the cast.
+    plane.coord = roundf(cast.position[plane.axis]);
+
+    bool duplicate = false;
+
+    for (size_t j = 0; j < found_count; ++j) {
+      if (found[j].axis == plane.axis && found[j].coord == plane.coord) {
+        duplicate = true;
+        break;
+      }
+    }
+
+    if (duplicate) continue;
+
+    // Keep the planes sorted by distance so the nearest are kept when there are too many.
+    float distance = fabsf(plane.coord - self.position[plane.axis]);
+    size_t insert = found_count++;
+
+    while (insert > 0 && found_distance[insert - 1] > distance) {
+      found[insert] = found[insert - 1];
+      found_distance[insert] = found_distance[insert - 1];
+      --insert;
+    }
+
+    found[insert] = plane;
+    found_distance[insert] = distance;
+  }
+
+  plane_count = std::min(found_count, kMaxAimPlanes);
+
+  for (size_t i = 0; i < plane_count; ++i) {
+    planes[i] = found[i];
+  }
+}
+
+bool AimSolver::Solve(Game& game, Player& self, Player** targets, size_t target_count, const AimWeapon* weapons,
+                      size_t weapon_count, u32 max_bounces, AimShot* result) {
+  if (self.ship >= 8) return false;
+
+  Map& map = game.GetMap();
+  ArenaSettings& settings = game.connection.settings;
+
+  if (target_count > kMaxAimTargets) target_count = kMaxAimTargets;
+  if (weapon_count > kMaxAimWeapons) weapon_count = kMaxAimWeapons;
+  if (max_bounces > kMaxAimBounces) max_bounces = kMaxAimBounces;
+
+  float search_distance = 0.0f;
+  bool bounces_allowed = false;
+  float self_speed = self.velocity.Length();
+
+  for (size_t i = 0; i < weapon_count; ++i) {
+    float alive_time = std::min(weapons[i].alive_time, kMaxAimTime);
+    float range = (weapons[i].speed + self_speed) * alive_time;
+
+    if (weapons[i].bounces > 0 && max_bounces > 0) {
+      bounces_allowed = true;
+      search_distance = std::max(search_distance, range);
+    }
+  }
+
+  if (search_distance > kMaxAimPlaneDistance) search_distance = kMaxAimPlaneDistance;
+
+  if (bounces_allowed && search_distance > 0.0f) {
+    UpdatePlanes(map, self, search_distance);
+  } else {
+    // The cache has to be rebuilt for the next bounce search since the planes are cleared here.
+    plane_count = 0;
+    planes_valid = false;
+  }
+
+  candidate_count = 0;
+
+  auto add_candidate = [&](size_t target, size_t weapon, const Vector2f& position, const Vector2f& velocity,
+                           float target_radius, float target_acceleration, u8 bounces, u8 first, u8 second) {
+    size_t i = candidate_count++;
+
+    pos_x[i] = position.x - self.position.x;
+    pos_y[i] = position.y - self.position.y;
+    vel_x[i] = velocity.x - self.velocity.x;
+    vel_y[i] = velocity.y - self.velocity.y;
+    speed[i] = weapons[weapon].speed;
+    max_time[i] = std::min(weapons[weapon].alive_time, kMaxAimTime);
+    dodge_scale[i] = 0.5f * target_acceleration;
+    radius[i] = target_radius;
+    reliability[i] = bounces == 0 ? 1.0f : kBounceReliability;
+    if (bounces > 1) reliability[i] *= kBounceReliability;
+
+    target_index[i] = (u8)target;
+    weapon_index[i] = (u8)weapon;
+    bounce_count[i] = bounces;
+    bounce_planes[i][0] = first;
+    bounce_planes[i][1] = second;
+  };
+
+  for (size_t t = 0; t < target_count; ++t) {
+    Player* target = targets[t];
+    if (!target || target->ship >= 8) continue;
+
+    float target_radius = settings.ShipSettings[target->ship].GetRadius();
+    float target_acceleration = settings.ShipSettings[target->ship].InitialThrust * (10.0f / 16.0f);
+
+    for (size_t w = 0; w < weapon_count; ++w) {
+      if (weapons[w].speed <= 0.0f) continue;
+
+      u32 allowed_bounces = std::min(weapons[w].bounces, max_bounces);
+
+      add_candidate(t, w, target->position, target->velocity, target_radius, target_acceleration, 0, 0, 0);
+
+      if (allowed_bounces < 1) continue;
+
+      for (u8 a = 0; a < plane_count; ++a) {
+        Vector2f position = ReflectPoint(target->position, planes[a].axis, planes[a].coord);
+        Vector2f velocity = ReflectVector(target->velocity, planes[a].axis);
+
+        add_candidate(t, w, position, velocity, target_radius, target_acceleration, 1, a, 0);
+      }
+
+      if (allowed_bounces < 2) continue;
+
+      // The shot hits plane a first, so the target is mirrored across the second plane and then the first.
+      for (u8 a = 0; a < plane_count; ++a) {
+        for (u8 b = 0; b < plane_count; ++b) {
+          if (a == b) continue;
+
+          Vector2f position = ReflectPoint(target->position, planes[b].axis, planes[b].coord);
+          position = ReflectPoint(position, planes[a].axis, planes[a].coord);
+
+          Vector2f velocity = ReflectVector(ReflectVector(target->velocity, planes[b].axis), planes[a].axis);
+
+          add_candidate(t, w, position, velocity, target_radius, target_acceleration, 2, a, b);
+        }
+      }
+    }
+  }
+
+  if (candidate_count == 0) return false;
+
+  // Solve |position + velocity * t| = speed * t for the smallest positive t, four candidates at a time.
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 two = _mm_set1_ps(2.0f);
+  const __m128 four = _mm_set1_ps(4.0f);
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128 invalid_time = _mm_set1_ps(-1.0f);
+  const __m128 max_float = _mm_set1_ps(std::numeric_limits<float>::max());
+
+  size_t i = 0;
+
+  for (; i + 4 <= candidate_count; i += 4) {
+    __m128 px = _mm_load_ps(pos_x + i);
+    __m128 py = _mm_load_ps(pos_y + i);
+    __m128 vx = _mm_load_ps(vel_x + i);
+    __m128 vy = _mm_load_ps(vel_y + i);
+    __m128 s = _mm_load_ps(speed + i);
+
+    __m128 a = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(s, s));
+    __m128 b = _mm_mul_ps(two, _mm_add_ps(_mm_mul_ps(vx, px), _mm_mul_ps(vy, py)));
+    __m128 c = _mm_add_ps(_mm_mul_ps(px, px), _mm_mul_ps(py, py));
+
+    __m128 disc = _mm_sub_ps(_mm_mul_ps(b, b), _mm_mul_ps(four, _mm_mul_ps(a, c)));
+    __m128 root = _mm_sqrt_ps(_mm_max_ps(disc, zero));
+    __m128 inv_a = _mm_div_ps(half, a);
+    __m128 neg_b = _mm_sub_ps(zero, b);
+
+    __m128 t1 = _mm_mul_ps(_mm_add_ps(neg_b, root), inv_a);
+    __m128 t2 = _mm_mul_ps(_mm_sub_ps(neg_b, root), inv_a);
+
+    // Negative and NaN roots are replaced with the max float so the min picks the smallest positive root.
+    __m128 t1_positive = _mm_cmpgt_ps(t1, zero);
+    __m128 t2_positive = _mm_cmpgt_ps(t2, zero);
+    t1 = _mm_or_ps(_mm_and_ps(t1_positive, t1), _mm_andnot_ps(t1_positive, max_float));
+    t2 = _mm_or_ps(_mm_and_ps(t2_positive, t2), _mm_andnot_ps(t2_positive, max_float));
+
+    __m128 t = _mm_min_ps(t1, t2);
+    __m128 valid = _mm_and_ps(_mm_cmpge_ps(disc, zero), _mm_cmple_ps(t, _mm_load_ps(max_time + i)));
+
+    // The target can move further from the predicted position the longer the weapon takes to reach it.
+    __m128 r = _mm_load_ps(radius + i);
+    __m128 dodge = _mm_mul_ps(_mm_load_ps(dodge_scale + i), _mm_mul_ps(t, t));
+    __m128 p = _mm_mul_ps(_mm_div_ps(r, _mm_add_ps(r, dodge)), _mm_load_ps(reliability + i));
+
+    _mm_store_ps(time + i, _mm_or_ps(_mm_and_ps(valid, t), _mm_andnot_ps(valid, invalid_time)));
+    _mm_store_ps(probability + i, _mm_and_ps(valid, p));
+  }
+
+  for (; i < candidate_count; ++i) {
+    float a = vel_x[i] * vel_x[i] + vel_y[i] * vel_y[i] - speed[i] * speed[i];
+    float b = 2.0f * (vel_x[i] * pos_x[i] + vel_y[i] * pos_y[i]);
+    float c = pos_x[i] * pos_x[i] + pos_y[i] * pos_y[i];
+    float disc = b * b - 4.0f * a * c;
+
+    time[i] = -1.0f;
+    probability[i] = 0.0f;
+
+    if (disc < 0.0f) continue;
+
+    float root = sqrtf(disc);
+    float t1 = (-b + root) * (0.5f / a);
+    float t2 = (-b - root) * (0.5f / a);
+    float t = std::numeric_limits<float>::max();
+
+    if (t1 > 0.0f) t = t1;
+    if (t2 > 0.0f && t2 < t) t = t2;
+
+    if (t > max_time[i]) continue;
+
+    float dodge = dodge_scale[i] * t * t;
+
+    time[i] = t;
+    probability[i] = radius[i] / (radius[i] + dodge) * reliability[i];
+  }
+
+  size_t order_count = 0;
+
+  for (size_t i = 0; i < candidate_count; ++i) {
+    if (time[i] < 0.0f) continue;
+
+    // Throw out bounce shots that don't cross their planes in order before doing any casts.
+    if (bounce_count[i] > 0) {
+      Vector2f velocity = Vector2f(vel_x[i], vel_y[i]) + self.velocity;
+      Vector2f end = self.position + Vector2f(pos_x[i], pos_y[i]) + velocity * time[i];
+      const Plane& first = planes[bounce_planes[i][0]];
+
+      float first_crossing = GetPlaneCrossing(self.position, end, first.axis, first.coord);
+      if (first_crossing < 0.0f) continue;
+
+      if (bounce_count[i] > 1) {
+        const Plane& second = planes[bounce_planes[i][1]];
+        // The second plane is mirrored across the first plane since the end position is mirrored across both.
+        float second_coord = second.axis == first.axis ? 2.0f * first.coord - second.coord : second.coord;
+        float second_crossing = GetPlaneCrossing(self.position, end, second.axis, second_coord);
+
+        if (second_crossing <= first_crossing) continue;
+      }
+    }
+
+    order[order_count++] = (u16)i;
+  }
+
+  std::sort(order, order + order_count, [this](u16 a, u16 b) {
+    if (probability[a] != probability[b]) return probability[a] > probability[b];
+    return time[a] < time[b];
+  });
+
+  size_t validation_count = std::min(order_count, max_validations);
+
+  for (size_t i = 0; i < validation_count; ++i) {
+    size_t index = order[i];
+
+    if (!ValidateCandidate(map, self, index)) continue;
+
+    Vector2f relative_end = Vector2f(pos_x[index], pos_y[index]) + Vector2f(vel_x[index], vel_y[index]) * time[index];
+    Vector2f intercept = relative_end + self.position + self.velocity * time[index];
+
+    // Unfold the intercept back into the world by mirroring in the opposite order.
+    for (size_t j = 0; j < bounce_count[index]; ++j) {
+      const Plane& plane = planes[bounce_planes[index][j]];
+      intercept = ReflectPoint(intercept, plane.axis, plane.coord);
+    }
+
+    result->target = targets[target_index[index]];
+    result->weapon_type = weapons[weapon_index[index]].type;
+    result->aim_position = self.position + relative_end;
+    result->intercept = intercept;
+    result->time = time[index];
+    result->bounces = bounce_count[index];
+    result->hit_probability = probability[index];
+
+    return true;
+  }
+
+  return false;
+}
+
+bool AimSolver::ValidateCandidate(const Map& map, const Player& self, size_t index) const {
+  float t = time[index];
+  Vector2f travel = Vector2f(pos_x[index], pos_y[index]) + (Vector2f(vel_x[index], vel_y[index]) + self.velocity) * t;
+
+  float remaining = travel.Length();
+  if (remaining <= 0.0f) return true;
+
+  Vector2f from = self.position;
+  Vector2f direction = travel * (1.0f / remaining);
+
+  // Walk the shot through the world, making sure each bounce happens on the expected wall.
+  for (size_t i = 0; i < bounce_count[index]; ++i) {
+    const Plane& plane = planes[bounce_planes[index][i]];
+
+    CastResult cast = map.CastWalls(from, direction, remaining, self.frequency);
+    if (!cast.hit) return false;
+
+    u8 axis = cast.normal.x != 0.0f ? 0 : 1;
+    if (cast.normal.x == 0.0f && cast.normal.y == 0.0f) return false;
+    if (axis != plane.axis || fabsf(cast.position[axis] - plane.coord) > kPlaneTolerance) return false;
+
+    remaining -= cast.distance;
+
+    // Move the next cast slightly away from the wall so it doesn't start inside of the solid tile.
+    from = cast.position;
+    from[axis] = plane.coord - (direction[axis] > 0.0f ? kPlaneTolerance : -kPlaneTolerance);
+    direction[axis] = -direction[axis];
+  }
+
+  if (remaining <= 0.0f) return true;
+
+  return !map.CastWalls(from, direction, remaining, self.frequency).hit;
+}
+
+}  // namespace zero
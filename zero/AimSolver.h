@@ -0,0 +1,106 @@
+#pragma once
+
+#include <zero/Math.h>
+#include <zero/Types.h>
+#include <zero/game/Clock.h>
+#include <zero/game/WeaponManager.h>
+
+namespace zero {
+
+struct Game;
+struct Map;
+struct Player;
+
+constexpr size_t kMaxAimTargets = 8;
+constexpr size_t kMaxAimWeapons = 4;
+constexpr size_t kMaxAimPlanes = 8;
+constexpr u32 kMaxAimBounces = 2;
+// Every target and weapon pair has a direct shot, a shot off each plane, and a shot off each ordered pair of planes.
+constexpr size_t kMaxAimShotsPerPair = 1 + kMaxAimPlanes + kMaxAimPlanes * (kMaxAimPlanes - 1);
+constexpr size_t kMaxAimCandidates = kMaxAimTargets * kMaxAimWeapons * kMaxAimShotsPerPair;
+
+struct AimWeapon {
+  WeaponType type = WeaponType::Bullet;
+  // Tiles per second relative to the shooter.
+  float speed = 0.0f;
+  // Seconds.
+  float alive_time = 0.0f;
+  // How many times the weapon can bounce off of walls before it's destroyed.
+  u32 bounces = 0;
+};
+
+struct AimShot {
+  Player* target = nullptr;
+  WeaponType weapon_type = WeaponType::Bullet;
+  // The position to face when firing. This is the same position that CalculateShot returns for direct shots.
+  Vector2f aim_position;
+  // The world position where the weapon hits the target.
+  Vector2f intercept;
+  // Seconds until the weapon hits the target.
+  float time = 0.0f;
+  u32 bounces = 0;
+  // Estimate from 0 to 1 of the target being unable to dodge the shot in time.
+  float hit_probability = 0.0f;
+};
+
+// Returns the speed, alive time, and bounces of the weapon when fired by the player.
+AimWeapon GetAimWeapon(Game& game, const Player& player, WeaponType type);
+
+// Solves every shot at several targets with several weapons at once, including shots that bounce off of the walls
+// around the shooter.
+// Bounce shots are solved by mirroring the target across the wall planes, so every candidate becomes a straight line
+// intercept. The intercepts are solved four at a time, then only the most likely candidates are validated against the
+// map with casts.
+struct AimSolver {
+  // Maximum number of candidates that are cast against the map before giving up.
+  size_t max_validations = 32;
+
+  // Returns false if no candidate shot can hit any of the targets.
+  bool Solve(Game& game, Player& self, Player** targets, size_t target_count, const AimWeapon* weapons,
+             size_t weapon_count, u32 max_bounces, AimShot* result);
+
+ private:
+  struct Plane {
+    // 0 for walls that face along the x axis, 1 for walls that face along the y axis.
+    u8 axis;
+    float coord;
+  };
+
+  // Finds the walls around the shooter that a shot could bounce off of. These are cached until the shooter moves or
+  // the tiles change.
+  void UpdatePlanes(const Map& map, const Player& self, float max_distance);
+  bool ValidateCandidate(const Map& map, const Player& self, size_t index) const;
+
+  Plane planes[kMaxAimPlanes];
+  size_t plane_count = 0;
+
+  bool planes_valid = false;
+  Vector2f plane_position;
+  float plane_distance = 0.0f;
+  u32 plane_frequency = 0;
+  u32 plane_tile_epoch = 0;
+
+  size_t candidate_count = 0;
+
+  // The candidate columns are aligned so they can be loaded four at a time.
+  alignas(16) float pos_x[kMaxAimCandidates];
+  alignas(16) float pos_y[kMaxAimCandidates];
+  alignas(16) float vel_x[kMaxAimCandidates];
+  alignas(16) float vel_y[kMaxAimCandidates];
+  alignas(16) float speed[kMaxAimCandidates];
+  alignas(16) float max_time[kMaxAimCandidates];
+  alignas(16) float dodge_scale[kMaxAimCandidates];
+  alignas(16) float radius[kMaxAimCandidates];
+  alignas(16) float reliability[kMaxAimCandidates];
+  alignas(16) float time[kMaxAimCandidates];
+  alignas(16) float probability[kMaxAimCandidates];
+
+  u8 target_index[kMaxAimCandidates];
+  u8 weapon_index[kMaxAimCandidates];
+  u8 bounce_count[kMaxAimCandidates];
+  u8 bounce_planes[kMaxAimCandidates][kMaxAimBounces];
+
+  u16 order[kMaxAimCandidates];
+};
+
+}  // namespace zero
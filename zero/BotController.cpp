@@ -1,7 +1,9 @@
 #include "BotController.h"
 
+#include <stdio.h>
 #include <zero/Utility.h>
 #include <zero/behavior/BehaviorBuilder.h>
+#include <zero/behavior/BehaviorProfiler.h>
 #include <zero/behavior/BehaviorTree.h>
 #include <zero/game/Logger.h>
 
@@ -45,6 +47,9 @@ void BotController::HandleEvent(const PlayerEnterEvent& event) {
 void BotController::HandleEvent(const MapLoadEvent& event) {
   // Send a request for the arena list so we can know the name of the current arena.
   game.chat.SendMessage(ChatType::Public, "?arena");
+
+  UpdateVisibilitySet(event.map);
+  UpdateWallSegments(event.map);
 }
 
 void BotController::HandleEvent(const PlayerFreqAndShipChangeEvent& event) {
@@ -68,6 +73,17 @@ void BotController::HandleEvent(const PlayerAttachEvent& event) {
   }
 }
 
+TargetTable& BotController::GetTargetTable() {
+  if (!region_registry) {
+    target_table.count = 0;
+    return target_table;
+  }
+
+  target_table.Update(game, *region_registry, region_epoch, energy_tracker);
+
+  return target_table;
+}
+
 void BotController::UpdatePathfinder(float radius) {
   if (pathfinder && pathfinder->config.ship_radius == radius) {
     pathfinder->SetDoorSolidMethod(door_solid_method);
@@ -80,6 +96,7 @@ void BotController::UpdatePathfinder(float radius) {
 
   region_registry = std::make_unique<RegionRegistry>();
   region_registry->CreateAll(game.GetMap(), radius);
+  ++region_epoch;
 
   pathfinder = std::make_unique<path::Pathfinder>(std::move(processor), region_registry.get());
 
@@ -93,6 +110,51 @@ void BotController::UpdatePathfinder(float radius) {
   pathfinder->SetDoorSolidMethod(door_solid_method);
 }
 
+void BotController::UpdateVisibilitySet(Map& map) {
+  if (!visibility_set || visibility_set->checksum != map.checksum) {
+    char cache_filename[1040];
+    sprintf(cache_filename, "%s.vis", map.filename);
+
+    // Any build that is still running is for the previous map.
+    visibility_build = nullptr;
+    visibility_set = std::make_unique<VisibilitySet>();
+
+    // The visibility set is cached next to the map file since it only changes when the map does.
+    if (!visibility_set->Load(cache_filename, map.checksum)) {
+      Log(LogLevel::Info, "Building visibility set for %s.", map.filename);
+
+      visibility_set = nullptr;
+      visibility_build = std::make_unique<VisibilitySetBuild>(map, cache_filename);
+    }
+  }
+
+  map.visibility = visibility_set.get();
+}
+
+void BotController::PollVisibilitySet(Map& map) {
+  if (!visibility_build || !visibility_build->IsFinished()) return;
+
+  std::unique_ptr<VisibilitySet> set = visibility_build->TakeResult();
+  visibility_build = nullptr;
+
+  if (set && set->checksum == map.checksum) {
+    Log(LogLevel::Info, "Finished building visibility set for %s.", map.filename);
+
+    visibility_set = std::move(set);
+    map.visibility = visibility_set.get();
+  }
+}
+
+void BotController::UpdateWallSegments(Map& map) {
+  // The segments only take a moment to build, so they aren't cached to disk like the visibility set.
+  if (!wall_segments || wall_segments->checksum != map.checksum) {
+    wall_segments = std::make_unique<WallSegments>();
+    wall_segments->Build(map);
+  }
+
+  map.wall_segments = wall_segments.get();
+}
+
 void BotController::RebuildRegionRegistry() {
   Player* self = game.player_manager.GetSelf();
   float radius = 14.0f / 16.0f;
@@ -105,6 +167,7 @@ void BotController::RebuildRegionRegistry() {
 
   region_registry = std::make_unique<RegionRegistry>();
   region_registry->CreateAll(game.GetMap(), radius);
+  ++region_epoch;
   pathfinder->regions_ = region_registry.get();
 }
 
@@ -162,6 +225,8 @@ void BotController::Update(RenderContext& rc, float dt, InputState& input, behav
 
   steering.Reset();
 
+  PollVisibilitySet(game.GetMap());
+
   execute_ctx.blackboard.Set("world_camera", game.camera);
   execute_ctx.blackboard.Set("ui_camera", game.ui_camera);
 
@@ -169,11 +234,44 @@ void BotController::Update(RenderContext& rc, float dt, InputState& input, behav
   energy_tracker.Update();
 
   static behavior::TreePrinter tree_printer;
+  static behavior::BehaviorProfiler profiler;
+
+  bool should_print = g_Settings.debug_behavior_tree;
+  bool should_profile = g_Settings.debug_behavior_profile;
+
+  if (!behavior_tree || !pathfinder) {
+    tree_dt = 0.0f;
+  } else if (!scheduler.BeginFrame(GetCurrentTick())) {
+    // The game only simulates once per tick, so keep applying the last decisions until the tree executes again.
+    steering.force += tree_steering.force;
+    steering.rotation += tree_steering.rotation;
+    if (steering.rotation_threshold == Steering().rotation_threshold) {
+      steering.rotation_threshold = tree_steering.rotation_threshold;
+    }
+    input.actions |= tree_actions;
+    tree_dt += dt;
+
+    tree_render.Render(rc, game.line_renderer);
+
+    if (should_profile) {
+      profiler.Render(rc);
+    }
 
-  if (behavior_tree && pathfinder) {
-    bool should_print = g_Settings.debug_behavior_tree;
+    if (should_print) {
+      tree_printer.Render(rc);
+    }
+  } else {
+    execute_ctx.dt = tree_dt + dt;
+    execute_ctx.scheduler = &scheduler;
+    tree_dt = 0.0f;
+
+    // Draws are kept until the next execution so they're rendered on the frames in between.
+    tree_render.Reset();
 
     if (should_print) {
+      // The output is kept until the next execution so it's rendered on the frames in between.
+      tree_printer.Reset();
+
       // Set to true to render { and } for each composite node.
       tree_printer.render_brackets = false;
       // Set this to false to disable rendering of the text, then enable it in your behavior tree with
@@ -183,13 +281,37 @@ void BotController::Update(RenderContext& rc, float dt, InputState& input, behav
       behavior::gDebugTreePrinter = &tree_printer;
     }
 
+    if (should_profile) {
+      behavior::gBehaviorProfiler = &profiler;
+
+      profiler.BeginFrame(behavior_tree.get());
+      profiler.Begin(behavior_tree.get());
+    }
+
+    Steering handler_steering = steering;
+
     behavior_tree->Execute(execute_ctx);
 
+    tree_steering.force = steering.force - handler_steering.force;
+    tree_steering.rotation = steering.rotation - handler_steering.rotation;
+    tree_steering.rotation_threshold = steering.rotation_threshold;
+    tree_actions = input.actions & InputState::kMovementMask;
+
+    tree_render.Render(rc, game.line_renderer);
+
+    if (should_profile) {
+      profiler.End();
+      profiler.EndFrame();
+
+      behavior::gBehaviorProfiler = nullptr;
+
+      profiler.Render(rc);
+    }
+
     if (should_print) {
       behavior::gDebugTreePrinter = nullptr;
 
       tree_printer.Render(rc);
-      tree_printer.Reset();
     }
   }
 
@@ -1,14 +1,19 @@
 #pragma once
 
 #include <zero/Actuator.h>
+#include <zero/AimSolver.h>
 #include <zero/ChatQueue.h>
 #include <zero/HeuristicEnergyTracker.h>
 #include <zero/InfluenceMap.h>
 #include <zero/RenderContext.h>
 #include <zero/Steering.h>
+#include <zero/TargetTable.h>
 #include <zero/behavior/Behavior.h>
+#include <zero/behavior/TreeRenderOutput.h>
 #include <zero/game/Game.h>
 #include <zero/game/GameEvent.h>
+#include <zero/game/VisibilitySet.h>
+#include <zero/game/WallSegments.h>
 #include <zero/path/Pathfinder.h>
 
 #include <memory>
@@ -52,10 +57,25 @@ struct BotController : EventHandler<PlayerFreqAndShipChangeEvent>,
 
   std::unique_ptr<path::Pathfinder> pathfinder;
   std::unique_ptr<RegionRegistry> region_registry;
+  // Incremented whenever region_registry is rebuilt.
+  u32 region_epoch = 0;
+  std::unique_ptr<VisibilitySet> visibility_set;
+  // Builds the visibility set when the map didn't have a cached one. Line of sight is cast until it finishes.
+  std::unique_ptr<VisibilitySetBuild> visibility_build;
+  std::unique_ptr<WallSegments> wall_segments;
   std::string behavior_name;
   InputState* input;
   InputState last_input = {};
 
+  behavior::BehaviorScheduler scheduler;
+  // What the tree added to the steering and held actions the last time it executed. These are replayed on top of the
+  // update handlers on the frames where it doesn't execute. Presses such as firing are only made on the executing frame.
+  Steering tree_steering;
+  u32 tree_actions = 0;
+  behavior::TreeRenderOutput tree_render;
+  // Time since the tree last executed.
+  float tree_dt = 0.0f;
+
   ChatQueue chat_queue;
   behavior::BehaviorRepository behaviors;
   Steering steering;
@@ -67,6 +87,8 @@ struct BotController : EventHandler<PlayerFreqAndShipChangeEvent>,
 
   HeuristicEnergyTracker energy_tracker;
   InfluenceMap influence_map;
+  TargetTable target_table;
+  AimSolver aim_solver;
 
   std::string default_arena;
   std::unique_ptr<LockedShipState> locked_ships;
@@ -75,8 +97,15 @@ struct BotController : EventHandler<PlayerFreqAndShipChangeEvent>,
 
   void Update(RenderContext& rc, float dt, InputState& input, behavior::ExecuteContext& execute_ctx);
 
+  // Returns the target table after rebuilding it if it's out of date.
+  TargetTable& GetTargetTable();
+
   void UpdatePathfinder(float radius);
   void RebuildRegionRegistry();
+  void UpdateVisibilitySet(Map& map);
+  // Starts using the visibility set once its background build finishes.
+  void PollVisibilitySet(Map& map);
+  void UpdateWallSegments(Map& map);
 
   void HandleEvent(const JoinGameEvent& event) override;
   void HandleEvent(const PlayerEnterEvent& event) override;
@@ -100,7 +129,7 @@ struct BotController : EventHandler<PlayerFreqAndShipChangeEvent>,
     std::string previous = behavior_name;
 
     behavior_name = name;
-    behavior_tree = std::move(tree);
+    behavior_tree = behavior::CompileTree(std::move(tree));
 
     Event::Dispatch(BehaviorChangeEvent(previous, name));
   }
@@ -106,7 +106,9 @@ struct Steering {
     Player* self = game.player_manager.GetSelf();
     float max_speed = GetMaxSpeed(game);
     Vector2f to_target = target_position - self->position;
-    float t = to_target.Length() / (max_speed + target.velocity.Length());
+    float closing_speed = max_speed + target.velocity.Length();
+    // Neither player can move when the speeds are zero, so the target is expected to stay where it is.
+    float t = closing_speed > 0.0f ? to_target.Length() / closing_speed : 0.0f;
 
     if (to_target.LengthSq() <= target_distance * target_distance) {
       return Seek(game, target_position - (Normalize(to_target) * target_distance));
@@ -118,7 +120,10 @@ struct Steering {
       return Seek(game, target_position);
     }
 
-    return Seek(game, target_position + target.velocity * t);
+    // The prediction bounces the target off of walls, so only its offset from the target is used.
+    Vector2f offset = game.player_manager.PredictPosition(target, t) - target.position;
+
+    return Seek(game, target_position + offset);
   }
 
   void AvoidWalls(Game& game) {
@@ -190,23 +195,27 @@ struct Steering {
     Vector2f avoid_force;
     float count = 0.0f;
 
+    const PlayerHotView& hot = pm.hot;
+    u32 current_tick = GetCurrentTick();
+
     for (size_t i = 0; i < pm.player_count; ++i) {
-      Player* player = pm.players + i;
+      if (hot.frequency[i] != self->frequency) continue;
+      if (hot.ship[i] >= 8) continue;
+      if (hot.id[i] == self->id) continue;
+      if (hot.IsRespawning(i)) continue;
+
+      Vector2f position = hot.GetPosition(i);
 
-      if (player->frequency != self->frequency) continue;
-      if (player->ship >= 8) continue;
-      if (player->id == self->id) continue;
-      if (player->IsRespawning()) continue;
-      if (player->position == Vector2f(0, 0)) continue;
-      if (!game.player_manager.IsSynchronized(*player)) continue;
+      if (position == Vector2f(0, 0)) continue;
+      if (!pm.IsSynchronized(i, current_tick)) continue;
 
-      float dist_sq = player->position.DistanceSq(self->position);
+      float dist_sq = position.DistanceSq(self->position);
       if (dist_sq > dist * dist) continue;
 
       float team_dist = sqrtf(dist_sq);
       float diff = dist - team_dist;
 
-      avoid_force += Normalize(self->position - player->position) * (diff * diff);
+      avoid_force += Normalize(self->position - position) * (diff * diff);
       ++count;
     }
 
@@ -226,22 +235,26 @@ struct Steering {
     Vector2f avoid_force;
     float count = 0.0f;
 
+    const PlayerHotView& hot = pm.hot;
+    u32 current_tick = GetCurrentTick();
+
     for (size_t i = 0; i < pm.player_count; ++i) {
-      Player* player = pm.players + i;
+      if (hot.frequency[i] == self->frequency) continue;
+      if (hot.id[i] == self->id) continue;
+      if (hot.IsRespawning(i)) continue;
+
+      Vector2f position = hot.GetPosition(i);
 
-      if (player->frequency == self->frequency) continue;
-      if (player->id == self->id) continue;
-      if (player->IsRespawning()) continue;
-      if (player->position == Vector2f(0, 0)) continue;
-      if (!game.player_manager.IsSynchronized(*player)) continue;
+      if (position == Vector2f(0, 0)) continue;
+      if (!pm.IsSynchronized(i, current_tick)) continue;
 
-      float dist_sq = player->position.DistanceSq(self->position);
+      float dist_sq = position.DistanceSq(self->position);
       if (dist_sq > dist * dist) continue;
 
       float team_dist = sqrtf(dist_sq);
       float diff = dist - team_dist;
 
-      avoid_force += Normalize(self->position - player->position) * (diff * diff);
+      avoid_force += Normalize(self->position - position) * (diff * diff);
       ++count;
     }
 
@@ -0,0 +1,181 @@
+#include "TargetTable.h"
+
+#include <math.h>
+#include <zero/HeuristicEnergyTracker.h>
+#include <zero/RegionRegistry.h>
+#include <zero/game/Game.h>
+
+#include <limits>
+
+namespace zero {
+
+// Distance in tiles where an enemy aimed directly at self has half of the maximum threat.
+constexpr float kThreatFalloffDistance = 30.0f;
+
+bool IsPlayerVisible(ArenaSettings& settings, const Player& self, const Player& target) {
+  constexpr Vector2f kViewDim(1920.0f, 1080.0f);
+
+  // XRadar can see no matter what.
+  if (self.togglables & Status_XRadar) return true;
+
+  // We can always see them if they don't have stealth on.
+  if (!(target.togglables & Status_Stealth)) return true;
+
+  const Vector2f half_view_dim = kViewDim * 0.5f;
+
+  Rectangle view_rect(self.position - half_view_dim, self.position + half_view_dim);
+  Rectangle target_rect =
+      Rectangle::FromPositionRadius(target.position, settings.ShipSettings[target.ship].GetRadius());
+
+  // Target has stealth on and is off screen. We cannot see them.
+  if (!BoxBoxIntersect(view_rect.min, view_rect.max, target_rect.min, target_rect.max)) {
+    return false;
+  }
+
+  // We can see them if they don't have cloak on since they are on our screen.
+  return !(target.togglables & Status_Cloak);
+}
+
+void TargetTable::Update(Game& game, const RegionRegistry& region_registry, u32 region_epoch,
+                         HeuristicEnergyTracker& energy_tracker) {
+  PlayerManager& player_manager = game.player_manager;
+  Player* self = player_manager.GetSelf();
+
+  if (!self) {
+    valid = false;
+    count = 0;
+    return;
+  }
+
+  Tick current_tick = GetCurrentTick();
+
+  if (valid && tick == current_tick && position_epoch == player_manager.position_epoch &&
+      this->region_epoch == region_epoch && self_id == self->id) {
+    return;
+  }
+
+  valid = true;
+  tick = current_tick;
+  position_epoch = player_manager.position_epoch;
+  this->region_epoch = region_epoch;
+  self_id = self->id;
+
+  Build(game, *self, region_registry, energy_tracker);
+}
+
+// Player headings are one of 40 rotations, so they are looked up instead of calling trig functions for every candidate.
+static const Vector2f* GetHeadingTable() {
+  static Vector2f headings[40];
+  static bool initialized = false;
+
+  if (!initialized) {
+    for (u8 i = 0; i < 40; ++i) {
+      headings[i] = OrientationToHeading(i);
+    }
+
+    initialized = true;
+  }
+
+  return headings;
+}
+
+void TargetTable::Build(Game& game, Player& self, const RegionRegistry& region_registry,
+                        HeuristicEnergyTracker& energy_tracker) {
+  PlayerManager& player_manager = game.player_manager;
+  const PlayerHotView& hot = player_manager.hot;
+
+  u16 hot_indices[kMaxTargetCandidates];
+
+  count = 0;
+
+  // Gather the enemies from the hot view so the rejected players never touch the full player data.
+  for (size_t i = 0; i < player_manager.player_count; ++i) {
+    if (hot.ship[i] >= 8) continue;
+    if (hot.frequency[i] == self.frequency) continue;
+    if (hot.IsRespawning(i)) continue;
+    if (hot.x[i] == 0.0f && hot.y[i] == 0.0f) continue;
+
+    hot_indices[count] = (u16)i;
+    players[count] = player_manager.players + i;
+    x[count] = hot.x[i];
+    y[count] = hot.y[i];
+    ++count;
+  }
+
+  const float self_x = self.position.x;
+  const float self_y = self.position.y;
+
+  for (size_t i = 0; i < count; ++i) {
+    float dx = x[i] - self_x;
+    float dy = y[i] - self_y;
+
+    distance_sq[i] = dx * dx + dy * dy;
+    distance[i] = sqrtf(distance_sq[i]);
+  }
+
+  RegionIndex self_region = region_registry.GetRegionIndex(self.position);
+  Map& map = game.connection.map;
+  ArenaSettings& settings = game.connection.settings;
+  const Vector2f* headings = GetHeadingTable();
+  bool self_xradar = self.togglables & Status_XRadar;
+  u32 sync_tick = GetCurrentTick();
+
+  for (size_t i = 0; i < count; ++i) {
+    size_t hot_index = hot_indices[i];
+    Vector2f position(x[i], y[i]);
+    TargetFlags player_flags = 0;
+
+    if (self_region != kUndefinedRegion && region_registry.GetRegionIndex(position) == self_region) {
+      player_flags |= TargetFlag_Connected;
+    }
+
+    bool synchronized = player_manager.IsSynchronized(hot_index, sync_tick);
+
+    if (synchronized) player_flags |= TargetFlag_Synchronized;
+
+    // If the player is within our view, but we haven't received any packets, then they left where we last saw them.
+    if (synchronized || !game.radar.InRadarView(position)) player_flags |= TargetFlag_Remembered;
+
+    if (map.GetTileId(position) == kTileIdSafe) player_flags |= TargetFlag_Safe;
+
+    // Only stealthed players need the full view check.
+    if (self_xradar || !(hot.togglables[hot_index] & Status_Stealth) || IsPlayerVisible(settings, self, *players[i])) {
+      player_flags |= TargetFlag_Visible;
+    }
+
+    flags[i] = player_flags;
+    energy[i] = energy_tracker.GetEnergy(*players[i]);
+
+    float facing = 1.0f;
+
+    if (distance[i] > 0.0f) {
+      Vector2f to_self = Vector2f(self_x - x[i], self_y - y[i]) * (1.0f / distance[i]);
+      u8 rotation = (u8)(players[i]->orientation * 40.0f) % 40;
+
+      facing = headings[rotation].Dot(to_self);
+    }
+
+    threat[i] = (facing > 0.0f ? facing : 0.0f) * kThreatFalloffDistance / (kThreatFalloffDistance + distance[i]);
+  }
+}
+
+Player* TargetTable::Select(TargetFlags required, TargetFlags excluded, const TargetScoreWeights& weights) const {
+  Player* best = nullptr;
+  float best_score = std::numeric_limits<float>::max();
+
+  for (size_t i = 0; i < count; ++i) {
+    if ((flags[i] & required) != required) continue;
+    if (flags[i] & excluded) continue;
+
+    float score = distance[i] * weights.distance + energy[i] * weights.energy + threat[i] * weights.threat;
+
+    if (score < best_score) {
+      best_score = score;
+      best = players[i];
+    }
+  }
+
+  return best;
+}
+
+}  // namespace zero
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <zero/Math.h>
+#include <zero/Types.h>
+#include <zero/game/Clock.h>
+
+namespace zero {
+
+struct ArenaSettings;
+struct Game;
+struct HeuristicEnergyTracker;
+struct Player;
+class RegionRegistry;
+
+enum {
+  // The bot can path to the player.
+  TargetFlag_Connected = (1 << 0),
+  // Packets for the player have been received recently.
+  TargetFlag_Synchronized = (1 << 1),
+  // The player is synchronized or is outside of radar view, so the bot can go back to where it last saw them.
+  TargetFlag_Remembered = (1 << 2),
+  // The player is on a safe tile.
+  TargetFlag_Safe = (1 << 3),
+  // The player isn't hidden by stealth or cloak.
+  TargetFlag_Visible = (1 << 4),
+};
+using TargetFlags = u8;
+
+// Each value of a candidate is multiplied by its weight and summed, and the candidate with the lowest score is chosen.
+// Negative weights prefer larger values.
+struct TargetScoreWeights {
+  float distance = 1.0f;
+  float energy = 0.0f;
+  float threat = 0.0f;
+
+  TargetScoreWeights() {}
+  TargetScoreWeights(float distance, float energy, float threat) : distance(distance), energy(energy), threat(threat) {}
+};
+
+constexpr size_t kMaxTargetCandidates = 1024;
+
+// Returns false if the target is hidden from self by stealth or cloak.
+bool IsPlayerVisible(ArenaSettings& settings, const Player& self, const Player& target);
+
+// Every enemy that can be targeted along with the values that target selection uses. This is built once per tick for
+// all of the target nodes instead of each node checking connectivity, visibility, and energy for every player.
+// The columns are separate arrays so the distance and score passes run over contiguous floats.
+struct TargetTable {
+  size_t count = 0;
+
+  Player* players[kMaxTargetCandidates];
+  TargetFlags flags[kMaxTargetCandidates];
+  float x[kMaxTargetCandidates];
+  float y[kMaxTargetCandidates];
+  float distance_sq[kMaxTargetCandidates];
+  float distance[kMaxTargetCandidates];
+  // Estimated with the energy tracker.
+  float energy[kMaxTargetCandidates];
+  // How directly the player is aimed at self scaled down by distance, from 0 to 1.
+  float threat[kMaxTargetCandidates];
+
+  // Rebuilds the table if the tick, the players, or the regions have changed since it was last built.
+  void Update(Game& game, const RegionRegistry& region_registry, u32 region_epoch,
+              HeuristicEnergyTracker& energy_tracker);
+
+  // Returns the candidate with all of the required flags and none of the excluded flags that has the lowest score.
+  Player* Select(TargetFlags required, TargetFlags excluded, const TargetScoreWeights& weights) const;
+
+ private:
+  void Build(Game& game, Player& self, const RegionRegistry& region_registry, HeuristicEnergyTracker& energy_tracker);
+
+  bool valid = false;
+  Tick tick = 0;
+  u32 position_epoch = 0;
+  u32 region_epoch = 0;
+  u16 self_id = 0;
+};
+
+}  // namespace zero
@@ -5,9 +5,11 @@
 #include <zero/game/Game.h>
 #include <zero/game/Logger.h>
 #include <zero/game/Settings.h>
+#include <zero/game/ThreadPool.h>
 #include <zero/game/WorkQueue.h>
 
 #include <chrono>
+#include <thread>
 
 #if 1
 #define SURFACE_WIDTH 1152
@@ -67,6 +69,8 @@ bool ZeroBot::Initialize(std::unique_ptr<ArgParser> args, const char* name, cons
   worker = new Worker(*work_queue);
   worker->Launch();
 
+  thread_pool = new ThreadPool(std::thread::hardware_concurrency());
+
   perm_global = &perm_arena;
 
   strcpy(this->name, name);
@@ -84,8 +88,8 @@ bool ZeroBot::JoinZone(ServerInfo& server) {
   kPlayerName = name;
   kPlayerPassword = password;
 
-  game = memory_arena_construct_type(&perm_arena, Game, perm_arena, trans_arena, *work_queue, SURFACE_WIDTH,
-                                     SURFACE_HEIGHT);
+  game = memory_arena_construct_type(&perm_arena, Game, perm_arena, trans_arena, *work_queue, *thread_pool,
+                                     SURFACE_WIDTH, SURFACE_HEIGHT);
   bot_controller = memory_arena_construct_type(&perm_arena, BotController, *game);
 
   commands = memory_arena_construct_type(&perm_arena, CommandSystem, *this, this->game->dispatcher);
@@ -155,6 +159,21 @@ void ZeroBot::Run() {
   auto opt_sleep_ms = this->config->GetInt("General", "SleepMs");
   if (opt_sleep_ms) sleep_ms = *opt_sleep_ms;
 
+  if (bot_controller) {
+    behavior::BehaviorScheduler& scheduler = bot_controller->scheduler;
+
+    auto opt_tree_interval = this->config->GetInt("General", "BehaviorTickInterval");
+    if (opt_tree_interval && *opt_tree_interval > 0) scheduler.tree_interval_ticks = *opt_tree_interval;
+
+    auto opt_strategic_interval = this->config->GetInt("General", "StrategicTickInterval");
+    if (opt_strategic_interval && *opt_strategic_interval > 0) {
+      scheduler.strategic_interval_ticks = *opt_strategic_interval;
+    }
+
+    auto opt_slice_budget = this->config->GetInt("General", "BehaviorSliceBudgetUs");
+    if (opt_slice_budget && *opt_slice_budget >= 0) scheduler.slice_budget_us = *opt_slice_budget;
+  }
+
   while (true) {
     auto start = std::chrono::high_resolution_clock::now();
 
@@ -170,17 +189,25 @@ void ZeroBot::Run() {
       break;
     }
 
-    if (bot_controller && bot_controller->actuator.enabled) {
-      input.Clear();
-    } else {
-      input.ClearWeapons();
+    if (game->render_enabled && !debug_renderer.Begin()) {
+      game->Cleanup();
+      break;
     }
 
-    if (game->render_enabled && !debug_renderer.Begin()) {
+    // Applies the input from the last frame.
+    if (!game->Update(input, dt)) {
       game->Cleanup();
       break;
     }
 
+    if (bot_controller && bot_controller->actuator.enabled) {
+      input.Clear();
+    } else {
+      input.ClearWeapons();
+    }
+
+    // The controller runs after the game update so the tree decides from the tick that was just simulated instead of
+    // the one before it. Its input is applied at the start of the next frame.
     if (bot_controller && game->connection.login_state == Connection::LoginState::Complete) {
       execute_ctx.bot = this;
       execute_ctx.dt = dt;
@@ -190,11 +217,6 @@ void ZeroBot::Run() {
       bot_controller->Update(rc, dt, input, execute_ctx);
     }
 
-    if (!game->Update(input, dt)) {
-      game->Cleanup();
-      break;
-    }
-
     game->Render(dt);
 
     if (game->render_enabled) {
@@ -208,7 +230,6 @@ void ZeroBot::Run() {
     auto end = std::chrono::high_resolution_clock::now();
     frame_time = std::chrono::duration_cast<ms_float>(end - start).count();
 
-    game->player_manager.kdtree = nullptr;
     trans_arena.Reset();
   }
 
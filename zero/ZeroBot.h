@@ -16,6 +16,7 @@
 namespace zero {
 
 struct BotController;
+struct ThreadPool;
 struct Worker;
 struct WorkQueue;
 
@@ -61,6 +62,8 @@ struct ZeroBot {
   MemoryArena work_arena;
   WorkQueue* work_queue;
   Worker* worker;
+  // Created once and shared by every game so joining a new zone doesn't start new threads.
+  ThreadPool* thread_pool;
   Game* game = nullptr;
   DebugRenderer debug_renderer;
 
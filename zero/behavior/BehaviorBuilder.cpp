@@ -14,6 +14,9 @@ CompositeBuilder& CompositeBuilder::Sequence(CompositeDecorator decorator) {
     case CompositeDecorator::Invert: {
       children.emplace_back(std::make_unique<InvertNode>(std::make_unique<SequenceNode>()));
     } break;
+    case CompositeDecorator::Scheduled: {
+      children.emplace_back(std::make_unique<ScheduledNode>(std::make_unique<SequenceNode>()));
+    } break;
   }
 
   current_builder = std::make_unique<CompositeBuilder>(this, CompositeType::Sequence, decorator);
@@ -32,6 +35,9 @@ CompositeBuilder& CompositeBuilder::Selector(CompositeDecorator decorator) {
     case CompositeDecorator::Invert: {
       children.emplace_back(std::make_unique<InvertNode>(std::make_unique<SelectorNode>()));
     } break;
+    case CompositeDecorator::Scheduled: {
+      children.emplace_back(std::make_unique<ScheduledNode>(std::make_unique<SelectorNode>()));
+    } break;
   }
 
   current_builder = std::make_unique<CompositeBuilder>(this, CompositeType::Selector, decorator);
@@ -50,6 +56,9 @@ CompositeBuilder& CompositeBuilder::Parallel(CompositeDecorator decorator) {
     case CompositeDecorator::Invert: {
       children.emplace_back(std::make_unique<InvertNode>(std::make_unique<ParallelNode>()));
     } break;
+    case CompositeDecorator::Scheduled: {
+      children.emplace_back(std::make_unique<ScheduledNode>(std::make_unique<ParallelNode>()));
+    } break;
   }
 
   current_builder = std::make_unique<CompositeBuilder>(this, CompositeType::Parallel, decorator);
@@ -68,6 +77,9 @@ CompositeBuilder& CompositeBuilder::Composite(std::unique_ptr<BehaviorNode> node
     case CompositeDecorator::Invert: {
       children.emplace_back(std::make_unique<InvertNode>(std::move(node)));
     } break;
+    case CompositeDecorator::Scheduled: {
+      children.emplace_back(std::make_unique<ScheduledNode>(std::move(node)));
+    } break;
   }
 
   return *this;
@@ -83,6 +95,9 @@ CompositeBuilder& CompositeBuilder::End() {
     } else if (decorator == CompositeDecorator::Invert) {
       InvertNode* invert_node = (InvertNode*)parent->children.back().get();
       composite_node = (CompositeNode*)invert_node->child_.get();
+    } else if (decorator == CompositeDecorator::Scheduled) {
+      ScheduledNode* scheduled_node = (ScheduledNode*)parent->children.back().get();
+      composite_node = (CompositeNode*)scheduled_node->child_.get();
     }
 
     for (auto& node : children) {
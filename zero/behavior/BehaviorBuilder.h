@@ -15,7 +15,8 @@ enum class CompositeType {
   Parallel,
 };
 
-enum class CompositeDecorator { None, Success, Invert };
+// Scheduled composites execute at the scheduler's strategic interval.
+enum class CompositeDecorator { None, Success, Invert, Scheduled };
 
 class CompositeBuilder {
  public:
@@ -43,6 +44,14 @@ class CompositeBuilder {
     return *this;
   }
 
+  // An interval of 0 uses the scheduler's strategic interval.
+  template <typename T, typename... Args>
+  CompositeBuilder& ScheduledChild(u32 interval_ticks, Args... args) {
+    children.emplace_back(
+        std::make_unique<ScheduledNode>(interval_ticks, std::make_unique<T>(std::forward<Args>(args)...)));
+    return *this;
+  }
+
   CompositeBuilder& Sequence(CompositeDecorator decorator = CompositeDecorator::None);
   CompositeBuilder& Selector(CompositeDecorator decorator = CompositeDecorator::None);
   CompositeBuilder& Parallel(CompositeDecorator decorator = CompositeDecorator::None);
@@ -0,0 +1,227 @@
+#include "BehaviorProfiler.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <zero/RenderContext.h>
+#include <zero/behavior/BehaviorTree.h>
+#include <zero/game/render/SpriteRenderer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <typeinfo>
+
+#ifndef _MSC_VER
+#include <cxxabi.h>
+#endif
+
+namespace zero {
+namespace behavior {
+
+BehaviorProfiler* gBehaviorProfiler = nullptr;
+
+constexpr size_t kProfileRenderCount = 24;
+constexpr float kProfileSmoothing = 0.05f;
+
+static u64 GetProfileTime() {
+  auto now = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+}
+
+static std::string GetNodeName(const BehaviorNode& node) {
+  std::string name = typeid(node).name();
+
+#ifndef _MSC_VER
+  int status = 0;
+  char* demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+
+  if (demangled) {
+    if (status == 0) {
+      name = demangled;
+    }
+
+    free(demangled);
+  }
+#endif
+
+  // Strip the namespaces from the class name, but leave the ones in template arguments.
+  size_t template_start = name.find('<');
+  size_t namespace_end = name.rfind(':', template_start);
+
+  if (namespace_end != std::string::npos) {
+    name.erase(0, namespace_end + 1);
+  } else if (name.compare(0, 7, "struct ") == 0) {
+    name.erase(0, 7);
+  } else if (name.compare(0, 6, "class ") == 0) {
+    name.erase(0, 6);
+  }
+
+  return name;
+}
+
+void BehaviorProfiler::BeginFrame(const BehaviorNode* root) {
+  // The entries are keyed by node, so they are no longer valid once the tree is replaced.
+  if (root != this->root) {
+    Reset();
+    this->root = root;
+  }
+
+  for (ProfileEntry& entry : entries) {
+    entry.frame_inclusive_ns = 0;
+    entry.frame_exclusive_ns = 0;
+    entry.frame_calls = 0;
+  }
+
+  stack.clear();
+}
+
+void BehaviorProfiler::EndFrame() {
+  for (ProfileEntry& entry : entries) {
+    entry.total_inclusive_ns += entry.frame_inclusive_ns;
+    entry.total_exclusive_ns += entry.frame_exclusive_ns;
+    entry.total_calls += entry.frame_calls;
+
+    float inclusive_us = entry.frame_inclusive_ns / 1000.0f;
+    float exclusive_us = entry.frame_exclusive_ns / 1000.0f;
+
+    entry.average_inclusive_us += (inclusive_us - entry.average_inclusive_us) * kProfileSmoothing;
+    entry.average_exclusive_us += (exclusive_us - entry.average_exclusive_us) * kProfileSmoothing;
+    entry.average_calls += (entry.frame_calls - entry.average_calls) * kProfileSmoothing;
+  }
+
+  u64 now = GetProfileTime();
+
+  if (last_write_ns == 0) {
+    last_write_ns = now;
+  } else if (now - last_write_ns >= write_interval_ms * 1000000ull) {
+    WriteFolded(kBehaviorProfileFile);
+    last_write_ns = now;
+  }
+}
+
+void BehaviorProfiler::Begin(const BehaviorNode* node) {
+  u32 parent = stack.empty() ? ProfileEntry::kInvalidIndex : stack.back().entry;
+  u32 entry = GetEntry(node, parent);
+
+  stack.push_back({entry, GetProfileTime(), 0});
+}
+
+void BehaviorProfiler::End() {
+  if (stack.empty()) return;
+
+  Frame frame = stack.back();
+  stack.pop_back();
+
+  u64 elapsed = GetProfileTime() - frame.start_ns;
+  ProfileEntry& entry = entries[frame.entry];
+
+  entry.frame_inclusive_ns += elapsed;
+  entry.frame_exclusive_ns += elapsed > frame.child_ns ? elapsed - frame.child_ns : 0;
+  ++entry.frame_calls;
+
+  if (!stack.empty()) {
+    stack.back().child_ns += elapsed;
+  }
+}
+
+void BehaviorProfiler::Reset() {
+  entries.clear();
+  lookup.clear();
+  stack.clear();
+  root = nullptr;
+}
+
+bool BehaviorProfiler::WriteFolded(const char* filename) {
+  FILE* f = fopen(filename, "w");
+
+  if (!f) return false;
+
+  std::string path;
+
+  for (u32 i = 0; i < (u32)entries.size(); ++i) {
+    u64 exclusive_us = entries[i].total_exclusive_ns / 1000;
+
+    if (exclusive_us == 0) continue;
+
+    path.clear();
+    AppendPath(path, i);
+
+    fprintf(f, "%s %llu\n", path.c_str(), (unsigned long long)exclusive_us);
+  }
+
+  fclose(f);
+  return true;
+}
+
+void BehaviorProfiler::Render(RenderContext& rc) {
+  if (!rc.renderer || !rc.ui_camera) return;
+
+  std::vector<u32> order(entries.size());
+
+  for (u32 i = 0; i < (u32)entries.size(); ++i) {
+    order[i] = i;
+  }
+
+  size_t count = std::min(order.size(), kProfileRenderCount);
+
+  std::partial_sort(order.begin(), order.begin() + count, order.end(), [this](u32 left, u32 right) {
+    return entries[left].average_exclusive_us > entries[right].average_exclusive_us;
+  });
+
+  float x = rc.ui_camera->surface_dim.x * 0.5f;
+  float y = 0.0f;
+  char line[256];
+
+  rc.renderer->PushText(*rc.ui_camera, "  excl(us)  incl(us)  calls  node", TextColor::Pink, Vector2f(x, y),
+                        Layer::TopMost);
+  y += 12.0f;
+
+  for (size_t i = 0; i < count; ++i) {
+    ProfileEntry& entry = entries[order[i]];
+    const char* parent_name = entry.parent != ProfileEntry::kInvalidIndex ? entries[entry.parent].name.c_str() : "";
+
+    snprintf(line, sizeof(line), "%10.1f%10.1f%7.1f  %s > %s", entry.average_exclusive_us, entry.average_inclusive_us,
+             entry.average_calls, parent_name, entry.name.c_str());
+
+    rc.renderer->PushText(*rc.ui_camera, line, TextColor::Pink, Vector2f(x, y), Layer::TopMost);
+    y += 12.0f;
+  }
+
+  rc.renderer->Render(*rc.ui_camera);
+}
+
+u32 BehaviorProfiler::GetEntry(const BehaviorNode* node, u32 parent) {
+  EntryKey key = {node, parent};
+  auto iter = lookup.find(key);
+
+  if (iter != lookup.end()) {
+    return iter->second;
+  }
+
+  u32 index = (u32)entries.size();
+
+  entries.emplace_back();
+
+  ProfileEntry& entry = entries.back();
+
+  entry.node = node;
+  entry.parent = parent;
+  entry.name = GetNodeName(*node);
+
+  lookup[key] = index;
+
+  return index;
+}
+
+void BehaviorProfiler::AppendPath(std::string& output, u32 index) {
+  const ProfileEntry& entry = entries[index];
+
+  if (entry.parent != ProfileEntry::kInvalidIndex) {
+    AppendPath(output, entry.parent);
+    output += ';';
+  }
+
+  output += entry.name;
+}
+
+}  // namespace behavior
+}  // namespace zero
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <zero/Types.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace zero {
+
+struct RenderContext;
+
+namespace behavior {
+
+class BehaviorNode;
+
+struct ProfileEntry {
+  static constexpr u32 kInvalidIndex = 0xFFFFFFFF;
+
+  const BehaviorNode* node;
+  u32 parent;
+  // Class name of the node without namespaces.
+  std::string name;
+
+  u64 total_inclusive_ns = 0;
+  u64 total_exclusive_ns = 0;
+  u64 total_calls = 0;
+
+  u64 frame_inclusive_ns = 0;
+  u64 frame_exclusive_ns = 0;
+  u32 frame_calls = 0;
+
+  // Smoothed per-frame values for the overlay.
+  float average_inclusive_us = 0.0f;
+  float average_exclusive_us = 0.0f;
+  float average_calls = 0.0f;
+};
+
+// Records how long each node of the behavior tree takes to execute, keyed by the path of nodes from the root.
+// Inclusive time counts the node's children and exclusive time only counts the node itself.
+// Composite nodes only report to the profiler while gBehaviorProfiler is set, so it costs a single pointer check per
+// child when disabled.
+struct BehaviorProfiler {
+  std::vector<ProfileEntry> entries;
+
+  // How often the folded stacks are written to kBehaviorProfileFile while profiling.
+  u32 write_interval_ms = 10000;
+
+  void BeginFrame(const BehaviorNode* root);
+  void EndFrame();
+
+  void Begin(const BehaviorNode* node);
+  void End();
+
+  void Reset();
+
+  // Writes each path on its own line with the nodes separated by semicolons followed by the exclusive microseconds
+  // spent in it. This is the folded stack format that flamegraph tools read.
+  bool WriteFolded(const char* filename);
+
+  // Renders the most expensive paths by smoothed exclusive time.
+  void Render(RenderContext& rc);
+
+ private:
+  struct Frame {
+    u32 entry;
+    u64 start_ns;
+    u64 child_ns;
+  };
+
+  struct EntryKey {
+    const BehaviorNode* node;
+    u32 parent;
+
+    bool operator==(const EntryKey& other) const { return node == other.node && parent == other.parent; }
+  };
+
+  struct EntryKeyHash {
+    size_t operator()(const EntryKey& key) const {
+      return std::hash<const void*>()(key.node) ^ ((size_t)key.parent * 0x9E3779B97F4A7C15ull);
+    }
+  };
+
+  u32 GetEntry(const BehaviorNode* node, u32 parent);
+  void AppendPath(std::string& output, u32 index);
+
+  std::unordered_map<EntryKey, u32, EntryKeyHash> lookup;
+  std::vector<Frame> stack;
+
+  const BehaviorNode* root = nullptr;
+  u64 last_write_ns = 0;
+};
+
+constexpr const char* kBehaviorProfileFile = "behavior_profile.folded";
+
+extern BehaviorProfiler* gBehaviorProfiler;
+
+}  // namespace behavior
+}  // namespace zero
@@ -0,0 +1,27 @@
+#include "BehaviorScheduler.h"
+
+namespace zero {
+namespace behavior {
+
+bool BehaviorScheduler::BeginFrame(Tick tick) {
+  current_tick = tick;
+
+  if (tree_executed && TICK_DIFF(tick, last_tree_tick) < (s32)tree_interval_ticks) {
+    return false;
+  }
+
+  last_tree_tick = tick;
+  tree_executed = true;
+  slice_used_us = 0;
+
+  return true;
+}
+
+bool BehaviorScheduler::CanBeginSlice(Tick due_tick) const {
+  if (slice_used_us < slice_budget_us) return true;
+
+  return TICK_DIFF(current_tick, due_tick) >= (s32)max_delay_ticks;
+}
+
+}  // namespace behavior
+}  // namespace zero
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <zero/Types.h>
+#include <zero/game/Clock.h>
+
+namespace zero {
+namespace behavior {
+
+// Decides how often the behavior tree and its scheduled subtrees execute.
+// The bot loop runs much faster than the game simulates, so the tree only executes once every tree_interval_ticks
+// game ticks and the frames in between replay the last steering and input that it produced.
+// Scheduled subtrees share a time budget for each execution of the tree. Once the budget is used, any other scheduled
+// subtree that is due waits for a later execution, so expensive subtrees that come due together are spread out.
+struct BehaviorScheduler {
+  // Game ticks between executions of the whole tree. 1 executes the tree at the game's tick rate.
+  u32 tree_interval_ticks = 1;
+  // Game ticks between executions of scheduled subtrees that don't set their own interval.
+  u32 strategic_interval_ticks = 25;
+  // Microseconds that scheduled subtrees can spend in each execution of the tree.
+  u32 slice_budget_us = 500;
+  // A scheduled subtree that has waited this many ticks past when it was due runs even if the budget is used up.
+  u32 max_delay_ticks = 50;
+
+  Tick current_tick = 0;
+  u64 slice_used_us = 0;
+
+  // Returns true if the tree should execute this frame. This also starts a new budget for scheduled subtrees.
+  bool BeginFrame(Tick tick);
+
+  // Returns true if a scheduled subtree that was due at due_tick can execute now.
+  bool CanBeginSlice(Tick due_tick) const;
+  inline void EndSlice(u64 elapsed_us) { slice_used_us += elapsed_us; }
+
+ private:
+  Tick last_tree_tick = 0;
+  bool tree_executed = false;
+};
+
+}  // namespace behavior
+}  // namespace zero
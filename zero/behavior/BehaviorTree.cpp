@@ -1,6 +1,7 @@
 #include "BehaviorTree.h"
 
 #include <zero/RenderContext.h>
+#include <zero/behavior/BehaviorProfiler.h>
 #include <zero/game/Game.h>
 
 namespace zero {
@@ -34,20 +35,20 @@ void Print(std::string_view str) {
 }
 
 template <typename T>
-static bool IsNodeType(std::unique_ptr<BehaviorNode>& node) {
-  return dynamic_cast<T*>(node.get());
+static bool IsNodeType(BehaviorNode* node) {
+  return dynamic_cast<T*>(node);
 }
 
-void Print(std::unique_ptr<BehaviorNode>& node) {
+void Print(BehaviorNode* node) {
   if (gDebugTreePrinter) {
     if (IsNodeType<SequenceNode>(node)) return;
     if (IsNodeType<ParallelNode>(node)) return;
     if (IsNodeType<SelectorNode>(node)) return;
     if (IsNodeType<SuccessNode>(node)) return;
     if (IsNodeType<InvertNode>(node)) return;
+    if (IsNodeType<ScheduledNode>(node)) return;
 
-    auto raw_node = node.get();
-    const char* type_name = typeid(*raw_node).name();
+    const char* type_name = typeid(*node).name();
     int type_name_len = (int)strlen(type_name);
     int first_index = 0;
 
@@ -63,6 +64,20 @@ void Print(std::unique_ptr<BehaviorNode>& node) {
   }
 }
 
+void Print(std::unique_ptr<BehaviorNode>& node) {
+  Print(node.get());
+}
+
+static inline ExecuteResult ExecuteChild(std::unique_ptr<BehaviorNode>& node, ExecuteContext& ctx) {
+  if (!gBehaviorProfiler) return node->Execute(ctx);
+
+  gBehaviorProfiler->Begin(node.get());
+  ExecuteResult result = node->Execute(ctx);
+  gBehaviorProfiler->End();
+
+  return result;
+}
+
 void DepthIncrease() {
   if (gDebugTreePrinter) {
     if (gDebugTreePrinter->render_brackets) {
@@ -97,7 +112,7 @@ ExecuteResult SequenceNode::Execute(ExecuteContext& ctx) {
 
     Print(node);
 
-    ExecuteResult result = node->Execute(ctx);
+    ExecuteResult result = ExecuteChild(node, ctx);
 
     if (result == ExecuteResult::Failure) {
       this->running_node_index_ = 0;
@@ -126,7 +141,7 @@ ExecuteResult ParallelNode::Execute(ExecuteContext& ctx) {
   for (auto& child : children_) {
     Print(child);
 
-    ExecuteResult child_result = child->Execute(ctx);
+    ExecuteResult child_result = ExecuteChild(child, ctx);
 
     if (result == ExecuteResult::Success && child_result != ExecuteResult::Success) {
       // TODO: Implement failure policies
@@ -148,7 +163,7 @@ ExecuteResult SelectorNode::Execute(ExecuteContext& ctx) {
   for (auto& child : children_) {
     Print(child);
 
-    ExecuteResult child_result = child->Execute(ctx);
+    ExecuteResult child_result = ExecuteChild(child, ctx);
 
     if (child_result == ExecuteResult::Running || child_result == ExecuteResult::Success) {
       DepthDecrease();
@@ -168,7 +183,7 @@ ExecuteResult SuccessNode::Execute(ExecuteContext& ctx) {
   DepthIncrease();
   Print(child_);
 
-  child_->Execute(ctx);
+  ExecuteChild(child_, ctx);
 
   DepthDecrease();
 
@@ -182,7 +197,7 @@ ExecuteResult InvertNode::Execute(ExecuteContext& ctx) {
   DepthIncrease();
   Print(child_);
 
-  ExecuteResult child_result = child_->Execute(ctx);
+  ExecuteResult child_result = ExecuteChild(child_, ctx);
 
   DepthDecrease();
 
@@ -195,5 +210,266 @@ ExecuteResult InvertNode::Execute(ExecuteContext& ctx) {
   return child_result;
 }
 
+ExecuteResult ScheduledNode::Execute(ExecuteContext& ctx) {
+  if (!child_) return ExecuteResult::Failure;
+
+  BehaviorScheduler* scheduler = ctx.scheduler;
+
+  if (scheduler && executed_ && last_result_ != ExecuteResult::Running) {
+    if (TICK_GT(due_tick_, scheduler->current_tick) || !scheduler->CanBeginSlice(due_tick_)) {
+      return last_result_;
+    }
+  }
+
+  Print("Scheduled");
+  DepthIncrease();
+  Print(child_);
+
+  u64 start_us = scheduler ? GetMicrosecondTick() : 0;
+
+  last_result_ = ExecuteChild(child_, ctx);
+  executed_ = true;
+
+  if (scheduler) {
+    u32 interval = interval_ticks_ > 0 ? interval_ticks_ : scheduler->strategic_interval_ticks;
+
+    scheduler->EndSlice(GetMicrosecondTick() - start_us);
+    due_tick_ = MAKE_TICK(scheduler->current_tick + interval);
+  }
+
+  DepthDecrease();
+
+  return last_result_;
+}
+
+static const char* GetFlatTypeName(CompiledTreeNode::FlatType type) {
+  switch (type) {
+    case CompiledTreeNode::FlatType::Sequence: {
+      return "Sequence";
+    } break;
+    case CompiledTreeNode::FlatType::Selector: {
+      return "Selector";
+    } break;
+    case CompiledTreeNode::FlatType::Parallel: {
+      return "Parallel";
+    } break;
+    case CompiledTreeNode::FlatType::Success: {
+      return "Success";
+    } break;
+    case CompiledTreeNode::FlatType::Invert: {
+      return "Invert";
+    } break;
+    case CompiledTreeNode::FlatType::Leaf: {
+    } break;
+  }
+
+  return "";
+}
+
+CompiledTreeNode::CompiledTreeNode(std::unique_ptr<BehaviorNode> root) : root_(std::move(root)) {
+  if (root_) {
+    Flatten(root_.get(), 0);
+  }
+}
+
+void CompiledTreeNode::Flatten(BehaviorNode* node, size_t depth) {
+  u32 index = (u32)nodes_.size();
+  FlatType type = FlatType::Leaf;
+  const std::type_info& info = typeid(*node);
+
+  // Exact type checks so subclasses that override Execute keep running their own version.
+  if (info == typeid(SequenceNode)) {
+    type = FlatType::Sequence;
+  } else if (info == typeid(SelectorNode)) {
+    type = FlatType::Selector;
+  } else if (info == typeid(ParallelNode)) {
+    type = FlatType::Parallel;
+  } else if (info == typeid(SuccessNode)) {
+    type = FlatType::Success;
+  } else if (info == typeid(InvertNode)) {
+    type = FlatType::Invert;
+  }
+
+  nodes_.push_back({node, type, 0, 0, 0});
+
+  // Every composite on the path to the deepest node needs a frame.
+  if (type != FlatType::Leaf && depth >= stack_.size()) {
+    stack_.resize(depth + 1);
+  }
+
+  switch (type) {
+    case FlatType::Sequence:
+    case FlatType::Selector:
+    case FlatType::Parallel: {
+      CompositeNode* composite = (CompositeNode*)node;
+
+      for (auto& child : composite->children_) {
+        Flatten(child.get(), depth + 1);
+      }
+
+      nodes_[index].child_count = (u32)composite->children_.size();
+    } break;
+    case FlatType::Success: {
+      SuccessNode* success = (SuccessNode*)node;
+
+      if (success->child_) {
+        Flatten(success->child_.get(), depth + 1);
+        nodes_[index].child_count = 1;
+      }
+    } break;
+    case FlatType::Invert: {
+      InvertNode* invert = (InvertNode*)node;
+
+      if (invert->child_) {
+        Flatten(invert->child_.get(), depth + 1);
+        nodes_[index].child_count = 1;
+      }
+    } break;
+    case FlatType::Leaf: {
+    } break;
+  }
+
+  nodes_[index].skip = (u32)nodes_.size();
+}
+
+ExecuteResult CompiledTreeNode::Execute(ExecuteContext& ctx) {
+  if (nodes_.empty()) return ExecuteResult::Failure;
+
+  // The debug hooks can only change between ticks, so the common case runs without checking them for every node.
+  if (gDebugTreePrinter || gBehaviorProfiler) {
+    return Run<true>(ctx);
+  }
+
+  return Run<false>(ctx);
+}
+
+template <bool kInstrumented>
+ExecuteResult CompiledTreeNode::Run(ExecuteContext& ctx) {
+  FlatNode* nodes = nodes_.data();
+  Frame* stack = stack_.data();
+  size_t depth = 0;
+  u32 index = 0;
+  ExecuteResult result = ExecuteResult::Success;
+
+  while (true) {
+    // Enter nodes until one produces a result. Composites push a frame and continue into their first child.
+    while (true) {
+      FlatNode& node = nodes[index];
+
+      if constexpr (kInstrumented) {
+        // The root isn't printed since it isn't run by a composite.
+        if (index > 0) {
+          Print(node.node);
+        }
+
+        if (gBehaviorProfiler) {
+          gBehaviorProfiler->Begin(node.node);
+        }
+      }
+
+      if (node.type == FlatType::Leaf) {
+        result = node.node->Execute(ctx);
+        break;
+      }
+
+      if (node.child_count == 0) {
+        if (node.type == FlatType::Selector || node.type == FlatType::Success || node.type == FlatType::Invert) {
+          result = ExecuteResult::Failure;
+        } else {
+          result = ExecuteResult::Success;
+        }
+
+        if constexpr (kInstrumented) {
+          if (node.type != FlatType::Success && node.type != FlatType::Invert) {
+            Print(GetFlatTypeName(node.type));
+            DepthIncrease();
+            DepthDecrease();
+          }
+        }
+
+        break;
+      }
+
+      if constexpr (kInstrumented) {
+        Print(GetFlatTypeName(node.type));
+        DepthIncrease();
+      }
+
+      u32 child = index + 1;
+      u32 ordinal = 0;
+
+      if (node.type == FlatType::Sequence && node.running_child < node.child_count) {
+        for (; ordinal < node.running_child; ++ordinal) {
+          child = nodes[child].skip;
+        }
+      }
+
+      stack[depth++] = {index, child, ordinal, ExecuteResult::Success};
+      index = child;
+    }
+
+    // Hand the result up to the parents until one of them has another child to run.
+    while (true) {
+      if constexpr (kInstrumented) {
+        if (gBehaviorProfiler) {
+          gBehaviorProfiler->End();
+        }
+      }
+
+      if (depth == 0) return result;
+
+      Frame& frame = stack[depth - 1];
+      FlatNode& parent = nodes[frame.index];
+      bool has_next = frame.child_ordinal + 1 < parent.child_count;
+      bool finished = true;
+
+      // Sequences and selectors make up most of the composites, so they are checked first.
+      if (parent.type == FlatType::Sequence) {
+        if (result == ExecuteResult::Running) {
+          parent.running_child = frame.child_ordinal;
+        } else if (result == ExecuteResult::Failure || !has_next) {
+          parent.running_child = 0;
+        } else {
+          finished = false;
+        }
+      } else if (parent.type == FlatType::Selector) {
+        finished = result != ExecuteResult::Failure || !has_next;
+      } else if (parent.type == FlatType::Parallel) {
+        if (frame.result == ExecuteResult::Success && result != ExecuteResult::Success) {
+          // TODO: Implement failure policies
+          frame.result = result;
+        }
+
+        finished = !has_next;
+        result = frame.result;
+      } else if (parent.type == FlatType::Success) {
+        result = ExecuteResult::Success;
+      } else if (result != ExecuteResult::Running) {
+        // Invert
+        result = result == ExecuteResult::Success ? ExecuteResult::Failure : ExecuteResult::Success;
+      }
+
+      if (!finished) {
+        frame.child = nodes[frame.child].skip;
+        ++frame.child_ordinal;
+        index = frame.child;
+        break;
+      }
+
+      if constexpr (kInstrumented) {
+        DepthDecrease();
+      }
+
+      --depth;
+    }
+  }
+}
+
+std::unique_ptr<BehaviorNode> CompileTree(std::unique_ptr<BehaviorNode> tree) {
+  if (!tree) return nullptr;
+
+  return std::make_unique<CompiledTreeNode>(std::move(tree));
+}
+
 }  // namespace behavior
 }  // namespace zero
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <zero/behavior/BehaviorScheduler.h>
 #include <zero/behavior/Blackboard.h>
 
 #include <cstdio>
@@ -51,8 +52,10 @@ struct ExecuteContext {
   Blackboard blackboard;
   ZeroBot* bot;
   float dt;
+  // Scheduled subtrees execute every time when this is null.
+  BehaviorScheduler* scheduler;
 
-  ExecuteContext() : bot(nullptr), dt(0) {}
+  ExecuteContext() : bot(nullptr), dt(0), scheduler(nullptr) {}
 };
 
 class BehaviorNode {
@@ -123,6 +126,77 @@ class InvertNode : public BehaviorNode {
   std::unique_ptr<BehaviorNode> child_;
 };
 
+// Executes its child at a lower rate than the rest of the tree and returns the child's last result in between. The
+// blackboard values that the child sets stay in place between executions, so strategic decisions can be made less
+// often while the tactical nodes that read them run every time.
+// A child that returns Running executes every time until it finishes.
+class ScheduledNode : public BehaviorNode {
+ public:
+  // An interval of 0 uses the scheduler's strategic interval.
+  ScheduledNode(std::unique_ptr<BehaviorNode> child) : ScheduledNode(0, std::move(child)) {}
+  ScheduledNode(u32 interval_ticks, std::unique_ptr<BehaviorNode> child)
+      : interval_ticks_(interval_ticks), child_(std::move(child)) {}
+
+  ExecuteResult Execute(ExecuteContext& ctx) override;
+
+  void Child(std::unique_ptr<BehaviorNode> child) { child_ = std::move(child); }
+
+  u32 interval_ticks_;
+  std::unique_ptr<BehaviorNode> child_;
+
+ private:
+  bool executed_ = false;
+  Tick due_tick_ = 0;
+  ExecuteResult last_result_ = ExecuteResult::Failure;
+};
+
+// Owns a built tree and runs it from a flattened preorder copy. Sequence, selector, parallel, success and invert nodes are
+// interpreted in a loop over the array instead of recursing through their virtual Execute calls, so only the leaf
+// nodes are called through Execute.
+// Subclasses of the composite nodes are treated as leaves, so any custom Execute is still called.
+class CompiledTreeNode : public BehaviorNode {
+ public:
+  CompiledTreeNode(std::unique_ptr<BehaviorNode> root);
+
+  ExecuteResult Execute(ExecuteContext& ctx) override;
+
+  enum class FlatType : u8 { Leaf, Sequence, Selector, Parallel, Success, Invert };
+
+ private:
+
+  struct FlatNode {
+    BehaviorNode* node;
+    FlatType type;
+    u32 child_count;
+    // Index of the node that comes after this node's subtree.
+    u32 skip;
+    // The child that a sequence resumes from after it returned running.
+    u32 running_child;
+  };
+
+  struct Frame {
+    u32 index;
+    // Index and position of the child that is being executed.
+    u32 child;
+    u32 child_ordinal;
+    ExecuteResult result;
+  };
+
+  void Flatten(BehaviorNode* node, size_t depth);
+
+  // The printer and profiler hooks are only compiled into the instrumented version.
+  template <bool kInstrumented>
+  ExecuteResult Run(ExecuteContext& ctx);
+
+  std::unique_ptr<BehaviorNode> root_;
+  std::vector<FlatNode> nodes_;
+  // Sized to the deepest composite when flattening, so it never grows while running.
+  std::vector<Frame> stack_;
+};
+
+// Flattens a built tree into a CompiledTreeNode. The tree runs the same way as before.
+std::unique_ptr<BehaviorNode> CompileTree(std::unique_ptr<BehaviorNode> tree);
+
 // Generic execution node that will execute any function that matches the required signature.
 struct ExecuteNode : public BehaviorNode {
   using Func = ExecuteResult(ExecuteContext&);
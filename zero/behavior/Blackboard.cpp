@@ -0,0 +1,53 @@
+#include "Blackboard.h"
+
+#include <string_view>
+#include <unordered_map>
+
+namespace zero {
+namespace behavior {
+
+struct KeyHash {
+  using is_transparent = void;
+
+  size_t operator()(std::string_view str) const { return std::hash<std::string_view>()(str); }
+};
+
+struct KeyTable {
+  std::unordered_map<std::string, u32, KeyHash, std::equal_to<>> ids;
+  // Points at the strings stored in the map, which never move.
+  std::vector<const char*> names;
+};
+
+static KeyTable& GetKeyTable() {
+  static KeyTable table;
+  return table;
+}
+
+u32 BlackboardKey::Intern(const char* name) {
+  KeyTable& table = GetKeyTable();
+  std::string_view view(name);
+
+  auto iter = table.ids.find(view);
+
+  if (iter != table.ids.end()) {
+    return iter->second;
+  }
+
+  u32 id = (u32)table.names.size();
+  auto result = table.ids.emplace(std::string(view), id);
+
+  table.names.push_back(result.first->first.c_str());
+
+  return id;
+}
+
+const char* BlackboardKey::GetName() const {
+  KeyTable& table = GetKeyTable();
+
+  if (id_ >= table.names.size()) return "";
+
+  return table.names[id_];
+}
+
+}  // namespace behavior
+}  // namespace zero
@@ -1,49 +1,246 @@
 #pragma once
 
-#include <any>
+#include <zero/Types.h>
+
+#include <concepts>
+#include <cstddef>
+#include <new>
 #include <optional>
 #include <string>
-#include <unordered_map>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace zero {
 namespace behavior {
 
+// Blackboard keys are interned into small ids, so looking up a value indexes directly into the blackboard instead of
+// hashing the key string. Nodes should store their keys as BlackboardKey so the string is only resolved once when the
+// node is constructed.
+// Keys are interned on the bot thread and are never released.
+class BlackboardKey {
+ public:
+  static constexpr u32 kInvalidId = 0xFFFFFFFF;
+
+  BlackboardKey() : id_(kInvalidId) {}
+  // A null name creates an invalid key so optional keys can be stored as a BlackboardKey.
+  BlackboardKey(const char* name) : id_(name ? Intern(name) : kInvalidId) {}
+  BlackboardKey(const std::string& name) : id_(Intern(name.c_str())) {}
+
+  inline u32 GetId() const { return id_; }
+  inline bool IsValid() const { return id_ != kInvalidId; }
+  explicit operator bool() const { return IsValid(); }
+
+  // Returns the string that the key was interned from or an empty string for invalid keys.
+  const char* GetName() const;
+
+  inline bool operator==(const BlackboardKey& other) const { return id_ == other.id_; }
+  inline bool operator!=(const BlackboardKey& other) const { return id_ != other.id_; }
+
+ private:
+  static u32 Intern(const char* name);
+
+  u32 id_;
+};
+
+struct BlackboardSlot;
+
+// Functions to manage the value stored in a slot. There is one of these for each stored type, so its address is also
+// used to check the type of the value.
+struct BlackboardSlotType {
+  void (*destroy)(BlackboardSlot& slot);
+  void (*move)(BlackboardSlot& dest, BlackboardSlot& src);
+};
+
+struct BlackboardSlot {
+  // Values that fit here are stored without any allocation. Larger values are allocated once and then reused when the
+  // key is set to the same type again.
+  static constexpr size_t kInlineSize = 48;
+
+  const BlackboardSlotType* type = nullptr;
+  void* heap = nullptr;
+  // Incremented whenever the value changes so readers can tell if anything they computed from it is stale.
+  u32 version = 0;
+  alignas(std::max_align_t) unsigned char storage[kInlineSize];
+
+  BlackboardSlot() {}
+  BlackboardSlot(const BlackboardSlot&) = delete;
+  BlackboardSlot& operator=(const BlackboardSlot&) = delete;
+
+  BlackboardSlot(BlackboardSlot&& other) noexcept : version(other.version) {
+    if (other.type) {
+      other.type->move(*this, other);
+    }
+  }
+
+  ~BlackboardSlot() { Reset(); }
+
+  inline void* GetData() { return heap ? heap : storage; }
+
+  inline void Reset() {
+    if (type) {
+      type->destroy(*this);
+      type = nullptr;
+      ++version;
+    }
+  }
+};
+
+template <typename T>
+constexpr bool kBlackboardInline = sizeof(T) <= BlackboardSlot::kInlineSize && alignof(T) <= alignof(std::max_align_t);
+
+template <typename T>
+const BlackboardSlotType* GetBlackboardSlotType() {
+  static const BlackboardSlotType kType = {
+      [](BlackboardSlot& slot) {
+        if constexpr (kBlackboardInline<T>) {
+          ((T*)slot.storage)->~T();
+        } else {
+          delete (T*)slot.heap;
+          slot.heap = nullptr;
+        }
+      },
+      [](BlackboardSlot& dest, BlackboardSlot& src) {
+        if constexpr (kBlackboardInline<T>) {
+          new (dest.storage) T(std::move(*(T*)src.storage));
+          ((T*)src.storage)->~T();
+        } else {
+          dest.heap = src.heap;
+          src.heap = nullptr;
+        }
+
+        dest.type = src.type;
+        src.type = nullptr;
+      },
+  };
+
+  return &kType;
+}
+
+// Stores values by interned key. Each key has a slot that holds a single value of any type, and reading the value
+// back as a different type than it was set with fails the same way that a bad any_cast would.
+// The string keyed calls are kept working by the implicit key conversion, but they pay for interning on every call.
 class Blackboard {
  public:
-  bool Has(const std::string& key) { return data_.find(key) != data_.end(); }
+  Blackboard() {}
+  Blackboard(const Blackboard&) = delete;
+  Blackboard& operator=(const Blackboard&) = delete;
 
-  template <typename T>
-  void Set(const std::string& key, const T& value) {
-    data_[key] = std::any(value);
+  bool Has(BlackboardKey key) {
+    BlackboardSlot* slot = FindSlot(key);
+
+    return slot && slot->type;
   }
 
   template <typename T>
-  std::optional<T> Value(const std::string& key) {
-    auto iter = data_.find(key);
+  void Set(BlackboardKey key, const T& value) {
+    using Stored = std::decay_t<const T&>;
 
-    if (iter == data_.end()) {
-      return std::nullopt;
+    if (!key.IsValid()) return;
+
+    if (key.GetId() >= slots_.size()) {
+      // Growing moves the existing slots, so copy the value first in case it came from one of them.
+      Stored copy = value;
+
+      slots_.resize(key.GetId() + 1);
+      Set(key, copy);
+      return;
+    }
+
+    BlackboardSlot& slot = slots_[key.GetId()];
+    const BlackboardSlotType* type = GetBlackboardSlotType<Stored>();
+
+    if constexpr (std::is_copy_assignable_v<Stored>) {
+      // Assign over the existing value so values like vectors can reuse their memory.
+      if (slot.type == type) {
+        Stored& current = *(Stored*)slot.GetData();
+
+        // Setting the same value again doesn't count as a change, so cached queries that read it stay valid.
+        if constexpr (std::equality_comparable<Stored>) {
+          if (current == value) return;
+        }
+
+        current = value;
+        ++slot.version;
+        return;
+      }
+    }
+
+    slot.Reset();
+
+    if constexpr (kBlackboardInline<Stored>) {
+      new (slot.storage) Stored(value);
+    } else {
+      slot.heap = new Stored(value);
     }
 
-    auto& any = iter->second;
+    slot.type = type;
+    ++slot.version;
+  }
+
+  // Returns a pointer to the stored value if it exists and has this exact type.
+  // The pointer is only valid until the blackboard is changed. Writing through it doesn't change the key's version.
+  template <typename T>
+  T* Get(BlackboardKey key) {
+    BlackboardSlot* slot = FindSlot(key);
+
+    if (!slot || slot->type != GetBlackboardSlotType<T>()) return nullptr;
+
+    return (T*)slot->GetData();
+  }
+
+  template <typename T>
+  std::optional<T> Value(BlackboardKey key) {
+    T* value = Get<T>(key);
 
-    try {
-      return std::any_cast<T>(any);
-    } catch (const std::bad_any_cast&) {
+    if (!value) {
       return std::nullopt;
     }
+
+    return *value;
   }
 
   template <typename T>
-  T ValueOr(const std::string& key, const T& or_result) {
-    return Value<T>(key).value_or(or_result);
+  T ValueOr(BlackboardKey key, const T& or_result) {
+    T* value = Get<T>(key);
+
+    if (!value) {
+      return or_result;
+    }
+
+    return *value;
+  }
+
+  // Returns a number that changes every time the value for this key is set to something new or erased.
+  u32 GetVersion(BlackboardKey key) {
+    BlackboardSlot* slot = FindSlot(key);
+
+    return slot ? slot->version : 0;
+  }
+
+  void Clear() {
+    for (BlackboardSlot& slot : slots_) {
+      slot.Reset();
+    }
   }
 
-  void Clear() { data_.clear(); }
-  void Erase(const std::string& key) { data_.erase(key); }
+  void Erase(BlackboardKey key) {
+    BlackboardSlot* slot = FindSlot(key);
+
+    if (slot) {
+      slot->Reset();
+    }
+  }
 
  private:
-  std::unordered_map<std::string, std::any> data_;
+  inline BlackboardSlot* FindSlot(BlackboardKey key) {
+    if (key.GetId() >= slots_.size()) return nullptr;
+
+    return &slots_[key.GetId()];
+  }
+
+  // Indexed by key id.
+  std::vector<BlackboardSlot> slots_;
 };
 
 }  // namespace behavior
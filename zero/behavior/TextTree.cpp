@@ -0,0 +1,470 @@
+#include "TextTree.h"
+
+#include <zero/game/Logger.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace zero {
+namespace behavior {
+
+std::unique_ptr<BehaviorNode> NodeRegistry::Create(const std::string& name,
+                                                   const std::vector<TreeArgument>& args) const {
+  auto iter = factories.find(name);
+  if (iter == factories.end()) return nullptr;
+
+  for (const Factory& factory : iter->second) {
+    std::unique_ptr<BehaviorNode> node = factory(*this, args);
+
+    if (node) return node;
+  }
+
+  return nullptr;
+}
+
+static bool IsValidValue(TreeValueType type, const TreeArgument& arg) {
+  switch (type) {
+    case TreeValueType::Float: {
+      return arg.type == TreeArgumentType::Number;
+    } break;
+    case TreeValueType::Int:
+    case TreeValueType::U32:
+    case TreeValueType::U16: {
+      return arg.type == TreeArgumentType::Number && arg.integral;
+    } break;
+    case TreeValueType::Bool: {
+      return arg.type == TreeArgumentType::Symbol && (arg.text == "true" || arg.text == "false");
+    } break;
+    case TreeValueType::String: {
+      return arg.type == TreeArgumentType::String;
+    } break;
+    case TreeValueType::Vector: {
+      return arg.type == TreeArgumentType::Vector && arg.component_count == 2;
+    } break;
+  }
+
+  return false;
+}
+
+void TextTree::ApplyValues(Blackboard& blackboard) const {
+  for (const TreeValue& value : values) {
+    const TreeArgument& arg = value.value;
+
+    switch (value.type) {
+      case TreeValueType::Float: {
+        blackboard.Set(value.key, (float)arg.number);
+      } break;
+      case TreeValueType::Int: {
+        blackboard.Set(value.key, (int)arg.number);
+      } break;
+      case TreeValueType::U32: {
+        blackboard.Set(value.key, (u32)arg.number);
+      } break;
+      case TreeValueType::U16: {
+        blackboard.Set(value.key, (u16)arg.number);
+      } break;
+      case TreeValueType::Bool: {
+        blackboard.Set(value.key, arg.text == "true");
+      } break;
+      case TreeValueType::String: {
+        blackboard.Set(value.key, arg.text);
+      } break;
+      case TreeValueType::Vector: {
+        blackboard.Set(value.key, Vector2f(arg.components[0], arg.components[1]));
+      } break;
+    }
+  }
+}
+
+namespace text {
+
+inline bool IsWhitespace(char c) {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline bool IsNumberStart(std::string_view str) {
+  if (str.empty()) return false;
+
+  size_t index = (str[0] == '-' || str[0] == '+') ? 1 : 0;
+
+  if (index < str.size() && str[index] == '.') ++index;
+
+  return index < str.size() && str[index] >= '0' && str[index] <= '9';
+}
+
+struct Lexer {
+  std::string_view line;
+  size_t index = 0;
+  std::string error;
+
+  Lexer(std::string_view line) : line(line) {}
+
+  bool ParseNumber(std::string_view str, TreeArgument& arg) {
+    std::string number(str);
+
+    // Allow float literals copied from C++ trees.
+    if (!number.empty() && (number.back() == 'f' || number.back() == 'F')) {
+      number.pop_back();
+    }
+
+    char* end = nullptr;
+    arg.type = TreeArgumentType::Number;
+    arg.number = strtod(number.c_str(), &end);
+    arg.integral = number.find_first_of(".eE") == std::string::npos;
+
+    if (end == number.c_str() || *end != 0) {
+      error = "Invalid number '" + std::string(str) + "'";
+      return false;
+    }
+
+    return true;
+  }
+
+  std::string_view ReadWord() {
+    size_t start = index;
+
+    while (index < line.size() && !IsWhitespace(line[index]) && line[index] != '(' && line[index] != ')' &&
+           line[index] != ',' && line[index] != '"' && line[index] != '#') {
+      ++index;
+    }
+
+    return line.substr(start, index - start);
+  }
+
+  // Returns false when the line is done or an error was found.
+  bool Next(TreeArgument& arg) {
+    while (index < line.size() && IsWhitespace(line[index])) ++index;
+
+    if (index >= line.size() || line[index] == '#') return false;
+
+    arg = TreeArgument();
+
+    char c = line[index];
+
+    if (c == '"') {
+      size_t end = line.find('"', index + 1);
+
+      if (end == std::string_view::npos) {
+        error = "Missing closing quote";
+        return false;
+      }
+
+      arg.type = TreeArgumentType::String;
+      arg.text = line.substr(index + 1, end - index - 1);
+      index = end + 1;
+
+      return true;
+    }
+
+    if (c == '(') {
+      ++index;
+
+      arg.type = TreeArgumentType::Vector;
+
+      while (true) {
+        while (index < line.size() && (IsWhitespace(line[index]) || line[index] == ',')) ++index;
+
+        if (index >= line.size()) {
+          error = "Missing closing parenthesis";
+          return false;
+        }
+
+        if (line[index] == ')') {
+          ++index;
+          break;
+        }
+
+        TreeArgument component;
+
+        if (arg.component_count >= 3 || !ParseNumber(ReadWord(), component)) {
+          if (error.empty()) error = "Vectors can only have 2 or 3 numbers";
+          return false;
+        }
+
+        arg.components[arg.component_count++] = (float)component.number;
+      }
+
+      if (arg.component_count < 2) {
+        error = "Vectors can only have 2 or 3 numbers";
+        return false;
+      }
+
+      return true;
+    }
+
+    std::string_view word = ReadWord();
+
+    if (word.empty()) {
+      error = std::string("Unexpected character '") + c + "'";
+      return false;
+    }
+
+    if (IsNumberStart(word)) {
+      return ParseNumber(word, arg);
+    }
+
+    arg.type = TreeArgumentType::Symbol;
+    arg.text = word;
+
+    return true;
+  }
+};
+
+enum class Decorator { Success, Invert, Scheduled };
+
+struct Frame {
+  size_t indent;
+  CompositeNode* composite;
+};
+
+}  // namespace text
+
+static bool GetValueType(const std::string& name, TreeValueType& type) {
+  static const std::pair<const char*, TreeValueType> kTypes[] = {
+      {"float", TreeValueType::Float}, {"int", TreeValueType::Int},       {"u32", TreeValueType::U32},
+      {"u16", TreeValueType::U16},     {"bool", TreeValueType::Bool},     {"string", TreeValueType::String},
+      {"vector", TreeValueType::Vector},
+  };
+
+  for (auto& kv : kTypes) {
+    if (name == kv.first) {
+      type = kv.second;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool TextTreeParser::Parse(std::string_view text, TextTree& tree) {
+  using namespace text;
+
+  std::vector<Frame> stack;
+  std::vector<TreeArgument> tokens;
+  std::vector<std::pair<Decorator, u32>> decorators;
+
+  size_t line_number = 0;
+  size_t previous_indent = 0;
+  bool previous_leaf = false;
+
+  tree.root = nullptr;
+  tree.values.clear();
+  error.clear();
+
+  auto fail = [&](const std::string& message) {
+    error = "Line " + std::to_string(line_number) + ": " + message;
+    tree.root = nullptr;
+    return false;
+  };
+
+  while (!text.empty()) {
+    size_t line_end = text.find('\n');
+    std::string_view line = text.substr(0, line_end);
+
+    text = line_end == std::string_view::npos ? std::string_view() : text.substr(line_end + 1);
+    ++line_number;
+
+    size_t indent = 0;
+    while (indent < line.size() && line[indent] == ' ') ++indent;
+
+    if (indent < line.size() && line[indent] == '\t') {
+      return fail("Indent with spaces instead of tabs");
+    }
+
+    Lexer lexer(line);
+    TreeArgument token;
+
+    tokens.clear();
+
+    while (lexer.Next(token)) {
+      tokens.push_back(std::move(token));
+    }
+
+    if (!lexer.error.empty()) return fail(lexer.error);
+    if (tokens.empty()) continue;
+
+    if (tokens[0].type == TreeArgumentType::Symbol && tokens[0].text == "set") {
+      TreeValueType type;
+
+      if (tokens.size() != 4 || tokens[1].type != TreeArgumentType::Symbol || !GetValueType(tokens[1].text, type) ||
+          tokens[2].type != TreeArgumentType::String) {
+        return fail("Expected 'set <type> \"key\" value'");
+      }
+
+      if (!IsValidValue(type, tokens[3])) {
+        return fail("Value doesn't match the type " + tokens[1].text);
+      }
+
+      tree.values.push_back({BlackboardKey(tokens[2].text), type, tokens[3]});
+      continue;
+    }
+
+    size_t index = 0;
+
+    decorators.clear();
+
+    while (index < tokens.size() && tokens[index].type == TreeArgumentType::Symbol) {
+      const std::string& word = tokens[index].text;
+
+      if (word == "success") {
+        decorators.emplace_back(Decorator::Success, 0);
+      } else if (word == "invert") {
+        decorators.emplace_back(Decorator::Invert, 0);
+      } else if (word == "scheduled") {
+        u32 interval = 0;
+
+        if (index + 1 < tokens.size() && tokens[index + 1].type == TreeArgumentType::Number) {
+          if (!tokens[index + 1].integral || tokens[index + 1].number < 0) {
+            return fail("The scheduled interval must be a positive number of ticks");
+          }
+
+          interval = (u32)tokens[++index].number;
+        }
+
+        decorators.emplace_back(Decorator::Scheduled, interval);
+      } else {
+        break;
+      }
+
+      ++index;
+    }
+
+    if (index >= tokens.size() || tokens[index].type != TreeArgumentType::Symbol) {
+      return fail("Expected a node name");
+    }
+
+    const std::string& name = tokens[index].text;
+    std::vector<TreeArgument> args(tokens.begin() + index + 1, tokens.end());
+
+    std::unique_ptr<BehaviorNode> node;
+    CompositeNode* composite = nullptr;
+
+    if (name == "sequence" || name == "selector" || name == "parallel") {
+      if (!args.empty()) return fail("Composites don't take arguments");
+
+      std::unique_ptr<CompositeNode> composite_node;
+
+      if (name == "sequence") {
+        composite_node = std::make_unique<SequenceNode>();
+      } else if (name == "selector") {
+        composite_node = std::make_unique<SelectorNode>();
+      } else {
+        composite_node = std::make_unique<ParallelNode>();
+      }
+
+      composite = composite_node.get();
+      node = std::move(composite_node);
+    } else {
+      node = registry.Create(name, args);
+
+      if (!node) {
+        if (!registry.HasNode(name)) return fail("Unknown node '" + name + "'");
+
+        return fail("No constructor of '" + name + "' takes these arguments");
+      }
+    }
+
+    for (size_t i = decorators.size(); i > 0; --i) {
+      switch (decorators[i - 1].first) {
+        case Decorator::Success: {
+          node = std::make_unique<SuccessNode>(std::move(node));
+        } break;
+        case Decorator::Invert: {
+          node = std::make_unique<InvertNode>(std::move(node));
+        } break;
+        case Decorator::Scheduled: {
+          node = std::make_unique<ScheduledNode>(decorators[i - 1].second, std::move(node));
+        } break;
+      }
+    }
+
+    if (tree.root && indent > previous_indent && previous_leaf) {
+      return fail("Only composites can have children");
+    }
+
+    while (!stack.empty() && stack.back().indent >= indent) {
+      stack.pop_back();
+    }
+
+    if (stack.empty()) {
+      if (tree.root) return fail("Only one root node is allowed");
+
+      tree.root = std::move(node);
+    } else {
+      stack.back().composite->children_.push_back(std::move(node));
+    }
+
+    if (composite) {
+      stack.push_back({indent, composite});
+    }
+
+    previous_indent = indent;
+    previous_leaf = composite == nullptr;
+  }
+
+  if (!tree.root) {
+    line_number = 0;
+    return fail("The tree is empty");
+  }
+
+  return true;
+}
+
+static bool LoadFile(const char* filename, std::string& result) {
+  FILE* f = fopen(filename, "rb");
+
+  if (!f) return false;
+
+  fseek(f, 0, SEEK_END);
+  long file_size = ftell(f);
+  fseek(f, 0, SEEK_SET);
+
+  result.resize(file_size);
+  size_t read_amount = fread(&result[0], 1, file_size, f);
+  fclose(f);
+
+  return read_amount == (size_t)file_size;
+}
+
+bool TextBehavior::Load(TextTree& tree) {
+  std::string text;
+
+  if (!LoadFile(filename.data(), text)) {
+    Log(LogLevel::Error, "Failed to read behavior tree file %s.", filename.data());
+    return false;
+  }
+
+  TextTreeParser parser(GetNodeRegistry());
+
+  if (!parser.Parse(text, tree)) {
+    Log(LogLevel::Error, "Failed to parse behavior tree file %s. %s", filename.data(), parser.error.data());
+    return false;
+  }
+
+  return true;
+}
+
+void TextBehavior::OnInitialize(ExecuteContext& ctx) {
+  TextTree tree;
+
+  if (Load(tree)) {
+    tree.ApplyValues(ctx.blackboard);
+    loaded_root = std::move(tree.root);
+  }
+}
+
+std::unique_ptr<BehaviorNode> TextBehavior::CreateTree(ExecuteContext& ctx) {
+  // The tree is loaded with the values when initializing, but the behavior can also be created without initializing.
+  if (!loaded_root) {
+    TextTree tree;
+
+    if (Load(tree)) {
+      loaded_root = std::move(tree.root);
+    }
+  }
+
+  return std::move(loaded_root);
+}
+
+}  // namespace behavior
+}  // namespace zero
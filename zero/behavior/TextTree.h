@@ -0,0 +1,226 @@
+#pragma once
+
+#include <zero/Math.h>
+#include <zero/Types.h>
+#include <zero/behavior/Behavior.h>
+#include <zero/behavior/BehaviorTree.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace zero {
+namespace behavior {
+
+// Behavior trees can be written as text and built at load time into the same nodes that the C++ builder creates.
+//
+// Each line is one node, and children are indented further than their parent composite:
+//
+//   # Comments start with '#'.
+//   set float "leash_distance" 25
+//   selector
+//     sequence
+//       invert VisibilityQueryNode "nearest_target_position"
+//       GoToNode "nearest_target_position"
+//     scheduled 25 sequence
+//       NearestTargetNode "nearest_target"
+//
+// Composites are 'sequence', 'selector', and 'parallel'. Any other name is looked up in the node registry with the
+// rest of the line as its constructor arguments. A line can start with the 'success', 'invert', and 'scheduled'
+// decorators, and 'scheduled' takes an optional interval in ticks.
+// Arguments are quoted strings, numbers, vectors like (512 512), true or false, or registered symbols like
+// InputAction::Bullet.
+// 'set' lines give blackboard values that are set when the behavior is initialized. The types are float, int, u32,
+// u16, bool, string, and vector.
+
+enum class TreeArgumentType { String, Number, Vector, Symbol };
+
+struct TreeArgument {
+  TreeArgumentType type = TreeArgumentType::Number;
+  std::string text;
+  double number = 0.0;
+  bool integral = false;
+  float components[3] = {};
+  size_t component_count = 0;
+};
+
+struct TreeSymbol {
+  // Only values of the type that the symbol was registered with can be created from a typed symbol. Untyped symbols
+  // are integer constants that can be used for any integer argument.
+  const void* type;
+  s64 value;
+};
+
+template <typename T>
+const void* GetTreeTypeTag() {
+  static const char kTag = 0;
+  return &kTag;
+}
+
+// Creates nodes by name from parsed arguments. A name can have several factories registered to match the constructor
+// overloads of the node, and the first one that accepts the arguments is used.
+class NodeRegistry {
+ public:
+  using Factory = std::function<std::unique_ptr<BehaviorNode>(const NodeRegistry&, const std::vector<TreeArgument>&)>;
+
+  // Registers a constructor of T that takes Args.
+  template <typename T, typename... Args>
+  void Register(const std::string& name) {
+    RegisterFactory<Args...>(name, [](const std::decay_t<Args>&... values) -> std::unique_ptr<BehaviorNode> {
+      return std::make_unique<T>(values...);
+    });
+  }
+
+  // Registers a function that creates a node from Args. This is used for nodes that are created from static helpers.
+  template <typename... Args, typename F>
+  void RegisterFactory(const std::string& name, F&& fn) {
+    factories[name].push_back([fn = std::forward<F>(fn)](const NodeRegistry& registry,
+                                                         const std::vector<TreeArgument>& args) {
+      std::unique_ptr<BehaviorNode> result;
+
+      if (args.size() != sizeof...(Args)) return result;
+
+      std::tuple<std::decay_t<Args>...> values;
+
+      if (registry.ConvertAll(args, values, std::index_sequence_for<Args...>())) {
+        result = std::apply(fn, values);
+      }
+
+      return result;
+    });
+  }
+
+  template <typename T>
+  void RegisterSymbol(const std::string& name, T value) {
+    symbols[name] = {GetTreeTypeTag<T>(), (s64)value};
+  }
+
+  inline void RegisterConstant(const std::string& name, s64 value) { symbols[name] = {nullptr, value}; }
+
+  inline bool HasNode(const std::string& name) const { return factories.find(name) != factories.end(); }
+
+  // Returns null if the name isn't registered or none of its factories accept the arguments.
+  std::unique_ptr<BehaviorNode> Create(const std::string& name, const std::vector<TreeArgument>& args) const;
+
+  // Strings are interned with the blackboard keys so nodes that store the raw pointer keep a valid string.
+  template <typename T>
+  bool Convert(const TreeArgument& arg, T& out) const {
+    if constexpr (std::is_same_v<T, const char*>) {
+      if (arg.type != TreeArgumentType::String) return false;
+
+      out = BlackboardKey(arg.text).GetName();
+      return true;
+    } else if constexpr (std::is_same_v<T, std::string>) {
+      if (arg.type != TreeArgumentType::String) return false;
+
+      out = arg.text;
+      return true;
+    } else if constexpr (std::is_same_v<T, bool>) {
+      if (arg.type != TreeArgumentType::Symbol) return false;
+      if (arg.text != "true" && arg.text != "false") return false;
+
+      out = arg.text == "true";
+      return true;
+    } else if constexpr (std::is_enum_v<T> || std::is_integral_v<T>) {
+      if (arg.type == TreeArgumentType::Number) {
+        if (!arg.integral) return false;
+
+        out = (T)(s64)arg.number;
+        return true;
+      }
+
+      if (arg.type != TreeArgumentType::Symbol) return false;
+
+      auto iter = symbols.find(arg.text);
+      if (iter == symbols.end()) return false;
+      if (iter->second.type != nullptr && iter->second.type != GetTreeTypeTag<T>()) return false;
+      if (iter->second.type == nullptr && std::is_enum_v<T>) return false;
+
+      out = (T)iter->second.value;
+      return true;
+    } else if constexpr (std::is_floating_point_v<T>) {
+      if (arg.type != TreeArgumentType::Number) return false;
+
+      out = (T)arg.number;
+      return true;
+    } else if constexpr (std::is_same_v<T, Vector2f>) {
+      if (arg.type != TreeArgumentType::Vector || arg.component_count != 2) return false;
+
+      out = Vector2f(arg.components[0], arg.components[1]);
+      return true;
+    } else if constexpr (std::is_same_v<T, Vector3f>) {
+      if (arg.type != TreeArgumentType::Vector || arg.component_count != 3) return false;
+
+      out = Vector3f(arg.components[0], arg.components[1], arg.components[2]);
+      return true;
+    } else {
+      static_assert(!sizeof(T), "Unsupported text tree argument type.");
+    }
+  }
+
+  template <typename Tuple, size_t... I>
+  bool ConvertAll(const std::vector<TreeArgument>& args, Tuple& values, std::index_sequence<I...>) const {
+    return (Convert(args[I], std::get<I>(values)) && ...);
+  }
+
+ private:
+  std::unordered_map<std::string, std::vector<Factory>> factories;
+  std::unordered_map<std::string, TreeSymbol> symbols;
+};
+
+// Returns the registry with every shared node registered. Zones can register their own nodes here before their text
+// trees are loaded.
+NodeRegistry& GetNodeRegistry();
+
+enum class TreeValueType { Float, Int, U32, U16, Bool, String, Vector };
+
+struct TreeValue {
+  BlackboardKey key;
+  TreeValueType type;
+  TreeArgument value;
+};
+
+struct TextTree {
+  std::unique_ptr<BehaviorNode> root;
+  std::vector<TreeValue> values;
+
+  void ApplyValues(Blackboard& blackboard) const;
+};
+
+class TextTreeParser {
+ public:
+  TextTreeParser(const NodeRegistry& registry) : registry(registry) {}
+
+  // Returns false and sets error to a message with the line number if the text isn't a valid tree.
+  bool Parse(std::string_view text, TextTree& tree);
+
+  std::string error;
+
+ private:
+  const NodeRegistry& registry;
+};
+
+// Loads its tree from a text file every time the behavior is initialized, so the tree can be changed without
+// rebuilding by setting the behavior again.
+struct TextBehavior : public Behavior {
+  TextBehavior(const std::string& filename) : filename(filename) {}
+
+  void OnInitialize(ExecuteContext& ctx) override;
+  std::unique_ptr<BehaviorNode> CreateTree(ExecuteContext& ctx) override;
+
+  std::string filename;
+
+ private:
+  bool Load(TextTree& tree);
+
+  std::unique_ptr<BehaviorNode> loaded_root;
+};
+
+}  // namespace behavior
+}  // namespace zero
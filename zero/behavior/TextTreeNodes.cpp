@@ -0,0 +1,444 @@
+#include <zero/behavior/TextTree.h>
+#include <zero/behavior/nodes/AimNode.h>
+#include <zero/behavior/nodes/AttachNode.h>
+#include <zero/behavior/nodes/BehaviorNode.h>
+#include <zero/behavior/nodes/BlackboardNode.h>
+#include <zero/behavior/nodes/ChatNode.h>
+#include <zero/behavior/nodes/FlagNode.h>
+#include <zero/behavior/nodes/InputActionNode.h>
+#include <zero/behavior/nodes/MapNode.h>
+#include <zero/behavior/nodes/MathNode.h>
+#include <zero/behavior/nodes/MoveNode.h>
+#include <zero/behavior/nodes/PlayerNode.h>
+#include <zero/behavior/nodes/PowerballNode.h>
+#include <zero/behavior/nodes/RegionNode.h>
+#include <zero/behavior/nodes/RenderNode.h>
+#include <zero/behavior/nodes/ShipNode.h>
+#include <zero/behavior/nodes/TargetNode.h>
+#include <zero/behavior/nodes/ThreatNode.h>
+#include <zero/behavior/nodes/TimerNode.h>
+#include <zero/behavior/nodes/WaypointNode.h>
+#include <zero/zones/svs/nodes/DynamicPlayerBoundingBoxQueryNode.h>
+#include <zero/zones/svs/nodes/IncomingDamageQueryNode.h>
+
+namespace zero {
+namespace behavior {
+
+// Template nodes are registered with the type in the name, such as 'ScalarThresholdNode<float>'.
+template <typename T>
+static void RegisterValueNodes(NodeRegistry& registry, const std::string& type_name) {
+  auto name = [&type_name](const char* node_name) { return std::string(node_name) + "<" + type_name + ">"; };
+
+  registry.Register<EqualityNode<T>, T, const char*>(name("EqualityNode"));
+  registry.Register<EqualityNode<T>, const char*, T>(name("EqualityNode"));
+  registry.Register<EqualityNode<T>, const char*, const char*>(name("EqualityNode"));
+
+  registry.Register<ValueCompareQuery<T>, const char*, T>(name("ValueCompareQuery"));
+
+  // Booleans can only be compared for equality.
+  if constexpr (!std::is_same_v<T, bool>) {
+    registry.Register<GreaterThanNode<T>, T, const char*>(name("GreaterThanNode"));
+    registry.Register<GreaterThanNode<T>, const char*, T>(name("GreaterThanNode"));
+    registry.Register<GreaterThanNode<T>, const char*, const char*>(name("GreaterThanNode"));
+
+    registry.Register<GreaterOrEqualThanNode<T>, T, const char*>(name("GreaterOrEqualThanNode"));
+    registry.Register<GreaterOrEqualThanNode<T>, const char*, T>(name("GreaterOrEqualThanNode"));
+    registry.Register<GreaterOrEqualThanNode<T>, const char*, const char*>(name("GreaterOrEqualThanNode"));
+
+    registry.Register<LessThanNode<T>, T, const char*>(name("LessThanNode"));
+    registry.Register<LessThanNode<T>, const char*, T>(name("LessThanNode"));
+    registry.Register<LessThanNode<T>, const char*, const char*>(name("LessThanNode"));
+
+    registry.Register<LessOrEqualThanNode<T>, T, const char*>(name("LessOrEqualThanNode"));
+    registry.Register<LessOrEqualThanNode<T>, const char*, T>(name("LessOrEqualThanNode"));
+    registry.Register<LessOrEqualThanNode<T>, const char*, const char*>(name("LessOrEqualThanNode"));
+
+    registry.Register<ScalarThresholdNode<T>, const char*, T>(name("ScalarThresholdNode"));
+    registry.Register<ScalarThresholdNode<T>, const char*, const char*>(name("ScalarThresholdNode"));
+
+    if constexpr (std::is_integral_v<T>) {
+      registry.Register<RandomIntNode<T>, T, T, const char*>(name("RandomIntNode"));
+      registry.Register<RandomIntNode<T>, T, const char*, const char*>(name("RandomIntNode"));
+      registry.Register<RandomIntNode<T>, const char*, T, const char*>(name("RandomIntNode"));
+      registry.Register<RandomIntNode<T>, const char*, const char*, const char*>(name("RandomIntNode"));
+
+      registry.Register<ReadConfigIntNode<T>, const char*, const char*>(name("ReadConfigIntNode"));
+    }
+  }
+}
+
+static void RegisterSymbols(NodeRegistry& registry) {
+  const char* kInputActionNames[] = {
+      "Left", "Right", "Forward", "Backward", "Afterburner", "Bomb", "Bullet", "Mine", "Thor", "Burst", "Multifire",
+      "Antiwarp", "Stealth", "Cloak", "XRadar", "Repel", "Warp", "Portal", "Decoy", "Rocket", "Brick", "Attach",
+      "StatBoxCycle", "StatBoxPrevious", "StatBoxNext", "StatBoxPreviousPage", "StatBoxNextPage", "StatBoxHelpNext",
+      "Play", "DisplayMap", "ChatDisplay",
+  };
+
+  static_assert(ZERO_ARRAY_SIZE(kInputActionNames) == (size_t)InputAction::ChatDisplay + 1);
+
+  for (size_t i = 0; i < ZERO_ARRAY_SIZE(kInputActionNames); ++i) {
+    registry.RegisterSymbol(std::string("InputAction::") + kInputActionNames[i], (InputAction)i);
+  }
+
+  registry.RegisterSymbol("WeaponType::None", WeaponType::None);
+  registry.RegisterSymbol("WeaponType::Bullet", WeaponType::Bullet);
+  registry.RegisterSymbol("WeaponType::BouncingBullet", WeaponType::BouncingBullet);
+  registry.RegisterSymbol("WeaponType::Bomb", WeaponType::Bomb);
+  registry.RegisterSymbol("WeaponType::ProximityBomb", WeaponType::ProximityBomb);
+  registry.RegisterSymbol("WeaponType::Repel", WeaponType::Repel);
+  registry.RegisterSymbol("WeaponType::Decoy", WeaponType::Decoy);
+  registry.RegisterSymbol("WeaponType::Burst", WeaponType::Burst);
+  registry.RegisterSymbol("WeaponType::Thor", WeaponType::Thor);
+
+  registry.RegisterSymbol("ShipItemType::Repel", ShipItemType::Repel);
+  registry.RegisterSymbol("ShipItemType::Burst", ShipItemType::Burst);
+  registry.RegisterSymbol("ShipItemType::Decoy", ShipItemType::Decoy);
+  registry.RegisterSymbol("ShipItemType::Thor", ShipItemType::Thor);
+  registry.RegisterSymbol("ShipItemType::Brick", ShipItemType::Brick);
+  registry.RegisterSymbol("ShipItemType::Rocket", ShipItemType::Rocket);
+  registry.RegisterSymbol("ShipItemType::Portal", ShipItemType::Portal);
+
+  registry.RegisterSymbol("Status_Stealth", Status_Stealth);
+  registry.RegisterSymbol("Status_Cloak", Status_Cloak);
+  registry.RegisterSymbol("Status_XRadar", Status_XRadar);
+  registry.RegisterSymbol("Status_Antiwarp", Status_Antiwarp);
+  registry.RegisterSymbol("Status_Flash", Status_Flash);
+  registry.RegisterSymbol("Status_Safety", Status_Safety);
+  registry.RegisterSymbol("Status_UFO", Status_UFO);
+  registry.RegisterSymbol("Status_InputChange", Status_InputChange);
+
+  registry.RegisterSymbol("LogLevel::Jabber", LogLevel::Jabber);
+  registry.RegisterSymbol("LogLevel::Debug", LogLevel::Debug);
+  registry.RegisterSymbol("LogLevel::Info", LogLevel::Info);
+  registry.RegisterSymbol("LogLevel::Warning", LogLevel::Warning);
+  registry.RegisterSymbol("LogLevel::Error", LogLevel::Error);
+
+  registry.RegisterSymbol("SeekNode::DistanceResolveType::Static", SeekNode::DistanceResolveType::Static);
+  registry.RegisterSymbol("SeekNode::DistanceResolveType::Zero", SeekNode::DistanceResolveType::Zero);
+  registry.RegisterSymbol("SeekNode::DistanceResolveType::Dynamic", SeekNode::DistanceResolveType::Dynamic);
+
+  registry.RegisterSymbol("NearestFlagNode::Type::Claimed", NearestFlagNode::Type::Claimed);
+  registry.RegisterSymbol("NearestFlagNode::Type::Unclaimed", NearestFlagNode::Type::Unclaimed);
+  registry.RegisterSymbol("NearestFlagNode::Type::Any", NearestFlagNode::Type::Any);
+
+  registry.RegisterConstant("kTileIdFlag", kTileIdFlag);
+  registry.RegisterConstant("kTileIdSafe", kTileIdSafe);
+  registry.RegisterConstant("kTileIdGoal", kTileIdGoal);
+  registry.RegisterConstant("kTileIdWormhole", kTileIdWormhole);
+
+  registry.RegisterConstant("ShipCapability_Stealth", ShipCapability_Stealth);
+  registry.RegisterConstant("ShipCapability_Cloak", ShipCapability_Cloak);
+  registry.RegisterConstant("ShipCapability_XRadar", ShipCapability_XRadar);
+  registry.RegisterConstant("ShipCapability_Antiwarp", ShipCapability_Antiwarp);
+  registry.RegisterConstant("ShipCapability_Multifire", ShipCapability_Multifire);
+  registry.RegisterConstant("ShipCapability_Proximity", ShipCapability_Proximity);
+  registry.RegisterConstant("ShipCapability_BouncingBullets", ShipCapability_BouncingBullets);
+}
+
+// Default arguments aren't part of the constructor type, so each arity of a constructor is registered separately.
+static void RegisterNodes(NodeRegistry& r) {
+  using Key = const char*;
+
+  // AimNode
+  r.Register<BulletDistanceNode, Key>("BulletDistanceNode");
+  r.Register<BulletDistanceNode, Key, Key>("BulletDistanceNode");
+  r.Register<ShotVelocityQueryNode, WeaponType, Key>("ShotVelocityQueryNode");
+  r.Register<ShotVelocityQueryNode, Key, WeaponType, Key>("ShotVelocityQueryNode");
+  r.Register<AimNode, WeaponType, Key, Key>("AimNode");
+  r.Register<BestShotQueryNode, WeaponType, Key, Key>("BestShotQueryNode");
+  r.Register<BestShotQueryNode, WeaponType, Key, Key, float>("BestShotQueryNode");
+  r.Register<BestShotQueryNode, Key, Key, Key>("BestShotQueryNode");
+  r.Register<BestShotQueryNode, Key, Key, Key, float>("BestShotQueryNode");
+
+  // AttachNode
+  r.Register<AttachedQueryNode>("AttachedQueryNode");
+  r.Register<AttachedQueryNode, Key>("AttachedQueryNode");
+  r.Register<AttachNode, Key>("AttachNode");
+  r.Register<DetachNode>("DetachNode");
+  r.Register<TurretCountQueryNode, Key>("TurretCountQueryNode");
+  r.Register<TurretCountQueryNode, Key, Key>("TurretCountQueryNode");
+
+  // BehaviorNode
+  r.Register<BehaviorSetNode, Key>("BehaviorSetNode");
+  r.Register<BehaviorSetFromKeyNode, Key>("BehaviorSetFromKeyNode");
+  r.Register<BehaviorSetFromKeyNode, Key, bool>("BehaviorSetFromKeyNode");
+
+  // BlackboardNode
+  r.Register<DebugPrintNode, Key>("DebugPrintNode");
+  r.Register<DebugPrintNode, Key, LogLevel>("DebugPrintNode");
+  r.Register<DebugPrintNode, LogLevel, Key>("DebugPrintNode");
+  r.Register<BlackboardSetQueryNode, Key>("BlackboardSetQueryNode");
+  r.Register<BlackboardEraseNode, Key>("BlackboardEraseNode");
+  r.Register<ReadConfigStringNode, Key, Key>("ReadConfigStringNode");
+
+  // ChatNode
+  auto chat = [](ChatMessageNode node) -> std::unique_ptr<BehaviorNode> {
+    return std::make_unique<ChatMessageNode>(node);
+  };
+
+  r.RegisterFactory<Key>("ChatMessageNode::Public",
+                         [chat](Key message) { return chat(ChatMessageNode::Public(message)); });
+  r.RegisterFactory<Key>("ChatMessageNode::Team", [chat](Key message) { return chat(ChatMessageNode::Team(message)); });
+  r.RegisterFactory<u16, Key>("ChatMessageNode::Frequency", [chat](u16 frequency, Key message) {
+    return chat(ChatMessageNode::Frequency(frequency, message));
+  });
+  r.RegisterFactory<Key, Key>("ChatMessageNode::Private", [chat](Key target_name, Key message) {
+    return chat(ChatMessageNode::Private(target_name, message));
+  });
+  r.RegisterFactory<Key>("ChatMessageNode::PublicBlackboard",
+                         [chat](Key message_key) { return chat(ChatMessageNode::PublicBlackboard(message_key)); });
+  r.RegisterFactory<Key>("ChatMessageNode::TeamBlackboard",
+                         [chat](Key message_key) { return chat(ChatMessageNode::TeamBlackboard(message_key)); });
+  r.RegisterFactory<Key, Key>("ChatMessageNode::FrequencyBlackboard", [chat](Key freq_key, Key message_key) {
+    return chat(ChatMessageNode::FrequencyBlackboard(freq_key, message_key));
+  });
+  r.RegisterFactory<Key, Key>("ChatMessageNode::PrivateBlackboard", [chat](Key target_name_key, Key message_key) {
+    return chat(ChatMessageNode::PrivateBlackboard(target_name_key, message_key));
+  });
+
+  // FlagNode
+  r.Register<FlagCarryCountQueryNode, Key>("FlagCarryCountQueryNode");
+  r.Register<FlagCarryCountQueryNode, Key, Key>("FlagCarryCountQueryNode");
+  r.Register<FlagPositionQueryNode, Key, Key>("FlagPositionQueryNode");
+  r.Register<ArenaFlagCountNode, Key>("ArenaFlagCountNode");
+  r.Register<TeamFlagCountNode, Key>("TeamFlagCountNode");
+  r.Register<TeamFlagCountNode, Key, Key>("TeamFlagCountNode");
+  r.Register<NearestFlagNode, NearestFlagNode::Type, Key>("NearestFlagNode");
+
+  // InputActionNode
+  r.Register<InputActionNode, InputAction>("InputActionNode");
+  r.Register<InputQueryNode, InputAction>("InputQueryNode");
+  r.Register<WarpNode>("WarpNode");
+
+  // MapNode
+  r.Register<ShipTraverseQueryNode, Key>("ShipTraverseQueryNode");
+  r.Register<ShipTraverseQueryNode, Key, Key>("ShipTraverseQueryNode");
+  r.Register<VisibilityQueryNode, Key>("VisibilityQueryNode");
+  r.Register<VisibilityQueryNode, Key, Key>("VisibilityQueryNode");
+  r.Register<TileQueryNode, TileId>("TileQueryNode");
+  r.Register<DistanceThresholdNode, Key, float>("DistanceThresholdNode");
+  r.Register<DistanceThresholdNode, Key, Key>("DistanceThresholdNode");
+  r.Register<DistanceThresholdNode, Key, Key, float>("DistanceThresholdNode");
+  r.Register<DistanceThresholdNode, Key, Key, Key>("DistanceThresholdNode");
+  r.Register<ClosestTileQueryNode, Key, Key>("ClosestTileQueryNode");
+  r.Register<ClosestTileQueryNode, Key, Key, Key>("ClosestTileQueryNode");
+
+  // MathNode
+  RegisterValueNodes<float>(r, "float");
+  RegisterValueNodes<int>(r, "int");
+  RegisterValueNodes<u16>(r, "u16");
+  RegisterValueNodes<u32>(r, "u32");
+  RegisterValueNodes<size_t>(r, "size_t");
+  RegisterValueNodes<bool>(r, "bool");
+
+  r.Register<RandomNode, float, float, Key>("RandomNode");
+  r.Register<RandomNode, float, Key, Key>("RandomNode");
+  r.Register<RandomNode, Key, float, Key>("RandomNode");
+  r.Register<RandomNode, Key, Key, Key>("RandomNode");
+  r.Register<ScalarNode, Key, Key>("ScalarNode");
+  r.Register<ScalarNode, float, Key>("ScalarNode");
+  r.Register<VectorNode, Key, Key>("VectorNode");
+  r.Register<VectorNode, Vector2f, Key>("VectorNode");
+  r.Register<PerpendicularNode, Vector2f, Vector2f, Key>("PerpendicularNode");
+  r.Register<PerpendicularNode, Vector2f, Vector2f, Key, bool>("PerpendicularNode");
+  r.Register<PerpendicularNode, Key, Vector2f, Key>("PerpendicularNode");
+  r.Register<PerpendicularNode, Key, Vector2f, Key, bool>("PerpendicularNode");
+  r.Register<PerpendicularNode, Vector2f, Key, Key>("PerpendicularNode");
+  r.Register<PerpendicularNode, Vector2f, Key, Key, bool>("PerpendicularNode");
+  r.Register<PerpendicularNode, Key, Key, Key>("PerpendicularNode");
+  r.Register<PerpendicularNode, Key, Key, Key, bool>("PerpendicularNode");
+  r.Register<MoveRectangleNode, Key, Vector2f, Key>("MoveRectangleNode");
+  r.Register<MoveRectangleNode, Key, Key, Key>("MoveRectangleNode");
+  r.Register<RectangleNode, Key, Key, Key>("RectangleNode");
+  r.Register<RectangleNode, Key, Vector2f, Key>("RectangleNode");
+  r.Register<RectangleContainsNode, Key, Key>("RectangleContainsNode");
+  r.Register<RectangleContainsNode, Key, Vector2f>("RectangleContainsNode");
+  r.Register<RayNode, Key, Key, Key>("RayNode");
+  r.Register<RayRectangleInterceptNode, Key, Key>("RayRectangleInterceptNode");
+  r.Register<VectorDotNode, Key, Key, Key>("VectorDotNode");
+  r.Register<VectorDotNode, Key, Key, Key, bool>("VectorDotNode");
+  r.Register<VectorAddNode, Key, Key, Key>("VectorAddNode");
+  r.Register<VectorAddNode, Key, Key, Key, bool>("VectorAddNode");
+  r.Register<VectorSubtractNode, Key, Key, Key>("VectorSubtractNode");
+  r.Register<VectorSubtractNode, Key, Key, Key, bool>("VectorSubtractNode");
+  r.Register<NormalizeNode, Key, Key>("NormalizeNode");
+  r.Register<DistanceNode, Key, Key, Key>("DistanceNode");
+  r.Register<DistanceNode, Key, Key, Key, bool>("DistanceNode");
+  r.Register<DistanceNode, Vector2f, Key, Key>("DistanceNode");
+  r.Register<DistanceNode, Vector2f, Key, Key, bool>("DistanceNode");
+
+  // MoveNode
+  r.Register<PursueNode, Key, Key, Key>("PursueNode");
+  r.Register<SeekNode, Key>("SeekNode");
+  r.Register<SeekNode, Key, float, SeekNode::DistanceResolveType>("SeekNode");
+  r.Register<SeekNode, Key, Key>("SeekNode");
+  r.Register<SeekNode, Key, Key, SeekNode::DistanceResolveType>("SeekNode");
+  r.Register<SeekZeroNode>("SeekZeroNode");
+  r.Register<ArriveNode, Key, float>("ArriveNode");
+  r.Register<AvoidTeamNode, Key>("AvoidTeamNode");
+  r.Register<AvoidTeamNode, float>("AvoidTeamNode");
+  r.Register<AvoidEnemyNode, Key>("AvoidEnemyNode");
+  r.Register<AvoidEnemyNode, float>("AvoidEnemyNode");
+  r.Register<AvoidWallsNode>("AvoidWallsNode");
+  r.Register<RotationThresholdSetNode, Key>("RotationThresholdSetNode");
+  r.Register<RotationThresholdSetNode, float>("RotationThresholdSetNode");
+  r.Register<FaceNode, Key>("FaceNode");
+  r.Register<FollowPathNode>("FollowPathNode");
+  r.Register<GoToNode, Key>("GoToNode");
+  r.Register<GoToNode, Vector2f>("GoToNode");
+  r.Register<PathDistanceQueryNode, Key>("PathDistanceQueryNode");
+  r.Register<PathDistanceQueryNode, Key, Key>("PathDistanceQueryNode");
+
+  // PlayerNode
+  r.Register<PlayerSelfNode, Key>("PlayerSelfNode");
+  r.Register<PlayerEnergyQueryNode, Key>("PlayerEnergyQueryNode");
+  r.Register<PlayerEnergyQueryNode, Key, Key>("PlayerEnergyQueryNode");
+  r.Register<PlayerNearPositionNode, Key, Key, float>("PlayerNearPositionNode");
+  r.Register<PlayerNearPositionNode, Key, Vector2f, float>("PlayerNearPositionNode");
+  r.Register<PlayerNearPositionNode, Key, float>("PlayerNearPositionNode");
+  r.Register<PlayerNearPositionNode, Vector2f, float>("PlayerNearPositionNode");
+  r.Register<PlayerFrequencyQueryNode, Key>("PlayerFrequencyQueryNode");
+  r.Register<PlayerFrequencyQueryNode, Key, Key>("PlayerFrequencyQueryNode");
+  r.Register<PlayerChangeFrequencyNode, u16>("PlayerChangeFrequencyNode");
+  r.Register<PlayerChangeFrequencyNode, Key>("PlayerChangeFrequencyNode");
+  r.Register<PlayerFrequencyCountQueryNode, Key>("PlayerFrequencyCountQueryNode");
+  r.Register<PlayerFrequencyCountQueryNode, Key, Key>("PlayerFrequencyCountQueryNode");
+  r.Register<PlayerBoundingBoxQueryNode, Key>("PlayerBoundingBoxQueryNode");
+  r.Register<PlayerBoundingBoxQueryNode, Key, float>("PlayerBoundingBoxQueryNode");
+  r.Register<PlayerBoundingBoxQueryNode, Key, Key>("PlayerBoundingBoxQueryNode");
+  r.Register<PlayerBoundingBoxQueryNode, Key, Key, float>("PlayerBoundingBoxQueryNode");
+  r.Register<PlayerStatusQueryNode, StatusFlag>("PlayerStatusQueryNode");
+  r.Register<PlayerStatusQueryNode, Key, StatusFlag>("PlayerStatusQueryNode");
+  r.Register<PlayerEnergyPercentThresholdNode, float>("PlayerEnergyPercentThresholdNode");
+  r.Register<PlayerEnergyPercentThresholdNode, Key, float>("PlayerEnergyPercentThresholdNode");
+  r.Register<PlayerCurrentEnergyQueryNode, Key>("PlayerCurrentEnergyQueryNode");
+  r.Register<PlayerPositionQueryNode, Key>("PlayerPositionQueryNode");
+  r.Register<PlayerPositionQueryNode, Key, Key>("PlayerPositionQueryNode");
+  r.Register<PlayerHeadingQueryNode, Key>("PlayerHeadingQueryNode");
+  r.Register<PlayerHeadingQueryNode, Key, Key>("PlayerHeadingQueryNode");
+  r.Register<PlayerVelocityQueryNode, Key>("PlayerVelocityQueryNode");
+  r.Register<PlayerVelocityQueryNode, Key, bool>("PlayerVelocityQueryNode");
+  r.Register<PlayerVelocityQueryNode, Key, Key>("PlayerVelocityQueryNode");
+  r.Register<PlayerVelocityQueryNode, Key, Key, bool>("PlayerVelocityQueryNode");
+
+  // PowerballNode
+  r.Register<PowerballGoalPathQuery, Key, Key>("PowerballGoalPathQuery");
+  r.Register<PowerballGoalPathQuery, Key, Key, bool>("PowerballGoalPathQuery");
+  r.Register<PowerballFireNode>("PowerballFireNode");
+  r.Register<PowerballRemainingTimeQueryNode, Key>("PowerballRemainingTimeQueryNode");
+  r.Register<PowerballCarryQueryNode>("PowerballCarryQueryNode");
+  r.Register<PowerballCarryQueryNode, Key>("PowerballCarryQueryNode");
+  r.Register<PowerballClosestQueryNode, Key>("PowerballClosestQueryNode");
+  r.Register<PowerballClosestQueryNode, Key, bool>("PowerballClosestQueryNode");
+  r.Register<PowerballClosestQueryNode, Key, Key>("PowerballClosestQueryNode");
+  r.Register<PowerballClosestQueryNode, Key, Key, bool>("PowerballClosestQueryNode");
+
+  // RegionNode
+  r.Register<RegionContainQueryNode, Vector2f>("RegionContainQueryNode");
+  r.Register<RegionContainQueryNode, Key>("RegionContainQueryNode");
+
+  // RenderNode
+  r.Register<RenderPathNode, Vector3f>("RenderPathNode");
+  r.Register<RenderPathNode, Key, Vector3f>("RenderPathNode");
+  r.Register<RenderRectNode, Key, Key, Vector3f>("RenderRectNode");
+  r.Register<RenderLineNode, Key, Key, Vector3f>("RenderLineNode");
+  r.Register<RenderRayNode, Key, Key, float, Vector3f>("RenderRayNode");
+  r.Register<RenderRayNode, Key, Key, Key, Vector3f>("RenderRayNode");
+  r.Register<RenderVectorNode, Key, Vector2f, Vector3f>("RenderVectorNode");
+  r.Register<RenderVectorNode, Key, Vector2f, Vector2f, Vector3f>("RenderVectorNode");
+  r.Register<RenderVectorNode, Key, Vector2f, Key, Vector3f>("RenderVectorNode");
+  r.Register<RenderVectorNode, Key, Key, Vector3f>("RenderVectorNode");
+  r.Register<RenderVectorNode, Key, Key, Vector2f, Vector3f>("RenderVectorNode");
+  r.Register<RenderVectorNode, Key, Key, Key, Vector3f>("RenderVectorNode");
+  r.Register<RenderEnableTreeNode, bool>("RenderEnableTreeNode");
+
+  // ShipNode
+  r.Register<ShipWeaponCooldownQueryNode, WeaponType>("ShipWeaponCooldownQueryNode");
+  r.Register<ShipQueryNode, int>("ShipQueryNode");
+  r.Register<ShipQueryNode, Key>("ShipQueryNode");
+  r.Register<ShipQueryNode, Key, int>("ShipQueryNode");
+  r.Register<ShipQueryNode, Key, Key>("ShipQueryNode");
+  r.Register<ShipRequestNode, int>("ShipRequestNode");
+  r.Register<ShipRequestNode, Key>("ShipRequestNode");
+  r.Register<ShipPortalPositionQueryNode>("ShipPortalPositionQueryNode");
+  r.Register<ShipPortalPositionQueryNode, Key>("ShipPortalPositionQueryNode");
+  r.Register<ShipCapabilityQueryNode, ShipCapabilityFlags>("ShipCapabilityQueryNode");
+  r.Register<ShipItemCountThresholdNode, ShipItemType>("ShipItemCountThresholdNode");
+  r.Register<ShipItemCountThresholdNode, ShipItemType, u32>("ShipItemCountThresholdNode");
+  r.Register<ShipItemCountQueryNode, ShipItemType, Key>("ShipItemCountQueryNode");
+  r.Register<ShipWeaponCapabilityQueryNode, WeaponType>("ShipWeaponCapabilityQueryNode");
+  r.Register<ShipWeaponCapabilityQueryNode, WeaponType, u32>("ShipWeaponCapabilityQueryNode");
+  r.Register<ShipMultifireQueryNode>("ShipMultifireQueryNode");
+  r.Register<ShipMineCapableQueryNode>("ShipMineCapableQueryNode");
+  r.Register<RepelDistanceQueryNode, Key>("RepelDistanceQueryNode");
+
+  // TargetNode
+  r.Register<HeadingPositionViewNode, Key, float>("HeadingPositionViewNode");
+  r.Register<HeadingDirectionViewNode, Key, float>("HeadingDirectionViewNode");
+  r.Register<NearestTargetNode, Key>("NearestTargetNode");
+  r.Register<NearestTargetNode, Key, bool>("NearestTargetNode");
+  auto scored_target = [](Key player_key, float distance, float energy, float threat,
+                          bool obey_stealth) -> std::unique_ptr<BehaviorNode> {
+    return std::make_unique<ScoredTargetNode>(player_key, TargetScoreWeights(distance, energy, threat), obey_stealth);
+  };
+
+  r.RegisterFactory<Key, float, float, float>(
+      "ScoredTargetNode", [scored_target](Key player_key, float distance, float energy, float threat) {
+        return scored_target(player_key, distance, energy, threat, false);
+      });
+  r.RegisterFactory<Key, float, float, float, bool>("ScoredTargetNode", scored_target);
+
+  // ThreatNode
+  r.Register<DodgeIncomingDamage, float, float>("DodgeIncomingDamage");
+  r.Register<DodgeIncomingDamage, float, float, float>("DodgeIncomingDamage");
+  r.Register<DodgeIncomingDamage, float, Key>("DodgeIncomingDamage");
+  r.Register<DodgeIncomingDamage, float, Key, float>("DodgeIncomingDamage");
+  r.Register<DodgeIncomingDamage, Key, Key>("DodgeIncomingDamage");
+  r.Register<DodgeIncomingDamage, Key, Key, float>("DodgeIncomingDamage");
+  r.Register<InfluenceMapGradientDodge>("InfluenceMapGradientDodge");
+  r.Register<InfluenceMapPopulateEnemies, float, float, bool>("InfluenceMapPopulateEnemies");
+  r.Register<InfluenceMapPopulateEnemies, Key, float, bool>("InfluenceMapPopulateEnemies");
+  r.Register<InfluenceMapPopulateWeapons>("InfluenceMapPopulateWeapons");
+  r.Register<InfluenceMapPopulateWeapons, bool>("InfluenceMapPopulateWeapons");
+  r.Register<FindTerritoryPosition, Key, Key, Key>("FindTerritoryPosition");
+  r.Register<FindTerritoryPosition, Key, Key, Key, bool>("FindTerritoryPosition");
+  r.Register<PositionThreatQueryNode, Vector2f, Key, float, float>("PositionThreatQueryNode");
+  r.Register<PositionThreatQueryNode, Key, Key, float, float>("PositionThreatQueryNode");
+  r.Register<ForecastDamageQueryNode, u32, Key>("ForecastDamageQueryNode");
+  r.Register<ForecastDamageQueryNode, Key, u32, Key>("ForecastDamageQueryNode");
+
+  // TimerNode
+  r.Register<TimerExpiredNode, Key>("TimerExpiredNode");
+  r.Register<TimerSetNode, Key, u32>("TimerSetNode");
+  r.Register<TimerSetNode, Key, Key>("TimerSetNode");
+
+  // WaypointNode
+  r.Register<WaypointNode, Key, Key, Key, float>("WaypointNode");
+
+  // These svs nodes are shared by other zones.
+  r.Register<svs::DynamicPlayerBoundingBoxQueryNode, Key>("svs::DynamicPlayerBoundingBoxQueryNode");
+  r.Register<svs::DynamicPlayerBoundingBoxQueryNode, Key, float>("svs::DynamicPlayerBoundingBoxQueryNode");
+  r.Register<svs::DynamicPlayerBoundingBoxQueryNode, Key, Key>("svs::DynamicPlayerBoundingBoxQueryNode");
+  r.Register<svs::DynamicPlayerBoundingBoxQueryNode, Key, Key, float>("svs::DynamicPlayerBoundingBoxQueryNode");
+  r.Register<svs::IncomingDamageQueryNode, float, Key>("svs::IncomingDamageQueryNode");
+  r.Register<svs::IncomingDamageQueryNode, Key, Key>("svs::IncomingDamageQueryNode");
+  r.Register<svs::IncomingDamageQueryNode, Key, Key, Key>("svs::IncomingDamageQueryNode");
+  r.Register<svs::IncomingDamageQueryNode, Key, float, float, Key>("svs::IncomingDamageQueryNode");
+}
+
+NodeRegistry& GetNodeRegistry() {
+  static NodeRegistry registry;
+  static bool registered = false;
+
+  if (!registered) {
+    RegisterSymbols(registry);
+    RegisterNodes(registry);
+    registered = true;
+  }
+
+  return registry;
+}
+
+}  // namespace behavior
+}  // namespace zero
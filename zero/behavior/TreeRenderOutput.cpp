@@ -0,0 +1,109 @@
+#include "TreeRenderOutput.h"
+
+#include <zero/RenderContext.h>
+
+namespace zero {
+namespace behavior {
+
+void TreeRenderOutput::PushLine(const Camera& camera, const Vector2f& start, const Vector3f& start_color,
+                                const Vector2f& end, const Vector3f& end_color) {
+  RenderableLine line(LineVertex(start, start_color), LineVertex(end, end_color));
+
+  if (IsUiCamera(camera)) {
+    ui_lines.push_back(line);
+  } else {
+    world_lines.push_back(line);
+  }
+}
+
+void TreeRenderOutput::PushLine(const Camera& camera, const LineSegment& line, const Vector3f& color) {
+  PushLine(camera, line.points[0], color, line.points[1], color);
+}
+
+void TreeRenderOutput::PushCross(const Camera& camera, const Vector2f& start, const Vector3f& color, float size) {
+  float radius = size * 0.5f;
+
+  Vector2f top_left = start;
+  Vector2f top_right(start.x + size, start.y);
+  Vector2f bottom_left(start.x, start.y + size);
+  Vector2f bottom_right(start.x + size, start.y + size);
+
+  Vector2f r(radius, radius);
+
+  PushLine(camera, top_left - r, color, bottom_right - r, color);
+  PushLine(camera, bottom_left - r, color, top_right - r, color);
+}
+
+void TreeRenderOutput::PushRect(const Camera& camera, const Vector2f& start, const Vector2f& end,
+                                const Vector3f& color) {
+  Vector2f top_left(start.x, start.y);
+  Vector2f top_right(end.x, start.y);
+  Vector2f bottom_left(start.x, end.y);
+  Vector2f bottom_right(end.x, end.y);
+
+  PushLine(camera, top_left, color, top_right, color);
+  PushLine(camera, top_left, color, bottom_left, color);
+
+  PushLine(camera, bottom_right, color, top_right, color);
+  PushLine(camera, bottom_right, color, bottom_left, color);
+}
+
+void TreeRenderOutput::PushRect(const Camera& camera, const Rectangle& rect, const Vector3f& color) {
+  PushRect(camera, rect.min, rect.max, color);
+}
+
+void TreeRenderOutput::PushText(const Camera& camera, const std::string& str, TextColor color,
+                                const Vector2f& position, Layer layer, TextAlignment alignment) {
+  texts.push_back({str, color, position, layer, alignment, IsUiCamera(camera)});
+}
+
+void TreeRenderOutput::Reset() {
+  world_lines.clear();
+  ui_lines.clear();
+  texts.clear();
+}
+
+void TreeRenderOutput::Render(RenderContext& rc, LineRenderer& line_renderer) {
+  if (rc.game_camera && !world_lines.empty()) {
+    for (const RenderableLine& line : world_lines) {
+      line_renderer.PushLine(line.vertices[0].position, line.vertices[0].color, line.vertices[1].position,
+                             line.vertices[1].color);
+    }
+
+    line_renderer.Render(*rc.game_camera);
+  }
+
+  if (rc.ui_camera && !ui_lines.empty()) {
+    for (const RenderableLine& line : ui_lines) {
+      line_renderer.PushLine(line.vertices[0].position, line.vertices[0].color, line.vertices[1].position,
+                             line.vertices[1].color);
+    }
+
+    line_renderer.Render(*rc.ui_camera);
+  }
+
+  if (!rc.renderer || texts.empty()) return;
+
+  // The sprite renderer flushes everything that was pushed with the camera that it renders with, so each camera's text
+  // is pushed and rendered separately.
+  for (int ui = 0; ui < 2; ++ui) {
+    Camera* camera = ui ? rc.ui_camera : rc.game_camera;
+    if (!camera) continue;
+
+    bool pushed = false;
+
+    for (const Text& text : texts) {
+      if (text.ui != (ui != 0)) continue;
+
+      rc.renderer->PushText(*camera, text.str.data(), text.color, text.position, text.layer, text.alignment);
+      pushed = true;
+    }
+
+    if (pushed) {
+      rc.renderer->Render(*camera);
+    }
+  }
+}
+
+}  // namespace behavior
+}  // namespace zero
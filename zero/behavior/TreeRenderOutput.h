@@ -0,0 +1,53 @@
+#pragma once
+
+#include <zero/Math.h>
+#include <zero/game/Camera.h>
+#include <zero/game/render/Layer.h>
+#include <zero/game/render/LineRenderer.h>
+#include <zero/game/render/SpriteRenderer.h>
+
+#include <string>
+#include <vector>
+
+namespace zero {
+
+struct RenderContext;
+
+namespace behavior {
+
+// Draws made by the behavior tree while it executes. The tree doesn't execute on every frame, so the draws are kept
+// until the next execution and rendered on every frame in between, the same way that the tree printer output is.
+// Draws are rendered with the cameras of the frame that they are rendered on, so world draws follow the game camera.
+struct TreeRenderOutput {
+  struct Text {
+    std::string str;
+    TextColor color;
+    Vector2f position;
+    Layer layer;
+    TextAlignment alignment;
+    bool ui;
+  };
+
+  std::vector<RenderableLine> world_lines;
+  std::vector<RenderableLine> ui_lines;
+  std::vector<Text> texts;
+
+  void PushLine(const Camera& camera, const Vector2f& start, const Vector3f& start_color, const Vector2f& end,
+                const Vector3f& end_color);
+  void PushLine(const Camera& camera, const LineSegment& line, const Vector3f& color);
+  void PushCross(const Camera& camera, const Vector2f& start, const Vector3f& color, float size = 1.0f);
+  void PushRect(const Camera& camera, const Vector2f& start, const Vector2f& end, const Vector3f& color);
+  void PushRect(const Camera& camera, const Rectangle& rect, const Vector3f& color);
+  void PushText(const Camera& camera, const std::string& str, TextColor color, const Vector2f& position, Layer layer,
+                TextAlignment alignment = TextAlignment::Left);
+
+  void Reset();
+  void Render(RenderContext& rc, LineRenderer& line_renderer);
+
+ private:
+  // The world camera is scaled down to tiles, so only the ui camera draws at one unit per pixel.
+  inline static bool IsUiCamera(const Camera& camera) { return camera.scale >= 1.0f; }
+};
+
+}  // namespace behavior
+}  // namespace zero
@@ -1,10 +1,13 @@
 #pragma once
 
+#include <zero/AimSolver.h>
+#include <zero/BotController.h>
 #include <zero/ZeroBot.h>
 #include <zero/behavior/BehaviorTree.h>
 #include <zero/game/Game.h>
 
 #include <optional>
+#include <vector>
 
 namespace zero {
 namespace behavior {
@@ -88,8 +91,8 @@ struct BulletDistanceNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* player_key = nullptr;
-  const char* output_key = nullptr;
+  BlackboardKey player_key;
+  BlackboardKey output_key;
 };
 
 struct ShotVelocityQueryNode : public BehaviorNode {
@@ -121,8 +124,8 @@ struct ShotVelocityQueryNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* player_key = nullptr;
-  const char* velocity_key = nullptr;
+  BlackboardKey player_key;
+  BlackboardKey velocity_key;
   WeaponType weapon_type;
 };
 
@@ -162,6 +165,17 @@ struct AimNode : public BehaviorNode {
     if (calculated_shot.has_value()) {
       aimshot = *calculated_shot;
 
+      // The shot assumes the target moves in a straight line, so shift it by however much the walls change where the
+      // target will be when the shot arrives.
+      float speed = weapon_velocity.Length();
+
+      if (speed > 0.0f) {
+        float t = aimshot.Distance(self->position) / speed;
+        Vector2f linear = target->position + target->velocity * t;
+
+        aimshot += ctx.bot->game->player_manager.PredictPosition(*target, t) - linear;
+      }
+
       constexpr float kFarDistance = 50.0f;
 
       // Set the aimshot directly to the player position if it is too far away.
@@ -181,8 +195,139 @@ struct AimNode : public BehaviorNode {
   }
 
   WeaponType weapon_type;
-  const char* target_player_key;
-  const char* position_key;
+  BlackboardKey target_player_key;
+  BlackboardKey position_key;
+};
+
+// Searches direct and bounce shots at the nearest visible enemies with several weapons at once and outputs the shot most
+// likely to hit.
+// The chosen enemy is set to target_player_key and the position to face when firing is set to position_key. The weapon
+// that the shot is for is set to weapon_type_key when there is one. Without a list of weapon types, every weapon that
+// the ship can currently aim is searched.
+struct BestShotQueryNode : public BehaviorNode {
+  BestShotQueryNode(WeaponType weapon_type, const char* target_player_key, const char* position_key,
+                    float min_probability = 0.0f)
+      : weapon_types({weapon_type}),
+        target_player_key(target_player_key),
+        position_key(position_key),
+        min_probability(min_probability) {}
+  BestShotQueryNode(const std::vector<WeaponType>& weapon_types, const char* target_player_key,
+                    const char* position_key, const char* weapon_type_key, float min_probability = 0.0f)
+      : weapon_types(weapon_types),
+        target_player_key(target_player_key),
+        position_key(position_key),
+        weapon_type_key(weapon_type_key),
+        min_probability(min_probability) {}
+  BestShotQueryNode(const char* target_player_key, const char* position_key, const char* weapon_type_key,
+                    float min_probability = 0.0f)
+      : target_player_key(target_player_key),
+        position_key(position_key),
+        weapon_type_key(weapon_type_key),
+        min_probability(min_probability) {}
+
+  ExecuteResult Execute(ExecuteContext& ctx) override {
+    auto self = ctx.bot->game->player_manager.GetSelf();
+    if (!self || self->ship >= 8) return ExecuteResult::Failure;
+
+    WeaponType available[kMaxAimWeapons];
+    const WeaponType* types = weapon_types.data();
+    size_t type_count = weapon_types.size();
+
+    if (weapon_types.empty()) {
+      types = available;
+      type_count = GetAvailableWeapons(ctx, available);
+    }
+
+    AimWeapon weapons[kMaxAimWeapons];
+    size_t weapon_count = 0;
+
+    for (size_t i = 0; i < type_count && weapon_count < kMaxAimWeapons; ++i) {
+      AimWeapon weapon = GetAimWeapon(*ctx.bot->game, *self, types[i]);
+
+      // Weapons like decoys don't travel on their own, so they can't be aimed.
+      if (weapon.speed <= 0.0f) continue;
+
+      weapons[weapon_count++] = weapon;
+    }
+
+    if (weapon_count == 0) return ExecuteResult::Failure;
+
+    TargetTable& table = ctx.bot->bot_controller->GetTargetTable();
+
+    constexpr TargetFlags kRequired = TargetFlag_Synchronized | TargetFlag_Visible;
+
+    Player* targets[kMaxAimTargets];
+    float distances[kMaxAimTargets];
+    size_t target_count = 0;
+
+    // Keep the nearest targets sorted by distance.
+    for (size_t i = 0; i < table.count; ++i) {
+      if ((table.flags[i] & kRequired) != kRequired) continue;
+      if (table.flags[i] & TargetFlag_Safe) continue;
+
+      float distance = table.distance[i];
+      if (target_count == kMaxAimTargets && distance >= distances[kMaxAimTargets - 1]) continue;
+
+      size_t insert = target_count < kMaxAimTargets ? target_count++ : kMaxAimTargets - 1;
+
+      while (insert > 0 && distances[insert - 1] > distance) {
+        targets[insert] = targets[insert - 1];
+        distances[insert] = distances[insert - 1];
+        --insert;
+      }
+
+      targets[insert] = table.players[i];
+      distances[insert] = distance;
+    }
+
+    if (target_count == 0) return ExecuteResult::Failure;
+
+    AimShot shot;
+    AimSolver& solver = ctx.bot->bot_controller->aim_solver;
+
+    // Every weapon is solved in the same pass so the shots of all of them are compared together.
+    if (!solver.Solve(*ctx.bot->game, *self, targets, target_count, weapons, weapon_count, kMaxAimBounces, &shot)) {
+      return ExecuteResult::Failure;
+    }
+
+    if (shot.hit_probability < min_probability) return ExecuteResult::Failure;
+
+    ctx.blackboard.Set(target_player_key, shot.target);
+    ctx.blackboard.Set(position_key, shot.aim_position);
+
+    if (weapon_type_key) {
+      ctx.blackboard.Set(weapon_type_key, shot.weapon_type);
+    }
+
+    return ExecuteResult::Success;
+  }
+
+  // Bullets and bombs are fired as their bouncing and proximity versions when the ship has them.
+  size_t GetAvailableWeapons(ExecuteContext& ctx, WeaponType* types) {
+    auto& ship = ctx.bot->game->ship_controller.ship;
+    size_t count = 0;
+
+    if (ship.guns > 0) {
+      types[count++] = (ship.capability & ShipCapability_BouncingBullets) ? WeaponType::BouncingBullet
+                                                                          : WeaponType::Bullet;
+    }
+
+    if (ship.bombs > 0) {
+      types[count++] = (ship.capability & ShipCapability_Proximity) ? WeaponType::ProximityBomb : WeaponType::Bomb;
+    }
+
+    if (ship.thors > 0) {
+      types[count++] = WeaponType::Thor;
+    }
+
+    return count;
+  }
+
+  std::vector<WeaponType> weapon_types;
+  BlackboardKey target_player_key;
+  BlackboardKey position_key;
+  BlackboardKey weapon_type_key;
+  float min_probability;
 };
 
 }  // namespace behavior
@@ -32,7 +32,7 @@ struct AttachedQueryNode : public BehaviorNode {
     return target->attach_parent == kInvalidPlayerId ? ExecuteResult::Failure : ExecuteResult::Success;
   }
 
-  const char* player_key = nullptr;
+  BlackboardKey player_key;
 };
 
 // Sends an attach request to a target player.
@@ -57,7 +57,7 @@ struct AttachNode : public BehaviorNode {
     return ExecuteResult::Failure;
   }
 
-  const char* target_player_key = nullptr;
+  BlackboardKey target_player_key;
 };
 
 struct DetachNode : public BehaviorNode {
@@ -111,8 +111,8 @@ struct TurretCountQueryNode : behavior::BehaviorNode {
     return behavior::ExecuteResult::Success;
   }
 
-  const char* player_key = nullptr;
-  const char* output_key = nullptr;
+  BlackboardKey player_key;
+  BlackboardKey output_key;
 };
 
 }  // namespace behavior
@@ -48,7 +48,7 @@ struct BehaviorSetFromKeyNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* key_name = nullptr;
+  BlackboardKey key_name;
   bool run_initializer = false;
 };
 
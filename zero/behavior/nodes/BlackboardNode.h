@@ -31,7 +31,7 @@ struct BlackboardSetQueryNode : public BehaviorNode {
     return has ? ExecuteResult::Success : ExecuteResult::Failure;
   }
 
-  const char* key;
+  BlackboardKey key;
 };
 
 struct BlackboardEraseNode : public BehaviorNode {
@@ -42,7 +42,7 @@ struct BlackboardEraseNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* key;
+  BlackboardKey key;
 };
 
 struct ReadConfigStringNode : public BehaviorNode {
@@ -62,7 +62,7 @@ struct ReadConfigStringNode : public BehaviorNode {
   }
 
   const char* config_key_name = nullptr;
-  const char* output_key = nullptr;
+  BlackboardKey output_key;
 };
 
 template <typename T>
@@ -83,7 +83,7 @@ struct ReadConfigIntNode : public BehaviorNode {
   }
 
   const char* config_key_name = nullptr;
-  const char* output_key = nullptr;
+  BlackboardKey output_key;
 };
 
 template <typename T>
@@ -99,7 +99,7 @@ struct ValueCompareQuery : public behavior::BehaviorNode {
     return current_value == compare_value ? behavior::ExecuteResult::Success : behavior::ExecuteResult::Failure;
   }
 
-  const char* key;
+  BlackboardKey key;
   T compare_value;
 };
 
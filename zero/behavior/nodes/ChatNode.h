@@ -139,9 +139,9 @@ struct ChatMessageNode : public BehaviorNode {
   std::string target_name;
   u16 frequency = 0;
 
-  const char* message_key = nullptr;
-  const char* freq_key = nullptr;
-  const char* target_name_key = nullptr;
+  BlackboardKey message_key;
+  BlackboardKey freq_key;
+  BlackboardKey target_name_key;
 
  private:
   ChatMessageNode() {}
@@ -28,8 +28,8 @@ struct FlagCarryCountQueryNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* player_key = nullptr;
-  const char* output_key = nullptr;
+  BlackboardKey player_key;
+  BlackboardKey output_key;
 };
 
 struct FlagPositionQueryNode : public BehaviorNode {
@@ -43,8 +43,8 @@ struct FlagPositionQueryNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* flag_key = nullptr;
-  const char* output_key = nullptr;
+  BlackboardKey flag_key;
+  BlackboardKey output_key;
 };
 
 struct ArenaFlagCountNode : public behavior::BehaviorNode {
@@ -55,7 +55,7 @@ struct ArenaFlagCountNode : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Success;
   }
 
-  const char* output_key = nullptr;
+  BlackboardKey output_key;
 };
 
 struct TeamFlagCountNode : public behavior::BehaviorNode {
@@ -86,8 +86,8 @@ struct TeamFlagCountNode : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Success;
   }
 
-  const char* player_key = nullptr;
-  const char* output_key = nullptr;
+  BlackboardKey player_key;
+  BlackboardKey output_key;
 };
 
 struct NearestFlagNode : public behavior::BehaviorNode {
@@ -130,7 +130,7 @@ struct NearestFlagNode : public behavior::BehaviorNode {
   }
 
   Type type = Type::Unclaimed;
-  const char* output_key;
+  BlackboardKey output_key;
 };
 
 }  // namespace behavior
@@ -3,18 +3,24 @@
 #include <zero/BotController.h>
 #include <zero/ZeroBot.h>
 #include <zero/behavior/BehaviorTree.h>
+#include <zero/behavior/nodes/QueryNode.h>
 #include <zero/game/Game.h>
 
 namespace zero {
 namespace behavior {
 
 // Determines whether or not the specified player can go directly to a position by using a CastShip query.
-struct ShipTraverseQueryNode : public BehaviorNode {
-  ShipTraverseQueryNode(const char* position_key) : position_key(position_key) {}
+struct ShipTraverseQueryNode : public QueryNode {
+  ShipTraverseQueryNode(const char* position_key) : ShipTraverseQueryNode(nullptr, position_key) {}
   ShipTraverseQueryNode(const char* player_key, const char* position_key)
-      : player_key(player_key), position_key(position_key) {}
+      : player_key(player_key), position_key(position_key) {
+    DependOnKey(player_key);
+    DependOnKey(position_key);
+    DependOnPlayer(player_key);
+    DependOnTiles();
+  }
 
-  ExecuteResult Execute(ExecuteContext& ctx) override {
+  ExecuteResult Query(ExecuteContext& ctx) override {
     Player* player = ctx.bot->game->player_manager.GetSelf();
 
     if (player_key) {
@@ -36,16 +42,22 @@ struct ShipTraverseQueryNode : public BehaviorNode {
     return hit ? ExecuteResult::Failure : ExecuteResult::Success;
   }
 
-  const char* position_key = nullptr;
-  const char* player_key = nullptr;
+  BlackboardKey position_key;
+  BlackboardKey player_key;
 };
 
-struct VisibilityQueryNode : public BehaviorNode {
-  VisibilityQueryNode(const char* position_key) : position_a_key(position_key), position_b_key(nullptr) {}
+struct VisibilityQueryNode : public QueryNode {
+  VisibilityQueryNode(const char* position_key) : VisibilityQueryNode(position_key, nullptr) {}
   VisibilityQueryNode(const char* position_a_key, const char* position_b_key)
-      : position_a_key(position_a_key), position_b_key(position_b_key) {}
+      : position_a_key(position_a_key), position_b_key(position_b_key) {
+    DependOnKey(position_a_key);
+    DependOnKey(position_b_key);
+    // The self position is only read without a second key, but the frequency is always used.
+    DependOnPlayer();
+    DependOnTiles();
+  }
 
-  ExecuteResult Execute(ExecuteContext& ctx) override {
+  ExecuteResult Query(ExecuteContext& ctx) override {
     auto self = ctx.bot->game->player_manager.GetSelf();
 
     if (!self) return ExecuteResult::Failure;
@@ -55,30 +67,33 @@ struct VisibilityQueryNode : public BehaviorNode {
 
     Vector2f& position_a = opt_position_a.value();
 
-    if (position_b_key != nullptr) {
+    if (position_b_key) {
       auto opt_position_b = ctx.blackboard.Value<Vector2f>(position_b_key);
       if (!opt_position_b.has_value()) return ExecuteResult::Failure;
 
       Vector2f& position_b = opt_position_b.value();
 
-      bool hit = ctx.bot->game->GetMap().CastTo(position_a, position_b, self->frequency).hit;
+      bool visible = ctx.bot->game->GetMap().HasLineOfSight(position_a, position_b, self->frequency);
 
-      return hit ? ExecuteResult::Failure : ExecuteResult::Success;
+      return visible ? ExecuteResult::Success : ExecuteResult::Failure;
     }
 
-    bool hit = ctx.bot->game->GetMap().CastTo(self->position, position_a, self->frequency).hit;
+    bool visible = ctx.bot->game->GetMap().HasLineOfSight(self->position, position_a, self->frequency);
 
-    return hit ? ExecuteResult::Failure : ExecuteResult::Success;
+    return visible ? ExecuteResult::Success : ExecuteResult::Failure;
   }
 
-  const char* position_a_key;
-  const char* position_b_key;
+  BlackboardKey position_a_key;
+  BlackboardKey position_b_key;
 };
 
-struct TileQueryNode : public BehaviorNode {
-  TileQueryNode(TileId id) : id(id) {}
+struct TileQueryNode : public QueryNode {
+  TileQueryNode(TileId id) : id(id) {
+    DependOnPlayer(nullptr, true);
+    DependOnTiles();
+  }
 
-  ExecuteResult Execute(ExecuteContext& ctx) override {
+  ExecuteResult Query(ExecuteContext& ctx) override {
     auto self = ctx.bot->game->player_manager.GetSelf();
     if (!self) return ExecuteResult::Failure;
 
@@ -131,20 +146,28 @@ struct DistanceThresholdNode : public BehaviorNode {
     return position_a.DistanceSq(position_b) >= threshold ? ExecuteResult::Success : ExecuteResult::Failure;
   }
 
-  const char* position_a_key = nullptr;
-  const char* position_b_key = nullptr;
-  const char* threshold_key = nullptr;
+  BlackboardKey position_a_key;
+  BlackboardKey position_b_key;
+  BlackboardKey threshold_key;
   float threshold_sq = 0.0f;
 };
 
 // Finds the closest tile and stores it in the provided key.
-struct ClosestTileQueryNode : public BehaviorNode {
+struct ClosestTileQueryNode : public QueryNode {
   ClosestTileQueryNode(const char* tile_vector_key, const char* closest_key)
-      : position_key(nullptr), tile_vector_key(tile_vector_key), closest_key(closest_key) {}
+      : ClosestTileQueryNode(nullptr, tile_vector_key, closest_key) {}
   ClosestTileQueryNode(const char* position_key, const char* tile_vector_key, const char* closest_key)
-      : position_key(position_key), tile_vector_key(tile_vector_key), closest_key(closest_key) {}
+      : position_key(position_key), tile_vector_key(tile_vector_key), closest_key(closest_key) {
+    DependOnKey(position_key);
+    DependOnKey(tile_vector_key);
+    DependOnKey(closest_key);
 
-  ExecuteResult Execute(ExecuteContext& ctx) override {
+    if (!position_key) {
+      DependOnPlayer();
+    }
+  }
+
+  ExecuteResult Query(ExecuteContext& ctx) override {
     Vector2f from_position;
 
     if (position_key) {
@@ -182,9 +205,9 @@ struct ClosestTileQueryNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* position_key;
-  const char* tile_vector_key;
-  const char* closest_key;
+  BlackboardKey position_key;
+  BlackboardKey tile_vector_key;
+  BlackboardKey closest_key;
 };
 
 }  // namespace behavior
@@ -33,8 +33,8 @@ struct EqualityNode : public BehaviorNode {
   }
 
   T a_value;
-  const char* a_key = nullptr;
-  const char* b_key = nullptr;
+  BlackboardKey a_key;
+  BlackboardKey b_key;
 };
 
 template <typename T>
@@ -65,8 +65,8 @@ struct GreaterThanNode : public BehaviorNode {
   }
 
   T a_value;
-  const char* a_key = nullptr;
-  const char* b_key = nullptr;
+  BlackboardKey a_key;
+  BlackboardKey b_key;
   bool flipped = false;
 };
 
@@ -98,8 +98,8 @@ struct GreaterOrEqualThanNode : public BehaviorNode {
   }
 
   T a_value;
-  const char* a_key = nullptr;
-  const char* b_key = nullptr;
+  BlackboardKey a_key;
+  BlackboardKey b_key;
   bool flipped = false;
 };
 
@@ -131,8 +131,8 @@ struct LessThanNode : public BehaviorNode {
   }
 
   T a_value;
-  const char* a_key = nullptr;
-  const char* b_key = nullptr;
+  BlackboardKey a_key;
+  BlackboardKey b_key;
   bool flipped = false;
 };
 
@@ -164,8 +164,8 @@ struct LessOrEqualThanNode : public BehaviorNode {
   }
 
   T a_value;
-  const char* a_key = nullptr;
-  const char* b_key = nullptr;
+  BlackboardKey a_key;
+  BlackboardKey b_key;
   bool flipped = false;
 };
 
@@ -211,9 +211,9 @@ struct RandomIntNode : public BehaviorNode {
   T min = {};
   T max = {};
 
-  const char* min_key = nullptr;
-  const char* max_key = nullptr;
-  const char* output_key = nullptr;
+  BlackboardKey min_key;
+  BlackboardKey max_key;
+  BlackboardKey output_key;
 };
 
 struct RandomNode : public BehaviorNode {
@@ -257,9 +257,9 @@ struct RandomNode : public BehaviorNode {
   float min = {};
   float max = {};
 
-  const char* min_key = nullptr;
-  const char* max_key = nullptr;
-  const char* output_key = nullptr;
+  BlackboardKey min_key;
+  BlackboardKey max_key;
+  BlackboardKey output_key;
 };
 
 struct ScalarNode : public BehaviorNode {
@@ -281,8 +281,8 @@ struct ScalarNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* existing_key;
-  const char* output_key;
+  BlackboardKey existing_key;
+  BlackboardKey output_key;
   float value = 0.0f;
 };
 
@@ -307,8 +307,8 @@ struct VectorNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* existing_vector_key;
-  const char* output_key;
+  BlackboardKey existing_vector_key;
+  BlackboardKey output_key;
   Vector2f vector;
 };
 
@@ -355,9 +355,9 @@ struct PerpendicularNode : public BehaviorNode {
 
   bool normalize = false;
 
-  const char* position_key1 = nullptr;
-  const char* position_key2 = nullptr;
-  const char* output_key = nullptr;
+  BlackboardKey position_key1;
+  BlackboardKey position_key2;
+  BlackboardKey output_key;
 };
 
 struct MoveRectangleNode : public BehaviorNode {
@@ -392,9 +392,9 @@ struct MoveRectangleNode : public BehaviorNode {
   }
 
   Vector2f new_position;
-  const char* rectangle_key;
-  const char* output_key;
-  const char* position_key = nullptr;
+  BlackboardKey rectangle_key;
+  BlackboardKey output_key;
+  BlackboardKey position_key;
 };
 
 struct RectangleNode : public BehaviorNode {
@@ -433,9 +433,9 @@ struct RectangleNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* center_position_key;
-  const char* half_extent_vector_key;
-  const char* output_key;
+  BlackboardKey center_position_key;
+  BlackboardKey half_extent_vector_key;
+  BlackboardKey output_key;
 
   Vector2f half_extent;
 };
@@ -469,10 +469,10 @@ struct RectangleContainsNode : public BehaviorNode {
     return check_rect.Contains(check_position) ? ExecuteResult::Success : ExecuteResult::Failure;
   }
 
-  const char* position_key = nullptr;
+  BlackboardKey position_key;
   Vector2f position;
 
-  const char* rect_key = nullptr;
+  BlackboardKey rect_key;
   Rectangle rect;
 };
 
@@ -499,9 +499,9 @@ struct RayNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* origin_key;
-  const char* direction_key;
-  const char* output_key;
+  BlackboardKey origin_key;
+  BlackboardKey direction_key;
+  BlackboardKey output_key;
 };
 
 struct RayRectangleInterceptNode : public BehaviorNode {
@@ -522,8 +522,8 @@ struct RayRectangleInterceptNode : public BehaviorNode {
     return intersects ? ExecuteResult::Success : ExecuteResult::Failure;
   }
 
-  const char* ray_key;
-  const char* rect_key;
+  BlackboardKey ray_key;
+  BlackboardKey rect_key;
 };
 
 template <typename T>
@@ -549,8 +549,8 @@ struct ScalarThresholdNode : public BehaviorNode {
     return scalar >= threshold ? ExecuteResult::Success : ExecuteResult::Failure;
   }
 
-  const char* scalar_key = nullptr;
-  const char* threshold_key = nullptr;
+  BlackboardKey scalar_key;
+  BlackboardKey threshold_key;
   T threshold = {};
 };
 
@@ -580,9 +580,9 @@ struct VectorDotNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* vector_a_key;
-  const char* vector_b_key;
-  const char* output_key;
+  BlackboardKey vector_a_key;
+  BlackboardKey vector_b_key;
+  BlackboardKey output_key;
   bool normalize;
 };
 
@@ -612,9 +612,9 @@ struct VectorAddNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* vector_a_key;
-  const char* vector_b_key;
-  const char* output_key;
+  BlackboardKey vector_a_key;
+  BlackboardKey vector_b_key;
+  BlackboardKey output_key;
   bool normalize;
 };
 
@@ -644,9 +644,9 @@ struct VectorSubtractNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* vector_a_key;
-  const char* vector_b_key;
-  const char* output_key;
+  BlackboardKey vector_a_key;
+  BlackboardKey vector_b_key;
+  BlackboardKey output_key;
   bool normalize;
 };
 
@@ -665,8 +665,8 @@ struct NormalizeNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* input_vector_key;
-  const char* output_vector_key;
+  BlackboardKey input_vector_key;
+  BlackboardKey output_vector_key;
 };
 
 struct DistanceNode : public BehaviorNode {
@@ -699,10 +699,10 @@ struct DistanceNode : public BehaviorNode {
 
   Vector2f vector_a_static;
 
-  const char* vector_a_key = nullptr;
-  const char* vector_b_key = nullptr;
+  BlackboardKey vector_a_key;
+  BlackboardKey vector_b_key;
 
-  const char* output_float_key = nullptr;
+  BlackboardKey output_float_key;
   bool squared = false;
 };
 
@@ -41,9 +41,9 @@ struct PursueNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* position_key = nullptr;
-  const char* target_distance_key = nullptr;
-  const char* target_player_key = nullptr;
+  BlackboardKey position_key;
+  BlackboardKey target_distance_key;
+  BlackboardKey target_player_key;
 };
 
 struct SeekNode : public BehaviorNode {
@@ -93,8 +93,8 @@ struct SeekNode : public BehaviorNode {
 
   DistanceResolveType distance_type = DistanceResolveType::Zero;
   float target_distance = 0.0f;
-  const char* position_key = nullptr;
-  const char* target_distance_key = nullptr;
+  BlackboardKey position_key;
+  BlackboardKey target_distance_key;
 };
 
 struct SeekZeroNode : public BehaviorNode {
@@ -118,7 +118,7 @@ struct ArriveNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* position_key;
+  BlackboardKey position_key;
   float deceleration;
 };
 
@@ -138,7 +138,7 @@ struct AvoidTeamNode : public BehaviorNode {
   }
 
   float dist = 0.0f;
-  const char* dist_key = nullptr;
+  BlackboardKey dist_key;
 };
 
 struct AvoidEnemyNode : public BehaviorNode {
@@ -157,7 +157,7 @@ struct AvoidEnemyNode : public BehaviorNode {
   }
 
   float dist = 0.0f;
-  const char* dist_key = nullptr;
+  BlackboardKey dist_key;
 };
 
 struct AvoidWallsNode : public BehaviorNode {
@@ -188,7 +188,7 @@ struct RotationThresholdSetNode : public BehaviorNode {
   }
 
   float threshold = 0.0f;
-  const char* threshold_key = nullptr;
+  BlackboardKey threshold_key;
 };
 
 struct FaceNode : public BehaviorNode {
@@ -205,7 +205,7 @@ struct FaceNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* position_key;
+  BlackboardKey position_key;
 };
 
 // Follows the 'current_path' from the bot controller without rebuilding.
@@ -440,7 +440,7 @@ struct GoToNode : public BehaviorNode {
   FollowPathNode follow_node;
 
   Vector2f position;
-  const char* position_key;
+  BlackboardKey position_key;
 };
 
 struct PathDistanceQueryNode : public BehaviorNode {
@@ -476,8 +476,8 @@ struct PathDistanceQueryNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* path_key = nullptr;
-  const char* output_key = nullptr;
+  BlackboardKey path_key;
+  BlackboardKey output_key;
 };
 
 }  // namespace behavior
@@ -3,6 +3,7 @@
 #include <zero/BotController.h>
 #include <zero/ZeroBot.h>
 #include <zero/behavior/BehaviorTree.h>
+#include <zero/behavior/nodes/QueryNode.h>
 #include <zero/game/Game.h>
 
 namespace zero {
@@ -20,7 +21,7 @@ struct PlayerSelfNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* output_key = nullptr;
+  BlackboardKey output_key;
 };
 
 struct PlayerEnergyQueryNode : public BehaviorNode {
@@ -46,8 +47,8 @@ struct PlayerEnergyQueryNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* player_key = nullptr;
-  const char* output_key = nullptr;
+  BlackboardKey player_key;
+  BlackboardKey output_key;
 };
 
 struct PlayerNearPositionNode : public behavior::BehaviorNode {
@@ -86,8 +87,8 @@ struct PlayerNearPositionNode : public behavior::BehaviorNode {
     return near ? behavior::ExecuteResult::Success : behavior::ExecuteResult::Failure;
   }
 
-  const char* player_key = nullptr;
-  const char* position_key = nullptr;
+  BlackboardKey player_key;
+  BlackboardKey position_key;
 
   float near_distance_sq = 0.0f;
   Vector2f position;
@@ -114,8 +115,8 @@ struct PlayerFrequencyQueryNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* player_key = nullptr;
-  const char* output_key = nullptr;
+  BlackboardKey player_key;
+  BlackboardKey output_key;
 };
 
 struct PlayerChangeFrequencyNode : public behavior::BehaviorNode {
@@ -142,7 +143,7 @@ struct PlayerChangeFrequencyNode : public behavior::BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* frequency_key;
+  BlackboardKey frequency_key;
   u16 frequency;
 };
 
@@ -154,7 +155,7 @@ struct PlayerFrequencyCountQueryNode : public behavior::BehaviorNode {
   behavior::ExecuteResult Execute(behavior::ExecuteContext& ctx) override {
     Player* player = ctx.bot->game->player_manager.GetSelf();
 
-    if (player_key != nullptr) {
+    if (player_key) {
       auto player_opt = ctx.blackboard.Value<Player*>(player_key);
       if (!player_opt.has_value()) return behavior::ExecuteResult::Failure;
 
@@ -168,7 +169,7 @@ struct PlayerFrequencyCountQueryNode : public behavior::BehaviorNode {
     u16 freq = player->frequency;
 
     for (size_t i = 0; i < player_man.player_count; ++i) {
-      if (freq == player_man.players[i].frequency) {
+      if (freq == player_man.hot.frequency[i]) {
         ++count;
       }
     }
@@ -178,8 +179,8 @@ struct PlayerFrequencyCountQueryNode : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Success;
   }
 
-  const char* player_key;
-  const char* output_key;
+  BlackboardKey player_key;
+  BlackboardKey output_key;
 };
 
 struct PlayerBoundingBoxQueryNode : public behavior::BehaviorNode {
@@ -191,7 +192,7 @@ struct PlayerBoundingBoxQueryNode : public behavior::BehaviorNode {
   behavior::ExecuteResult Execute(behavior::ExecuteContext& ctx) override {
     Player* player = ctx.bot->game->player_manager.GetSelf();
 
-    if (player_key != nullptr) {
+    if (player_key) {
       auto player_opt = ctx.blackboard.Value<Player*>(player_key);
       if (!player_opt.has_value()) return behavior::ExecuteResult::Failure;
 
@@ -213,8 +214,8 @@ struct PlayerBoundingBoxQueryNode : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Success;
   }
 
-  const char* player_key;
-  const char* output_key;
+  BlackboardKey player_key;
+  BlackboardKey output_key;
   float radius_multiplier;
 };
 
@@ -225,7 +226,7 @@ struct PlayerStatusQueryNode : public behavior::BehaviorNode {
   behavior::ExecuteResult Execute(behavior::ExecuteContext& ctx) override {
     Player* player = ctx.bot->game->player_manager.GetSelf();
 
-    if (player_key != nullptr) {
+    if (player_key) {
       auto player_opt = ctx.blackboard.Value<Player*>(player_key);
       if (!player_opt.has_value()) return behavior::ExecuteResult::Failure;
 
@@ -241,7 +242,7 @@ struct PlayerStatusQueryNode : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Failure;
   }
 
-  const char* player_key;
+  BlackboardKey player_key;
   StatusFlag status;
 };
 
@@ -267,7 +268,7 @@ struct PlayerEnergyPercentThresholdNode : public behavior::BehaviorNode {
     return percent >= threshold ? behavior::ExecuteResult::Success : behavior::ExecuteResult::Failure;
   }
 
-  const char* player_key;
+  BlackboardKey player_key;
   float threshold;
 };
 
@@ -284,15 +285,19 @@ struct PlayerCurrentEnergyQueryNode : public behavior::BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* output_key = nullptr;
+  BlackboardKey output_key;
 };
 
-struct PlayerPositionQueryNode : public behavior::BehaviorNode {
-  PlayerPositionQueryNode(const char* position_key) : player_key(nullptr), position_key(position_key) {}
+struct PlayerPositionQueryNode : public behavior::QueryNode {
+  PlayerPositionQueryNode(const char* position_key) : PlayerPositionQueryNode(nullptr, position_key) {}
   PlayerPositionQueryNode(const char* player_key, const char* position_key)
-      : player_key(player_key), position_key(position_key) {}
+      : player_key(player_key), position_key(position_key) {
+    DependOnKey(player_key);
+    DependOnKey(position_key);
+    DependOnPlayer(player_key);
+  }
 
-  behavior::ExecuteResult Execute(behavior::ExecuteContext& ctx) override {
+  behavior::ExecuteResult Query(behavior::ExecuteContext& ctx) override {
     Player* player = ctx.bot->game->player_manager.GetSelf();
 
     if (player_key) {
@@ -309,8 +314,8 @@ struct PlayerPositionQueryNode : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Success;
   }
 
-  const char* player_key;
-  const char* position_key;
+  BlackboardKey player_key;
+  BlackboardKey position_key;
 };
 
 struct PlayerHeadingQueryNode : public behavior::BehaviorNode {
@@ -335,8 +340,8 @@ struct PlayerHeadingQueryNode : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Success;
   }
 
-  const char* player_key;
-  const char* output_key;
+  BlackboardKey player_key;
+  BlackboardKey output_key;
 };
 
 struct PlayerVelocityQueryNode : public behavior::BehaviorNode {
@@ -368,8 +373,8 @@ struct PlayerVelocityQueryNode : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Success;
   }
 
-  const char* player_key;
-  const char* output_key;
+  BlackboardKey player_key;
+  BlackboardKey output_key;
   bool normalize = false;
 };
 
@@ -119,8 +119,8 @@ struct PowerballGoalPathQuery : public BehaviorNode {
     return nullptr;
   }
 
-  const char* output_position_key = nullptr;
-  const char* output_scored_key = nullptr;
+  BlackboardKey output_position_key;
+  BlackboardKey output_scored_key;
   bool reverse = false;
 };
 
@@ -150,7 +150,7 @@ struct PowerballRemainingTimeQueryNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* output_key = nullptr;
+  BlackboardKey output_key;
 };
 
 struct PowerballCarryQueryNode : public BehaviorNode {
@@ -172,7 +172,7 @@ struct PowerballCarryQueryNode : public BehaviorNode {
     return player->ball_carrier ? ExecuteResult::Success : ExecuteResult::Failure;
   }
 
-  const char* player_key = nullptr;
+  BlackboardKey player_key;
 };
 
 struct PowerballClosestQueryNode : public BehaviorNode {
@@ -231,8 +231,8 @@ struct PowerballClosestQueryNode : public BehaviorNode {
     return ball_exists;
   }
 
-  const char* player_key = nullptr;
-  const char* output_position_key = nullptr;
+  BlackboardKey player_key;
+  BlackboardKey output_position_key;
 };
 
 }  // namespace behavior
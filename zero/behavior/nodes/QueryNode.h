@@ -0,0 +1,147 @@
+#pragma once
+
+#include <zero/BotController.h>
+#include <zero/ZeroBot.h>
+#include <zero/behavior/BehaviorTree.h>
+#include <zero/game/Clock.h>
+#include <zero/game/Game.h>
+
+#include <cassert>
+
+namespace zero {
+namespace behavior {
+
+// Base for query nodes whose result only depends on a known set of inputs. The query is only run again once one of the
+// declared dependencies changes, otherwise the last result is returned and the outputs that it set are left in place.
+// Every key that the query reads or writes must be declared. Writing to an output key from anywhere else drops the
+// cache since its version changes.
+// Only the one player that the query reads is tracked, so other players moving doesn't drop the cache.
+struct QueryNode : public BehaviorNode {
+  static constexpr size_t kMaxQueryKeys = 8;
+
+  ExecuteResult Execute(ExecuteContext& ctx) final {
+    if (cached && IsCacheValid(ctx)) {
+      return cached_result;
+    }
+
+    cached_result = Query(ctx);
+    cached = !uncacheable;
+
+    for (size_t i = 0; i < key_count; ++i) {
+      key_versions[i] = ctx.blackboard.GetVersion(keys[i]);
+    }
+
+    if (depend_player) {
+      player_snapshot = GetPlayerSnapshot(ctx);
+    }
+
+    tile_epoch = ctx.bot->game->GetMap().tile_epoch;
+    region_epoch = ctx.bot->bot_controller->region_epoch;
+    query_tick = GetCurrentTick();
+
+    return cached_result;
+  }
+
+  virtual ExecuteResult Query(ExecuteContext& ctx) = 0;
+
+ protected:
+  // These should be called from the constructor of the query.
+  inline void DependOnKey(BlackboardKey key) {
+    if (!key) return;
+
+    assert(key_count < kMaxQueryKeys);
+
+    // A missing key would keep stale results, so run the query every time instead.
+    if (key_count >= kMaxQueryKeys) {
+      uncacheable = true;
+      return;
+    }
+
+    keys[key_count++] = key;
+  }
+
+  // The query reads the position, ship, or frequency of the player stored in player_key, or of self without a key.
+  // The key must also be declared with DependOnKey.
+  // With tile_precision, moving within the same tile keeps the cache since the query only reads the tile coordinate.
+  inline void DependOnPlayer(BlackboardKey player_key = nullptr, bool tile_precision = false) {
+    depend_player = true;
+    this->player_key = player_key;
+    this->tile_precision = tile_precision;
+  }
+  // The query reads tiles that can change from doors or bricks.
+  inline void DependOnTiles() { depend_tiles = true; }
+  // The query reads the region registry.
+  inline void DependOnRegions() { depend_regions = true; }
+  // The query reads state that has no version, so it is run again after this many ticks.
+  inline void DependOnInterval(u32 ticks) { tick_interval = ticks; }
+
+ private:
+  bool IsCacheValid(ExecuteContext& ctx) const {
+    for (size_t i = 0; i < key_count; ++i) {
+      if (ctx.blackboard.GetVersion(keys[i]) != key_versions[i]) return false;
+    }
+
+    if (depend_player && GetPlayerSnapshot(ctx) != player_snapshot) return false;
+    if (depend_tiles && ctx.bot->game->GetMap().tile_epoch != tile_epoch) return false;
+    if (depend_regions && ctx.bot->bot_controller->region_epoch != region_epoch) return false;
+    if (tick_interval > 0 && TICK_DIFF(GetCurrentTick(), query_tick) >= (s32)tick_interval) return false;
+
+    return true;
+  }
+
+  struct PlayerSnapshot {
+    u16 id = kInvalidPlayerId;
+    u8 ship = 8;
+    u16 frequency = 0;
+    Vector2f position;
+
+    bool operator!=(const PlayerSnapshot& other) const {
+      return id != other.id || ship != other.ship || frequency != other.frequency || position != other.position;
+    }
+  };
+
+  PlayerSnapshot GetPlayerSnapshot(ExecuteContext& ctx) const {
+    PlayerSnapshot snapshot;
+    Player* player = ctx.bot->game->player_manager.GetSelf();
+
+    if (player_key) {
+      auto opt_player = ctx.blackboard.Value<Player*>(player_key);
+      player = opt_player ? *opt_player : nullptr;
+    }
+
+    if (!player) return snapshot;
+
+    snapshot.id = player->id;
+    snapshot.ship = player->ship;
+    snapshot.frequency = player->frequency;
+    snapshot.position = player->position;
+
+    if (tile_precision) {
+      snapshot.position = Vector2f(floorf(player->position.x), floorf(player->position.y));
+    }
+
+    return snapshot;
+  }
+
+  BlackboardKey keys[kMaxQueryKeys];
+  u32 key_versions[kMaxQueryKeys];
+  size_t key_count = 0;
+  bool uncacheable = false;
+
+  bool depend_player = false;
+  bool tile_precision = false;
+  BlackboardKey player_key;
+  PlayerSnapshot player_snapshot;
+  bool depend_tiles = false;
+  bool depend_regions = false;
+  u32 tick_interval = 0;
+
+  bool cached = false;
+  ExecuteResult cached_result = ExecuteResult::Failure;
+  u32 tile_epoch = 0;
+  u32 region_epoch = 0;
+  u32 query_tick = 0;
+};
+
+}  // namespace behavior
+}  // namespace zero
@@ -3,16 +3,24 @@
 #include <zero/BotController.h>
 #include <zero/ZeroBot.h>
 #include <zero/behavior/BehaviorTree.h>
+#include <zero/behavior/nodes/QueryNode.h>
 #include <zero/game/Game.h>
 
 namespace zero {
 namespace behavior {
 
-struct RegionContainQueryNode : public BehaviorNode {
-  RegionContainQueryNode(Vector2f position) : coord(position) {}
-  RegionContainQueryNode(const char* position_key) : position_key(position_key) {}
+struct RegionContainQueryNode : public QueryNode {
+  RegionContainQueryNode(Vector2f position) : coord(position) {
+    DependOnPlayer(nullptr, true);
+    DependOnRegions();
+  }
+  RegionContainQueryNode(const char* position_key) : position_key(position_key) {
+    DependOnKey(position_key);
+    DependOnPlayer(nullptr, true);
+    DependOnRegions();
+  }
 
-  ExecuteResult Execute(ExecuteContext& ctx) override {
+  ExecuteResult Query(ExecuteContext& ctx) override {
     auto self = ctx.bot->game->player_manager.GetSelf();
     auto& registry = ctx.bot->bot_controller->region_registry;
 
@@ -41,7 +49,7 @@ struct RegionContainQueryNode : public BehaviorNode {
   }
 
   MapCoord coord;
-  const char* position_key = nullptr;
+  BlackboardKey position_key;
 };
 
 }  // namespace behavior
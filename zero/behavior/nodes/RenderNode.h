@@ -1,5 +1,6 @@
 #pragma once
 
+#include <zero/BotController.h>
 #include <zero/RenderContext.h>
 #include <zero/ZeroBot.h>
 #include <zero/behavior/BehaviorTree.h>
@@ -35,7 +36,6 @@ struct RenderPathNode : public BehaviorNode {
 
     static constexpr Vector3f kColors[] = {Vector3f(1, 0, 0), Vector3f(0, 1, 0), Vector3f(0, 0, 1)};
 
-    bool render = false;
     for (size_t i = path.index; i < path.points.size(); ++i) {
       Vector3f this_color = color;
 
@@ -44,20 +44,16 @@ struct RenderPathNode : public BehaviorNode {
         this_color = kColors[i % 3];
       }
 
-      ctx.bot->game->line_renderer.PushLine(prev_position, this_color, path.points[i], this_color);
+      ctx.bot->bot_controller->tree_render.PushLine(ctx.bot->game->camera, prev_position, this_color, path.points[i],
+                                                    this_color);
       prev_position = path.points[i];
-      render = true;
-    }
-
-    if (render) {
-      ctx.bot->game->line_renderer.Render(ctx.bot->game->camera);
     }
 
     return ExecuteResult::Success;
   }
 
   Vector3f color;
-  const char* path_key = nullptr;
+  BlackboardKey path_key;
 };
 
 struct RenderTextNode : public BehaviorNode {
@@ -92,15 +88,14 @@ struct RenderTextNode : public BehaviorNode {
     }
 
     Request request = formatter(ctx);
-    ctx.bot->game->sprite_renderer.PushText(*opt_camera, request.str.data(), request.color, position, request.layer,
-                                            request.alignment);
-    ctx.bot->game->sprite_renderer.Render(*opt_camera);
+    ctx.bot->bot_controller->tree_render.PushText(*opt_camera, request.str, request.color, position, request.layer,
+                                                  request.alignment);
 
     return ExecuteResult::Success;
   }
 
-  const char* camera_key = nullptr;
-  const char* position_key = nullptr;
+  BlackboardKey camera_key;
+  BlackboardKey position_key;
 
   Vector2f position;
 
@@ -125,14 +120,13 @@ struct RenderRectNode : public BehaviorNode {
       rect = *opt_rect;
     }
 
-    ctx.bot->game->line_renderer.PushRect(rect, color);
-    ctx.bot->game->line_renderer.Render(*opt_camera);
+    ctx.bot->bot_controller->tree_render.PushRect(*opt_camera, rect, color);
 
     return ExecuteResult::Success;
   }
 
-  const char* camera_key = nullptr;
-  const char* rect_key = nullptr;
+  BlackboardKey camera_key;
+  BlackboardKey rect_key;
   Rectangle rectangle;
   Vector3f color;
 };
@@ -155,14 +149,13 @@ struct RenderLineNode : public BehaviorNode {
       line = *opt_line;
     }
 
-    ctx.bot->game->line_renderer.PushLine(line, color);
-    ctx.bot->game->line_renderer.Render(*opt_camera);
+    ctx.bot->bot_controller->tree_render.PushLine(*opt_camera, line, color);
 
     return ExecuteResult::Success;
   }
 
-  const char* camera_key = nullptr;
-  const char* line_key = nullptr;
+  BlackboardKey camera_key;
+  BlackboardKey line_key;
   LineSegment line;
   Vector3f color;
 };
@@ -203,15 +196,14 @@ struct RenderRayNode : public BehaviorNode {
     line.points[0] = ray.origin;
     line.points[1] = ray.origin + ray.direction * length;
 
-    ctx.bot->game->line_renderer.PushLine(line, color);
-    ctx.bot->game->line_renderer.Render(*opt_camera);
+    ctx.bot->bot_controller->tree_render.PushLine(*opt_camera, line, color);
 
     return ExecuteResult::Success;
   }
 
-  const char* camera_key = nullptr;
-  const char* ray_key = nullptr;
-  const char* length_key = nullptr;
+  BlackboardKey camera_key;
+  BlackboardKey ray_key;
+  BlackboardKey length_key;
 
   Ray ray;
   float length = 1.0f;
@@ -268,15 +260,14 @@ struct RenderVectorNode : public BehaviorNode {
     line.points[0] = origin;
     line.points[1] = origin + vector;
 
-    ctx.bot->game->line_renderer.PushLine(line, color);
-    ctx.bot->game->line_renderer.Render(*opt_camera);
+    ctx.bot->bot_controller->tree_render.PushLine(*opt_camera, line, color);
 
     return ExecuteResult::Success;
   }
 
-  const char* camera_key = nullptr;
-  const char* vector_key = nullptr;
-  const char* origin_key = nullptr;
+  BlackboardKey camera_key;
+  BlackboardKey vector_key;
+  BlackboardKey origin_key;
 
   Vector2f vector;
   Vector2f origin;
@@ -79,8 +79,8 @@ struct ShipQueryNode : public BehaviorNode {
 
   int ship = 0;
 
-  const char* player_key = nullptr;
-  const char* ship_key = nullptr;
+  BlackboardKey player_key;
+  BlackboardKey ship_key;
 };
 
 struct ShipRequestNode : public BehaviorNode {
@@ -130,7 +130,7 @@ struct ShipRequestNode : public BehaviorNode {
   }
 
   int ship = 0;
-  const char* ship_key = nullptr;
+  BlackboardKey ship_key;
 };
 
 struct ShipPortalPositionQueryNode : public BehaviorNode {
@@ -148,7 +148,7 @@ struct ShipPortalPositionQueryNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* output_key = nullptr;
+  BlackboardKey output_key;
 };
 
 struct ShipCapabilityQueryNode : public BehaviorNode {
@@ -203,7 +203,7 @@ struct ShipItemCountQueryNode : public BehaviorNode {
   }
 
   ShipItemType type = ShipItemType::Repel;
-  const char* output_key = nullptr;
+  BlackboardKey output_key;
 };
 
 struct ShipWeaponCapabilityQueryNode : public BehaviorNode {
@@ -306,7 +306,7 @@ struct RepelDistanceQueryNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* output_key = nullptr;
+  BlackboardKey output_key;
 };
 
 }  // namespace behavior
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <zero/BotController.h>
 #include <zero/ZeroBot.h>
 #include <zero/behavior/BehaviorTree.h>
 #include <zero/game/Game.h>
@@ -29,7 +30,7 @@ struct HeadingPositionViewNode : public behavior::BehaviorNode {
     return angle <= view_radians ? ExecuteResult::Success : ExecuteResult::Failure;
   }
 
-  const char* position_key;
+  BlackboardKey position_key;
   float view_radians;
 };
 
@@ -53,7 +54,7 @@ struct HeadingDirectionViewNode : public behavior::BehaviorNode {
     return angle <= view_radians ? ExecuteResult::Success : ExecuteResult::Failure;
   }
 
-  const char* direction_key;
+  BlackboardKey direction_key;
   float view_radians;
 };
 
@@ -66,7 +67,10 @@ struct NearestTargetNode : public behavior::BehaviorNode {
     Player* self = ctx.bot->game->player_manager.GetSelf();
     if (!self) return behavior::ExecuteResult::Failure;
 
-    Player* nearest = GetNearestTarget(ctx, *self);
+    TargetFlags required = TargetFlag_Connected | TargetFlag_Synchronized;
+    if (obey_stealth) required |= TargetFlag_Visible;
+
+    Player* nearest = ctx.bot->bot_controller->GetTargetTable().Select(required, TargetFlag_Safe, TargetScoreWeights());
 
     if (!nearest) {
       ctx.blackboard.Erase(player_key);
@@ -79,64 +83,43 @@ struct NearestTargetNode : public behavior::BehaviorNode {
   }
 
   inline static bool IsVisible(ArenaSettings& settings, const Player& self, const Player& target) {
-    constexpr Vector2f kViewDim(1920.0f, 1080.0f);
-
-    // XRadar can see no matter what.
-    if (self.togglables & Status_XRadar) return true;
-
-    // We can always see them if they don't have stealth on.
-    if (!(target.togglables & Status_Stealth)) return true;
-
-    const Vector2f half_view_dim = kViewDim * 0.5f;
-
-    Rectangle view_rect(self.position - half_view_dim, self.position + half_view_dim);
-    Rectangle target_rect =
-        Rectangle::FromPositionRadius(target.position, settings.ShipSettings[target.ship].GetRadius());
-
-    // Target has stealth on and is off screen. We cannot see them.
-    if (!BoxBoxIntersect(view_rect.min, view_rect.max, target_rect.min, target_rect.max)) {
-      return false;
-    }
-
-    // We can see them if they don't have cloak on since they are on our screen.
-    return !(target.togglables & Status_Cloak);
+    return IsPlayerVisible(settings, self, target);
   }
 
  private:
-  Player* GetNearestTarget(behavior::ExecuteContext& ctx, Player& self) {
-    Game& game = *ctx.bot->game;
-    RegionRegistry& region_registry = *ctx.bot->bot_controller->region_registry;
-
-    Player* best_target = nullptr;
-    float closest_dist_sq = std::numeric_limits<float>::max();
+  bool obey_stealth = false;
+  BlackboardKey player_key;
+};
 
-    for (size_t i = 0; i < game.player_manager.player_count; ++i) {
-      Player* player = game.player_manager.players + i;
+// Chooses the enemy with the lowest weighted score of distance, energy, and threat from the target table.
+// If obey_stealth is true, then we will ignore players that we can't see.
+struct ScoredTargetNode : public behavior::BehaviorNode {
+  ScoredTargetNode(const char* player_key, TargetScoreWeights weights, bool obey_stealth = false)
+      : player_key(player_key), weights(weights), obey_stealth(obey_stealth) {}
 
-      if (player->ship >= 8) continue;
-      if (player->frequency == self.frequency) continue;
-      if (player->IsRespawning()) continue;
-      if (player->position == Vector2f(0, 0)) continue;
-      if (!game.player_manager.IsSynchronized(*player)) continue;
-      if (!region_registry.IsConnected(self.position, player->position)) continue;
+  behavior::ExecuteResult Execute(behavior::ExecuteContext& ctx) override {
+    Player* self = ctx.bot->game->player_manager.GetSelf();
+    if (!self) return behavior::ExecuteResult::Failure;
 
-      bool in_safe = game.connection.map.GetTileId(player->position) == kTileIdSafe;
-      if (in_safe) continue;
+    TargetFlags required = TargetFlag_Connected | TargetFlag_Synchronized;
+    if (obey_stealth) required |= TargetFlag_Visible;
 
-      if (obey_stealth && !IsVisible(ctx.bot->game->connection.settings, self, *player)) continue;
+    Player* target = ctx.bot->bot_controller->GetTargetTable().Select(required, TargetFlag_Safe, weights);
 
-      float dist_sq = player->position.DistanceSq(self.position);
-      if (dist_sq < closest_dist_sq) {
-        closest_dist_sq = dist_sq;
-        best_target = player;
-      }
+    if (!target) {
+      ctx.blackboard.Erase(player_key);
+      return behavior::ExecuteResult::Failure;
     }
 
-    return best_target;
+    ctx.blackboard.Set(player_key, target);
+
+    return behavior::ExecuteResult::Success;
   }
 
+ private:
+  BlackboardKey player_key;
+  TargetScoreWeights weights;
   bool obey_stealth = false;
-  const char* player_key;
 };
 
 }  // namespace behavior
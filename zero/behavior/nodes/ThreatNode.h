@@ -9,6 +9,7 @@
 
 #include <random>
 #include <unordered_set>
+#include <vector>
 
 // These nodes are pretty bad. They could be improved by projecting weapons through an influence map and finding a
 // nearby tile on the map that is safe.
@@ -16,13 +17,8 @@
 namespace zero {
 namespace behavior {
 
-struct IncomingDamageReport {
-  Vector2f average_direction;
-  Vector2f average_origin;
-  float average_damage;
-  u32 weapon_count;
-};
-
+// Pushes the ship toward the safest nearby position in the danger forecast. This succeeds when the forecast damage
+// within the check distance is over the threshold or would kill the ship, so the rest of the tree can be skipped.
 struct DodgeIncomingDamage : public behavior::BehaviorNode {
   DodgeIncomingDamage(float damage_percent_threshold, float distance, float minimum_force = 2.0f)
       : damage_percent_threshold(damage_percent_threshold), distance(distance), minimum_force(minimum_force) {}
@@ -55,16 +51,19 @@ struct DodgeIncomingDamage : public behavior::BehaviorNode {
       damage_percent_threshold = *opt_threshold;
     }
 
-    IncomingDamageReport report = GetIncomingDamage(ctx, self, check_distance);
-    float est_damage = report.weapon_count * report.average_damage;
+    auto& forecast = ctx.bot->game->danger_forecast;
+    if (!forecast.IsValid(self->frequency)) return behavior::ExecuteResult::Failure;
+
+    // Only count the weapons that can reach the ship from about the check distance away.
+    u32 ticks = forecast.GetTravelTicks(check_distance);
+    float est_damage = forecast.GetDamage(self->position, ticks);
     float new_energy = self->energy - est_damage;
     float damage_percent = est_damage / (float)ctx.bot->game->ship_controller.ship.energy;
 
-    Vector2f incoming_direction = Normalize(report.average_direction);
-    Ray ray(report.average_origin, incoming_direction);
-    Vector2f closest_hit = ray.GetClosestPosition(self->position);
-
-    Vector2f side = Normalize(self->position - closest_hit);
+    // Check far enough away that the ship is out of the cells that it's in now.
+    float ship_radius = ctx.bot->game->connection.settings.ShipSettings[self->ship].GetRadius();
+    float dodge_distance = ship_radius * 2.0f + (float)kForecastCellSize;
+    Vector2f side = forecast.GetSafestDirection(self->position, self->velocity, dodge_distance, ticks);
 
     if (est_damage > 0) {
       Vector3f color = Vector3f(1, 1, 0);
@@ -72,8 +71,8 @@ struct DodgeIncomingDamage : public behavior::BehaviorNode {
         color = Vector3f(0, 1, 0);
       }
 
-      ctx.bot->game->line_renderer.PushLine(self->position, Vector3f(1, 1, 0), self->position + side * 5.0f, color);
-      ctx.bot->game->line_renderer.Render(ctx.bot->game->camera);
+      ctx.bot->bot_controller->tree_render.PushLine(ctx.bot->game->camera, self->position, Vector3f(1, 1, 0),
+                                                    self->position + side * 5.0f, color);
     }
 
     float force = 10000.0f;
@@ -91,100 +90,11 @@ struct DodgeIncomingDamage : public behavior::BehaviorNode {
     return result;
   }
 
-  IncomingDamageReport GetIncomingDamage(behavior::ExecuteContext& ctx, Player* self, float check_distance) {
-    float distance_sq = check_distance * check_distance;
-    float ship_radius = ctx.bot->game->connection.settings.ShipSettings[self->ship].GetRadius();
-    float bounds_extent = ship_radius * 2.0f;
-
-    Rectangle self_bounds(self->position - Vector2f(bounds_extent, bounds_extent),
-                          self->position + Vector2f(bounds_extent, bounds_extent));
-
-    Vector2f average_direction;
-    Vector2f average_origin;
-    float average_damage = 0.0f;
-    size_t incoming_count = 0;
-
-    auto& weapon_man = ctx.bot->game->weapon_manager;
-    for (size_t i = 0; i < weapon_man.weapon_count; ++i) {
-      Weapon& weapon = weapon_man.weapons[i];
-
-      if (weapon.frequency == self->frequency) continue;
-      if (weapon.data.type == WeaponType::Repel || weapon.data.type == WeaponType::Decoy) continue;
-      if (weapon.data.type == WeaponType::Burst && !(weapon.flags & WEAPON_FLAG_BURST_ACTIVE)) continue;
-      if (weapon.position.DistanceSq(self->position) > distance_sq) continue;
-
-      bool is_mine = (weapon.data.type == WeaponType::Bomb || weapon.data.type == WeaponType::ProximityBomb) &&
-                     weapon.data.alternate;
-
-      Vector2f relative_velocity = weapon.velocity - self->velocity;
-      Vector2f direction = Normalize(relative_velocity);
-      Rectangle check_bounds = self_bounds;
-
-      if (weapon.data.type == WeaponType::Bomb) {
-        // Grow by bomb size plus some extra pixels to be certain.
-        check_bounds = check_bounds.Grow(6.0f / 16.0f);
-      } else if (weapon.data.type == WeaponType::ProximityBomb) {
-        float prox_radius =
-            ((float)ctx.bot->game->connection.settings.ProximityDistance + (float)weapon.data.level) + (2.0f / 16.0f);
-
-        check_bounds = check_bounds.Grow(prox_radius);
-      }
-
-      Rectangle view_bounds = check_bounds.Translate(-self->position);
-      view_bounds = view_bounds.Translate(weapon.position);
-
-      ctx.bot->game->line_renderer.PushRect(view_bounds, Vector3f(1, 0, 0));
-
-      // The amount of ticks that we are uncertain of with weapon alive time.
-      // This will cause it to attempt to dodge weapons that might be right outside of hitting range.
-      constexpr u32 kSlopTicks = 30;
-
-      float remaining_distance =
-          weapon.velocity.Length() * (TICK_DIFF(MAKE_TICK(weapon.end_tick + kSlopTicks), GetCurrentTick()) / 100.0f);
-
-      float dist = 0.0f;
-
-      if (RayBoxIntersect(Ray(weapon.position, direction), check_bounds, &dist, nullptr)) {
-        // Ignore weapons that will time out before reaching us.
-        if (dist > remaining_distance && !is_mine) continue;
-
-        // Reduce the amount of impact this weapon will have based on its distance away.
-        float threat_percent = (check_distance - dist) / (check_distance * 0.7f);
-        if (threat_percent > 1.0f) threat_percent = 1.0f;
-        if (threat_percent < 0.0f) threat_percent = 0.0f;
-
-        float damage = (float)GetEstimatedWeaponDamage(weapon, ctx.bot->game->connection) * threat_percent;
-        Vector2f weighted_direction = direction * threat_percent;
-
-        // Reduce the effect of this direction if the damage is lower than average.
-        if (average_damage > 0) {
-          weighted_direction *= damage / average_damage;
-        }
-
-        average_direction +=
-            (weighted_direction + (float)incoming_count * average_direction) / ((float)incoming_count + 1);
-        average_origin += (weapon.position + (float)incoming_count * average_origin) / ((float)incoming_count + 1);
-        average_damage += (damage + (float)incoming_count * average_damage) / ((float)incoming_count + 1);
-        ++incoming_count;
-      }
-    }
-
-    ctx.bot->game->line_renderer.Render(ctx.bot->game->camera);
-
-    IncomingDamageReport report;
-    report.average_damage = average_damage;
-    report.average_direction = average_direction;
-    report.average_origin = average_origin;
-    report.weapon_count = (u32)incoming_count;
-
-    return report;
-  }
-
   float damage_percent_threshold = 0.0f;
   float distance = 0.0f;
   float minimum_force = 2.0f;
-  const char* distance_key = nullptr;
-  const char* damage_percent_threshold_key = nullptr;
+  BlackboardKey distance_key;
+  BlackboardKey damage_percent_threshold_key;
 };
 
 struct InfluenceMapGradientDodge : public BehaviorNode {
@@ -290,16 +200,17 @@ struct InfluenceMapPopulateEnemies : public BehaviorNode {
     }
 
     u32 current_tick = GetCurrentTick();
+    const PlayerHotView& hot = player_manager.hot;
 
     for (size_t i = 0; i < player_manager.player_count; ++i) {
-      Player* p = player_manager.players + i;
+      if (hot.ship[i] >= 8) continue;
+      if (hot.frequency[i] == self->frequency) continue;
+      if (!player_manager.IsSynchronized(i, current_tick)) continue;
 
-      if (p->ship >= 8) continue;
-      if (p->frequency == self->frequency) continue;
-      if (!player_manager.IsSynchronized(*p, current_tick)) continue;
+      Vector2f position = hot.GetPosition(i);
 
-      for (float y = p->position.y - influence_radius; y < p->position.y + influence_radius; ++y) {
-        for (float x = p->position.x - influence_radius; x < p->position.x + influence_radius; ++x) {
+      for (float y = position.y - influence_radius; y < position.y + influence_radius; ++y) {
+        for (float x = position.x - influence_radius; x < position.x + influence_radius; ++x) {
           if (x >= 0 && y >= 0 && x <= 1023 && y <= 1023) {
             influence_map.AddValue((u16)x, (u16)y, value);
           }
@@ -314,7 +225,7 @@ struct InfluenceMapPopulateEnemies : public BehaviorNode {
   float value = 1.0f;
   float radius = 1.0f;
 
-  const char* radius_key = nullptr;
+  BlackboardKey radius_key;
 };
 
 struct InfluenceMapPopulateWeapons : public BehaviorNode {
@@ -453,7 +364,7 @@ struct FindTerritoryPosition : public BehaviorNode {
 
     if (!self) return ExecuteResult::Failure;
 
-    if (target_player_key != nullptr) {
+    if (target_player_key) {
       auto player_opt = ctx.blackboard.Value<Player*>(target_player_key);
       if (!player_opt.has_value()) return ExecuteResult::Failure;
 
@@ -463,7 +374,7 @@ struct FindTerritoryPosition : public BehaviorNode {
     if (!player) return ExecuteResult::Failure;
 
     float nearby_distance = 0.0f;
-    if (nearby_distance_key != nullptr) {
+    if (nearby_distance_key) {
       auto nearby_opt = ctx.blackboard.Value<float>(nearby_distance_key);
       if (!nearby_opt.has_value()) return ExecuteResult::Failure;
 
@@ -479,7 +390,7 @@ struct FindTerritoryPosition : public BehaviorNode {
         Vector2f existing = existing_opt.value();
 
         if (existing.DistanceSq(player->position) <= nearby_distance * nearby_distance) {
-          if (!ctx.bot->game->GetMap().CastTo(player->position, existing, self->frequency).hit) {
+          if (ctx.bot->game->GetMap().HasLineOfSight(player->position, existing, self->frequency)) {
             return ExecuteResult::Success;
           }
         }
@@ -501,7 +412,7 @@ struct FindTerritoryPosition : public BehaviorNode {
 
     Vector2f end_position = player->position + lateral_offset + forward_offset;
 
-    if (ctx.bot->game->GetMap().CastTo(player->position, end_position, self->frequency).hit) {
+    if (!ctx.bot->game->GetMap().HasLineOfSight(player->position, end_position, self->frequency)) {
       return ExecuteResult::Failure;
     }
 
@@ -512,9 +423,9 @@ struct FindTerritoryPosition : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* target_player_key;
-  const char* nearby_distance_key;
-  const char* output_key;
+  BlackboardKey target_player_key;
+  BlackboardKey nearby_distance_key;
+  BlackboardKey output_key;
   bool fresh = false;
 
   std::random_device dev;
@@ -560,9 +471,18 @@ struct PositionThreatQueryNode : public BehaviorNode {
 
     links.clear();
 
-    for (size_t i = 0; i < weapon_manager.weapon_count; ++i) {
-      Weapon& weapon = weapon_manager.weapons[i];
+    // Only weapons that can travel to the largest check bounds within the lookahead can do damage.
+    float reach = radius * 2.0f + weapon_manager.max_weapon_speed * seconds_lookahead;
+    Vector2f reach_min = position - Vector2f(reach, reach);
+    Vector2f reach_max = position + Vector2f(reach, reach);
+
+    // Only the first weapon of each link is checked, so they are visited in index order to always check the same one.
+    weapon_manager.GetWeaponsInRect(reach_min, reach_max, weapons);
 
+    for (Weapon* candidate : weapons) {
+      Weapon& weapon = *candidate;
+
+      if (energy <= 0) continue;
       if (weapon.frequency == freq) continue;
       if (weapon.data.type == WeaponType::Repel || weapon.data.type == WeaponType::Decoy) continue;
       if (weapon.data.type == WeaponType::Burst && !(weapon.flags & WEAPON_FLAG_BURST_ACTIVE)) continue;
@@ -584,8 +504,6 @@ struct PositionThreatQueryNode : public BehaviorNode {
         if (start.DistanceSq(end) >= dist * dist) {
           int damage = GetEstimatedWeaponDamage(weapon, connection);
           energy -= damage;
-
-          if (energy <= 0) break;
         }
       }
     }
@@ -598,10 +516,44 @@ struct PositionThreatQueryNode : public BehaviorNode {
   Vector2f set_position;
   float seconds_lookahead;
   float radius;
-  const char* position_key = nullptr;
-  const char* output_key = nullptr;
+  BlackboardKey position_key;
+  BlackboardKey output_key;
 
   std::unordered_set<u32> links;
+  std::vector<Weapon*> weapons;
+};
+
+// Looks up the damage that the game's danger forecast expects a ship at the position to take within the ticks.
+// The forecast is built for the self ship, so this fails for anything that isn't on the self frequency.
+struct ForecastDamageQueryNode : public BehaviorNode {
+  ForecastDamageQueryNode(u32 ticks, const char* output_key) : ticks(ticks), output_key(output_key) {}
+  ForecastDamageQueryNode(const char* position_key, u32 ticks, const char* output_key)
+      : position_key(position_key), ticks(ticks), output_key(output_key) {}
+
+  ExecuteResult Execute(ExecuteContext& ctx) override {
+    auto self = ctx.bot->game->player_manager.GetSelf();
+    if (!self || self->ship >= 8) return ExecuteResult::Failure;
+
+    auto& forecast = ctx.bot->game->danger_forecast;
+    if (!forecast.IsValid(self->frequency)) return ExecuteResult::Failure;
+
+    Vector2f position = self->position;
+
+    if (position_key) {
+      auto opt_position = ctx.blackboard.Value<Vector2f>(position_key);
+      if (!opt_position.has_value()) return ExecuteResult::Failure;
+
+      position = opt_position.value();
+    }
+
+    ctx.blackboard.Set(output_key, forecast.GetDamage(position, ticks));
+
+    return ExecuteResult::Success;
+  }
+
+  BlackboardKey position_key;
+  u32 ticks;
+  BlackboardKey output_key;
 };
 
 }  // namespace behavior
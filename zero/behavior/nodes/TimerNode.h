@@ -19,7 +19,7 @@ struct TimerExpiredNode : public BehaviorNode {
     return TICK_GTE(current_tick, timeout) ? ExecuteResult::Success : ExecuteResult::Failure;
   }
 
-  const char* key;
+  BlackboardKey key;
 };
 
 struct TimerSetNode : public BehaviorNode {
@@ -40,8 +40,8 @@ struct TimerSetNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* timer_key = nullptr;
-  const char* ticks_key = nullptr;
+  BlackboardKey timer_key;
+  BlackboardKey ticks_key;
 
   u32 ticks = 0;
 };
@@ -43,9 +43,9 @@ struct WaypointNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* waypoints_key;
-  const char* index_key;
-  const char* position_key;
+  BlackboardKey waypoints_key;
+  BlackboardKey index_key;
+  BlackboardKey position_key;
   float nearby_radius_sq;
 };
 
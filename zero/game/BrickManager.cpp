@@ -1,6 +1,7 @@
 #include "BrickManager.h"
 
 #include <assert.h>
+#include <string.h>
 #include <zero/game/Buffer.h>
 #include <zero/game/Camera.h>
 #include <zero/game/Clock.h>
@@ -72,7 +73,10 @@ static void OnBrickDroppedPkt(void* user, u8* pkt, size_t size) {
 
 BrickManager::BrickManager(MemoryArena& arena, Connection& connection, PlayerManager& player_manager,
                            PacketDispatcher& dispatcher)
-    : arena(arena), connection(connection), player_manager(player_manager), brick_map(arena) {
+    : arena(arena), connection(connection), player_manager(player_manager) {
+  brick_teams = memory_arena_push_type_count(&arena, u16, 1024 * 1024);
+  memset(brick_teams, 0xFF, sizeof(u16) * 1024 * 1024);
+
   dispatcher.Register(ProtocolS2C::BrickDropped, OnBrickDroppedPkt, this);
 }
 
@@ -81,35 +85,26 @@ void BrickManager::Update(Map& map, u32 frequency, float dt) {
 
   u32 tick = GetCurrentTick();
 
-  Brick* current = bricks;
-  Brick* previous = nullptr;
-
-  while (current) {
-    if (TICK_GT(tick, current->end_tick)) {
-      if (previous) {
-        previous->next = current->next;
-      } else {
-        bricks = current->next;
-      }
-
-      Brick* brick = current;
-      current = current->next;
+  // Bricks are kept in expiration order, so everything expired is at the front.
+  while (bricks && TICK_GT(tick, bricks->end_tick)) {
+    Brick* brick = bricks;
 
-      map.SetTileId(brick->tile.x, brick->tile.y, 0);
+    bricks = brick->next;
+    if (!bricks) {
+      last_brick = nullptr;
+    }
 
-      Event::Dispatch(BrickTileClearEvent(*brick));
+    map.SetTileId(brick->tile.x, brick->tile.y, 0);
+    brick_teams[brick->tile.y * 1024 + brick->tile.x] = kNoBrickTeam;
 
-      Brick** removed = brick_map.Remove(brick->tile);
-      assert(removed);
+    Event::Dispatch(BrickTileClearEvent(*brick));
 
-      brick->next = free;
-      free = brick;
-    } else {
-      map.SetTileId(current->tile.x, current->tile.y, 250);
+    brick->next = free;
+    free = brick;
+  }
 
-      previous = current;
-      current = current->next;
-    }
+  for (Brick* current = bricks; current; current = current->next) {
+    map.SetTileId(current->tile.x, current->tile.y, 250);
   }
 }
 
@@ -146,17 +141,25 @@ void BrickManager::Render(Camera& camera, SpriteRenderer& renderer, const Vector
 }
 
 void BrickManager::InsertBrick(u16 x, u16 y, u16 team, u16 id, u32 timestamp) {
-  Brick* brick = free;
+  if (x >= 1024 || y >= 1024) return;
 
-  if (!brick) {
-    brick = free = memory_arena_push_type(&arena, Brick);
-    brick->next = nullptr;
+  Brick* brick = nullptr;
+
+  // Refresh the brick that already exists on this tile instead of stacking another one on top of it.
+  if (brick_teams[y * 1024 + x] != kNoBrickTeam) {
+    brick = UnlinkBrick(x, y);
   }
 
-  free = free->next;
+  if (!brick) {
+    brick = free;
+
+    if (!brick) {
+      brick = free = memory_arena_push_type(&arena, Brick);
+      brick->next = nullptr;
+    }
 
-  brick->next = bricks;
-  bricks = brick;
+    free = free->next;
+  }
 
   brick->tile.x = x;
   brick->tile.y = y;
@@ -164,7 +167,9 @@ void BrickManager::InsertBrick(u16 x, u16 y, u16 team, u16 id, u32 timestamp) {
   brick->team = team;
   brick->end_tick = timestamp + connection.settings.BrickTime;
 
-  brick_map.Insert(brick->tile, brick);
+  LinkBrick(brick);
+
+  brick_teams[y * 1024 + x] = team;
 
   Event::Dispatch(BrickTileEvent(*brick));
 }
@@ -176,14 +181,73 @@ void BrickManager::Clear() {
     Brick* brick = current;
     current = current->next;
 
-    Brick** removed = brick_map.Remove(brick->tile);
-    assert(removed);
+    brick_teams[brick->tile.y * 1024 + brick->tile.x] = kNoBrickTeam;
 
     brick->next = free;
     free = brick;
   }
 
   bricks = nullptr;
+  last_brick = nullptr;
+}
+
+void BrickManager::LinkBrick(Brick* brick) {
+  // Bricks almost always arrive in order, so they can usually be appended directly.
+  if (!last_brick || TICK_GTE(brick->end_tick, last_brick->end_tick)) {
+    brick->next = nullptr;
+
+    if (last_brick) {
+      last_brick->next = brick;
+    } else {
+      bricks = brick;
+    }
+
+    last_brick = brick;
+    return;
+  }
+
+  Brick* previous = nullptr;
+  Brick* current = bricks;
+
+  while (current && TICK_GTE(brick->end_tick, current->end_tick)) {
+    previous = current;
+    current = current->next;
+  }
+
+  brick->next = current;
+
+  if (previous) {
+    previous->next = brick;
+  } else {
+    bricks = brick;
+  }
+}
+
+Brick* BrickManager::UnlinkBrick(u16 x, u16 y) {
+  Brick* previous = nullptr;
+  Brick* current = bricks;
+
+  while (current) {
+    if (current->tile.x == x && current->tile.y == y) {
+      if (previous) {
+        previous->next = current->next;
+      } else {
+        bricks = current->next;
+      }
+
+      if (last_brick == current) {
+        last_brick = previous;
+      }
+
+      current->next = nullptr;
+      return current;
+    }
+
+    previous = current;
+    current = current->next;
+  }
+
+  return nullptr;
 }
 
 }  // namespace zero
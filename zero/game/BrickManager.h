@@ -4,7 +4,7 @@
 #include <zero/Math.h>
 #include <zero/Types.h>
 #include <zero/game/Camera.h>
-#include <zero/game/HashMap.h>
+#include <zero/game/Memory.h>
 
 namespace zero {
 
@@ -34,25 +34,21 @@ struct Brick {
   struct Brick* next;
 };
 
-struct BrickHasher {
-  inline u32 operator()(const BrickTile& tile) { return Hash(tile); }
-  inline u32 Hash(const BrickTile& tile) { return (tile.y << 16) | tile.x; }
-};
-
-constexpr size_t kBrickMapBuckets = (1 << 8);
-struct BrickMap : public HashMap<BrickTile, Brick*, BrickHasher, kBrickMapBuckets> {
-  BrickMap(MemoryArena& arena) : HashMap<BrickTile, Brick*, BrickHasher, kBrickMapBuckets>(arena) {}
-};
+// Stored in the brick overlay for tiles without a brick.
+constexpr u16 kNoBrickTeam = 0xFFFF;
 
 struct BrickManager {
   MemoryArena& arena;
   Connection& connection;
   PlayerManager& player_manager;
 
+  // Active bricks ordered by end_tick so expiring only needs to look at the front of the list.
   Brick* bricks = nullptr;
+  Brick* last_brick = nullptr;
   Brick* free = nullptr;
 
-  BrickMap brick_map;
+  // Dense 1024x1024 overlay of the team that owns the brick on each tile.
+  u16* brick_teams = nullptr;
   float animation_t = 0.0f;
 
   BrickManager(MemoryArena& arena, Connection& connection, PlayerManager& player_manager, PacketDispatcher& dispatcher);
@@ -62,10 +58,15 @@ struct BrickManager {
   void InsertBrick(u16 x, u16 y, u16 team, u16 id, u32 timestamp);
   void Clear();
 
-  inline Brick* GetBrick(u16 x, u16 y) {
-    Brick** brick = brick_map.Find(BrickTile(x, y));
-    return brick ? *brick : nullptr;
+  inline u16 GetBrickTeam(u16 x, u16 y) const {
+    if (x >= 1024 || y >= 1024) return kNoBrickTeam;
+
+    return brick_teams[y * 1024 + x];
   }
+
+ private:
+  void LinkBrick(Brick* brick);
+  Brick* UnlinkBrick(u16 x, u16 y);
 };
 
 }  // namespace zero
@@ -1,7 +1,6 @@
 #include "ChatController.h"
 
 #include <assert.h>
-#include <ctype.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <string.h>
@@ -126,37 +125,7 @@ void ChatController::SendPrivateMessage(const char* mesg, u16 pid) {
 }
 
 Player* ChatController::GetBestPlayerNameMatch(char* name, size_t length) {
-  Player* best_match = nullptr;
-
-  // Loop through each player looking at the first 'length' characters of their name.
-  // If they match up to the length then add them as a candidate.
-  // If they match up to the length and the name is exactly the same length as the check name then return that one.
-  for (size_t i = 0; i < player_manager.player_count; ++i) {
-    Player* p = player_manager.players + i;
-
-    bool is_match = true;
-
-    for (size_t j = 0; j < ZERO_ARRAY_SIZE(p->name) && j < length; ++j) {
-      char p_curr = tolower(p->name[j]);
-      char n_curr = tolower(name[j]);
-
-      if (p_curr != n_curr) {
-        is_match = false;
-        break;
-      }
-    }
-
-    if (is_match) {
-      best_match = p;
-
-      // If they match up until the length of the check name and they are the same length then it must be exact
-      if (strlen(p->name) == length) {
-        return p;
-      }
-    }
-  }
-
-  return best_match;
+  return player_manager.GetPlayerByPrefix(name, length);
 }
 
 inline int GetShipStatusPercent(u32 upgrade, u32 maximum, u32 current) {
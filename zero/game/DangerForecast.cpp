@@ -0,0 +1,348 @@
+#include "DangerForecast.h"
+
+#include <string.h>
+#include <zero/game/Clock.h>
+#include <zero/game/PlayerManager.h>
+#include <zero/game/WeaponManager.h>
+#include <zero/game/net/Connection.h>
+
+namespace zero {
+
+constexpr s32 kForecastWindowSize = kForecastCellSize * kForecastCellsPerAxis;
+
+DangerForecast::DangerForecast(Connection& connection, PlayerManager& player_manager, WeaponManager& weapon_manager)
+    : connection(connection), player_manager(player_manager), weapon_manager(weapon_manager) {
+  memset(cells, 0, sizeof(cells));
+}
+
+void DangerForecast::Update() {
+  Player* self = player_manager.GetSelf();
+
+  if (!self || self->ship >= 8) {
+    valid = false;
+    return;
+  }
+
+  u32 current_tick = GetCurrentTick();
+
+  if (valid && tick == current_tick && frequency == self->frequency && ship == self->ship &&
+      weapon_generation == weapon_manager.weapon_generation) {
+    return;
+  }
+
+  valid = true;
+  tick = current_tick;
+  frequency = self->frequency;
+  ship = self->ship;
+  weapon_generation = weapon_manager.weapon_generation;
+  ++generation;
+
+  origin_x = (s32)self->position.x - kForecastWindowSize / 2;
+  origin_y = (s32)self->position.y - kForecastWindowSize / 2;
+
+  if (origin_x < 0) origin_x = 0;
+  if (origin_y < 0) origin_y = 0;
+  if (origin_x > 1024 - kForecastWindowSize) origin_x = 1024 - kForecastWindowSize;
+  if (origin_y > 1024 - kForecastWindowSize) origin_y = 1024 - kForecastWindowSize;
+
+  float ship_radius = connection.settings.ShipSettings[self->ship].GetRadius();
+
+  // Only weapons that can reach the window before the forecast ends need to be stepped.
+  float reach = weapon_manager.max_weapon_speed * (kForecastTicks / 100.0f) + 1.0f;
+  Vector2f window_min((float)origin_x, (float)origin_y);
+  Vector2f window_max((float)(origin_x + kForecastWindowSize), (float)(origin_y + kForecastWindowSize));
+
+  weapon_manager.ForEachWeaponInRect(window_min - Vector2f(reach, reach), window_max + Vector2f(reach, reach),
+                                     [&](Weapon& weapon) {
+                                       if (weapon.frequency == frequency) return;
+                                       if (weapon.data.type == WeaponType::Repel) return;
+                                       if (weapon.data.type == WeaponType::Decoy) return;
+
+                                       Project(weapon, ship_radius);
+                                     });
+}
+
+float DangerForecast::GetDamage(const Vector2f& position, u32 ticks) {
+  Update();
+
+  const ForecastCell* cell = GetCell(position);
+
+  if (!cell) return 0.0f;
+
+  return GetCellDamage(*cell, ticks);
+}
+
+float DangerForecast::GetDamage(const Vector2f& min, const Vector2f& max, u32 ticks) {
+  Update();
+
+  if (!valid) return 0.0f;
+
+  s32 start_x = GetCellCoord(min.x, origin_x);
+  s32 start_y = GetCellCoord(min.y, origin_y);
+  s32 end_x = GetCellCoord(max.x, origin_x);
+  s32 end_y = GetCellCoord(max.y, origin_y);
+
+  if (start_x < 0) start_x = 0;
+  if (start_y < 0) start_y = 0;
+  if (end_x >= kForecastCellsPerAxis) end_x = kForecastCellsPerAxis - 1;
+  if (end_y >= kForecastCellsPerAxis) end_y = kForecastCellsPerAxis - 1;
+
+  float worst = 0.0f;
+
+  for (s32 y = start_y; y <= end_y; ++y) {
+    for (s32 x = start_x; x <= end_x; ++x) {
+      const ForecastCell& cell = cells[y * kForecastCellsPerAxis + x];
+
+      if (cell.generation != generation) continue;
+
+      float damage = GetCellDamage(cell, ticks);
+
+      if (damage > worst) {
+        worst = damage;
+      }
+    }
+  }
+
+  return worst;
+}
+
+u32 DangerForecast::GetFirstHitTick(const Vector2f& position) {
+  Update();
+
+  const ForecastCell* cell = GetCell(position);
+
+  if (!cell) return kNoForecastHit;
+
+  return cell->first_tick;
+}
+
+u32 DangerForecast::GetFirstHitTick(const Vector2f& min, const Vector2f& max) {
+  Update();
+
+  if (!valid) return kNoForecastHit;
+
+  s32 start_x = GetCellCoord(min.x, origin_x);
+  s32 start_y = GetCellCoord(min.y, origin_y);
+  s32 end_x = GetCellCoord(max.x, origin_x);
+  s32 end_y = GetCellCoord(max.y, origin_y);
+
+  if (start_x < 0) start_x = 0;
+  if (start_y < 0) start_y = 0;
+  if (end_x >= kForecastCellsPerAxis) end_x = kForecastCellsPerAxis - 1;
+  if (end_y >= kForecastCellsPerAxis) end_y = kForecastCellsPerAxis - 1;
+
+  u32 first_tick = kNoForecastHit;
+
+  for (s32 y = start_y; y <= end_y; ++y) {
+    for (s32 x = start_x; x <= end_x; ++x) {
+      const ForecastCell& cell = cells[y * kForecastCellsPerAxis + x];
+
+      if (cell.generation == generation && cell.first_tick < first_tick) {
+        first_tick = cell.first_tick;
+      }
+    }
+  }
+
+  return first_tick;
+}
+
+Vector2f DangerForecast::GetSafestDirection(const Vector2f& position, const Vector2f& preferred, float distance,
+                                            u32 ticks) {
+  constexpr float kDiagonal = 0.70710678f;
+  const Vector2f kDirections[] = {Vector2f(1, 0),  Vector2f(kDiagonal, kDiagonal),   Vector2f(0, 1),
+                                  Vector2f(-kDiagonal, kDiagonal),  Vector2f(-1, 0), Vector2f(-kDiagonal, -kDiagonal),
+                                  Vector2f(0, -1), Vector2f(kDiagonal, -kDiagonal)};
+
+  float current_damage = GetDamage(position, ticks);
+
+  if (!valid || current_damage <= 0.0f) return Vector2f(0, 0);
+
+  Vector2f best(0, 0);
+  float best_damage = current_damage;
+  u32 best_first_tick = 0;
+  float best_alignment = -2.0f;
+
+  for (const Vector2f& direction : kDirections) {
+    Vector2f check = position + direction * distance;
+
+    if (connection.map.IsSolid((u16)check.x, (u16)check.y, frequency)) continue;
+
+    float damage = GetDamage(check, ticks);
+
+    if (damage > best_damage) continue;
+
+    u32 first_tick = GetFirstHitTick(check);
+    float alignment = direction.Dot(preferred);
+
+    if (damage == best_damage) {
+      if (first_tick < best_first_tick) continue;
+      if (first_tick == best_first_tick && alignment <= best_alignment) continue;
+    }
+
+    best = direction;
+    best_damage = damage;
+    best_first_tick = first_tick;
+    best_alignment = alignment;
+  }
+
+  // Staying still is as good as any direction.
+  if (best_damage >= current_damage && best_first_tick <= GetFirstHitTick(position)) return Vector2f(0, 0);
+
+  return best;
+}
+
+u32 DangerForecast::GetTravelTicks(float distance) const {
+  float speed = weapon_manager.max_weapon_speed;
+
+  if (speed <= 0.0f || distance >= speed * (kForecastTicks / 100.0f)) return kForecastTicks - 1;
+
+  return (u32)(distance / speed * 100.0f);
+}
+
+void DangerForecast::Project(const Weapon& source, float ship_radius) {
+  Weapon weapon = source;
+  WeaponType type = weapon.data.type;
+  float damage = (float)GetEstimatedWeaponDamage(weapon, connection);
+
+  if (damage <= 0.0f) return;
+
+  bool is_bomb = type == WeaponType::Bomb || type == WeaponType::ProximityBomb || type == WeaponType::Thor;
+  // Inactive bursts can't hurt anything until they bounce off of a wall.
+  bool active = type != WeaponType::Burst || (weapon.flags & WEAPON_FLAG_BURST_ACTIVE);
+  float radius = ship_radius + weapon_manager.GetCollisionRadius(weapon);
+  Map& map = connection.map;
+
+  ++weapon_stamp;
+
+  // Cell coordinates are never below -1, so this forces the first mark.
+  s32 last_start_x = -2;
+  s32 last_start_y = -2;
+  s32 last_end_x = -2;
+  s32 last_end_y = -2;
+
+  for (u32 offset = 0; offset < kForecastTicks; ++offset) {
+    if (active) {
+      float x = weapon.x / 16000.0f;
+      float y = weapon.y / 16000.0f;
+
+      s32 start_x = GetCellCoord(x - radius, origin_x);
+      s32 start_y = GetCellCoord(y - radius, origin_y);
+      s32 end_x = GetCellCoord(x + radius, origin_x);
+      s32 end_y = GetCellCoord(y + radius, origin_y);
+
+      // Most ticks stay within the same cells, so only mark again once the covered cells change.
+      if (start_x != last_start_x || start_y != last_start_y || end_x != last_end_x || end_y != last_end_y) {
+        Mark(start_x, start_y, end_x, end_y, offset, damage);
+
+        last_start_x = start_x;
+        last_start_y = start_y;
+        last_end_x = end_x;
+        last_end_y = end_y;
+      }
+    }
+
+    // Mines and other still weapons cover the same cells for the entire forecast.
+    if (weapon.velocity_x == 0 && weapon.velocity_y == 0) break;
+    if (TICK_GTE(weapon.last_tick, weapon.end_tick)) break;
+
+    ++weapon.last_tick;
+
+    bool x_collide = weapon_manager.SimulateAxis(weapon, 0);
+    bool y_collide = weapon_manager.SimulateAxis(weapon, 1);
+
+    if (x_collide || y_collide) {
+      if (type == WeaponType::Burst) {
+        active = true;
+      } else if (type == WeaponType::Bullet || type == WeaponType::Bomb || type == WeaponType::ProximityBomb) {
+        if (weapon.bounces_remaining == 0) {
+          if (is_bomb) {
+            // The bomb explodes against the wall, so mark everything within its blast.
+            float explode_radius =
+                (connection.settings.BombExplodePixels * (1.0f + weapon.data.level)) / 16.0f + ship_radius;
+            float x = weapon.x / 16000.0f;
+            float y = weapon.y / 16000.0f;
+
+            Mark(GetCellCoord(x - explode_radius, origin_x), GetCellCoord(y - explode_radius, origin_y),
+                 GetCellCoord(x + explode_radius, origin_x), GetCellCoord(y + explode_radius, origin_y), offset + 1,
+                 damage);
+          }
+
+          break;
+        }
+
+        --weapon.bounces_remaining;
+      }
+    }
+
+    if (map.GetTileId(Vector2f(weapon.x / 16000.0f, weapon.y / 16000.0f)) == kTileIdWormhole) break;
+  }
+}
+
+void DangerForecast::Mark(s32 start_x, s32 start_y, s32 end_x, s32 end_y, u32 tick_offset, float damage) {
+  if (tick_offset >= kForecastTicks) return;
+
+  if (start_x < 0) start_x = 0;
+  if (start_y < 0) start_y = 0;
+  if (end_x >= kForecastCellsPerAxis) end_x = kForecastCellsPerAxis - 1;
+  if (end_y >= kForecastCellsPerAxis) end_y = kForecastCellsPerAxis - 1;
+
+  size_t bucket = tick_offset / kForecastBucketTicks;
+
+  for (s32 y = start_y; y <= end_y; ++y) {
+    for (s32 x = start_x; x <= end_x; ++x) {
+      ForecastCell& cell = cells[y * kForecastCellsPerAxis + x];
+
+      if (cell.generation != generation) {
+        cell.generation = generation;
+        cell.weapon_stamp = 0;
+        cell.first_tick = kNoForecastHit;
+
+        for (size_t i = 0; i < kForecastBucketCount; ++i) {
+          cell.damage[i] = 0.0f;
+        }
+      }
+
+      if (cell.weapon_stamp == weapon_stamp) continue;
+
+      cell.weapon_stamp = weapon_stamp;
+      cell.damage[bucket] += damage;
+
+      if (tick_offset < cell.first_tick) {
+        cell.first_tick = tick_offset;
+      }
+    }
+  }
+}
+
+const ForecastCell* DangerForecast::GetCell(const Vector2f& position) const {
+  if (!valid) return nullptr;
+
+  s32 x = GetCellCoord(position.x, origin_x);
+  s32 y = GetCellCoord(position.y, origin_y);
+
+  if (x < 0 || y < 0 || x >= kForecastCellsPerAxis || y >= kForecastCellsPerAxis) return nullptr;
+
+  const ForecastCell* cell = cells + y * kForecastCellsPerAxis + x;
+
+  if (cell->generation != generation) return nullptr;
+
+  return cell;
+}
+
+float DangerForecast::GetCellDamage(const ForecastCell& cell, u32 ticks) const {
+  size_t bucket_count = ticks / kForecastBucketTicks + 1;
+
+  if (bucket_count > kForecastBucketCount) {
+    bucket_count = kForecastBucketCount;
+  }
+
+  float damage = 0.0f;
+
+  for (size_t i = 0; i < bucket_count; ++i) {
+    damage += cell.damage[i];
+  }
+
+  return damage;
+}
+
+}  // namespace zero
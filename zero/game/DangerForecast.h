@@ -0,0 +1,111 @@
+#ifndef ZERO_DANGERFORECAST_H_
+#define ZERO_DANGERFORECAST_H_
+
+#include <zero/Math.h>
+#include <zero/Types.h>
+
+namespace zero {
+
+struct Connection;
+struct PlayerManager;
+struct Weapon;
+struct WeaponManager;
+
+constexpr u32 kForecastTicks = 128;
+constexpr u32 kForecastBucketTicks = 16;
+constexpr size_t kForecastBucketCount = kForecastTicks / kForecastBucketTicks;
+constexpr s32 kForecastCellSize = 2;
+constexpr s32 kForecastCellsPerAxis = 64;
+constexpr u32 kNoForecastHit = 0xFFFFFFFF;
+
+struct ForecastCell {
+  // The cell is only part of the forecast if this matches the forecast generation, so the cells never need clearing.
+  u32 generation;
+  // Stamp of the last weapon that entered the cell so each weapon is only counted once per cell.
+  u32 weapon_stamp;
+  // Ticks from the forecast tick until the first weapon enters the cell.
+  u32 first_tick;
+  // Damage of the weapons that first enter the cell within each kForecastBucketTicks span.
+  float damage[kForecastBucketCount];
+};
+
+// Steps the enemy weapons around the self player kForecastTicks into the future and records when and how much damage
+// reaches each cell in a window around the player. The forecast is built by the first query of each tick, so nothing
+// is simulated for bots that never query it.
+// Cells are grown by the self ship radius while marking, so looking up the ship's position answers whether the ship
+// would be hit if it stayed there.
+// Weapons are only stepped with WeaponManager::SimulateAxis. Wormhole gravity (WeaponManager::SimulateWormholeGravity)
+// is ignored, so gravity bombs are forecast as if they fly straight, and repels aren't applied.
+struct DangerForecast {
+  Connection& connection;
+  PlayerManager& player_manager;
+  WeaponManager& weapon_manager;
+
+  bool valid = false;
+  // The state that the current forecast was built from.
+  u32 tick = 0;
+  u16 frequency = 0;
+  u8 ship = 0;
+  u32 weapon_generation = 0;
+
+  // Tile coordinates of the top left of the window.
+  s32 origin_x = 0;
+  s32 origin_y = 0;
+
+  u32 generation = 0;
+  u32 weapon_stamp = 0;
+  ForecastCell cells[kForecastCellsPerAxis * kForecastCellsPerAxis];
+
+  DangerForecast(Connection& connection, PlayerManager& player_manager, WeaponManager& weapon_manager);
+
+  // Rebuilds the forecast if the tick, the self ship, or the weapon generation have changed since the last build. The
+  // queries call this themselves.
+  void Update();
+
+  // The forecast only applies to ships of the self player's frequency and ship radius.
+  inline bool IsValid(u16 frequency) {
+    Update();
+    return valid && this->frequency == frequency;
+  }
+
+  // Total damage of the enemy weapons that are forecast to hit a ship at this position within ticks.
+  // The ticks are rounded up to the end of their kForecastBucketTicks span.
+  // Positions outside of the window have no damage.
+  float GetDamage(const Vector2f& position, u32 ticks);
+  // Same as above, but returns the worst cell that overlaps the area. Damage is never summed across cells since the same
+  // weapon would be counted once in every cell that it passes through.
+  float GetDamage(const Vector2f& min, const Vector2f& max, u32 ticks);
+
+  // Ticks until the first enemy weapon is forecast to hit a ship at this position, or kNoForecastHit.
+  u32 GetFirstHitTick(const Vector2f& position);
+  u32 GetFirstHitTick(const Vector2f& min, const Vector2f& max);
+
+  // Checks the eight directions around the position at the distance and returns the one with the least damage within
+  // ticks, breaking ties by the latest first hit and then by the direction closest to preferred.
+  // Returns a zero vector if no direction has less damage than the position itself.
+  Vector2f GetSafestDirection(const Vector2f& position, const Vector2f& preferred, float distance, u32 ticks);
+
+  // Ticks that the fastest live weapon takes to travel the distance, limited to the forecast. Nodes that are tuned with a
+  // check distance use this to only count damage from weapons that start about that close.
+  u32 GetTravelTicks(float distance) const;
+
+ private:
+  void Project(const Weapon& weapon, float ship_radius);
+  void Mark(s32 start_x, s32 start_y, s32 end_x, s32 end_y, u32 tick_offset, float damage);
+
+  const ForecastCell* GetCell(const Vector2f& position) const;
+  float GetCellDamage(const ForecastCell& cell, u32 ticks) const;
+
+  // Converts a tile coordinate to a cell coordinate in the window. This isn't clamped, so it can be outside the window.
+  inline s32 GetCellCoord(float coord, s32 origin) const {
+    float local = coord - (float)origin;
+
+    if (local < 0.0f) return -1;
+
+    return (s32)local / kForecastCellSize;
+  }
+};
+
+}  // namespace zero
+
+#endif
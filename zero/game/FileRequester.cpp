@@ -10,8 +10,6 @@
 #include <zero/game/net/PacketDispatcher.h>
 #include <zero/game/net/security/Checksum.h>
 
-#include <thread>
-
 namespace zero {
 
 extern const char* kServerName;
@@ -34,29 +32,6 @@ static void CreateZoneFolder(MemoryArena& temp_arena) {
   platform.CreateFolder(path);
 }
 
-inline static bool FileExists(MemoryArena& temp_arena, const char* filename) {
-  char path[260];
-  GetFilePath(temp_arena, path, filename);
-
-  FILE* file = fopen(path, "rb");
-  if (!file) return false;
-
-  fseek(file, 0, SEEK_END);
-  size_t file_size = ftell(file);
-  fseek(file, 0, SEEK_SET);
-
-  u8* file_data = temp_arena.Allocate(file_size);
-
-  size_t read_amount = fread(file_data, 1, file_size, file);
-  if (read_amount != file_size) {
-    Log(LogLevel::Warning, "FileRequester FileExists to read entire file: %s", filename);
-  }
-
-  fclose(file);
-
-  return true;
-}
-
 static void OnCompressedMapPkt(void* user, u8* pkt, size_t size) {
   FileRequester* requester = (FileRequester*)user;
 
@@ -101,15 +76,31 @@ void FileRequester::OnCompressedFile(u8* pkt, size_t size) {
 
   CreateZoneFolder(temp_arena);
 
-  FILE* f = fopen(current->filename, "wb");
+  // Write to a temporary file and move it into place so other bots that have the old file mapped never see a
+  // partially written or truncated file.
+  char temp_filename[270];
+  sprintf(temp_filename, "%s.tmp", current->filename);
+
+  FILE* f = fopen(temp_filename, "wb");
   if (f) {
     fwrite(data, 1, data_size, f);
     fclose(f);
+
+    if (rename(temp_filename, current->filename) != 0) {
+      // Windows won't rename over an existing file, so remove it first.
+      remove(current->filename);
+
+      if (rename(temp_filename, current->filename) != 0) {
+        Log(LogLevel::Error, "Failed to move %s into place.", current->filename);
+        remove(temp_filename);
+      }
+    }
   } else {
-    Log(LogLevel::Error, "Failed to open %s for writing.", current->filename);
+    Log(LogLevel::Error, "Failed to open %s for writing.", temp_filename);
   }
 
   current->size = data_size;
+  current->cached = false;
 
   Log(LogLevel::Info, "Download complete: %s", current->filename);
   current->callback(current->user, current, data);
@@ -156,42 +147,28 @@ void FileRequester::Request(const char* filename, u16 index, u32 size, u32 check
   request->user = user;
   request->decompress = decompress;
 
-  if (FileExists(temp_arena, filename)) {
-    constexpr size_t kReadTries = 20;
-
-    MemoryRevert reverter = temp_arena.GetReverter();
-    u8* data = nullptr;
+  request->cached = false;
 
-    for (size_t i = 0; i < kReadTries; ++i) {
-      FILE* f = fopen(request->filename, "rb");
-      fseek(f, 0, SEEK_END);
-      long filesize = ftell(f);
-      fseek(f, 0, SEEK_SET);
+  size_t file_size = 0;
+  u8* data = platform.MapFile(request->filename, &file_size);
 
-      request->size = filesize;
+  if (data) {
+    // Verify the cached file straight from the mapping instead of reading it into memory.
+    bool valid = crc32(data, file_size) == checksum;
 
-      temp_arena.Revert(reverter.snapshot);
-      data = (u8*)temp_arena.Allocate(filesize);
+    if (valid) {
+      request->size = (u32)file_size;
+      request->cached = true;
 
-      size_t read_amount = fread(data, 1, filesize, f);
-      if (read_amount != filesize) {
-        Log(LogLevel::Warning, "FileRequester failed to read entire file: %s", filename);
-        data = nullptr;
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
-        continue;
-      }
-
-      fclose(f);
-      break;
-    }
-
-    if (data && crc32(data, request->size) == checksum) {
+      // The callback owns the mapping now, so the data that was verified is the same data that gets used.
       callback(user, request, data);
 
       request->next = free;
       free = request;
       return;
     }
+
+    platform.UnmapFile(data, file_size);
   }
 
   Log(LogLevel::Info, "Requesting download: %s", filename);
@@ -14,6 +14,10 @@ struct FileRequest {
   u16 decompress;
   u16 index;
 
+  // Set when the file was verified from the local zone folder instead of being downloaded. The callback data is then
+  // the verified file mapping, and the callback takes ownership of it so the file doesn't need to be mapped again.
+  bool cached;
+
   u32 size;
   u32 checksum;
 
@@ -240,7 +240,8 @@ static void OnBombDamageTaken(void* user) {
   game->jitter_time = game->connection.settings.JitterTime / 100.0f;
 }
 
-Game::Game(MemoryArena& perm_arena, MemoryArena& temp_arena, WorkQueue& work_queue, int width, int height)
+Game::Game(MemoryArena& perm_arena, MemoryArena& temp_arena, WorkQueue& work_queue, ThreadPool& thread_pool, int width,
+           int height)
     : perm_arena(perm_arena),
       temp_arena(temp_arena),
       work_queue(work_queue),
@@ -248,7 +249,7 @@ Game::Game(MemoryArena& perm_arena, MemoryArena& temp_arena, WorkQueue& work_que
       dispatcher(),
       connection(perm_arena, temp_arena, work_queue, dispatcher),
       player_manager(perm_arena, connection, dispatcher),
-      weapon_manager(temp_arena, connection, player_manager, dispatcher, animation),
+      weapon_manager(temp_arena, connection, player_manager, dispatcher, animation, thread_pool),
       brick_manager(perm_arena, connection, player_manager, dispatcher),
       camera(Vector2f((float)width, (float)height), Vector2f(0, 0), 1.0f / 16.0f),
       ui_camera(Vector2f((float)width, (float)height), Vector2f(0, 0), 1.0f),
@@ -256,7 +257,8 @@ Game::Game(MemoryArena& perm_arena, MemoryArena& temp_arena, WorkQueue& work_que
       chat(dispatcher, connection, player_manager),
       soccer(player_manager),
       ship_controller(player_manager, weapon_manager, dispatcher),
-      radar(player_manager) {
+      radar(player_manager),
+      danger_forecast(connection, player_manager, weapon_manager) {
   dispatcher.Register(ProtocolS2C::FlagPosition, OnFlagPositionPkt, this);
   dispatcher.Register(ProtocolS2C::FlagClaim, OnFlagClaimPkt, this);
   dispatcher.Register(ProtocolS2C::PlayerId, OnPlayerIdPkt, this);
@@ -4,6 +4,7 @@
 #include <zero/game/BrickManager.h>
 #include <zero/game/Camera.h>
 #include <zero/game/ChatController.h>
+#include <zero/game/DangerForecast.h>
 #include <zero/game/InputState.h>
 #include <zero/game/Memory.h>
 #include <zero/game/PlayerManager.h>
@@ -68,6 +69,7 @@ struct Game {
   Soccer soccer;
   ShipController ship_controller;
   Radar radar;
+  DangerForecast danger_forecast;
   float fps;
   int mapzoom = 0;
   float jitter_time = 0.0f;
@@ -93,7 +95,8 @@ struct Game {
   u32 last_green_tick = 0;
   u32 last_green_collision_tick = 0;
 
-  Game(MemoryArena& perm_arena, MemoryArena& temp_arena, WorkQueue& work_queue, int width, int height);
+  Game(MemoryArena& perm_arena, MemoryArena& temp_arena, WorkQueue& work_queue, ThreadPool& thread_pool, int width,
+       int height);
 
   GameInitializeResult Initialize(InputState& input);
   void Cleanup();
@@ -37,7 +37,7 @@ struct HashMap {
 
     Element* element = elements[bucket];
     while (element) {
-      if (element->value == value) {
+      if (element->key == key) {
         break;
       }
       element = element->next;
@@ -62,12 +62,12 @@ struct InputState {
 
   void Clear() { actions = 0; }
 
-  void ClearWeapons() {
-    u32 movement_mask = (1 << (u32)InputAction::Left) | (1 << (u32)InputAction::Right) |
-                        (1 << (u32)InputAction::Forward) | (1 << (u32)InputAction::Backward) |
-                        (1 << (u32)InputAction::Afterburner);
-    actions &= movement_mask;
-  }
+  // The actions that are held down rather than pressed once.
+  static constexpr u32 kMovementMask = (1 << (u32)InputAction::Left) | (1 << (u32)InputAction::Right) |
+                                       (1 << (u32)InputAction::Forward) | (1 << (u32)InputAction::Backward) |
+                                       (1 << (u32)InputAction::Afterburner);
+
+  void ClearWeapons() { actions &= kMovementMask; }
 
   void SetAction(InputAction action, bool value) {
     size_t action_bit = (size_t)action;
@@ -9,9 +9,14 @@
 #include <zero/game/Clock.h>
 #include <zero/game/GameEvent.h>
 #include <zero/game/Logger.h>
+#include <zero/game/Platform.h>
 #include <zero/game/PlayerManager.h>
+#include <zero/game/VisibilitySet.h>
+#include <zero/game/WallSegments.h>
 #include <zero/game/net/Connection.h>
 
+#include <algorithm>
+
 namespace zero {
 
 template <int a, int b, int c, int d>
@@ -603,32 +608,44 @@ size_t Map::GetAllOccupiedRects(Vector2f position, float radius, u32 frequency,
 }
 
 bool Map::Load(MemoryArena& arena, const char* filename) {
-  FILE* file = fopen(filename, "rb");
+  size_t size = 0;
+  u8* mapped = platform.MapFile(filename, &size);
 
-  if (!file) {
+  if (!mapped) {
     return false;
   }
 
-  fseek(file, 0, SEEK_END);
-  size_t size = ftell(file);
-  fseek(file, 0, SEEK_SET);
+  return LoadMapped(arena, filename, mapped, size);
+}
 
-  if (size <= 0) {
-    fclose(file);
-    return false;
-  }
+bool Map::LoadMapped(MemoryArena& arena, const char* filename, u8* mapping, size_t size) {
+  Unload();
 
-  // Maps are allocated in their own arena so they are freed automatically when the arena is reset
-  data = (char*)arena.Allocate(size);
-  if (!data) return false;
+  // The tiles are decoded straight out of the mapping, so the file is never copied into the arena.
+  data = (char*)mapping;
+  data_size = size;
+  data_mapped = true;
+
+  return LoadFromMemory(arena, filename, nullptr, size);
+}
 
-  size_t read_size = fread(data, 1, size, file);
-  if (read_size != size) {
-    Log(LogLevel::Warning, "Map load failed to read entire file: %s", filename);
+void Map::Unload() {
+  if (data_mapped) {
+    platform.UnmapFile((u8*)data, data_size);
+    data_mapped = false;
   }
-  fclose(file);
 
-  return LoadFromMemory(arena, filename, nullptr, size);
+  data = nullptr;
+  data_size = 0;
+
+  regions.clear();
+  region_map.clear();
+  region_set_ids.clear();
+  region_set_offsets.clear();
+  region_set_entries.clear();
+  regions_parsed = false;
+
+  ++tile_epoch;
 }
 
 bool Map::LoadFromMemory(MemoryArena& arena, const char* filename, const u8* raw_data, size_t size) {
@@ -637,6 +654,8 @@ bool Map::LoadFromMemory(MemoryArena& arena, const char* filename, const u8* raw
   strcpy(this->filename, filename);
 
   if (raw_data) {
+    Unload();
+
     // Maps are allocated in their own arena so they are freed automatically when the arena is reset
     data = (char*)arena.Allocate(size);
     data_size = size;
@@ -647,35 +666,60 @@ bool Map::LoadFromMemory(MemoryArena& arena, const char* filename, const u8* raw
 
   if (!data) return false;
 
+  // Any regions from the previous map are invalid now. They will be parsed again on first use.
+  regions.clear();
+  region_map.clear();
+  region_set_ids.clear();
+  region_set_offsets.clear();
+  region_set_entries.clear();
+  regions_parsed = false;
+
   tiles = arena.Allocate(1024 * 1024);
   if (!tiles) return false;
 
+  ++tile_epoch;
+
   size_t pos = 0;
 
-  if (data[0] == 'B' && data[1] == 'M') {
+  if (size >= 6 && data[0] == 'B' && data[1] == 'M') {
     pos = *(u32*)(data + 2);
   }
 
-  memset(tiles, 0, 1024 * 1024);
+  if (pos > size) return false;
 
-  // Expand tile data out into full grid
-  size_t start = pos;
+  memset(tiles, 0, 1024 * 1024);
 
   size_t tile_count = (size - pos) / sizeof(Tile);
-  Tile* tiles = (Tile*)(data + pos);
+  const Tile* tiles = (const Tile*)(data + pos);
 
-  this->door_count = GetTileCount(tiles, tile_count, kTileIdFirstDoor, kTileIdLastDoor);
+  // Count every tile id in a single pass so the door and animated tile lists can be allocated up front.
+  size_t id_counts[256] = {};
+  for (size_t tile_index = 0; tile_index < tile_count; ++tile_index) {
+    ++id_counts[tiles[tile_index].id];
+  }
+
+  this->door_count = 0;
+  for (int id = kTileIdFirstDoor; id <= kTileIdLastDoor; ++id) {
+    this->door_count += id_counts[id];
+  }
   this->doors = memory_arena_push_type_count(&arena, Tile, this->door_count);
 
+  // Lookup from tile id to animated tile index so each tile doesn't need to be checked against every animated id.
+  s8 animated_lookup[256];
+  memset(animated_lookup, -1, sizeof(animated_lookup));
+
   for (size_t i = 0; i < kAnimatedTileCount; ++i) {
+    animated_lookup[kAnimatedIds[i]] = (s8)i;
+
     animated_tiles[i].index = 0;
-    animated_tiles[i].count = GetTileCount(tiles, tile_count, kAnimatedIds[i], kAnimatedIds[i]);
+    animated_tiles[i].count = id_counts[kAnimatedIds[i]];
     animated_tiles[i].tiles = memory_arena_push_type_count(&arena, Tile, animated_tiles[i].count);
   }
 
+  // Expand tile data out into full grid
   size_t door_index = 0;
   for (size_t tile_index = 0; tile_index < tile_count; ++tile_index) {
-    Tile* tile = tiles + tile_index;
+    const Tile* tile = tiles + tile_index;
 
     this->tiles[tile->y * 1024 + tile->x] = tile->id;
 
@@ -684,29 +728,303 @@ bool Map::LoadFromMemory(MemoryArena& arena, const char* filename, const u8* raw
       *door = *tile;
     }
 
-    for (size_t i = 0; i < kAnimatedTileCount; ++i) {
-      if (tile->id == kAnimatedIds[i]) {
-        animated_tiles[i].tiles[animated_tiles[i].index++] = *tile;
+    s8 animated_index = animated_lookup[tile->id];
 
-        for (size_t j = 0; j < kAnimatedTileSizes[i]; ++j) {
-          size_t y = tile->y + j;
+    if (animated_index >= 0) {
+      size_t i = (size_t)animated_index;
 
-          for (size_t k = 0; k < kAnimatedTileSizes[i]; ++k) {
-            size_t x = tile->x + k;
+      animated_tiles[i].tiles[animated_tiles[i].index++] = *tile;
 
-            this->tiles[y * 1024 + x] = tile->id;
-          }
+      for (size_t j = 0; j < kAnimatedTileSizes[i]; ++j) {
+        size_t y = tile->y + j;
+
+        for (size_t k = 0; k < kAnimatedTileSizes[i]; ++k) {
+          size_t x = tile->x + k;
+
+          this->tiles[y * 1024 + x] = tile->id;
         }
       }
     }
   }
 
+  clearance = arena.Allocate(1024 * 1024);
+  if (!clearance) return false;
+
+  BuildClearance();
+
   return true;
 }
 
-void Map::ParseRegions() {
+void Map::BuildClearance() {
+  for (s32 y = 0; y < 1024; ++y) {
+    for (s32 x = 0; x < 1024; ++x) {
+      // Doors are still their closed id when the map is loaded, so they count as solid here.
+      if (zero::IsSolid(tiles[y * 1024 + x])) {
+        clearance[y * 1024 + x] = 0;
+        continue;
+      }
+
+      s32 distance = std::min(std::min(x + 1, y + 1), std::min(1024 - x, 1024 - y));
+
+      clearance[y * 1024 + x] = (u8)std::min(distance, (s32)kMaxTileClearance);
+    }
+  }
+
+  // Two pass chamfer transform. Every neighbor has a cost of one, so this gives the exact Chebyshev distance.
+  for (s32 y = 0; y < 1024; ++y) {
+    for (s32 x = 0; x < 1024; ++x) {
+      s32 distance = clearance[y * 1024 + x];
+
+      if (x > 0) distance = std::min(distance, clearance[y * 1024 + x - 1] + 1);
+
+      if (y > 0) {
+        distance = std::min(distance, clearance[(y - 1) * 1024 + x] + 1);
+
+        if (x > 0) distance = std::min(distance, clearance[(y - 1) * 1024 + x - 1] + 1);
+        if (x < 1023) distance = std::min(distance, clearance[(y - 1) * 1024 + x + 1] + 1);
+      }
+
+      clearance[y * 1024 + x] = (u8)distance;
+    }
+  }
+
+  for (s32 y = 1023; y >= 0; --y) {
+    for (s32 x = 1023; x >= 0; --x) {
+      s32 distance = clearance[y * 1024 + x];
+
+      if (x < 1023) distance = std::min(distance, clearance[y * 1024 + x + 1] + 1);
+
+      if (y < 1023) {
+        distance = std::min(distance, clearance[(y + 1) * 1024 + x] + 1);
+
+        if (x > 0) distance = std::min(distance, clearance[(y + 1) * 1024 + x - 1] + 1);
+        if (x < 1023) distance = std::min(distance, clearance[(y + 1) * 1024 + x + 1] + 1);
+      }
+
+      clearance[y * 1024 + x] = (u8)distance;
+    }
+  }
+}
+
+void Map::LowerClearance(u16 x, u16 y) {
+  s32 start_x = std::max((s32)x - kMaxTileClearance, 0);
+  s32 start_y = std::max((s32)y - kMaxTileClearance, 0);
+  s32 end_x = std::min((s32)x + kMaxTileClearance, 1023);
+  s32 end_y = std::min((s32)y + kMaxTileClearance, 1023);
+
+  for (s32 check_y = start_y; check_y <= end_y; ++check_y) {
+    for (s32 check_x = start_x; check_x <= end_x; ++check_x) {
+      s32 distance = std::max(abs(check_x - (s32)x), abs(check_y - (s32)y));
+      u8& current = clearance[check_y * 1024 + check_x];
+
+      if (distance < current) {
+        current = (u8)distance;
+      }
+    }
+  }
+}
+
+bool Map::IsAreaOpen(s32 start_x, s32 start_y, s32 end_x, s32 end_y) const {
+  if (!clearance) return false;
+  if (start_x > end_x || start_y > end_y) return true;
+  if (start_x < 0 || start_y < 0 || end_x > 1023 || end_y > 1023) return false;
+
+  s32 center_x = (start_x + end_x) / 2;
+  s32 center_y = (start_y + end_y) / 2;
+  s32 extent_x = std::max(center_x - start_x, end_x - center_x);
+  s32 extent_y = std::max(center_y - start_y, end_y - center_y);
+  s32 extent = std::max(extent_x, extent_y);
+
+  u8 distance = clearance[center_y * 1024 + center_x];
+
+  if (distance > extent) return true;
+  if (distance == 0) return false;
+
+  // The center can't cover the whole area, so split it along the longer side and check each half.
+  if (end_x - start_x >= end_y - start_y) {
+    return IsAreaOpen(start_x, start_y, center_x, end_y) && IsAreaOpen(center_x + 1, start_y, end_x, end_y);
+  }
+
+  return IsAreaOpen(start_x, start_y, end_x, center_y) && IsAreaOpen(start_x, center_y + 1, end_x, end_y);
+}
+
+void RegionBitset::Build(std::vector<RegionRun> runs) {
+  data.clear();
+  this->runs.clear();
+  row_offsets.clear();
+
+  start_x = start_y = end_x = end_y = 0;
+
+  std::sort(runs.begin(), runs.end(), [](const RegionRun& a, const RegionRun& b) {
+    if (a.y != b.y) return a.y < b.y;
+    return a.start_x < b.start_x;
+  });
+
+  // Merge overlapping and touching runs so each tile belongs to exactly one run.
+  for (const RegionRun& run : runs) {
+    if (!this->runs.empty()) {
+      RegionRun& last = this->runs.back();
+
+      if (last.y == run.y && (size_t)run.start_x <= (size_t)last.end_x + 1) {
+        if (run.end_x > last.end_x) last.end_x = run.end_x;
+        continue;
+      }
+    }
+
+    this->runs.push_back(run);
+  }
+
+  if (this->runs.empty()) return;
+
+  start_x = 0xFFFF;
+  start_y = this->runs.front().y;
+  end_y = this->runs.back().y;
+
+  for (const RegionRun& run : this->runs) {
+    if (run.start_x < start_x) start_x = run.start_x;
+    if (run.end_x > end_x) end_x = run.end_x;
+  }
+
+  size_t width = (size_t)end_x - (size_t)start_x + 1;
+  size_t height = (size_t)end_y - (size_t)start_y + 1;
+
+  data.resize((width * height + (kSliceBits - 1)) / kSliceBits, 0);
+  row_offsets.resize(height + 1, 0);
+
+  size_t run_index = 0;
+
+  for (size_t row = 0; row < height; ++row) {
+    row_offsets[row] = (u32)run_index;
+
+    while (run_index < this->runs.size() && this->runs[run_index].y == start_y + row) {
+      const RegionRun& run = this->runs[run_index++];
+
+      // Runs are contiguous in the row-major bit layout, so fill whole slices with masks.
+      size_t bit = row * width + ((size_t)run.start_x - start_x);
+      size_t bit_end = bit + ((size_t)run.end_x - run.start_x) + 1;
+
+      while (bit < bit_end) {
+        size_t slice_bit = bit % kSliceBits;
+        size_t count = kSliceBits - slice_bit;
+
+        if (count > bit_end - bit) {
+          count = bit_end - bit;
+        }
+
+        SliceType mask = count == kSliceBits ? ~(SliceType)0 : (((SliceType)1 << count) - 1) << slice_bit;
+
+        data[bit / kSliceBits] |= mask;
+        bit += count;
+      }
+    }
+  }
+
+  row_offsets[height] = (u32)run_index;
+}
+
+namespace elvl {
+
+void DecodeRegionRuns(const u8* data, size_t size, std::vector<RegionRun>& runs) {
+  // The current tile being processed for the run-length encoded data.
+  int current_x = 0;
+  int current_y = 0;
+
+  auto add_run = [&runs](int x, int y, int count) {
+    if (y > 1023 || x > 1023) return;
+
+    int end_x = x + count - 1;
+    if (end_x > 1023) end_x = 1023;
+
+    runs.push_back({(u16)y, (u16)x, (u16)end_x});
+  };
+
+  const u8* tile_ptr = data;
+  const u8* end = data + size;
+
+  while (tile_ptr < end) {
+    u8 sequence_type = *tile_ptr >> 5;
+
+    // This sequence type is based on the first 3 bits.
+    // The 1-32 and 1-1024 of the same type are used for optimization since it would require more bits
+    // to encode 1024 always. By using 3 bits to determine, the 1-32 can fit in the remaining 5 bits
+    // instead of having to have an extra byte that would be needed for 1024.
+    //
+    // Since a single tile would be required for the existence of one of these types, it is encoded as
+    // +1 from the remaining bit value. That allows 5 bits to be used for 31(32) since 32 wouldn't
+    // normally fit.
+    bool long_run = sequence_type & 1;
+
+    if (long_run && tile_ptr + 1 >= end) break;
+
+    int run = long_run ? ((((tile_ptr[0] & 3) << 8) | tile_ptr[1]) + 1) : ((tile_ptr[0] & 0x1F) + 1);
+
+    tile_ptr += long_run ? 2 : 1;
+
+    switch (sequence_type) {
+      case 0:    // 1-32 Empty tiles in a row
+      case 1: {  // 1-1024 Empty tiles in a row
+        current_x += run;
+        if (current_x >= 1024) {
+          current_x = 0;
+          current_y++;
+        }
+      } break;
+      case 2:    // 1-32 Present tiles in a row
+      case 3: {  // 1-1024 Present tiles in a row
+        add_run(current_x, current_y, run);
+
+        current_x += run;
+        if (current_x >= 1024) {
+          current_x = 0;
+          current_y++;
+        }
+      } break;
+      case 4:    // 1-32 Rows of empty
+      case 5: {  // 1-1024 Rows of empty
+        current_x = 0;
+        current_y += run;
+      } break;
+      case 6:    // Repeat last row 1-32 times
+      case 7: {  // Repeat last row 1-1024 times
+        current_x = 0;
+
+        // Find the runs of the previous row at the end of the list, skipping any partial runs of the current row.
+        size_t previous_end = runs.size();
+        while (previous_end > 0 && runs[previous_end - 1].y == current_y) {
+          --previous_end;
+        }
+
+        size_t previous_begin = previous_end;
+        while (previous_begin > 0 && runs[previous_begin - 1].y == current_y - 1) {
+          --previous_begin;
+        }
+
+        for (int i = 0; i < run; ++i) {
+          for (size_t j = previous_begin; j < previous_end; ++j) {
+            RegionRun previous = runs[j];
+
+            add_run(previous.start_x, current_y + i, previous.end_x - previous.start_x + 1);
+          }
+        }
+
+        current_y += run;
+      } break;
+    }
+  }
+}
+
+}  // namespace elvl
+
+void Map::ParseRegions() const {
   using namespace elvl;
 
+  if (regions_parsed) return;
+
+  // Mark as parsed even if there's no elvl data so the lookup isn't attempted on every region query.
+  regions_parsed = true;
+
+  if (!this->data || this->data_size < 10) return;
+
   // The offset to elvl data will be stored in the bitmap reserved section.
   std::size_t elvl_metadata_offset = *(u32*)(&this->data[6]);
 
@@ -722,9 +1040,6 @@ void Map::ParseRegions() {
     u32 size;
   };
 
-  this->regions.clear();
-  this->region_map.clear();
-
   if (!elvl_metadata_offset || elvl_metadata_offset + sizeof(ElvlMetadataHeader) >= this->data_size) return;
 
   ElvlMetadataHeader* header = (ElvlMetadataHeader*)(this->data + elvl_metadata_offset);
@@ -752,9 +1067,8 @@ void Map::ParseRegions() {
         regions.emplace_back();
         Region& region = regions.back();
 
-        // The current tile being processed for the run-length encoded data.
-        int current_x = 0;
-        int current_y = 0;
+        // Collect all of the tile runs first so the bitset can be allocated and filled once.
+        std::vector<RegionRun> region_runs;
 
         while (sub_data < chunk_data + chunk_header->size) {
           ELvlChunkHeader* subchunk = (ELvlChunkHeader*)sub_data;
@@ -768,124 +1082,7 @@ void Map::ParseRegions() {
             } break;
             case FourCC<'r', 'T', 'I', 'L'>::value: {
               // Tile data
-              u8* tile_ptr = sub_data;
-
-              while (tile_ptr < sub_data + subchunk->size) {
-                u8 sequence_type = *tile_ptr >> 5;
-
-                // This sequence type is based on the first 3 bits.
-                // The 1-32 and 1-1024 of the same type are used for optimization since it would require more bits
-                // to encode 1024 always. By using 3 bits to determine, the 1-32 can fit in the remaining 5 bits
-                // instead of having to have an extra byte that would be needed for 1024.
-                //
-                // Since a single tile would be required for the existence of one of these types, it is encoded as
-                // +1 from the remaining bit value. That allows 5 bits to be used for 31(32) since 32 wouldn't
-                // normally fit.
-                switch (sequence_type) {
-                  case 0: {  // 1-32 Empty tiles in a row
-                    u8 run = (tile_ptr[0] & 0x1F) + 1;
-
-                    current_x += run;
-                    if (current_x >= 1024) {
-                      current_x = 0;
-                      current_y++;
-                    }
-
-                    tile_ptr += 1;
-                  } break;
-                  case 1: {  // 1-1024 Empty tiles in a row
-                    u16 run = (((tile_ptr[0] & 3) << 8) | tile_ptr[1]) + 1;
-
-                    current_x += run;
-                    if (current_x >= 1024) {
-                      current_x = 0;
-                      current_y++;
-                    }
-
-                    tile_ptr += 2;
-                  } break;
-                  case 2: {  // 1-32 Present tiles in a row
-                    u8 run = (tile_ptr[0] & 0x1F) + 1;
-
-                    for (int i = 0; i < run; ++i) {
-                      region.SetTile(current_x + i, current_y);
-                    }
-
-                    current_x += run;
-                    if (current_x >= 1024) {
-                      current_x = 0;
-                      current_y++;
-                    }
-
-                    tile_ptr += 1;
-                  } break;
-                  case 3: {  // 1-1024 Present tiles in a row
-                    u16 run = (((tile_ptr[0] & 3) << 8) | tile_ptr[1]) + 1;
-
-                    for (int i = 0; i < run; ++i) {
-                      region.SetTile(current_x + i, current_y);
-                    }
-
-                    current_x += run;
-                    if (current_x >= 1024) {
-                      current_x = 0;
-                      current_y++;
-                    }
-
-                    tile_ptr += 2;
-                  } break;
-                  case 4: {  // 1-32 Rows of empty
-                    u8 run = (tile_ptr[0] & 0x1F) + 1;
-
-                    current_x = 0;
-                    current_y += run;
-
-                    tile_ptr += 1;
-                  } break;
-                  case 5: {  // 1-1024 Rows of empty
-                    u16 run = (((tile_ptr[0] & 3) << 8) | tile_ptr[1]) + 1;
-
-                    current_x = 0;
-                    current_y += run;
-
-                    tile_ptr += 2;
-                  } break;
-                  case 6: {  // Repeat last row 1-32 times
-                    u8 run = (tile_ptr[0] & 0x1F) + 1;
-
-                    current_x = 0;
-
-                    for (int i = 0; i < run; ++i) {
-                      for (int x = 0; x < 1024; ++x) {
-                        if (region.InRegion(x, current_y - 1)) {
-                          region.SetTile(x, current_y + i);
-                        }
-                      }
-                    }
-
-                    current_y += run;
-
-                    tile_ptr += 1;
-                  } break;
-                  case 7: {  // Repeat last row 1-204 times
-                    u16 run = (((tile_ptr[0] & 3) << 8) | tile_ptr[1]) + 1;
-
-                    current_x = 0;
-
-                    for (int i = 0; i < run; ++i) {
-                      for (int x = 0; x < 1024; ++x) {
-                        if (region.InRegion(x, current_y - 1)) {
-                          region.SetTile(x, current_y + i);
-                        }
-                      }
-                    }
-
-                    current_y += run;
-
-                    tile_ptr += 2;
-                  } break;
-                }
-              }
+              DecodeRegionRuns(sub_data, subchunk->size, region_runs);
             } break;
             case FourCC<'r', 'B', 'S', 'E'>::value: {
               // Base
@@ -914,6 +1111,8 @@ void Map::ParseRegions() {
           // Align the pointer to 4 byte boundary.
           sub_data += (subchunk->size + 3) & ~3;
         }
+
+        region.tiles.Build(std::move(region_runs));
       } break;
       case FourCC<'T', 'S', 'E', 'T'>::value: {
         // Tileset data
@@ -932,15 +1131,93 @@ void Map::ParseRegions() {
   }
 
   // Create a mapping from names to region data.
+  // The bitsets are built from runs, so they are already tightly bound and don't need to be compacted.
   for (auto& region : regions) {
     region_map[region.name] = &region;
+  }
+
+  BuildRegionIndex();
+}
+
+void Map::BuildRegionIndex() const {
+  region_set_ids.clear();
+  region_set_offsets.clear();
+  region_set_entries.clear();
+
+  if (regions.empty()) return;
+
+  region_set_ids.resize(1024 * 1024, 0);
+
+  // Interned sets as lists of region indices. Set 0 is the empty set.
+  std::vector<std::vector<u16>> sets(1);
+  // Maps an existing set id to the set id that results from adding the current region to it.
+  std::vector<u16> transitions;
+
+  constexpr size_t kMaxRegionSets = 0xFFFF;
+
+  // Regions are added in index order, so every tile with the same membership follows the same chain of transitions.
+  // This keeps the sets unique without having to hash their contents.
+  for (size_t region_index = 0; region_index < regions.size(); ++region_index) {
+    const RegionBitset& bitset = regions[region_index].tiles;
+
+    if (bitset.data.empty()) continue;
+
+    transitions.assign(sets.size(), 0xFFFF);
+
+    bool overflow = false;
+
+    bitset.ForEachRun([&](const RegionRun& run) {
+      if (overflow) return;
+
+      u16* set_ids = region_set_ids.data() + (size_t)run.y * 1024;
+
+      for (size_t x = run.start_x; x <= run.end_x; ++x) {
+        u16 set_id = set_ids[x];
+        u16 next_id = transitions[set_id];
+
+        if (next_id == 0xFFFF) {
+          if (sets.size() >= kMaxRegionSets) {
+            overflow = true;
+            return;
+          }
+
+          next_id = (u16)sets.size();
+
+          std::vector<u16> next_set = sets[set_id];
+          next_set.push_back((u16)region_index);
+          sets.push_back(std::move(next_set));
+
+          transitions[set_id] = next_id;
+        }
+
+        set_ids[x] = next_id;
+      }
+    });
+
+    if (overflow) {
+      Log(LogLevel::Warning, "Map %s has too many overlapping regions to index.", filename);
+
+      region_set_ids.clear();
+      return;
+    }
+  }
 
-    // Compact the tiles so they take up less memory.
-    region.tiles.Compact();
+  region_set_offsets.reserve(sets.size() + 1);
+
+  for (auto& set : sets) {
+    region_set_offsets.push_back((u32)region_set_entries.size());
+
+    for (u16 region_index : set) {
+      region_set_entries.push_back(&regions[region_index]);
+    }
   }
+
+  region_set_offsets.push_back((u32)region_set_entries.size());
 }
 
 const elvl::Region* Map::GetRegionByName(const char* name) const {
+  EnsureRegions();
+
   auto iter = this->region_map.find(name);
   if (iter == this->region_map.end()) return nullptr;
   return iter->second;
@@ -955,18 +1232,50 @@ bool Map::InRegion(const char* name, Vector2f position) const {
 }
 
 std::vector<const elvl::Region*> Map::GetRegions(u16 x, u16 y) const {
-  std::vector<const elvl::Region*> result;
+  elvl::RegionSet set = GetRegionSet(x, y);
 
-  for (auto& region : regions) {
-    if (region.InRegion(x, y)) {
-      result.push_back(&region);
+  return std::vector<const elvl::Region*>(set.begin(), set.end());
+}
+
+elvl::RegionSet Map::GetRegionSet(u16 x, u16 y) const {
+  EnsureRegions();
+
+  elvl::RegionSet result = {};
+
+  if (x > 1023 || y > 1023) return result;
+
+  if (region_set_ids.empty()) {
+    // There are no regions or there were too many overlapping regions to build the index.
+    if (regions.empty()) return result;
+
+    // Fall back to building the set in temporary storage. This is only used for pathological maps.
+    thread_local std::vector<const elvl::Region*> fallback;
+
+    fallback.clear();
+
+    for (auto& region : regions) {
+      if (region.InRegion(x, y)) {
+        fallback.push_back(&region);
+      }
     }
+
+    result.regions = fallback.data();
+    result.count = fallback.size();
+    return result;
   }
 
+  u16 set_id = region_set_ids[(size_t)y * 1024 + x];
+  u32 begin = region_set_offsets[set_id];
+
+  result.regions = region_set_entries.data() + begin;
+  result.count = region_set_offsets[set_id + 1] - begin;
+
   return result;
 }
 
 bool Map::InRegion(const char* name, u16 x, u16 y) const {
+  EnsureRegions();
+
   auto iter = region_map.find(name);
 
   if (iter == region_map.end()) return false;
@@ -977,37 +1286,21 @@ bool Map::InRegion(const char* name, u16 x, u16 y) const {
 std::vector<Tile> Map::GetRegionTiles(const elvl::Region& region) const {
   std::vector<Tile> result;
 
-  for (u16 y = 0; y < 1024; ++y) {
-    for (u16 x = 0; x < 1024; ++x) {
-      if (region.InRegion(x, y)) {
-        Tile tile = {};
+  region.tiles.ForEachRun([&](const RegionRun& run) {
+    for (u16 x = run.start_x; x <= run.end_x; ++x) {
+      Tile tile = {};
 
-        tile.x = x;
-        tile.y = y;
-        tile.id = GetTileId(x, y);
+      tile.x = x;
+      tile.y = run.y;
+      tile.id = GetTileId(x, run.y);
 
-        result.push_back(tile);
-      }
+      result.push_back(tile);
     }
-  }
+  });
 
   return result;
 }
 
-size_t Map::GetTileCount(Tile* tiles, size_t tile_count, TileId id_begin, TileId id_end) {
-  size_t count = 0;
-
-  for (size_t i = 0; i < tile_count; ++i) {
-    Tile* tile = tiles + i;
-
-    if (tile->id >= id_begin && tile->id <= id_end) {
-      ++count;
-    }
-  }
-
-  return count;
-}
-
 void Map::UpdateDoors(const ArenaSettings& settings, bool force_update) {
   u32 current_tick = GetCurrentTick();
 
@@ -1140,6 +1433,10 @@ void Map::SeedDoors(u32 seed) {
     TileId previous_id = tiles[door->y * 1024 + door->x];
     tiles[door->y * 1024 + door->x] = id;
 
+    if (previous_id != id) {
+      ++tile_epoch;
+    }
+
     // If the tile just changed from open to closed then check for collisions
     if (self && self->ship < 8 && previous_id == kOpenDoorId && id != kOpenDoorId) {
       Vector2f door_position((float)door->x, (float)door->y);
@@ -1259,8 +1556,14 @@ TileId Map::GetTileId(u16 x, u16 y) const {
 void Map::SetTileId(u16 x, u16 y, TileId id) {
   if (!tiles) return;
   if (x >= 1024 || y >= 1024) return;
+  if (tiles[y * 1024 + x] == id) return;
 
   tiles[y * 1024 + x] = id;
+  ++tile_epoch;
+
+  if (clearance && zero::IsSolid(id)) {
+    LowerClearance(x, y);
+  }
 }
 
 TileId Map::GetTileId(const Vector2f& position) const {
@@ -1293,12 +1596,8 @@ bool Map::IsDoor(u16 x, u16 y) const {
 bool Map::IsSolid(u16 x, u16 y, u32 frequency) const {
   TileId id = GetTileId(x, y);
 
-  if (id == 250 && brick_manager) {
-    Brick* brick = brick_manager->GetBrick(x, y);
-
-    if (brick && brick->team == frequency) {
-      return false;
-    }
+  if (id == 250 && brick_manager && brick_manager->GetBrickTeam(x, y) == frequency) {
+    return false;
   }
 
   return zero::IsSolid(id);
@@ -1307,12 +1606,8 @@ bool Map::IsSolid(u16 x, u16 y, u32 frequency) const {
 bool Map::IsSolidEmptyDoors(u16 x, u16 y, u32 frequency) const {
   TileId id = GetTileId(x, y);
 
-  if (id == 250 && brick_manager) {
-    Brick* brick = brick_manager->GetBrick(x, y);
-
-    if (brick && brick->team == frequency) {
-      return false;
-    }
+  if (id == 250 && brick_manager && brick_manager->GetBrickTeam(x, y) == frequency) {
+    return false;
   }
 
   return zero::IsSolidEmptyDoors(id);
@@ -1430,6 +1725,27 @@ CastResult Map::CastTo(const Vector2f& from, const Vector2f& to, u32 frequency)
   return Cast(from, direction, dist, frequency);
 }
 
+CastResult Map::CastWalls(const Vector2f& from, const Vector2f& direction, float max_distance, u32 frequency) const {
+  if (wall_segments && wall_segments->checksum == checksum) {
+    return wall_segments->Cast(*this, from, direction, max_distance, frequency);
+  }
+
+  return Cast(from, direction, max_distance, frequency);
+}
+
+bool Map::HasLineOfSight(const Vector2f& from, const Vector2f& to, u32 frequency) const {
+  if (visibility && visibility->checksum == checksum) {
+    CellVisibility cell_visibility = visibility->GetVisibility(from, to);
+
+    if (cell_visibility == CellVisibility::Occluded) return false;
+
+    // Bricks aren't part of the visibility set, so any active brick could be blocking a visible cell.
+    if (cell_visibility == CellVisibility::Visible && !(brick_manager && brick_manager->bricks)) return true;
+  }
+
+  return !CastTo(from, to, frequency).hit;
+}
+
 // Loop over entire casted area to find minimal tiles to check against.
 // When a solid tile is found, perform a minkowski sum so the new rect can be checked against a ray.
 CastResult Map::CastShip(Player* player, float radius, const Vector2f& to) const {
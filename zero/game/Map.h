@@ -13,13 +13,22 @@
 
 namespace zero {
 
+// A horizontal run of tiles within a single row. The end is inclusive.
+struct RegionRun {
+  u16 y;
+  u16 start_x;
+  u16 end_x;
+};
+
 // This uses a bitset to manage a tightly-bound region.
 // This saves memory over a full map bitset.
+// Build from runs when the full region is known. It allocates once and fills whole slices at a time.
 // Manually calling Fit when the boundary is known will have better performance than calling Set many times.
 // Recommended usage:
 // Fit 0, 1023, 0, 1023 to fully compact the region, fit it to one of the tiles in the set with shrink.
 struct RegionBitset {
   using SliceType = unsigned int;
+  static constexpr size_t kSliceBits = sizeof(SliceType) * 8;
 
   unsigned short start_x = 0;
   unsigned short start_y = 0;
@@ -29,6 +38,48 @@ struct RegionBitset {
 
   std::vector<SliceType> data;
 
+  // Sorted and merged runs of set tiles. Row y owns runs[row_offsets[y - start_y]] up to
+  // runs[row_offsets[y - start_y + 1]]. These only exist when built from runs and are dropped by Set.
+  std::vector<RegionRun> runs;
+  std::vector<u32> row_offsets;
+
+  // Replaces the contents of the bitset with the tiles covered by the runs. The runs don't need to be sorted.
+  void Build(std::vector<RegionRun> runs);
+
+  // Calls fn(const RegionRun&) for every run of set tiles in row order.
+  template <typename F>
+  void ForEachRun(F&& fn) const {
+    if (data.empty()) return;
+
+    if (!row_offsets.empty()) {
+      for (const RegionRun& run : runs) {
+        fn(run);
+      }
+      return;
+    }
+
+    // The runs were dropped by a modification, so recover them from the bits.
+    for (unsigned short y = start_y; y <= end_y; ++y) {
+      unsigned short x = start_x;
+
+      while (x <= end_x) {
+        if (!_Test(x, y)) {
+          ++x;
+          continue;
+        }
+
+        RegionRun run = {y, x, x};
+
+        while (run.end_x < end_x && _Test(run.end_x + 1, y)) {
+          ++run.end_x;
+        }
+
+        fn(run);
+        x = run.end_x + 1;
+      }
+    }
+  }
+
   bool Test(unsigned short x, unsigned short y) const {
     if (data.empty()) return false;
     if (x < start_x || x > end_x) return false;
@@ -40,33 +91,27 @@ struct RegionBitset {
   void Set(unsigned short x, unsigned short y, bool value) {
     bool shrinking = false;
 
+    runs.clear();
+    row_offsets.clear();
+
     if (!value && Test(x, y)) {
       // The value is being cleared and it's in our set, so we should clear it before shrinking.
-      size_t x_delta = (size_t)x - (size_t)start_x;
-      size_t y_delta = (size_t)y - (size_t)start_y;
-
-      size_t width = (size_t)end_x - (size_t)start_x + 1;
-      size_t total_index = (size_t)y_delta * width + (size_t)x_delta;
-      size_t slice_index = total_index / sizeof(SliceType);
-      size_t bit_index = total_index % sizeof(SliceType);
+      size_t total_index = GetBitIndex(x, y);
 
-      data[slice_index] &= ~(1 << bit_index);
+      data[total_index / kSliceBits] &= ~((SliceType)1 << (total_index % kSliceBits));
       shrinking = true;
     }
 
     Fit(x, x, y, y, shrinking);
 
-    size_t x_delta = (size_t)x - (size_t)start_x;
-    size_t y_delta = (size_t)y - (size_t)start_y;
-    size_t width = (size_t)end_x - (size_t)start_x + 1;
-    size_t total_index = (size_t)y_delta * width + (size_t)x_delta;
-    size_t slice_index = total_index / sizeof(SliceType);
-    size_t bit_index = total_index % sizeof(SliceType);
+    size_t total_index = GetBitIndex(x, y);
+    size_t slice_index = total_index / kSliceBits;
+    size_t bit_index = total_index % kSliceBits;
 
     if (value) {
-      data[slice_index] |= (1 << bit_index);
+      data[slice_index] |= ((SliceType)1 << bit_index);
     } else {
-      data[slice_index] &= ~(1 << bit_index);
+      data[slice_index] &= ~((SliceType)1 << bit_index);
     }
   }
 
@@ -98,9 +143,6 @@ struct RegionBitset {
       // Expand to include existing set data.
       for (unsigned short check_y = start_y; check_y <= end_y; ++check_y) {
         for (unsigned short check_x = start_x; check_x <= end_x; ++check_x) {
-          bool outside_region =
-              check_x < new_start_x || check_x > new_end_x || check_y < new_start_y || check_y > new_end_y;
-
           if (_Test(check_x, check_y)) {
             if (check_x < new_start_x) new_start_x = check_x;
             if (check_x > new_end_x) new_end_x = check_x;
@@ -116,12 +158,13 @@ struct RegionBitset {
       if (end_y > new_end_y) new_end_y = end_y;
     }
 
-    if (new_start_x != start_x || new_end_x != end_x || new_start_y != start_y || new_end_y != end_y) {
+    if (data.empty() || new_start_x != start_x || new_end_x != end_x || new_start_y != start_y ||
+        new_end_y != end_y) {
       size_t new_width = (size_t)(new_end_x - new_start_x + 1);
       size_t new_height = (size_t)(new_end_y - new_start_y + 1);
 
       size_t total_size = new_height * new_width;
-      size_t total_slices = (total_size + (sizeof(SliceType) - 1)) / sizeof(SliceType);
+      size_t total_slices = (total_size + (kSliceBits - 1)) / kSliceBits;
 
       std::vector<SliceType> new_data(total_slices);
 
@@ -134,16 +177,14 @@ struct RegionBitset {
               size_t y_delta = (size_t)check_y - (size_t)new_start_y;
 
               size_t total_index = (size_t)y_delta * new_width + (size_t)x_delta;
-              size_t slice_index = total_index / sizeof(SliceType);
-              size_t bit_index = total_index % sizeof(SliceType);
 
-              new_data[slice_index] |= (1 << bit_index);
+              new_data[total_index / kSliceBits] |= ((SliceType)1 << (total_index % kSliceBits));
             }
           }
         }
       }
 
-      data = new_data;
+      data = std::move(new_data);
 
       start_x = new_start_x;
       start_y = new_start_y;
@@ -153,17 +194,19 @@ struct RegionBitset {
   }
 
  private:
-  inline bool _Test(unsigned short x, unsigned short y) const {
+  inline size_t GetBitIndex(unsigned short x, unsigned short y) const {
     // Map into local space to get bit index.
-    unsigned short x_delta = x - start_x;
-    unsigned short y_delta = y - start_y;
-    unsigned short width = end_x - start_x + 1;
+    size_t x_delta = (size_t)x - (size_t)start_x;
+    size_t y_delta = (size_t)y - (size_t)start_y;
+    size_t width = (size_t)end_x - (size_t)start_x + 1;
 
-    size_t total_index = (size_t)y_delta * (size_t)width + (size_t)x_delta;
-    size_t slice_index = total_index / sizeof(SliceType);
-    size_t bit_index = total_index % sizeof(SliceType);
+    return y_delta * width + x_delta;
+  }
 
-    return data[slice_index] & (1 << bit_index);
+  inline bool _Test(unsigned short x, unsigned short y) const {
+    size_t total_index = GetBitIndex(x, y);
+
+    return data[total_index / kSliceBits] & ((SliceType)1 << (total_index % kSliceBits));
   }
 };
 
@@ -182,6 +225,8 @@ struct CastResult {
 
 struct ArenaSettings;
 struct BrickManager;
+struct VisibilitySet;
+struct WallSegments;
 
 using TileId = u8;
 
@@ -191,6 +236,7 @@ constexpr u32 kTileIdGoal = 172;
 constexpr int kTileIdFirstDoor = 162;
 constexpr int kTileIdLastDoor = 169;
 constexpr u32 kTileIdWormhole = 220;
+constexpr u8 kMaxTileClearance = 31;
 
 constexpr size_t kAnimatedTileCount = 7;
 
@@ -284,11 +330,30 @@ struct Region {
   }
 };
 
+// A view into one of the map's interned region sets. This is only valid until the map is reloaded.
+struct RegionSet {
+  const Region* const* regions;
+  size_t count;
+
+  inline const Region* const* begin() const { return regions; }
+  inline const Region* const* end() const { return regions + count; }
+};
+
+// Decodes the run-length encoded rTIL region tile data into row runs. Runs are appended in the encoded order.
+void DecodeRegionRuns(const u8* data, size_t size, std::vector<RegionRun>& runs);
+
 }  // namespace elvl
 
 struct Map {
+  // Memory maps the file and decodes the tiles directly out of the mapping.
+  // The mapping is kept alive until the next load so the elvl data can be parsed lazily without a copy.
   bool Load(MemoryArena& arena, const char* filename);
+  // Same as Load, but decodes a mapping that the caller already made. The map takes ownership of the mapping and
+  // releases it in Unload, even if loading fails.
+  bool LoadMapped(MemoryArena& arena, const char* filename, u8* mapping, size_t size);
   bool LoadFromMemory(MemoryArena& arena, const char* filename, const u8* data, size_t size);
+  // Releases the file mapping if the map was loaded from disk.
+  void Unload();
 
   bool IsSolid(u16 x, u16 y, u32 frequency) const;
   bool IsSolidEmptyDoors(u16 x, u16 y, u32 frequency) const;
@@ -322,6 +387,10 @@ struct Map {
   // Checks if a ship is currently overlapping any tiles.
   bool IsColliding(const Vector2f& position, float radius, u32 frequency) const;
 
+  // Returns true if no tile in the inclusive tile area could be solid for any frequency. This is answered from the
+  // clearance map, so large areas only need a few lookups.
+  bool IsAreaOpen(s32 start_x, s32 start_y, s32 end_x, s32 end_y) const;
+
   void UpdateDoors(const ArenaSettings& settings, bool force_update = false);
   void SeedDoors(u32 seed);
 
@@ -329,15 +398,33 @@ struct Map {
 
   CastResult Cast(const Vector2f& from, const Vector2f& direction, float max_distance, u32 frequency) const;
   CastResult CastTo(const Vector2f& from, const Vector2f& to, u32 frequency) const;
+  // Same result as Cast, but answered from the wall segments when they are available. This is faster for long rays
+  // such as weapon bounce prediction.
+  CastResult CastWalls(const Vector2f& from, const Vector2f& direction, float max_distance, u32 frequency) const;
+
+  // Returns true if there are no solid tiles between the two positions.
+  // The visibility set is checked first so only ambiguous queries need to cast.
+  bool HasLineOfSight(const Vector2f& from, const Vector2f& to, u32 frequency) const;
 
   CastResult CastShip(struct Player* player, float radius, const Vector2f& to) const;
 
   inline AnimatedTileSet& GetAnimatedTileSet(AnimatedTile type) { return animated_tiles[(size_t)type]; }
   inline const AnimatedTileSet& GetAnimatedTileSet(AnimatedTile type) const { return animated_tiles[(size_t)type]; }
 
+  // These copy the tile's region set into a new vector. Prefer GetRegionSet or ForEachRegion in per-frame code.
   std::vector<const elvl::Region*> GetRegions(Vector2f position) const;
   std::vector<const elvl::Region*> GetRegions(u16 x, u16 y) const;
 
+  // Allocation-free lookup of every region that contains the tile using the per-tile region index.
+  elvl::RegionSet GetRegionSet(u16 x, u16 y) const;
+
+  template <typename F>
+  inline void ForEachRegion(u16 x, u16 y, F&& fn) const {
+    for (const elvl::Region* region : GetRegionSet(x, y)) {
+      fn(*region);
+    }
+  }
+
   bool InRegion(const char* name, Vector2f position) const;
   bool InRegion(const char* name, u16 x, u16 y) const;
 
@@ -346,9 +433,9 @@ struct Map {
   // This is a fairly expensive operation, so the results should be cached after map is loaded once.
   std::vector<Tile> GetRegionTiles(const elvl::Region& region) const;
 
-  // This needs to be called manually to parse the regions from the data.
-  // Only do this if the regions will be used because they can use a lot of memory.
-  void ParseRegions();
+  // Regions are parsed lazily on the first region query, but this can be called to parse them ahead of time.
+  // Parsing only happens once per loaded map.
+  void ParseRegions() const;
 
   char filename[1024];
   u32 checksum = 0;
@@ -358,19 +445,49 @@ struct Map {
   char* data = nullptr;
   size_t data_size = 0;
   u8* tiles = nullptr;
+  // Incremented whenever any tile changes, including doors, bricks, and loading a new map.
+  u32 tile_epoch = 0;
 
   size_t door_count = 0;
   Tile* doors = nullptr;
 
+  // Chebyshev distance in tiles from each tile to the closest tile that could be solid, capped at kMaxTileClearance.
+  // The edge of the map counts as solid and so do doors whether they are open or not. Placing a brick lowers the
+  // distances around it, but they are never raised again, so the map only ever underestimates the open space.
+  u8* clearance = nullptr;
+
   BrickManager* brick_manager = nullptr;
+  // These are only used while their checksum matches the loaded map.
+  const VisibilitySet* visibility = nullptr;
+  const WallSegments* wall_segments = nullptr;
 
   AnimatedTileSet animated_tiles[kAnimatedTileCount];
 
-  std::vector<elvl::Region> regions;
-  std::unordered_map<std::string, elvl::Region*> region_map;
+  // These are lazily filled in by ParseRegions when they are first needed.
+  mutable std::vector<elvl::Region> regions;
+  mutable std::unordered_map<std::string, elvl::Region*> region_map;
 
  private:
-  size_t GetTileCount(Tile* tiles, size_t tile_count, TileId id_begin, TileId id_end);
+  inline void EnsureRegions() const {
+    if (!regions_parsed) ParseRegions();
+  }
+
+  void BuildRegionIndex() const;
+
+  void BuildClearance();
+  void LowerClearance(u16 x, u16 y);
+
+  mutable bool regions_parsed = false;
+
+  // Per-tile id of the interned set of regions that contain the tile. Set 0 is always the empty set.
+  // This is empty if the map has no regions.
+  mutable std::vector<u16> region_set_ids;
+  // Set i is stored in region_set_entries from region_set_offsets[i] to region_set_offsets[i + 1].
+  mutable std::vector<u32> region_set_offsets;
+  mutable std::vector<const elvl::Region*> region_set_entries;
+
+  // Set when data points into a read-only file mapping instead of arena memory.
+  bool data_mapped = false;
 };
 
 }  // namespace zero
@@ -16,8 +16,11 @@
 #include <Windows.h>
 
 #else
+#include <fcntl.h>
 #include <strings.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 #ifndef __ANDROID__
 #ifdef GLFW_AVAILABLE
@@ -253,6 +256,40 @@ int null_stricmp(const char* s1, const char* s2) {
   return _stricmp(s1, s2);
 }
 
+u8* MapFile(const char* filename, size_t* size) {
+  *size = 0;
+
+  HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE) return nullptr;
+
+  LARGE_INTEGER file_size = {};
+  if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0) {
+    CloseHandle(file);
+    return nullptr;
+  }
+
+  HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  // The mapping keeps its own reference to the file, so the file handle can be closed immediately.
+  CloseHandle(file);
+
+  if (!mapping) return nullptr;
+
+  u8* data = (u8*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  // The view keeps the mapping alive until it's unmapped.
+  CloseHandle(mapping);
+
+  if (!data) return nullptr;
+
+  *size = (size_t)file_size.QuadPart;
+  return data;
+}
+
+void UnmapFile(u8* data, size_t size) {
+  if (data) {
+    UnmapViewOfFile(data);
+  }
+}
+
 #else
 bool CreateFolder(const char* path) {
   return mkdir(path, 0700) == 0;
@@ -283,9 +320,38 @@ int GetTimeZoneBias() {
   return 240;
 }
 
+u8* MapFile(const char* filename, size_t* size) {
+  *size = 0;
+
+  int fd = open(filename, O_RDONLY);
+  if (fd < 0) return nullptr;
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+    close(fd);
+    return nullptr;
+  }
+
+  void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps its own reference to the file, so the descriptor can be closed immediately.
+  close(fd);
+
+  if (data == MAP_FAILED) return nullptr;
+
+  *size = (size_t)info.st_size;
+  return (u8*)data;
+}
+
+void UnmapFile(u8* data, size_t size) {
+  if (data && size > 0) {
+    munmap(data, size);
+  }
+}
+
 #endif
 
 Platform platform = {StandardLog,  ErrorLog,       StandardGetStoragePath, StandardLoadAsset, StandardLoadAssetArena,
-                     CreateFolder, PasteClipboard, GetMachineId,           GetTimeZoneBias};
+                     CreateFolder, PasteClipboard, GetMachineId,           GetTimeZoneBias,   MapFile,
+                     UnmapFile};
 
 }  // namespace zero
@@ -13,6 +13,9 @@ typedef unsigned char* (*AssetLoader)(const char* filename, size_t* size);
 typedef unsigned char* (*AssetLoaderArena)(MemoryArena& arena, const char* filename, size_t* size);
 typedef bool (*FolderCreate)(const char* path);
 typedef void (*ClipboardPaste)(char* dest, size_t available_size);
+// Maps an entire file read-only into memory. Returns nullptr if the file doesn't exist or is empty.
+typedef unsigned char* (*FileMapper)(const char* filename, size_t* size);
+typedef void (*FileUnmapper)(unsigned char* data, size_t size);
 
 typedef unsigned int (*MachineIdGet)();
 typedef int (*TimeZoneBiasGet)();
@@ -28,6 +31,9 @@ struct Platform {
   ClipboardPaste PasteClipboard;
   MachineIdGet GetMachineId;
   TimeZoneBiasGet GetTimeZoneBias;
+
+  FileMapper MapFile;
+  FileUnmapper UnmapFile;
 };
 extern Platform platform;
 
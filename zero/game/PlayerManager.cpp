@@ -1,6 +1,7 @@
 #include "PlayerManager.h"
 
 #include <assert.h>
+#include <math.h>
 #include <stdio.h>
 #include <string.h>
 #include <zero/game/Buffer.h>
@@ -8,7 +9,6 @@
 #include <zero/game/Clock.h>
 #include <zero/game/GameEvent.h>
 #include <zero/game/InputState.h>
-#include <zero/game/KDTree.h>
 #include <zero/game/Logger.h>
 #include <zero/game/Radar.h>
 #include <zero/game/ShipController.h>
@@ -113,6 +113,9 @@ static void UnstuckSelf(PlayerManager& pm, Player& self) {
       }
     }
   }
+
+  pm.UpdatePlayerCell(self);
+  pm.UpdateHotPlayer(self);
 }
 static void OnSetCoordinatesPkt(void* user, u8* pkt, size_t size) {
   PlayerManager* manager = (PlayerManager*)user;
@@ -218,6 +221,12 @@ void PlayerManager::Update(float dt) {
     }
   }
 
+  // Refit every player since their positions can be changed in many places throughout the frame.
+  for (size_t i = 0; i < this->player_count; ++i) {
+    UpdatePlayerCell(players[i]);
+    UpdateHotPlayer(players[i]);
+  }
+
   s32 position_delay = 100;
 
   if (self && self->ship != 8) {
@@ -591,15 +600,19 @@ Player* PlayerManager::GetPlayerById(u16 id, size_t* index) {
 }
 
 Player* PlayerManager::GetPlayerByName(const char* name) {
-  for (size_t i = 0; i < player_count; ++i) {
-    Player* player = players + i;
+  u16 id = name_index.Find(name);
 
-    if (strcmp(player->name, name) == 0) {
-      return player;
-    }
-  }
+  if (id == kInvalidPlayerId) return nullptr;
 
-  return nullptr;
+  return GetPlayerById(id);
+}
+
+Player* PlayerManager::GetPlayerByPrefix(const char* prefix, size_t length) {
+  u16 id = name_index.FindPrefix(prefix, length);
+
+  if (id == kInvalidPlayerId) return nullptr;
+
+  return GetPlayerById(id);
 }
 
 void PlayerManager::OnPlayerIdChange(u8* pkt, size_t size) {
@@ -608,7 +621,9 @@ void PlayerManager::OnPlayerIdChange(u8* pkt, size_t size) {
 
   this->player_count = 0;
   this->received_initial_list = false;
-  this->kdtree = nullptr;
+  this->grid.Clear();
+  this->name_index.Clear();
+  ++this->position_epoch;
 
   memset(player_lookup, 0xFF, sizeof(player_lookup));
 }
@@ -661,6 +676,10 @@ void PlayerManager::OnPlayerEnter(u8* pkt, size_t size) {
   player->bombflash_anim_t = kAnimDurationBombFlash;
 
   player_lookup[player->id] = (u16)player_index;
+  name_index.Insert(player->name, player->id);
+  ++position_epoch;
+  UpdatePlayerCell(*player);
+  UpdateHotPlayer(*player);
 
   Log(LogLevel::Info, "%s [%d] entered arena", name, player->id);
 
@@ -713,8 +732,16 @@ void PlayerManager::RemovePlayer(Player* player) {
 
   player_lookup[players[player_count - 1].id] = (u16)index;
   player_lookup[player->id] = kInvalidPlayerId;
+  name_index.Remove(player->name);
+  ++position_epoch;
+
+  grid.SwapRemove((u16)index, (u16)(player_count - 1));
 
   players[index] = players[--player_count];
+
+  if (index < player_count) {
+    UpdateHotPlayer(players[index]);
+  }
 }
 
 void PlayerManager::OnPlayerDeath(u8* pkt, size_t size) {
@@ -740,6 +767,8 @@ void PlayerManager::OnPlayerDeath(u8* pkt, size_t size) {
     killed->ball_carrier = false;
     killed->energy = 0;
 
+    UpdateHotPlayer(*killed);
+
     DetachPlayer(*killed);
     DetachAllChildren(*killed);
   }
@@ -900,6 +929,9 @@ void PlayerManager::Spawn(bool reset) {
   self->warp_anim_t = 0.0f;
   self->velocity = Vector2f(0, 0);
 
+  UpdatePlayerCell(*self);
+  UpdateHotPlayer(*self);
+
   Event::Dispatch(SpawnEvent(*self));
 }
 
@@ -929,6 +961,8 @@ void PlayerManager::OnPlayerFrequencyChange(u8* pkt, size_t size) {
     player->ball_carrier = false;
     player->energy = 0;
 
+    UpdateHotPlayer(*player);
+
     weapon_manager->ClearWeapons(*player);
 
     Event::Dispatch(PlayerFreqAndShipChangeEvent(*player, old_freq, frequency, player->ship, player->ship));
@@ -968,6 +1002,8 @@ void PlayerManager::OnPlayerFreqAndShipChange(u8* pkt, size_t size) {
     player->ball_carrier = false;
     player->energy = 0;
 
+    UpdateHotPlayer(*player);
+
     weapon_manager->ClearWeapons(*player);
 
     if (player->id == player_id) {
@@ -1275,9 +1311,12 @@ void PlayerManager::OnPositionPacket(Player& player, const Vector2f& position, c
   // ping. The player should be simulated however many ticks it took to reach server plus the tick difference between
   // this client and the server.
 
-  // Simulate per tick because the simulation can be unstable with large dt
-  for (int i = 0; i < sim_ticks; ++i) {
-    SimulatePlayer(player, (1.0f / 100.0f), true);
+  // Simulate per tick because the simulation can be unstable with large dt.
+  // Self is left out of the fast path since it also needs to check for wormholes.
+  if (player.id == player_id || !ExtrapolateOpen(player, sim_ticks)) {
+    for (int i = 0; i < sim_ticks; ++i) {
+      SimulatePlayer(player, (1.0f / 100.0f), true);
+    }
   }
 
   Vector2f projected_pos = player.position;
@@ -1301,6 +1340,9 @@ void PlayerManager::OnPositionPacket(Player& player, const Vector2f& position, c
     player.lerp_velocity = (projected_pos - player.position) * (1.0f / player.lerp_time);
   }
 
+  UpdatePlayerCell(player);
+  UpdateHotPlayer(player);
+
   // We received a packet telling us where we are, so make sure it didn't put is in a wall. (Hyperspace)
   if (player.id == player_id) {
     UnstuckSelf(*this, player);
@@ -1452,6 +1494,9 @@ void PlayerManager::OnCreateTurretLink(u8* pkt, size_t size) {
       requester->velocity = destination->velocity;
       requester->lerp_velocity = destination->lerp_velocity;
       requester->lerp_time = destination->lerp_time;
+
+      UpdatePlayerCell(*requester);
+      UpdateHotPlayer(*requester);
     }
   }
 }
@@ -1625,6 +1670,118 @@ bool PlayerManager::SimulateAxis(Player& player, float dt, int axis, bool extrap
   return false;
 }
 
+bool PlayerManager::ExtrapolateOpen(Player& player, s32 ticks) {
+  if (ticks <= 0) return true;
+  // Lerping adds its own velocity on top, so leave that to the full simulation.
+  if (player.lerp_time > 0.0f) return false;
+
+  constexpr float kTickDt = 1.0f / 100.0f;
+
+  // Step the same way that SimulatePlayer does so the result matches the full simulation exactly.
+  Vector2f end = player.position;
+  float lerp_time = player.lerp_time;
+
+  for (s32 i = 0; i < ticks; ++i) {
+    end.x += player.velocity.x * kTickDt;
+    end.y += player.velocity.y * kTickDt;
+    lerp_time -= kTickDt;
+  }
+
+  // Every tile that SimulateAxis could check along the way is within the ship radius plus one tile of the path.
+  float extent = connection.settings.ShipSettings[player.ship].GetRadius() + 1.0f;
+
+  s32 start_x = (s32)floorf(std::min(player.position.x, end.x) - extent);
+  s32 start_y = (s32)floorf(std::min(player.position.y, end.y) - extent);
+  s32 end_x = (s32)floorf(std::max(player.position.x, end.x) + extent);
+  s32 end_y = (s32)floorf(std::max(player.position.y, end.y) + extent);
+
+  if (!connection.map.IsAreaOpen(start_x, start_y, end_x, end_y)) return false;
+
+  player.position = end;
+  player.lerp_time = lerp_time;
+
+  return true;
+}
+
+Vector2f PlayerManager::PredictPosition(const Player& player, float seconds) {
+  constexpr float kTickDt = 1.0f / 100.0f;
+  constexpr float kSampleTime = PlayerPrediction::kTicksPerSample * kTickDt;
+
+  // This also rejects NaN, which comes from dividing by a speed of zero.
+  if (player.ship >= 8 || !(seconds > 0.0f)) return player.position;
+
+  // Infinite times can't continue in a straight line, so they stop at the end of the simulated horizon.
+  if (isinf(seconds)) seconds = PlayerPrediction::kMaxSamples * kSampleTime;
+
+  // The whole movement state is compared, so copies of a player share the cached prediction only when they would
+  // simulate the same way.
+  PlayerPrediction& prediction = predictions[player.id & (kPredictionSlots - 1)];
+  Tick tick = GetCurrentTick();
+
+  if (prediction.tick != tick || prediction.id != player.id || prediction.ship != player.ship ||
+      prediction.frequency != player.frequency || prediction.position != player.position ||
+      prediction.velocity != player.velocity || prediction.lerp_velocity != player.lerp_velocity ||
+      prediction.lerp_time != player.lerp_time) {
+    prediction.tick = tick;
+    prediction.id = player.id;
+    prediction.ship = player.ship;
+    prediction.frequency = player.frequency;
+    prediction.position = player.position;
+    prediction.velocity = player.velocity;
+    prediction.lerp_velocity = player.lerp_velocity;
+    prediction.lerp_time = player.lerp_time;
+
+    prediction.sample_count = 1;
+    prediction.samples[0] = player.position;
+    prediction.end_velocity = player.velocity;
+    prediction.end_lerp_velocity = player.lerp_velocity;
+    prediction.end_lerp_time = player.lerp_time;
+  }
+
+  float sample = seconds / kSampleTime;
+  // Clamp before converting so times far past the horizon don't overflow the sample index.
+  float sample_index = std::min(sample, (float)PlayerPrediction::kMaxSamples);
+  size_t needed = std::min((size_t)sample_index + 2, PlayerPrediction::kMaxSamples + 1);
+
+  if (prediction.sample_count < needed) {
+    // Simulate a copy so the extrapolation can't touch the real player.
+    Player sim = player;
+
+    sim.position = prediction.samples[prediction.sample_count - 1];
+    sim.velocity = prediction.end_velocity;
+    sim.lerp_velocity = prediction.end_lerp_velocity;
+    sim.lerp_time = prediction.end_lerp_time;
+
+    while (prediction.sample_count < needed) {
+      // Step the axes directly instead of using SimulatePlayer since that would trigger wormholes for self.
+      if (!ExtrapolateOpen(sim, PlayerPrediction::kTicksPerSample)) {
+        for (s32 i = 0; i < PlayerPrediction::kTicksPerSample; ++i) {
+          SimulateAxis(sim, kTickDt, 0, true);
+          SimulateAxis(sim, kTickDt, 1, true);
+          sim.lerp_time -= kTickDt;
+        }
+      }
+
+      prediction.samples[prediction.sample_count++] = sim.position;
+    }
+
+    prediction.end_velocity = sim.velocity;
+    prediction.end_lerp_velocity = sim.lerp_velocity;
+    prediction.end_lerp_time = sim.lerp_time;
+  }
+
+  size_t last = prediction.sample_count - 1;
+
+  if (sample >= (float)last) {
+    return prediction.samples[last] + prediction.end_velocity * ((sample - last) * kSampleTime);
+  }
+
+  size_t before = (size_t)sample;
+  float t = sample - before;
+
+  return prediction.samples[before] + (prediction.samples[before + 1] - prediction.samples[before]) * t;
+}
+
 void PlayerManager::SimulatePlayer(Player& player, float dt, bool extrapolating) {
   if (!extrapolating && !IsSynchronized(player)) {
     player.velocity = Vector2f(0, 0);
@@ -2,7 +2,10 @@
 #define ZERO_PLAYER_MANAGER_H_
 
 #include <zero/Types.h>
+#include <zero/game/Clock.h>
 #include <zero/game/Player.h>
+#include <zero/game/PlayerNameIndex.h>
+#include <zero/game/SpatialGrid.h>
 #include <zero/game/net/Connection.h>
 #include <zero/game/render/Animation.h>
 #include <zero/game/render/Graphics.h>
@@ -19,6 +22,57 @@ struct Soccer;
 struct SpriteRenderer;
 struct WeaponManager;
 
+// Buckets every player in the arena by the 32 tile cell that they are in. This is kept up to date as players move, so it
+// can be queried at any time without a rebuild.
+using PlayerGrid = SpatialGrid<1024, 32>;
+
+// Packed copy of the player fields that batch loops filter and measure with. Index i matches players[i], so a loop can
+// stream these arrays and only touch the full Player record for the players that it keeps.
+struct PlayerHotView {
+  PlayerId id[1024];
+  u16 frequency[1024];
+  u8 ship[1024];
+  u8 togglables[1024];
+  u16 timestamp[1024];
+
+  float x[1024];
+  float y[1024];
+  float velocity_x[1024];
+  float velocity_y[1024];
+  float energy[1024];
+  float enter_delay[1024];
+
+  inline Vector2f GetPosition(size_t index) const { return Vector2f(x[index], y[index]); }
+  inline bool IsRespawning(size_t index) const { return ship[index] != 8 && enter_delay[index] > 0.0f; }
+};
+
+// Positions that a player is expected to reach if nothing changes its velocity, including bounces off of walls.
+// Samples are simulated lazily as later times are requested, and the prediction is thrown away once the tick or the
+// player's movement state changes.
+struct PlayerPrediction {
+  static constexpr s32 kTicksPerSample = 10;
+  static constexpr size_t kMaxSamples = 20;
+
+  // The state that the prediction was made from.
+  Tick tick = 0;
+  PlayerId id = kInvalidPlayerId;
+  u8 ship = 8;
+  u16 frequency = 0;
+  Vector2f position;
+  Vector2f velocity;
+  Vector2f lerp_velocity;
+  float lerp_time = 0.0f;
+
+  // samples[0] is the starting position and each sample after it is kTicksPerSample ticks later.
+  size_t sample_count = 0;
+  Vector2f samples[kMaxSamples + 1];
+
+  // Movement state after the last sample so more samples can be simulated from it.
+  Vector2f end_velocity;
+  Vector2f end_lerp_velocity;
+  float end_lerp_time = 0.0f;
+};
+
 enum class AttachRequestResponse {
   Success,
   DetatchFromParent,
@@ -47,8 +101,6 @@ struct PlayerManager {
   Soccer* soccer = nullptr;
   Radar* radar = nullptr;
 
-  struct KDNode* kdtree = nullptr;
-
   u16 player_id = 0;
   bool requesting_attach = false;
 
@@ -71,6 +123,19 @@ struct PlayerManager {
 
   // Indirection table to look up player by id quickly
   u16 player_lookup[65536];
+  PlayerNameIndex name_index;
+
+  PlayerGrid grid;
+  // This is refreshed after simulating and whenever a packet changes one of its fields. Changes that other systems make
+  // later in the frame show up after the next update.
+  PlayerHotView hot;
+  // Incremented whenever a player's position, ship, or frequency changes or the player list changes. Caches built from
+  // every player's position, such as the target table, compare against this to know when they need to be rebuilt.
+  u32 position_epoch = 0;
+  // Only a few players are predicted each tick, so predictions are cached in a small table indexed by the low bits of
+  // the player id. Players that share a slot replace each other's prediction.
+  static constexpr size_t kPredictionSlots = 16;
+  PlayerPrediction predictions[kPredictionSlots];
 
   PlayerManager(MemoryArena& perm_arena, Connection& connection, PacketDispatcher& dispatcher);
 
@@ -97,17 +162,135 @@ struct PlayerManager {
 
   Player* GetSelf();
   Player* GetPlayerById(u16 id, size_t* index = nullptr);
+  // Names are matched ignoring case.
   Player* GetPlayerByName(const char* name);
+  // Finds a player whose name starts with the first length characters of prefix, preferring an exact match.
+  Player* GetPlayerByPrefix(const char* prefix, size_t length);
 
   inline u16 GetPlayerIndex(u16 id) { return player_lookup[id]; }
 
   void RemovePlayer(Player* player);
 
+  // Moves the player to the grid cell of its current position. This must be called after setting a player's position
+  // outside of the normal update.
+  inline void UpdatePlayerCell(Player& player) { grid.Update((u16)(&player - players), player.position); }
+
+  // Copies the player's hot fields into the hot view. This must be called after changing any of them outside of the
+  // player manager.
+  inline void UpdateHotPlayer(const Player& player) {
+    size_t index = (size_t)(&player - players);
+
+    if (hot.x[index] != player.position.x || hot.y[index] != player.position.y || hot.ship[index] != player.ship ||
+        hot.frequency[index] != player.frequency) {
+      ++position_epoch;
+    }
+
+    hot.id[index] = player.id;
+    hot.frequency[index] = player.frequency;
+    hot.ship[index] = player.ship;
+    hot.togglables[index] = player.togglables;
+    hot.timestamp[index] = player.timestamp;
+    hot.x[index] = player.position.x;
+    hot.y[index] = player.position.y;
+    hot.velocity_x[index] = player.velocity.x;
+    hot.velocity_y[index] = player.velocity.y;
+    hot.energy[index] = player.energy;
+    hot.enter_delay[index] = player.enter_delay;
+  }
+
+  // These call fn with each player whose position is inside of the query shape. The players are not filtered, so
+  // spectators and desynchronized players are included.
+  // Players must not enter or leave from fn.
+  template <typename F>
+  void ForEachPlayerInRect(const Vector2f& min, const Vector2f& max, F&& fn) {
+    grid.ForEachInRect(min, max, [&](u16 index) {
+      Player* player = players + index;
+
+      if (BoxContainsPoint(min, max, player->position)) {
+        fn(player);
+      }
+    });
+  }
+
+  template <typename F>
+  void ForEachPlayerInRadius(const Vector2f& center, float radius, F&& fn) {
+    float radius_sq = radius * radius;
+
+    ForEachPlayerInRect(center - Vector2f(radius, radius), center + Vector2f(radius, radius), [&](Player* player) {
+      if (player->position.DistanceSq(center) <= radius_sq) {
+        fn(player);
+      }
+    });
+  }
+
+  // Finds the players within radius of the segment from start to end.
+  template <typename F>
+  void ForEachPlayerInCapsule(const Vector2f& start, const Vector2f& end, float radius, F&& fn) {
+    if (start == end) {
+      ForEachPlayerInRadius(start, radius, fn);
+      return;
+    }
+
+    Vector2f min(start.x < end.x ? start.x : end.x, start.y < end.y ? start.y : end.y);
+    Vector2f max(start.x > end.x ? start.x : end.x, start.y > end.y ? start.y : end.y);
+    float radius_sq = radius * radius;
+
+    min -= Vector2f(radius, radius);
+    max += Vector2f(radius, radius);
+
+    ForEachPlayerInRect(min, max, [&](Player* player) {
+      if (GetClosestLinePoint(start, end, player->position).DistanceSq(player->position) <= radius_sq) {
+        fn(player);
+      }
+    });
+  }
+
+  // Fills result with up to count of the players closest to position that pass the filter, sorted by distance.
+  template <typename F>
+  size_t GetNearestPlayers(const Vector2f& position, size_t count, Player** result, F&& filter) {
+    u16 indices[ZERO_ARRAY_SIZE(players)];
+    float distances_sq[ZERO_ARRAY_SIZE(players)];
+
+    if (count > ZERO_ARRAY_SIZE(players)) count = ZERO_ARRAY_SIZE(players);
+
+    size_t found = grid.FindNearest(position, count, indices, distances_sq, [&](u16 index, float* distance_sq) {
+      Player* player = players + index;
+
+      if (!filter(player)) return false;
+
+      *distance_sq = player->position.DistanceSq(position);
+      return true;
+    });
+
+    for (size_t i = 0; i < found; ++i) {
+      result[i] = players + indices[i];
+    }
+
+    return found;
+  }
+
+  template <typename F>
+  Player* GetNearestPlayer(const Vector2f& position, F&& filter) {
+    Player* result = nullptr;
+
+    GetNearestPlayers(position, 1, &result, filter);
+
+    return result;
+  }
+
   void PushDamage(PlayerId shooter_id, WeaponData weapon_data, int energy, int damage);
 
   void SendPositionPacket();
   void SimulatePlayer(Player& player, float dt, bool extrapolating);
   bool SimulateAxis(Player& player, float dt, int axis, bool extrapolating);
+  // Extrapolates the player by whole ticks without any tile checks when the map's clearance shows that nothing along the
+  // path can be solid. Returns false without touching the player if the path gets close to anything solid.
+  bool ExtrapolateOpen(Player& player, s32 ticks);
+
+  // Returns where the player is expected to be after this many seconds by simulating its movement with wall collisions.
+  // The simulation is cached for the rest of the tick, so repeated predictions of the same player are lookups.
+  // Times past the simulated horizon continue in a straight line from the last sample.
+  Vector2f PredictPosition(const Player& player, float seconds);
 
   void OnPlayerIdChange(u8* pkt, size_t size);
   void OnPlayerEnter(u8* pkt, size_t size);
@@ -139,6 +322,12 @@ struct PlayerManager {
     u16 tick = (current_tick + connection.time_diff) & 0x7FFF;
     return player.id == player_id || SMALL_TICK_DIFF(tick, player.timestamp) < kPlayerTimeout;
   }
+
+  // Same as above but for the player at this index of the hot view.
+  inline bool IsSynchronized(size_t index, u32 current_tick) const {
+    u16 tick = (current_tick + connection.time_diff) & 0x7FFF;
+    return hot.id[index] == player_id || SMALL_TICK_DIFF(tick, hot.timestamp[index]) < kPlayerTimeout;
+  }
 };
 
 }  // namespace zero
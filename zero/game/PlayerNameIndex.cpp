@@ -0,0 +1,173 @@
+#include "PlayerNameIndex.h"
+
+#include <string.h>
+#include <zero/game/Player.h>
+
+namespace zero {
+
+// Writes the lowercase name to out and returns its length. Only ascii is folded, which is what Continuum does.
+static size_t LowercaseName(const char* name, size_t length, char* out) {
+  size_t i = 0;
+
+  for (; i < length && i < kMaxIndexedNameLength && name[i]; ++i) {
+    char c = name[i];
+
+    out[i] = (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c;
+  }
+
+  out[i] = 0;
+  return i;
+}
+
+static u32 HashName(const char* lower_name) {
+  u32 hash = 2166136261;
+
+  for (const char* c = lower_name; *c; ++c) {
+    hash = (hash ^ (u8)*c) * 16777619;
+  }
+
+  return hash;
+}
+
+void PlayerNameIndex::Clear() {
+  for (size_t i = 0; i < kCapacity; ++i) {
+    slots[i] = kInvalidEntry;
+  }
+
+  for (size_t i = 0; i < kMaxEntries; ++i) {
+    free_entries[i] = (u16)(kMaxEntries - i - 1);
+  }
+
+  free_count = kMaxEntries;
+  sorted_count = 0;
+}
+
+void PlayerNameIndex::Insert(const char* name, u16 id) {
+  char lower_name[kMaxIndexedNameLength + 1];
+  LowercaseName(name, kMaxIndexedNameLength, lower_name);
+
+  u32 hash = HashName(lower_name);
+  size_t slot = FindSlot(lower_name, hash);
+
+  if (slots[slot] != kInvalidEntry) {
+    entries[slots[slot]].id = id;
+    return;
+  }
+
+  if (free_count == 0) return;
+
+  u16 entry_index = free_entries[--free_count];
+  Entry* entry = entries + entry_index;
+
+  entry->hash = hash;
+  entry->id = id;
+  memcpy(entry->name, lower_name, sizeof(lower_name));
+
+  slots[slot] = entry_index;
+
+  size_t position = LowerBound(lower_name, kMaxIndexedNameLength + 1);
+
+  memmove(sorted + position + 1, sorted + position, (sorted_count - position) * sizeof(u16));
+  sorted[position] = entry_index;
+  ++sorted_count;
+}
+
+void PlayerNameIndex::Remove(const char* name) {
+  char lower_name[kMaxIndexedNameLength + 1];
+  LowercaseName(name, kMaxIndexedNameLength, lower_name);
+
+  size_t slot = FindSlot(lower_name, HashName(lower_name));
+  u16 entry_index = slots[slot];
+
+  if (entry_index == kInvalidEntry) return;
+
+  // Shift the following entries of the probe chain back so lookups never need to skip over removed slots.
+  constexpr size_t kMask = kCapacity - 1;
+  size_t empty = slot;
+
+  slots[empty] = kInvalidEntry;
+
+  for (size_t next = (empty + 1) & kMask; slots[next] != kInvalidEntry; next = (next + 1) & kMask) {
+    size_t home = entries[slots[next]].hash & kMask;
+
+    // Only move the entry back if its home slot isn't between the empty slot and its current slot.
+    if (((next - home) & kMask) >= ((next - empty) & kMask)) {
+      slots[empty] = slots[next];
+      slots[next] = kInvalidEntry;
+      empty = next;
+    }
+  }
+
+  size_t position = LowerBound(lower_name, kMaxIndexedNameLength + 1);
+
+  if (position < sorted_count && sorted[position] == entry_index) {
+    memmove(sorted + position, sorted + position + 1, (sorted_count - position - 1) * sizeof(u16));
+    --sorted_count;
+  }
+
+  free_entries[free_count++] = entry_index;
+}
+
+u16 PlayerNameIndex::Find(const char* name) const {
+  char lower_name[kMaxIndexedNameLength + 1];
+  LowercaseName(name, kMaxIndexedNameLength, lower_name);
+
+  u16 entry_index = slots[FindSlot(lower_name, HashName(lower_name))];
+
+  if (entry_index == kInvalidEntry) return kInvalidPlayerId;
+
+  return entries[entry_index].id;
+}
+
+u16 PlayerNameIndex::FindPrefix(const char* prefix, size_t length) const {
+  char lower_prefix[kMaxIndexedNameLength + 1];
+  length = LowercaseName(prefix, length, lower_prefix);
+
+  // An exact match sorts before every longer name that shares its prefix, so the first match is always the best one.
+  size_t position = LowerBound(lower_prefix, length);
+
+  if (position >= sorted_count) return kInvalidPlayerId;
+
+  const Entry& entry = entries[sorted[position]];
+
+  if (strncmp(entry.name, lower_prefix, length) != 0) return kInvalidPlayerId;
+
+  return entry.id;
+}
+
+size_t PlayerNameIndex::FindSlot(const char* lower_name, u32 hash) const {
+  constexpr size_t kMask = kCapacity - 1;
+  size_t slot = hash & kMask;
+
+  // The table has more slots than entries, so this always finds an empty slot.
+  while (slots[slot] != kInvalidEntry) {
+    const Entry& entry = entries[slots[slot]];
+
+    if (entry.hash == hash && strcmp(entry.name, lower_name) == 0) {
+      break;
+    }
+
+    slot = (slot + 1) & kMask;
+  }
+
+  return slot;
+}
+
+size_t PlayerNameIndex::LowerBound(const char* lower_prefix, size_t length) const {
+  size_t low = 0;
+  size_t high = sorted_count;
+
+  while (low < high) {
+    size_t mid = (low + high) / 2;
+
+    if (strncmp(entries[sorted[mid]].name, lower_prefix, length) < 0) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+
+  return low;
+}
+
+}  // namespace zero
@@ -0,0 +1,59 @@
+#ifndef ZERO_PLAYERNAMEINDEX_H_
+#define ZERO_PLAYERNAMEINDEX_H_
+
+#include <zero/Types.h>
+
+namespace zero {
+
+// Player names are read from packets as 20 byte strings.
+constexpr size_t kMaxIndexedNameLength = 20;
+
+// Case-insensitive index of player names to player ids, matching how Continuum treats names.
+// Names are hashed for exact lookups and also kept sorted so partial names can be matched without looping over every
+// player. Player ids are stored instead of player indices so players can be moved around in the player list freely.
+struct PlayerNameIndex {
+  static constexpr size_t kMaxEntries = 1024;
+  static constexpr size_t kCapacity = 2048;
+  static constexpr u16 kInvalidEntry = 0xFFFF;
+
+  struct Entry {
+    u32 hash;
+    u16 id;
+    char name[kMaxIndexedNameLength + 1];
+  };
+
+  Entry entries[kMaxEntries];
+  u16 free_entries[kMaxEntries];
+  size_t free_count = 0;
+
+  // Open addressing table of entry indices.
+  u16 slots[kCapacity];
+
+  // Entry indices in lowercase name order.
+  u16 sorted[kMaxEntries];
+  size_t sorted_count = 0;
+
+  PlayerNameIndex() { Clear(); }
+
+  void Clear();
+
+  // Any existing entry with the same name is replaced.
+  void Insert(const char* name, u16 id);
+  void Remove(const char* name);
+
+  // Returns the id of the player with this exact name ignoring case, or kInvalidPlayerId.
+  u16 Find(const char* name) const;
+
+  // Returns the id of the player whose name starts with the first length characters of prefix ignoring case, or
+  // kInvalidPlayerId. A name that matches the prefix exactly is always chosen, otherwise the first match in name order
+  // is returned.
+  u16 FindPrefix(const char* prefix, size_t length) const;
+
+ private:
+  size_t FindSlot(const char* lower_name, u32 hash) const;
+  size_t LowerBound(const char* lower_prefix, size_t length) const;
+};
+
+}  // namespace zero
+
+#endif
@@ -0,0 +1,231 @@
+#ifndef ZERO_SPATIALGRID_H_
+#define ZERO_SPATIALGRID_H_
+
+#include <zero/Math.h>
+#include <zero/Types.h>
+
+#include <algorithm>
+
+namespace zero {
+
+constexpr u16 kInvalidGridIndex = 0xFFFF;
+
+// Buckets entries by the coarse map cell that they are in, so nearby entries can be found without looping over all of
+// them. Each cell is an intrusive list of indices into an array that is owned by the user of the grid.
+template <size_t kCapacity, s32 kCellSize>
+struct SpatialGrid {
+  static_assert(kCapacity < kInvalidGridIndex, "Grid indices must fit in u16");
+
+  static constexpr s32 kCellsPerAxis = 1024 / kCellSize;
+
+  u16 heads[kCellsPerAxis * kCellsPerAxis];
+  u16 next[kCapacity];
+  u16 previous[kCapacity];
+  u16 cells[kCapacity];
+
+  SpatialGrid() { Clear(); }
+
+  void Clear() {
+    for (size_t i = 0; i < ZERO_ARRAY_SIZE(heads); ++i) {
+      heads[i] = kInvalidGridIndex;
+    }
+
+    for (size_t i = 0; i < kCapacity; ++i) {
+      cells[i] = kInvalidGridIndex;
+    }
+  }
+
+  void Insert(u16 index, u16 cell) {
+    u16 head = heads[cell];
+
+    next[index] = head;
+    previous[index] = kInvalidGridIndex;
+    cells[index] = cell;
+
+    if (head != kInvalidGridIndex) {
+      previous[head] = index;
+    }
+
+    heads[cell] = index;
+  }
+
+  void Remove(u16 index) {
+    u16 prev = previous[index];
+    u16 after = next[index];
+
+    if (prev != kInvalidGridIndex) {
+      next[prev] = after;
+    } else {
+      heads[cells[index]] = after;
+    }
+
+    if (after != kInvalidGridIndex) {
+      previous[after] = prev;
+    }
+
+    cells[index] = kInvalidGridIndex;
+  }
+
+  // Moves the entry at index from to index to. The entry at to must already be removed.
+  void Relocate(u16 from, u16 to) {
+    u16 cell = cells[from];
+
+    cells[to] = cell;
+    cells[from] = kInvalidGridIndex;
+
+    if (cell == kInvalidGridIndex) return;
+
+    u16 prev = previous[from];
+    u16 after = next[from];
+
+    previous[to] = prev;
+    next[to] = after;
+
+    if (prev != kInvalidGridIndex) {
+      next[prev] = to;
+    } else {
+      heads[cell] = to;
+    }
+
+    if (after != kInvalidGridIndex) {
+      previous[after] = to;
+    }
+  }
+
+  // Matches a swap removal in the user's array where the element at last is moved into index.
+  void SwapRemove(u16 index, u16 last) {
+    if (cells[index] != kInvalidGridIndex) {
+      Remove(index);
+    }
+
+    if (index != last) {
+      Relocate(last, index);
+    }
+  }
+
+  // Inserts the entry or moves it to a new cell if the position has left its current one.
+  inline void Update(u16 index, const Vector2f& position) {
+    u16 cell = GetCell(position);
+
+    if (cells[index] != cell) {
+      if (cells[index] != kInvalidGridIndex) {
+        Remove(index);
+      }
+
+      Insert(index, cell);
+    }
+  }
+
+  // Calls fn with the index of every entry in the cells that overlap the rect. The caller is responsible for any exact
+  // containment test.
+  template <typename F>
+  void ForEachInRect(const Vector2f& min, const Vector2f& max, F&& fn) const {
+    s32 start_x = GetCellCoord(min.x);
+    s32 start_y = GetCellCoord(min.y);
+    s32 end_x = GetCellCoord(max.x);
+    s32 end_y = GetCellCoord(max.y);
+
+    for (s32 y = start_y; y <= end_y; ++y) {
+      for (s32 x = start_x; x <= end_x; ++x) {
+        u16 index = heads[y * kCellsPerAxis + x];
+
+        while (index != kInvalidGridIndex) {
+          // Grab the next index first so fn can't affect the walk.
+          u16 current = index;
+          index = next[index];
+
+          fn(current);
+        }
+      }
+    }
+  }
+
+  // Finds up to count of the closest entries to position, sorted by distance.
+  // fn is called as fn(index, &distance_sq) and returns false if the entry should be ignored.
+  // Cells are searched in rings around the position and the search stops once no unsearched cell can be closer than
+  // the furthest entry found.
+  template <typename F>
+  size_t FindNearest(const Vector2f& position, size_t count, u16* indices, float* distances_sq, F&& fn) const {
+    if (count == 0) return 0;
+
+    s32 center_x = GetCellCoord(position.x);
+    s32 center_y = GetCellCoord(position.y);
+    size_t found = 0;
+
+    for (s32 ring = 0; ring < kCellsPerAxis; ++ring) {
+      s32 start_x = center_x - ring;
+      s32 start_y = center_y - ring;
+      s32 end_x = center_x + ring;
+      s32 end_y = center_y + ring;
+
+      for (s32 y = start_y; y <= end_y; ++y) {
+        if (y < 0 || y >= kCellsPerAxis) continue;
+
+        bool edge_row = y == start_y || y == end_y;
+        // Only the border of the ring is new, so the inner rows only need their two end cells.
+        s32 step = edge_row ? 1 : (end_x - start_x);
+
+        if (step <= 0) step = 1;
+
+        for (s32 x = start_x; x <= end_x; x += step) {
+          if (x < 0 || x >= kCellsPerAxis) continue;
+
+          for (u16 index = heads[y * kCellsPerAxis + x]; index != kInvalidGridIndex; index = next[index]) {
+            float distance_sq = 0.0f;
+
+            if (!fn(index, &distance_sq)) continue;
+            if (found == count && distance_sq >= distances_sq[found - 1]) continue;
+
+            size_t insert = found < count ? found++ : found - 1;
+
+            while (insert > 0 && distances_sq[insert - 1] > distance_sq) {
+              indices[insert] = indices[insert - 1];
+              distances_sq[insert] = distances_sq[insert - 1];
+              --insert;
+            }
+
+            indices[insert] = index;
+            distances_sq[insert] = distance_sq;
+          }
+        }
+      }
+
+      bool covers_x = start_x <= 0 && end_x >= kCellsPerAxis - 1;
+      bool covers_y = start_y <= 0 && end_y >= kCellsPerAxis - 1;
+
+      if (covers_x && covers_y) break;
+
+      if (found == count) {
+        // Closest distance from the position to any cell outside of the searched square. Sides that are past the edge
+        // of the map have no cells left to search.
+        float edge = 1024.0f * 2.0f;
+
+        if (start_x > 0) edge = std::min(edge, position.x - (float)(start_x * kCellSize));
+        if (end_x < kCellsPerAxis - 1) edge = std::min(edge, (float)((end_x + 1) * kCellSize) - position.x);
+        if (start_y > 0) edge = std::min(edge, position.y - (float)(start_y * kCellSize));
+        if (end_y < kCellsPerAxis - 1) edge = std::min(edge, (float)((end_y + 1) * kCellSize) - position.y);
+
+        if (edge > 0.0f && edge * edge >= distances_sq[found - 1]) break;
+      }
+    }
+
+    return found;
+  }
+
+  inline static s32 GetCellCoord(float coord) {
+    s32 cell = (s32)coord / kCellSize;
+
+    if (coord < 0.0f || cell < 0) return 0;
+    if (cell >= kCellsPerAxis) return kCellsPerAxis - 1;
+
+    return cell;
+  }
+
+  inline static u16 GetCell(const Vector2f& position) {
+    return (u16)(GetCellCoord(position.y) * kCellsPerAxis + GetCellCoord(position.x));
+  }
+};
+
+}  // namespace zero
+
+#endif
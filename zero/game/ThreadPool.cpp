@@ -0,0 +1,104 @@
+#include "ThreadPool.h"
+
+namespace zero {
+
+ThreadPool::ThreadPool(size_t thread_count) {
+  worker_count = thread_count > 1 ? thread_count - 1 : 0;
+
+  if (worker_count > kMaxPoolThreads - 1) {
+    worker_count = kMaxPoolThreads - 1;
+  }
+
+  for (size_t i = 0; i < worker_count; ++i) {
+    threads[i] = std::thread(&ThreadPool::WorkerRun, this, i + 1);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    shutdown = true;
+  }
+
+  start_convar.notify_all();
+
+  for (size_t i = 0; i < worker_count; ++i) {
+    threads[i].join();
+  }
+}
+
+size_t ThreadPool::GetJobThreadCount(size_t count, size_t min_per_thread) const {
+  size_t thread_count = min_per_thread > 0 ? count / min_per_thread : count;
+
+  if (thread_count > GetThreadCount()) {
+    thread_count = GetThreadCount();
+  }
+
+  return thread_count > 0 ? thread_count : 1;
+}
+
+void ThreadPool::Run(ThreadJobRun run, void* user, size_t count, size_t min_per_thread) {
+  size_t thread_count = GetJobThreadCount(count, min_per_thread);
+
+  if (thread_count <= 1) {
+    run(user, 0, 0, count);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    job_run = run;
+    job_user = user;
+    job_count = count;
+    job_thread_count = thread_count;
+    pending = thread_count - 1;
+    ++generation;
+  }
+
+  start_convar.notify_all();
+
+  run(user, 0, 0, count / thread_count);
+
+  std::unique_lock<std::mutex> lock(mutex);
+  done_convar.wait(lock, [this] { return pending == 0; });
+}
+
+void ThreadPool::WorkerRun(size_t thread_index) {
+  u32 seen_generation = 0;
+
+  while (true) {
+    ThreadJobRun run = nullptr;
+    void* user = nullptr;
+    size_t start = 0;
+    size_t end = 0;
+
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+
+      start_convar.wait(lock, [&] { return shutdown || generation != seen_generation; });
+
+      if (shutdown) return;
+
+      seen_generation = generation;
+
+      // Small jobs don't use every thread.
+      if (thread_index >= job_thread_count) continue;
+
+      run = job_run;
+      user = job_user;
+      start = job_count * thread_index / job_thread_count;
+      end = job_count * (thread_index + 1) / job_thread_count;
+    }
+
+    run(user, thread_index, start, end);
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (--pending == 0) {
+      done_convar.notify_one();
+    }
+  }
+}
+
+}  // namespace zero
@@ -0,0 +1,54 @@
+#ifndef ZERO_THREADPOOL_H_
+#define ZERO_THREADPOOL_H_
+
+#include <zero/Types.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace zero {
+
+constexpr size_t kMaxPoolThreads = 8;
+
+typedef void (*ThreadJobRun)(void* user, size_t thread_index, size_t start, size_t end);
+
+// Set of threads that stay alive between jobs so per-frame work can be split up without creating threads every frame.
+// The calling thread always takes part in the job as thread index 0. Run must only be called from one thread at a time.
+struct ThreadPool {
+  // The pool is capped at kMaxPoolThreads threads including the calling thread.
+  ThreadPool(size_t thread_count);
+  ~ThreadPool();
+
+  inline size_t GetThreadCount() const { return worker_count + 1; }
+
+  // Number of threads that Run will split a job of this size across.
+  size_t GetJobThreadCount(size_t count, size_t min_per_thread) const;
+
+  // Splits [0, count) into contiguous ranges in thread index order and waits for all of them to finish.
+  // Each thread is given at least min_per_thread items, so small jobs run entirely on the calling thread.
+  void Run(ThreadJobRun run, void* user, size_t count, size_t min_per_thread);
+
+ private:
+  void WorkerRun(size_t thread_index);
+
+  std::thread threads[kMaxPoolThreads];
+  size_t worker_count = 0;
+
+  std::mutex mutex;
+  std::condition_variable start_convar;
+  std::condition_variable done_convar;
+
+  u32 generation = 0;
+  size_t pending = 0;
+  bool shutdown = false;
+
+  ThreadJobRun job_run = nullptr;
+  void* job_user = nullptr;
+  size_t job_count = 0;
+  size_t job_thread_count = 0;
+};
+
+}  // namespace zero
+
+#endif
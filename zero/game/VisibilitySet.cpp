@@ -0,0 +1,444 @@
+#include "VisibilitySet.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <zero/game/Logger.h>
+#include <zero/game/Map.h>
+
+#include <algorithm>
+#include <thread>
+
+namespace zero {
+
+constexpr u32 kVisibilityMagic = 0x73697665;  // 'evis'
+constexpr u32 kVisibilityVersion = 1;
+
+// Rays between two cells stay within the hull of the two cells, which is the segment between their centers swept by
+// half a cell. An extra tile is added so rays that clip the corner of a tile are always included.
+constexpr s32 kHullMargin = VisibilitySet::kCellSize / 2 + 1;
+
+struct VisibilityFileHeader {
+  u32 magic;
+  u32 version;
+  u32 checksum;
+  u32 count;
+};
+
+struct VisibilityGrid {
+  // Tiles that might block a ray. This includes every door regardless of its current state.
+  std::vector<u8> blocking;
+  // Tiles that block a ray even when all of the doors are open.
+  std::vector<u8> solid;
+
+  // Per-row prefix sums so the tiles in a span of a row can be counted in constant time.
+  std::vector<u16> blocking_sums;
+  std::vector<u16> solid_sums;
+
+  inline u32 CountBlocking(s32 y, s32 start_x, s32 end_x) const {
+    return blocking_sums[y * 1025 + end_x + 1] - blocking_sums[y * 1025 + start_x];
+  }
+
+  inline u32 CountSolid(s32 y, s32 start_x, s32 end_x) const {
+    return solid_sums[y * 1025 + end_x + 1] - solid_sums[y * 1025 + start_x];
+  }
+};
+
+struct HullSpan {
+  s32 start_x;
+  s32 end_x;
+};
+
+struct VisibilityScratch {
+  std::vector<HullSpan> spans;
+  std::vector<u8> states;
+  std::vector<u32> stack;
+};
+
+static void CreateVisibilityGrid(const Map& map, VisibilityGrid& grid) {
+  grid.blocking.resize(1024 * 1024);
+  grid.solid.resize(1024 * 1024);
+
+  for (u16 y = 0; y < 1024; ++y) {
+    for (u16 x = 0; x < 1024; ++x) {
+      TileId id = map.GetTileId(x, y);
+      bool door = id >= kTileIdFirstDoor && id <= kTileIdLastDoor;
+
+      grid.blocking[y * 1024 + x] = IsSolid(id);
+      grid.solid[y * 1024 + x] = IsSolid(id) && !door && id != 250;
+    }
+  }
+
+  // Open doors aren't solid tiles in the map, so they need to be marked from the door list.
+  for (size_t i = 0; i < map.door_count; ++i) {
+    grid.blocking[map.doors[i].y * 1024 + map.doors[i].x] = 1;
+    grid.solid[map.doors[i].y * 1024 + map.doors[i].x] = 0;
+  }
+
+  grid.blocking_sums.resize(1024 * 1025);
+  grid.solid_sums.resize(1024 * 1025);
+
+  for (s32 y = 0; y < 1024; ++y) {
+    grid.blocking_sums[y * 1025] = 0;
+    grid.solid_sums[y * 1025] = 0;
+
+    for (s32 x = 0; x < 1024; ++x) {
+      grid.blocking_sums[y * 1025 + x + 1] = grid.blocking_sums[y * 1025 + x] + grid.blocking[y * 1024 + x];
+      grid.solid_sums[y * 1025 + x + 1] = grid.solid_sums[y * 1025 + x] + grid.solid[y * 1024 + x];
+    }
+  }
+}
+
+// Returns the first row of the hull between the cells and fills out the tile span of each row.
+static s32 GetHullSpans(s32 from_x, s32 from_y, s32 to_x, s32 to_y, std::vector<HullSpan>& spans) {
+  constexpr s32 kCellSize = VisibilitySet::kCellSize;
+
+  float start_x = (float)(from_x * kCellSize + kCellSize / 2);
+  float start_y = (float)(from_y * kCellSize + kCellSize / 2);
+  float end_x = (float)(to_x * kCellSize + kCellSize / 2);
+  float end_y = (float)(to_y * kCellSize + kCellSize / 2);
+
+  float min_y = std::min(start_y, end_y);
+  float max_y = std::max(start_y, end_y);
+
+  s32 first_row = std::max((s32)min_y - kHullMargin - 1, 0);
+  s32 last_row = std::min((s32)max_y + kHullMargin, 1023);
+
+  spans.clear();
+
+  for (s32 y = first_row; y <= last_row; ++y) {
+    // Find the part of the center segment that is within the margin of this row.
+    float band_min = std::max((float)(y - kHullMargin), min_y);
+    float band_max = std::min((float)(y + 1 + kHullMargin), max_y);
+
+    float left = std::min(start_x, end_x);
+    float right = std::max(start_x, end_x);
+
+    if (start_y != end_y) {
+      float slope = (end_x - start_x) / (end_y - start_y);
+      float x1 = start_x + (band_min - start_y) * slope;
+      float x2 = start_x + (band_max - start_y) * slope;
+
+      left = std::min(x1, x2);
+      right = std::max(x1, x2);
+    }
+
+    HullSpan span;
+
+    span.start_x = std::max((s32)floorf(left) - kHullMargin - 1, 0);
+    span.end_x = std::min((s32)ceilf(right) + kHullMargin, 1023);
+
+    spans.push_back(span);
+  }
+
+  return first_row;
+}
+
+static CellVisibility CalculateVisibility(const VisibilityGrid& grid, s32 from_x, s32 from_y, s32 to_x, s32 to_y,
+                                          VisibilityScratch& scratch) {
+  constexpr s32 kCellSize = VisibilitySet::kCellSize;
+
+  s32 first_row = GetHullSpans(from_x, from_y, to_x, to_y, scratch.spans);
+
+  u32 blocking_count = 0;
+  u32 solid_count = 0;
+  s32 min_x = 1023;
+  s32 max_x = 0;
+
+  for (size_t i = 0; i < scratch.spans.size(); ++i) {
+    s32 y = first_row + (s32)i;
+    HullSpan span = scratch.spans[i];
+
+    blocking_count += grid.CountBlocking(y, span.start_x, span.end_x);
+    solid_count += grid.CountSolid(y, span.start_x, span.end_x);
+
+    min_x = std::min(min_x, span.start_x);
+    max_x = std::max(max_x, span.end_x);
+  }
+
+  if (blocking_count == 0) return CellVisibility::Visible;
+
+  // The hull is at least a cell wide, so anything less than that can't form a wall that separates the two cells.
+  if (solid_count < kCellSize) return CellVisibility::Unknown;
+
+  // Flood fill the open tiles of the hull from the first cell. Every ray between the cells must travel through
+  // connected open tiles, so the cells are occluded if the flood never reaches the second cell.
+  enum { State_Closed, State_Open, State_Visited };
+
+  s32 width = max_x - min_x + 1;
+  s32 height = (s32)scratch.spans.size();
+
+  scratch.states.assign(width * height, State_Closed);
+  scratch.stack.clear();
+
+  for (s32 i = 0; i < height; ++i) {
+    s32 y = first_row + i;
+    HullSpan span = scratch.spans[i];
+
+    for (s32 x = span.start_x; x <= span.end_x; ++x) {
+      if (!grid.solid[y * 1024 + x]) {
+        scratch.states[i * width + x - min_x] = State_Open;
+      }
+    }
+  }
+
+  s32 target_x = to_x * kCellSize - min_x;
+  s32 target_y = to_y * kCellSize - first_row;
+  bool target_open = false;
+
+  for (s32 y = target_y; y < target_y + kCellSize; ++y) {
+    for (s32 x = target_x; x < target_x + kCellSize; ++x) {
+      target_open |= scratch.states[y * width + x] == State_Open;
+    }
+  }
+
+  // Rays that start or end in a solid tile are always blocked.
+  if (!target_open) return CellVisibility::Occluded;
+
+  s32 source_x = from_x * kCellSize - min_x;
+  s32 source_y = from_y * kCellSize - first_row;
+
+  for (s32 y = source_y; y < source_y + kCellSize; ++y) {
+    for (s32 x = source_x; x < source_x + kCellSize; ++x) {
+      if (scratch.states[y * width + x] == State_Open) {
+        scratch.states[y * width + x] = State_Visited;
+        scratch.stack.push_back(y * width + x);
+      }
+    }
+  }
+
+  while (!scratch.stack.empty()) {
+    u32 index = scratch.stack.back();
+    scratch.stack.pop_back();
+
+    s32 x = index % width;
+    s32 y = index / width;
+
+    if (x >= target_x && x < target_x + kCellSize && y >= target_y && y < target_y + kCellSize) {
+      return CellVisibility::Unknown;
+    }
+
+    // Rays can pass between tiles that only touch at a corner, so diagonal neighbors are connected.
+    for (s32 offset_y = -1; offset_y <= 1; ++offset_y) {
+      for (s32 offset_x = -1; offset_x <= 1; ++offset_x) {
+        s32 check_x = x + offset_x;
+        s32 check_y = y + offset_y;
+
+        if (check_x < 0 || check_x >= width || check_y < 0 || check_y >= height) continue;
+
+        u32 check_index = check_y * width + check_x;
+
+        if (scratch.states[check_index] == State_Open) {
+          scratch.states[check_index] = State_Visited;
+          scratch.stack.push_back(check_index);
+        }
+      }
+    }
+  }
+
+  return CellVisibility::Occluded;
+}
+
+static void CalculateVisibilityRows(const VisibilityGrid& grid, CellVisibility* cells, s32 start_y, s32 end_y,
+                                    const std::atomic<bool>* cancelled) {
+  constexpr s32 kCellsPerAxis = VisibilitySet::kCellsPerAxis;
+  constexpr s32 kCellRadius = VisibilitySet::kCellRadius;
+  constexpr s32 kWindowSize = VisibilitySet::kWindowSize;
+
+  VisibilityScratch scratch;
+
+  for (s32 y = start_y; y < end_y; ++y) {
+    if (cancelled && cancelled->load(std::memory_order_relaxed)) return;
+
+    for (s32 x = 0; x < kCellsPerAxis; ++x) {
+      CellVisibility* window = cells + (size_t)(y * kCellsPerAxis + x) * kWindowSize * kWindowSize;
+
+      // Visibility is symmetric, so only the later half of the window is calculated here.
+      for (s32 offset_y = 0; offset_y <= kCellRadius; ++offset_y) {
+        for (s32 offset_x = -kCellRadius; offset_x <= kCellRadius; ++offset_x) {
+          if (offset_y == 0 && offset_x < 0) continue;
+
+          s32 to_x = x + offset_x;
+          s32 to_y = y + offset_y;
+
+          if (to_x < 0 || to_x >= kCellsPerAxis || to_y >= kCellsPerAxis) continue;
+
+          window[(offset_y + kCellRadius) * kWindowSize + offset_x + kCellRadius] =
+              CalculateVisibility(grid, x, y, to_x, to_y, scratch);
+        }
+      }
+    }
+  }
+}
+
+void VisibilitySet::Build(const Map& map) {
+  VisibilityGrid grid;
+  CreateVisibilityGrid(map, grid);
+
+  Build(grid, map.checksum, nullptr);
+}
+
+bool VisibilitySet::Build(const VisibilityGrid& grid, u32 checksum, const std::atomic<bool>* cancelled) {
+  constexpr size_t kWindowCount = kWindowSize * kWindowSize;
+
+  this->checksum = checksum;
+  cells.assign(kCellsPerAxis * kCellsPerAxis * kWindowCount, CellVisibility::Unknown);
+
+  s32 thread_count = (s32)std::max(std::thread::hardware_concurrency(), 1u);
+  s32 per_thread = (kCellsPerAxis + thread_count - 1) / thread_count;
+
+  std::vector<std::thread> threads;
+
+  for (s32 i = 0; i < thread_count; ++i) {
+    s32 start_y = std::min(i * per_thread, kCellsPerAxis);
+    s32 end_y = std::min(start_y + per_thread, kCellsPerAxis);
+
+    if (start_y >= end_y) break;
+
+    threads.emplace_back(CalculateVisibilityRows, std::cref(grid), cells.data(), start_y, end_y, cancelled);
+  }
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  if (cancelled && cancelled->load(std::memory_order_relaxed)) {
+    cells.clear();
+    return false;
+  }
+
+  // Mirror the calculated half into the earlier half of each window.
+  for (s32 y = 0; y < kCellsPerAxis; ++y) {
+    for (s32 x = 0; x < kCellsPerAxis; ++x) {
+      CellVisibility* window = cells.data() + (size_t)(y * kCellsPerAxis + x) * kWindowCount;
+
+      for (s32 offset_y = -kCellRadius; offset_y <= 0; ++offset_y) {
+        for (s32 offset_x = -kCellRadius; offset_x <= kCellRadius; ++offset_x) {
+          if (offset_y == 0 && offset_x >= 0) break;
+
+          s32 to_x = x + offset_x;
+          s32 to_y = y + offset_y;
+
+          if (to_x < 0 || to_x >= kCellsPerAxis || to_y < 0) continue;
+
+          CellVisibility* other = cells.data() + (size_t)(to_y * kCellsPerAxis + to_x) * kWindowCount;
+
+          window[(offset_y + kCellRadius) * kWindowSize + offset_x + kCellRadius] =
+              other[(kCellRadius - offset_y) * kWindowSize + kCellRadius - offset_x];
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+bool VisibilitySet::Load(const char* filename, u32 checksum) {
+  FILE* f = fopen(filename, "rb");
+  if (!f) return false;
+
+  VisibilityFileHeader header = {};
+  size_t count = kCellsPerAxis * kCellsPerAxis * kWindowSize * kWindowSize;
+
+  if (fread(&header, sizeof(header), 1, f) != 1 || header.magic != kVisibilityMagic ||
+      header.version != kVisibilityVersion || header.checksum != checksum || header.count != count) {
+    fclose(f);
+    return false;
+  }
+
+  cells.resize(count);
+
+  if (fread(cells.data(), sizeof(CellVisibility), count, f) != count) {
+    Log(LogLevel::Warning, "Failed to read visibility set from %s.", filename);
+    cells.clear();
+    fclose(f);
+    return false;
+  }
+
+  fclose(f);
+
+  this->checksum = checksum;
+
+  return true;
+}
+
+bool VisibilitySet::Save(const char* filename) const {
+  // Write to a temporary file and move it into place so another bot loading the same map never reads a partially
+  // written set.
+  char temp_filename[1060];
+  sprintf(temp_filename, "%s.tmp", filename);
+
+  FILE* f = fopen(temp_filename, "wb");
+
+  if (!f) {
+    Log(LogLevel::Error, "Failed to open %s for writing.", temp_filename);
+    return false;
+  }
+
+  VisibilityFileHeader header;
+
+  header.magic = kVisibilityMagic;
+  header.version = kVisibilityVersion;
+  header.checksum = checksum;
+  header.count = (u32)cells.size();
+
+  bool success = fwrite(&header, sizeof(header), 1, f) == 1 &&
+                 fwrite(cells.data(), sizeof(CellVisibility), cells.size(), f) == cells.size();
+
+  fclose(f);
+
+  if (!success) {
+    Log(LogLevel::Error, "Failed to write %s.", temp_filename);
+    remove(temp_filename);
+    return false;
+  }
+
+  if (rename(temp_filename, filename) != 0) {
+    // Windows won't rename over an existing file, so remove it first.
+    remove(filename);
+
+    if (rename(temp_filename, filename) != 0) {
+      Log(LogLevel::Error, "Failed to move %s into place.", filename);
+      remove(temp_filename);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+VisibilitySetBuild::VisibilitySetBuild(const Map& map, const char* cache_filename)
+    : grid(std::make_unique<VisibilityGrid>()),
+      set(std::make_unique<VisibilitySet>()),
+      cache_filename(cache_filename),
+      checksum(map.checksum) {
+  CreateVisibilityGrid(map, *grid);
+
+  thread = std::thread(&VisibilitySetBuild::Run, this);
+}
+
+VisibilitySetBuild::~VisibilitySetBuild() {
+  cancelled = true;
+
+  if (thread.joinable()) {
+    thread.join();
+  }
+}
+
+void VisibilitySetBuild::Run() {
+  if (set->Build(*grid, checksum, &cancelled)) {
+    set->Save(cache_filename.data());
+  }
+
+  grid.reset();
+  finished.store(true, std::memory_order_release);
+}
+
+std::unique_ptr<VisibilitySet> VisibilitySetBuild::TakeResult() {
+  if (thread.joinable()) {
+    thread.join();
+  }
+
+  return std::move(set);
+}
+
+}  // namespace zero
@@ -0,0 +1,96 @@
+#ifndef ZERO_VISIBILITYSET_H_
+#define ZERO_VISIBILITYSET_H_
+
+#include <zero/Math.h>
+#include <zero/Types.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace zero {
+
+struct Map;
+struct VisibilityGrid;
+
+enum class CellVisibility : u8 {
+  // Some rays between the cells are blocked and some are not, so an exact cast is required.
+  Unknown,
+  // Every ray between the cells is clear of walls, doors, and static bricks.
+  Visible,
+  // Every ray between the cells hits a wall even when all doors are open.
+  Occluded,
+};
+
+// Potentially visible set over coarse cells of the map.
+// Each cell stores the visibility to all of the cells within kCellRadius of it, so most line of sight queries between
+// nearby positions can be answered without walking a ray through the tiles.
+struct VisibilitySet {
+  static constexpr s32 kCellSize = 16;
+  static constexpr s32 kCellsPerAxis = 1024 / kCellSize;
+  static constexpr s32 kCellRadius = 5;
+  static constexpr s32 kWindowSize = kCellRadius * 2 + 1;
+
+  // Checksum of the map that this set was built from.
+  u32 checksum = 0;
+  std::vector<CellVisibility> cells;
+
+  // Builds the set for the current tiles of the map. This is expensive, so the result should be saved.
+  void Build(const Map& map);
+  // Returns false if the build was cancelled before it finished.
+  bool Build(const VisibilityGrid& grid, u32 checksum, const std::atomic<bool>* cancelled);
+
+  bool Load(const char* filename, u32 checksum);
+  bool Save(const char* filename) const;
+
+  inline CellVisibility GetVisibility(const Vector2f& from, const Vector2f& to) const {
+    if (cells.empty()) return CellVisibility::Unknown;
+    if (from.x < 0.0f || from.y < 0.0f || from.x >= 1024.0f || from.y >= 1024.0f) return CellVisibility::Unknown;
+    if (to.x < 0.0f || to.y < 0.0f || to.x >= 1024.0f || to.y >= 1024.0f) return CellVisibility::Unknown;
+
+    s32 from_x = (s32)from.x / kCellSize;
+    s32 from_y = (s32)from.y / kCellSize;
+    s32 offset_x = (s32)to.x / kCellSize - from_x + kCellRadius;
+    s32 offset_y = (s32)to.y / kCellSize - from_y + kCellRadius;
+
+    if (offset_x < 0 || offset_x >= kWindowSize || offset_y < 0 || offset_y >= kWindowSize) {
+      return CellVisibility::Unknown;
+    }
+
+    size_t index = (size_t)(from_y * kCellsPerAxis + from_x) * kWindowSize * kWindowSize;
+
+    return cells[index + offset_y * kWindowSize + offset_x];
+  }
+};
+
+// Builds a visibility set on its own thread so a map without a cached set doesn't stall the bot while it builds.
+// The tiles are copied before the thread starts, so the map can keep changing while the set is built.
+// The finished set is saved to the cache file before it's marked as finished.
+struct VisibilitySetBuild {
+  VisibilitySetBuild(const Map& map, const char* cache_filename);
+  // Cancels the build if it's still running and waits for the thread to exit.
+  ~VisibilitySetBuild();
+
+  inline bool IsFinished() const { return finished.load(std::memory_order_acquire); }
+
+  // Returns the built set. This must only be called once IsFinished returns true.
+  std::unique_ptr<VisibilitySet> TakeResult();
+
+ private:
+  void Run();
+
+  std::unique_ptr<VisibilityGrid> grid;
+  std::unique_ptr<VisibilitySet> set;
+  std::string cache_filename;
+  u32 checksum;
+
+  std::atomic<bool> finished = false;
+  std::atomic<bool> cancelled = false;
+  std::thread thread;
+};
+
+}  // namespace zero
+
+#endif
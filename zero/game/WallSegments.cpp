@@ -0,0 +1,278 @@
+#include "WallSegments.h"
+
+#include <math.h>
+#include <zero/game/BrickManager.h>
+#include <zero/game/Map.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace zero {
+
+void WallSegments::Build(const Map& map) {
+  checksum = map.checksum;
+  segments.clear();
+
+  std::vector<u8> solid(1024 * 1024);
+  std::vector<u8> dynamic(1024 * 1024);
+
+  for (u16 y = 0; y < 1024; ++y) {
+    for (u16 x = 0; x < 1024; ++x) {
+      TileId id = map.GetTileId(x, y);
+      bool is_dynamic = (id >= kTileIdFirstDoor && id <= kTileIdLastDoor) || id == 250;
+
+      dynamic[y * 1024 + x] = is_dynamic && IsSolid(id);
+      solid[y * 1024 + x] = IsSolid(id) && !is_dynamic;
+    }
+  }
+
+  // Open doors aren't solid tiles in the map, so they need to be marked from the door list.
+  for (size_t i = 0; i < map.door_count; ++i) {
+    dynamic[map.doors[i].y * 1024 + map.doors[i].x] = 1;
+    solid[map.doors[i].y * 1024 + map.doors[i].x] = 0;
+  }
+
+  // The edge of the map is solid for casts, so everything outside of it is too.
+  auto is_solid = [&solid](s32 x, s32 y) {
+    if (x < 0 || y < 0 || x >= 1024 || y >= 1024) return true;
+    return solid[y * 1024 + x] != 0;
+  };
+
+  // Walk each tile edge line and merge the consecutive faces that point the same direction.
+  for (u8 axis = 0; axis < 2; ++axis) {
+    for (s32 line = 0; line <= 1024; ++line) {
+      s8 run_normal = 0;
+      s32 run_start = 0;
+
+      for (s32 i = 0; i <= 1024; ++i) {
+        s8 normal = 0;
+
+        if (i < 1024) {
+          bool before = axis == 0 ? is_solid(line - 1, i) : is_solid(i, line - 1);
+          bool after = axis == 0 ? is_solid(line, i) : is_solid(i, line);
+
+          if (before != after) normal = before ? 1 : -1;
+        }
+
+        if (normal == run_normal) continue;
+
+        if (run_normal != 0) {
+          segments.push_back({(float)line, (float)run_start, (float)i, axis, run_normal});
+        }
+
+        run_normal = normal;
+        run_start = i;
+      }
+    }
+  }
+
+  auto clamp_cell = [](s32 v) { return std::clamp(v / kCellSize, 0, kCellsPerAxis - 1); };
+
+  // A segment is added to the cells on both sides of its line, so walls on cell borders are found from either cell.
+  auto for_each_cell = [&clamp_cell](const WallSegment& segment, auto&& fn) {
+    s32 line_start = clamp_cell((s32)segment.coord - 1);
+    s32 line_end = clamp_cell((s32)segment.coord);
+    s32 range_start = clamp_cell((s32)segment.start);
+    s32 range_end = clamp_cell((s32)segment.end);
+
+    for (s32 line = line_start; line <= line_end; ++line) {
+      for (s32 range = range_start; range <= range_end; ++range) {
+        fn(segment.axis == 0 ? range * kCellsPerAxis + line : line * kCellsPerAxis + range);
+      }
+    }
+  };
+
+  cell_segment_offsets.assign(kCellCount + 1, 0);
+
+  for (const WallSegment& segment : segments) {
+    for_each_cell(segment, [this](s32 cell) { ++cell_segment_offsets[cell + 1]; });
+  }
+
+  for (size_t i = 0; i < kCellCount; ++i) {
+    cell_segment_offsets[i + 1] += cell_segment_offsets[i];
+  }
+
+  cell_segments.resize(cell_segment_offsets[kCellCount]);
+
+  std::vector<u32> cursor(cell_segment_offsets.begin(), cell_segment_offsets.end() - 1);
+
+  for (const WallSegment& segment : segments) {
+    for_each_cell(segment, [&](s32 cell) { cell_segments[cursor[cell]++] = segment; });
+  }
+
+  cell_door_offsets.assign(kCellCount + 1, 0);
+
+  for (s32 y = 0; y < 1024; ++y) {
+    for (s32 x = 0; x < 1024; ++x) {
+      if (dynamic[y * 1024 + x]) ++cell_door_offsets[(y / kCellSize) * kCellsPerAxis + x / kCellSize + 1];
+    }
+  }
+
+  for (size_t i = 0; i < kCellCount; ++i) {
+    cell_door_offsets[i + 1] += cell_door_offsets[i];
+  }
+
+  cell_doors.resize(cell_door_offsets[kCellCount]);
+  cursor.assign(cell_door_offsets.begin(), cell_door_offsets.end() - 1);
+
+  for (s32 y = 0; y < 1024; ++y) {
+    for (s32 x = 0; x < 1024; ++x) {
+      if (!dynamic[y * 1024 + x]) continue;
+
+      size_t cell = (y / kCellSize) * kCellsPerAxis + x / kCellSize;
+      cell_doors[cursor[cell]++] = Vector2f((float)x, (float)y);
+    }
+  }
+
+  bricks_valid = false;
+}
+
+void WallSegments::UpdateBricks(const Map& map) const {
+  // Placing and removing bricks changes the tiles, so the overlay only needs to be rebuilt when the tiles do.
+  if (bricks_valid && brick_tile_epoch == map.tile_epoch) return;
+
+  bricks_valid = true;
+  brick_tile_epoch = map.tile_epoch;
+
+  cell_brick_offsets.assign(kCellCount + 1, 0);
+  cell_bricks.clear();
+
+  for (Brick* brick = map.brick_manager->bricks; brick; brick = brick->next) {
+    ++cell_brick_offsets[(brick->tile.y / kCellSize) * kCellsPerAxis + brick->tile.x / kCellSize + 1];
+  }
+
+  for (size_t i = 0; i < kCellCount; ++i) {
+    cell_brick_offsets[i + 1] += cell_brick_offsets[i];
+  }
+
+  cell_bricks.resize(cell_brick_offsets[kCellCount]);
+
+  std::vector<u32> cursor(cell_brick_offsets.begin(), cell_brick_offsets.end() - 1);
+
+  for (Brick* brick = map.brick_manager->bricks; brick; brick = brick->next) {
+    size_t cell = (brick->tile.y / kCellSize) * kCellsPerAxis + brick->tile.x / kCellSize;
+    cell_bricks[cursor[cell]++] = Vector2f((float)brick->tile.x, (float)brick->tile.y);
+  }
+}
+
+CastResult WallSegments::Cast(const Map& map, const Vector2f& from, const Vector2f& direction, float max_distance,
+                              u32 frequency) const {
+  if (cell_segment_offsets.empty() || from.x < 0.0f || from.y < 0.0f || from.x >= 1024.0f || from.y >= 1024.0f) {
+    return map.Cast(from, direction, max_distance, frequency);
+  }
+
+  CastResult result;
+
+  result.hit = false;
+  result.normal = Vector2f(0, 0);
+
+  if (map.IsSolid(from, frequency)) {
+    result.hit = true;
+    result.distance = 0.0f;
+    result.position = from;
+    return result;
+  }
+
+  float best = max_distance;
+
+  auto test_tile = [&](const Vector2f& tile) {
+    float distance;
+    Vector2f normal;
+
+    if (!map.IsSolid((u16)tile.x, (u16)tile.y, frequency)) return;
+    if (!RayBoxIntersect(from, direction, tile, Vector2f(1, 1), &distance, &normal)) return;
+    if (distance < 0.0f || distance > best || (result.hit && distance >= best)) return;
+
+    best = distance;
+    result.hit = true;
+    result.normal = normal;
+  };
+
+  bool has_bricks = map.brick_manager && map.brick_manager->bricks;
+
+  if (has_bricks) {
+    UpdateBricks(map);
+  }
+
+  constexpr float kInfinity = std::numeric_limits<float>::max();
+
+  s32 cell_x = (s32)from.x / kCellSize;
+  s32 cell_y = (s32)from.y / kCellSize;
+  s32 step_x = direction.x < 0.0f ? -1 : 1;
+  s32 step_y = direction.y < 0.0f ? -1 : 1;
+
+  float delta_x = direction.x != 0.0f ? fabsf(kCellSize / direction.x) : kInfinity;
+  float delta_y = direction.y != 0.0f ? fabsf(kCellSize / direction.y) : kInfinity;
+  float next_x = kInfinity;
+  float next_y = kInfinity;
+
+  if (direction.x != 0.0f) {
+    next_x = ((cell_x + (step_x > 0 ? 1 : 0)) * kCellSize - from.x) / direction.x;
+  }
+
+  if (direction.y != 0.0f) {
+    next_y = ((cell_y + (step_y > 0 ? 1 : 0)) * kCellSize - from.y) / direction.y;
+  }
+
+  Vector2f inv_direction(1.0f / direction.x, 1.0f / direction.y);
+
+  while (true) {
+    size_t cell = cell_y * kCellsPerAxis + cell_x;
+
+    for (u32 i = cell_segment_offsets[cell]; i < cell_segment_offsets[cell + 1]; ++i) {
+      const WallSegment& segment = cell_segments[i];
+      u8 axis = segment.axis;
+
+      // The ray has to be moving into the face for it to hit.
+      if (direction[axis] * segment.normal >= 0.0f) continue;
+
+      float distance = (segment.coord - from[axis]) * inv_direction[axis];
+      if (distance < 0.0f || distance > best || (result.hit && distance >= best)) continue;
+
+      float along = from[1 - axis] + direction[1 - axis] * distance;
+      if (along < segment.start || along > segment.end) continue;
+
+      best = distance;
+      result.hit = true;
+      result.normal = axis == 0 ? Vector2f((float)segment.normal, 0) : Vector2f(0, (float)segment.normal);
+    }
+
+    for (u32 i = cell_door_offsets[cell]; i < cell_door_offsets[cell + 1]; ++i) {
+      test_tile(cell_doors[i]);
+    }
+
+    if (has_bricks) {
+      for (u32 i = cell_brick_offsets[cell]; i < cell_brick_offsets[cell + 1]; ++i) {
+        test_tile(cell_bricks[i]);
+      }
+    }
+
+    float exit = std::min(next_x, next_y);
+
+    // Anything in a later cell is further away than the hit in this one.
+    if (result.hit && best <= exit) break;
+    if (exit >= max_distance) break;
+
+    if (next_x < next_y) {
+      cell_x += step_x;
+      next_x += delta_x;
+    } else {
+      cell_y += step_y;
+      next_y += delta_y;
+    }
+
+    if (cell_x < 0 || cell_y < 0 || cell_x >= kCellsPerAxis || cell_y >= kCellsPerAxis) break;
+  }
+
+  if (result.hit) {
+    result.distance = best;
+    result.position = from + direction * best;
+  } else {
+    result.distance = max_distance;
+    result.position = from + direction * max_distance;
+  }
+
+  return result;
+}
+
+}  // namespace zero
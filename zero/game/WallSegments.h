@@ -0,0 +1,68 @@
+#ifndef ZERO_WALLSEGMENTS_H_
+#define ZERO_WALLSEGMENTS_H_
+
+#include <zero/Math.h>
+#include <zero/Types.h>
+
+#include <vector>
+
+namespace zero {
+
+struct CastResult;
+struct Map;
+
+// An axis aligned wall face made from a run of solid tiles that are next to empty tiles on the same side.
+struct WallSegment {
+  // The x position of walls on axis 0, or the y position of walls on axis 1.
+  float coord;
+  // The range along the other axis that the wall covers.
+  float start;
+  float end;
+  u8 axis;
+  // Direction of the face away from the solid tiles, either 1 or -1.
+  s8 normal;
+};
+
+// Wall faces of a map merged into segments and bucketed into a coarse grid, so casts only test the few segments in
+// the cells that the ray passes through instead of checking every tile along it.
+// Doors and bricks change while the map is loaded, so they are excluded from the segments and checked against their
+// current state as an overlay. Door tiles are bucketed when the segments are built, and active bricks are bucketed
+// again whenever the tiles of the map change.
+struct WallSegments {
+  static constexpr s32 kCellSize = 8;
+  static constexpr s32 kCellsPerAxis = 1024 / kCellSize;
+  static constexpr size_t kCellCount = kCellsPerAxis * kCellsPerAxis;
+
+  // Checksum of the map that the segments were built from.
+  u32 checksum = 0;
+
+  std::vector<WallSegment> segments;
+
+  // Each cell's segments are copied into one array with the start offset of each cell, and the final offset is the
+  // total count. Copying them keeps the segments of a cell next to each other in memory.
+  std::vector<u32> cell_segment_offsets;
+  std::vector<WallSegment> cell_segments;
+
+  // Door tiles and any brick tiles that were already in the map, stored the same way as the segments.
+  std::vector<u32> cell_door_offsets;
+  std::vector<Vector2f> cell_doors;
+
+  void Build(const Map& map);
+
+  // Same result as Map::Cast, but the walls are found by intersecting segments instead of walking the tiles.
+  CastResult Cast(const Map& map, const Vector2f& from, const Vector2f& direction, float max_distance,
+                  u32 frequency) const;
+
+ private:
+  void UpdateBricks(const Map& map) const;
+
+  // The brick overlay is rebuilt lazily during casts.
+  mutable bool bricks_valid = false;
+  mutable u32 brick_tile_epoch = 0;
+  mutable std::vector<u32> cell_brick_offsets;
+  mutable std::vector<Vector2f> cell_bricks;
+};
+
+}  // namespace zero
+
+#endif
@@ -7,7 +7,6 @@
 #include <zero/game/Camera.h>
 #include <zero/game/Clock.h>
 #include <zero/game/GameEvent.h>
-#include <zero/game/KDTree.h>
 #include <zero/game/Logger.h>
 #include <zero/game/Memory.h>
 #include <zero/game/PlayerManager.h>
@@ -17,7 +16,7 @@
 #include <zero/game/net/PacketDispatcher.h>
 #include <zero/game/render/Graphics.h>
 
-// TODO: Spatial partition acceleration structures
+#include <algorithm>
 
 namespace zero {
 
@@ -28,15 +27,24 @@ static void OnLargePositionPkt(void* user, u8* pkt, size_t size) {
 }
 
 WeaponManager::WeaponManager(MemoryArena& temp_arena, Connection& connection, PlayerManager& player_manager,
-                             PacketDispatcher& dispatcher, AnimationSystem& animation)
-    : temp_arena(temp_arena), connection(connection), player_manager(player_manager), animation(animation) {
+                             PacketDispatcher& dispatcher, AnimationSystem& animation, ThreadPool& thread_pool)
+    : temp_arena(temp_arena),
+      connection(connection),
+      player_manager(player_manager),
+      animation(animation),
+      thread_pool(thread_pool) {
   dispatcher.Register(ProtocolS2C::LargePosition, OnLargePositionPkt, this);
 }
 
 void WeaponManager::Update(float dt) {
   u32 tick = GetCurrentTick();
 
+  for (size_t i = 0; i < link_removal_count; ++i) {
+    link_removal_lookup.Erase(link_removals[i].link_id);
+  }
+
   link_removal_count = 0;
+  lanes.count = 0;
 
   for (size_t i = 0; i < weapon_count; ++i) {
     Weapon* weapon = weapons + i;
@@ -45,12 +53,58 @@ void WeaponManager::Update(float dt) {
 
     if (player && connection.map.GetTileId(player->position) == kTileIdSafe) {
       Event::Dispatch(WeaponDestroyEvent(*weapon));
-      weapons[i--] = weapons[--weapon_count];
-      continue;
+      RemoveWeapon(i--);
     }
+  }
+
+  bool use_fast_paths = fast_paths_enabled && TICK_DIFF(tick, last_update_tick) >= kMinFastPathTicks;
+  bool use_lanes = false;
 
+  last_update_tick = tick;
+
+  if (use_fast_paths) {
+    FindAllCollisionCandidates(tick);
+    use_lanes = FindLaneRepels(tick);
+  }
+
+  for (size_t i = 0; i < weapon_count; ++i) {
+    Weapon* weapon = weapons + i;
     s32 tick_count = TICK_DIFF(tick, weapon->last_tick);
 
+    needs_simulation[i] = true;
+
+    if (use_lanes && tick_count > 0 && CanUseLane(*weapon, collision_candidates[i], tick_count)) {
+      size_t lane = lanes.count++;
+
+      lanes.index[lane] = (u16)i;
+      lanes.frequency[lane] = weapon->frequency;
+      lanes.x[lane] = weapon->x;
+      lanes.y[lane] = weapon->y;
+      lanes.velocity_x[lane] = weapon->velocity_x;
+      lanes.velocity_y[lane] = weapon->velocity_y;
+      lanes.last_tick[lane] = weapon->last_tick;
+      lanes.end_tick[lane] = weapon->end_tick;
+      lanes.tick_count[lane] = tick_count;
+    }
+  }
+
+  if (use_fast_paths) {
+    collision_candidate_count = weapon_count;
+  }
+
+  SimulateLanes();
+
+  // Weapons that are spawned during the loop, such as shrapnel, don't have a flag and always get the full simulation.
+  size_t flagged_count = weapon_count;
+
+  for (size_t i = 0; i < weapon_count; ++i) {
+    if (i < flagged_count && !needs_simulation[i]) continue;
+
+    Weapon* weapon = weapons + i;
+
+    s32 tick_count = TICK_DIFF(tick, weapon->last_tick);
+    bool removed = false;
+
     for (s32 j = 0; j < tick_count; ++j) {
       WeaponSimulateResult result = WeaponSimulateResult::Continue;
 
@@ -63,41 +117,46 @@ void WeaponManager::Update(float dt) {
       if (result == WeaponSimulateResult::PlayerExplosion || result == WeaponSimulateResult::WallExplosion) {
         CreateExplosion(*weapon);
         Event::Dispatch(WeaponDestroyEvent(*weapon));
-        weapons[i--] = weapons[--weapon_count];
+        removed = true;
         break;
       } else if (result == WeaponSimulateResult::TimedOut) {
         Event::Dispatch(WeaponDestroyEvent(*weapon));
-        weapons[i--] = weapons[--weapon_count];
+        removed = true;
         break;
       }
     }
+
+    if (removed) {
+      // The last weapon is swapped into this slot, so its flag moves with it and the slot is visited again.
+      size_t last = weapon_count - 1;
+
+      needs_simulation[i] = last >= flagged_count || needs_simulation[last];
+      RemoveWeapon(i--);
+
+      if (flagged_count > weapon_count) {
+        flagged_count = weapon_count;
+      }
+    } else {
+      UpdateWeaponCell(i);
+    }
   }
 
-  if (link_removal_count > 0) {
-    for (size_t i = 0; i < weapon_count; ++i) {
-      Weapon* weapon = weapons + i;
+  // The candidates are only valid for this update, so anything simulated outside of it must query the player grid.
+  collision_candidate_count = 0;
 
-      if (weapon->link_id != kInvalidLink) {
-        bool removed = false;
+  for (size_t i = 0; i < link_removal_count; ++i) {
+    if (link_removals[i].result == WeaponSimulateResult::PlayerExplosion) {
+      DestroyLink(link_removals[i].link_id);
+    }
+  }
 
-        for (size_t j = 0; j < link_removal_count; ++j) {
-          WeaponLinkRemoval* removal = link_removals + j;
+  max_weapon_speed = 0.0f;
 
-          if (removal->link_id == weapon->link_id) {
-            if (removal->result == WeaponSimulateResult::PlayerExplosion) {
-              CreateExplosion(*weapon);
-              removed = true;
-            }
-            break;
-          }
-        }
+  for (size_t i = 0; i < weapon_count; ++i) {
+    float speed_sq = weapons[i].velocity.LengthSq();
 
-        if (removed) {
-          assert(weapon_count > 0);
-          Event::Dispatch(WeaponDestroyEvent(*weapon));
-          weapons[i--] = weapons[--weapon_count];
-        }
-      }
+    if (speed_sq > max_weapon_speed * max_weapon_speed) {
+      max_weapon_speed = sqrtf(speed_sq);
     }
   }
 }
@@ -133,6 +192,10 @@ bool WeaponManager::SimulateWormholeGravity(Weapon& weapon) {
         weapon.velocity_x += (s32)(direction.x * per_second);
         weapon.velocity_y += (s32)(direction.y * per_second);
         weapon.UpdatePosition();
+
+        if (weapon.velocity.Length() > max_weapon_speed) {
+          max_weapon_speed = weapon.velocity.Length();
+        }
         affected = true;
       }
     }
@@ -212,61 +275,14 @@ WeaponSimulateResult WeaponManager::Simulate(Weapon& weapon, u32 current_tick) {
 
   WeaponSimulateResult result = WeaponSimulateResult::Continue;
 
-  float max_distance = 0.0f;
-  // Find ship max radius
-  for (size_t i = 0; i < 8; ++i) {
-    float radius = connection.settings.ShipSettings[i].GetRadius();
-    if (radius > max_distance) {
-      max_distance = radius;
-    }
-  }
-
-  float weapon_radius = 18.0f;
-
-  if (is_prox) {
-    float prox = (float)(connection.settings.ProximityDistance + weapon.data.level);
-
-    if (weapon.data.type == WeaponType::Thor) {
-      prox += 3;
-    }
-
-    weapon_radius = prox * 18.0f;
-  }
-
-  weapon_radius = (weapon_radius - 14.0f) / 16.0f;
-
-  // Combine ship radius with weapon radius to find max collision lookup distance.
-  max_distance += weapon_radius;
-
-  if (player_manager.kdtree == nullptr) {
-    player_manager.kdtree = BuildPartition(temp_arena, player_manager);
-  }
-
-  KDCollection players = {};
-  KDNode* node = nullptr;
-
+  float weapon_radius = GetCollisionRadius(weapon);
   Vector2f weapon_position = weapon.GetPosition();
 
-  if (player_manager.kdtree) {
-    // Range search is L2 distance, so max distance should be multiplied by sqrt(2) to handle box corner cases.
-    constexpr float sqrt2 = 1.5f;
-    // Add some buffer room for rounding errors
-    max_distance += 1.0f;
-
-    node = player_manager.kdtree->RangeSearch(weapon_position, max_distance * sqrt2);
-  }
-
-  if (node) {
-    players = node->Collect(temp_arena);
-  }
-
-  for (size_t i = 0; i < players.count; ++i) {
-    Player* player = players.players[i];
-
-    if (player->ship == 8) continue;
-    if (player->frequency == weapon.frequency) continue;
-    if (player->enter_delay > 0) continue;
-    if (!player_manager.IsSynchronized(*player, current_tick)) continue;
+  auto check_player = [&](Player* player) {
+    if (player->ship == 8) return;
+    if (player->frequency == weapon.frequency) return;
+    if (player->enter_delay > 0) return;
+    if (!player_manager.IsSynchronized(*player, current_tick)) return;
 
     float radius = connection.settings.ShipSettings[player->ship].GetRadius();
     Vector2f player_r(radius, radius);
@@ -307,7 +323,7 @@ WeaponSimulateResult WeaponManager::Simulate(Weapon& weapon, u32 current_tick) {
         hit = BoxBoxOverlap(pos - player_r, pos + player_r, min_w, max_w);
 
         if (!hit) {
-          continue;
+          return;
         }
       }
 
@@ -328,6 +344,25 @@ WeaponSimulateResult WeaponManager::Simulate(Weapon& weapon, u32 current_tick) {
 
       result = WeaponSimulateResult::PlayerExplosion;
     }
+  };
+
+  size_t index = (size_t)(&weapon - weapons);
+
+  if (index < collision_candidate_count && collision_candidates[index].offset != kNoCollisionCandidates) {
+    WeaponCollisionCandidates& candidates = collision_candidates[index];
+
+    for (u32 i = 0; i < candidates.count; ++i) {
+      check_player(collision_pairs[candidates.offset + i]);
+    }
+  } else {
+    // Combine ship radius with weapon radius to find max collision lookup distance.
+    // Add some buffer room for rounding errors
+    float max_distance = max_ship_radius + weapon_radius + 1.0f;
+
+    Vector2f search_min = weapon_position - Vector2f(max_distance, max_distance);
+    Vector2f search_max = weapon_position + Vector2f(max_distance, max_distance);
+
+    player_manager.ForEachPlayerInRect(search_min, search_max, check_player);
   }
 
   return result;
@@ -356,6 +391,15 @@ WeaponSimulateResult WeaponManager::SimulateRepel(Weapon& weapon) {
 
       other.UpdatePosition();
 
+      if (other.velocity.Length() > max_weapon_speed) {
+        max_weapon_speed = other.velocity.Length();
+      }
+
+      // The new velocity can take it outside of its swept bounds.
+      if (i < collision_candidate_count) {
+        collision_candidates[i].offset = kNoCollisionCandidates;
+      }
+
       WeaponType type = other.data.type;
 
       if (other.data.alternate && (type == WeaponType::Bomb || type == WeaponType::ProximityBomb)) {
@@ -367,22 +411,29 @@ WeaponSimulateResult WeaponManager::SimulateRepel(Weapon& weapon) {
     }
   }
 
+  const PlayerHotView& hot = player_manager.hot;
+  u32 current_tick = GetCurrentTick();
+
   for (size_t i = 0; i < player_manager.player_count; ++i) {
-    Player& player = player_manager.players[i];
+    if (hot.frequency[i] == weapon.frequency) continue;
+    if (hot.ship[i] >= 8) continue;
+    if (hot.enter_delay[i] > 0.0f) continue;
+    if (!player_manager.IsSynchronized(i, current_tick)) continue;
 
-    if (player.frequency == weapon.frequency) continue;
-    if (player.ship >= 8) continue;
-    if (player.enter_delay > 0.0f) continue;
-    if (!player_manager.IsSynchronized(player)) continue;
+    Vector2f position = hot.GetPosition(i);
 
-    if (PointInsideBox(rect_min, rect_max, player.position)) {
-      if (connection.map.GetTileId(player.position) != kTileIdSafe) {
-        player.last_repel_timestamp = GetCurrentTick();
+    if (PointInsideBox(rect_min, rect_max, position)) {
+      if (connection.map.GetTileId(position) != kTileIdSafe) {
+        Player& player = player_manager.players[i];
+
+        player.last_repel_timestamp = current_tick;
 
         if (player.id == player_manager.player_id) {
           Vector2f direction = Normalize(player.position - weapon.GetPosition());
           player.velocity = direction * speed;
           player.repel_time = connection.settings.RepelTime / 100.0f;
+
+          player_manager.UpdateHotPlayer(player);
         }
       }
     }
@@ -459,13 +510,319 @@ WeaponSimulateResult WeaponManager::SimulatePosition(Weapon& weapon) {
   return WeaponSimulateResult::Continue;
 }
 
+bool WeaponManager::CanUseLane(const Weapon& weapon, const WeaponCollisionCandidates& candidates, s32 tick_count) {
+  // Only plain bullets are handled here since everything else has special behavior while flying.
+  if (weapon.data.type != WeaponType::Bullet && weapon.data.type != WeaponType::BouncingBullet) return false;
+
+  // The weapon can't hit anyone if no enemy is within the total distance that it can travel this update.
+  if (candidates.offset == kNoCollisionCandidates || candidates.count != 0) return false;
+
+  if (lane_repel_count == 0) return true;
+
+  // Repels change the velocity of the weapons in their area partway through the update, so the weapon must not be able
+  // to travel into the area of any enemy repel.
+  float travel = tick_count * (abs(weapon.velocity_x) + abs(weapon.velocity_y)) / 16000.0f + 1.0f;
+  Vector2f position(weapon.x / 16000.0f, weapon.y / 16000.0f);
+  Vector2f min = position - Vector2f(travel, travel);
+  Vector2f max = position + Vector2f(travel, travel);
+
+  for (size_t i = 0; i < lane_repel_count; ++i) {
+    const LaneRepel& repel = lane_repels[i];
+
+    if (repel.frequency == weapon.frequency) continue;
+
+    if (BoxBoxOverlap(min, max, repel.min, repel.max)) return false;
+  }
+
+  return true;
+}
+
+bool WeaponManager::FindLaneRepels(u32 current_tick) {
+  float effect_radius = connection.settings.RepelDistance / 16.0f;
+
+  lane_repel_count = 0;
+
+  for (size_t i = 0; i < weapon_count; ++i) {
+    Weapon& weapon = weapons[i];
+
+    if (weapon.data.type != WeaponType::Repel) continue;
+    if (TICK_DIFF(current_tick, weapon.last_tick) <= 0) continue;
+
+    // There are too many repels to check each weapon against, so everything goes through the full simulation.
+    if (lane_repel_count >= ZERO_ARRAY_SIZE(lane_repels)) return false;
+
+    LaneRepel& repel = lane_repels[lane_repel_count++];
+    Vector2f position = weapon.GetPosition();
+
+    repel.min = position - Vector2f(effect_radius, effect_radius);
+    repel.max = position + Vector2f(effect_radius, effect_radius);
+    repel.frequency = weapon.frequency;
+  }
+
+  return true;
+}
+
+void WeaponManager::UpdateMaxShipRadius() {
+  max_ship_radius = 0.0f;
+
+  for (size_t i = 0; i < 8; ++i) {
+    float radius = connection.settings.ShipSettings[i].GetRadius();
+
+    if (radius > max_ship_radius) {
+      max_ship_radius = radius;
+    }
+  }
+}
+
+float WeaponManager::GetCollisionRadius(const Weapon& weapon) {
+  float weapon_radius = 18.0f;
+
+  if (weapon.data.type == WeaponType::ProximityBomb || weapon.data.type == WeaponType::Thor) {
+    float prox = (float)(connection.settings.ProximityDistance + weapon.data.level);
+
+    if (weapon.data.type == WeaponType::Thor) {
+      prox += 3;
+    }
+
+    weapon_radius = prox * 18.0f;
+  }
+
+  return (weapon_radius - 14.0f) / 16.0f;
+}
+
+void WeaponManager::FindAllCollisionCandidates(u32 current_tick) {
+  constexpr size_t kMinWeaponsPerThread = 512;
+
+  UpdateMaxShipRadius();
+
+  size_t thread_count = thread_pool.GetJobThreadCount(weapon_count, kMinWeaponsPerThread);
+
+  for (size_t i = 0; i < thread_count; ++i) {
+    CollisionPairSegment& segment = collision_segments[i];
+
+    segment.start = kMaxCollisionPairs * i / thread_count;
+    segment.capacity = kMaxCollisionPairs * (i + 1) / thread_count - segment.start;
+    segment.count = 0;
+    segment.weapon_start = segment.weapon_end = 0;
+  }
+
+  collision_search_tick = current_tick;
+  thread_pool.Run(RunCollisionCandidateJob, this, weapon_count, kMinWeaponsPerThread);
+
+  // Pack the segments together. Each segment only moves down, so the pairs can be moved in order.
+  collision_pair_count = 0;
+
+  for (size_t i = 0; i < thread_count; ++i) {
+    CollisionPairSegment& segment = collision_segments[i];
+    u32 shift = (u32)(segment.start - collision_pair_count);
+
+    if (shift > 0) {
+      memmove(collision_pairs + collision_pair_count, collision_pairs + segment.start,
+              segment.count * sizeof(*collision_pairs));
+
+      for (size_t j = segment.weapon_start; j < segment.weapon_end; ++j) {
+        if (collision_candidates[j].offset != kNoCollisionCandidates) {
+          collision_candidates[j].offset -= shift;
+        }
+      }
+    }
+
+    collision_pair_count += segment.count;
+  }
+}
+
+void WeaponManager::RunCollisionCandidateJob(void* user, size_t thread_index, size_t start, size_t end) {
+  WeaponManager* manager = (WeaponManager*)user;
+  CollisionPairSegment& segment = manager->collision_segments[thread_index];
+  u32 tick = manager->collision_search_tick;
+
+  segment.weapon_start = start;
+  segment.weapon_end = end;
+
+  for (size_t i = start; i < end; ++i) {
+    s32 tick_count = TICK_DIFF(tick, manager->weapons[i].last_tick);
+
+    manager->FindCollisionCandidates(i, tick_count, tick, segment);
+  }
+}
+
+void WeaponManager::FindCollisionCandidates(size_t index, s32 tick_count, u32 current_tick,
+                                            CollisionPairSegment& segment) {
+  Weapon& weapon = weapons[index];
+  WeaponCollisionCandidates& candidates = collision_candidates[index];
+  WeaponType type = weapon.data.type;
+
+  candidates.offset = (u32)(segment.start + segment.count);
+  candidates.count = 0;
+
+  if (type == WeaponType::Repel || type == WeaponType::Decoy) return;
+
+  // Gravity can change the velocity during the update, so the area that the weapon travels through isn't known.
+  if (connection.settings.GravityBombs && (type == WeaponType::Bomb || type == WeaponType::ProximityBomb)) {
+    candidates.offset = kNoCollisionCandidates;
+    return;
+  }
+
+  // Player positions don't change during the update and bouncing can only keep the weapon closer, so every position the
+  // weapon can reach is within the total distance it can travel of where it starts.
+  float travel = tick_count > 0 ? tick_count * (abs(weapon.velocity_x) + abs(weapon.velocity_y)) / 16000.0f : 0.0f;
+  float reach = travel + max_ship_radius + GetCollisionRadius(weapon) + 1.0f;
+  Vector2f position = weapon.GetPosition();
+
+  Vector2f search_min = position - Vector2f(reach, reach);
+  Vector2f search_max = position + Vector2f(reach, reach);
+
+  player_manager.ForEachPlayerInRect(search_min, search_max, [&](Player* player) {
+    if (player->ship == 8) return;
+    if (player->frequency == weapon.frequency) return;
+    if (player->enter_delay > 0) return;
+    if (!player_manager.IsSynchronized(*player, current_tick)) return;
+
+    if (segment.count >= segment.capacity) {
+      candidates.offset = kNoCollisionCandidates;
+      return;
+    }
+
+    collision_pairs[segment.start + segment.count++] = player;
+    ++candidates.count;
+  });
+}
+
+void WeaponManager::SimulateLanes() {
+  constexpr size_t kMinBlocksPerThread = 128;
+
+  size_t block_count = (lanes.count + kWeaponLaneWidth - 1) / kWeaponLaneWidth;
+
+  thread_pool.Run(RunLaneJob, this, block_count, kMinBlocksPerThread);
+
+  // Writing back touches the weapon grid, so it stays on this thread.
+  for (size_t i = 0; i < lanes.count; ++i) {
+    Weapon* weapon = weapons + lanes.index[i];
+
+    if (weapon->last_tick != lanes.last_tick[i]) {
+      weapon->flags &= ~WEAPON_FLAG_INITIAL_SIM;
+    }
+
+    weapon->x = lanes.x[i];
+    weapon->y = lanes.y[i];
+    weapon->last_tick = lanes.last_tick[i];
+    weapon->UpdatePosition();
+
+    UpdateWeaponCell(lanes.index[i]);
+
+    needs_simulation[lanes.index[i]] = lanes.tick_count[i] > 0;
+  }
+}
+
+void WeaponManager::RunLaneJob(void* user, size_t thread_index, size_t start, size_t end) {
+  WeaponManager* manager = (WeaponManager*)user;
+
+  manager->SimulateLaneBlocks(start, end);
+}
+
+void WeaponManager::SimulateLaneBlocks(size_t start_block, size_t end_block) {
+  Map& map = connection.map;
+
+  for (size_t block = start_block; block < end_block; ++block) {
+    size_t base = block * kWeaponLaneWidth;
+    size_t width = lanes.count - base;
+
+    if (width > kWeaponLaneWidth) {
+      width = kWeaponLaneWidth;
+    }
+
+    u32* x = lanes.x + base;
+    u32* y = lanes.y + base;
+    s32* velocity_x = lanes.velocity_x + base;
+    s32* velocity_y = lanes.velocity_y + base;
+    u32* last_tick = lanes.last_tick + base;
+    u32* end_tick = lanes.end_tick + base;
+    s32* tick_count = lanes.tick_count + base;
+
+    bool active[kWeaponLaneWidth] = {};
+    bool any_active = false;
+
+    for (size_t i = 0; i < width; ++i) {
+      active[i] = tick_count[i] > 0;
+      any_active |= active[i];
+    }
+
+    while (any_active) {
+      u32 next_x[kWeaponLaneWidth] = {};
+      u32 next_y[kWeaponLaneWidth] = {};
+
+      for (size_t i = 0; i < width; ++i) {
+        next_x[i] = x[i] + velocity_x[i];
+        next_y[i] = y[i] + velocity_y[i];
+      }
+
+      any_active = false;
+
+      for (size_t i = 0; i < width; ++i) {
+        if (!active[i]) continue;
+
+        u16 frequency = lanes.frequency[base + i];
+
+        // Stop the lane before any tick that would time out or touch a wall or wormhole.
+        // The full simulation picks up from there since those need the rest of the weapon data.
+        if (last_tick[i] >= end_tick[i] || map.IsSolid(next_x[i] / 16000, y[i] / 16000, frequency) ||
+            map.IsSolid(next_x[i] / 16000, next_y[i] / 16000, frequency) ||
+            map.GetTileId(Vector2f(next_x[i] / 16000.0f, next_y[i] / 16000.0f)) == kTileIdWormhole) {
+          active[i] = false;
+          continue;
+        }
+
+        x[i] = next_x[i];
+        y[i] = next_y[i];
+        ++last_tick[i];
+
+        active[i] = --tick_count[i] > 0;
+        any_active |= active[i];
+      }
+    }
+  }
+}
+
+void WeaponManager::RemoveWeapon(size_t index) {
+  size_t last = --weapon_count;
+
+  ++weapon_generation;
+
+  if (weapons[index].link_id != kInvalidLink) {
+    links.Remove((u16)index, weapons[index].link_id);
+  }
+
+  if (index != last) {
+    if (weapons[last].link_id != kInvalidLink) {
+      links.Relocate((u16)last, (u16)index, weapons[last].link_id);
+    }
+
+    weapons[index] = weapons[last];
+  }
+
+  grid.SwapRemove((u16)index, (u16)last);
+
+  if (index < collision_candidate_count) {
+    collision_candidates[index].offset = kNoCollisionCandidates;
+
+    if (index != last && last < collision_candidate_count) {
+      collision_candidates[index] = collision_candidates[last];
+      collision_candidates[last].offset = kNoCollisionCandidates;
+    }
+  }
+}
+
+void WeaponManager::UpdateWeaponCell(size_t index) {
+  grid.Update((u16)index, weapons[index].position);
+}
+
 void WeaponManager::ClearWeapons(Player& player) {
   for (size_t i = 0; i < weapon_count; ++i) {
     Weapon* weapon = weapons + i;
 
     if (weapon->player_id == player.id) {
       Event::Dispatch(WeaponDestroyEvent(*weapon));
-      weapons[i--] = weapons[--weapon_count];
+      RemoveWeapon(i--);
     }
   }
 }
@@ -474,26 +831,34 @@ bool WeaponManager::HasLinkRemoved(u32 link_id) {
   // This should never happen, but check just to make sure.
   if (link_id == kInvalidLink) return false;
 
-  for (size_t i = 0; i < link_removal_count; ++i) {
-    if (link_removals[i].link_id == link_id) {
-      return true;
-    }
-  }
-
-  return false;
+  return link_removal_lookup.Find(link_id) != nullptr;
 }
 
 void WeaponManager::AddLinkRemoval(u32 link_id, WeaponSimulateResult result) {
   // This should never happen, but check just to make sure.
   if (link_id == kInvalidLink) return;
+  if (HasLinkRemoved(link_id)) return;
 
   assert(link_removal_count < ZERO_ARRAY_SIZE(link_removals));
 
+  link_removal_lookup.Insert(link_id, (u16)link_removal_count);
+
   WeaponLinkRemoval* removal = link_removals + link_removal_count++;
   removal->link_id = link_id;
   removal->result = result;
 }
 
+void WeaponManager::DestroyLink(u32 link_id) {
+  // Removing a weapon unlinks it, so keep taking the first one until the link is empty.
+  for (u16 index = links.GetFirst(link_id); index != kInvalidGridIndex; index = links.GetFirst(link_id)) {
+    Weapon* weapon = weapons + index;
+
+    CreateExplosion(*weapon);
+    Event::Dispatch(WeaponDestroyEvent(*weapon));
+    RemoveWeapon(index);
+  }
+}
+
 void WeaponManager::CreateExplosion(Weapon& weapon) {
   WeaponType type = weapon.data.type;
   Vector2f position(weapon.x / 16000.0f, weapon.y / 16000.0f);
@@ -535,6 +900,8 @@ void WeaponManager::CreateExplosion(Weapon& weapon) {
 
         Weapon* shrap = weapons + weapon_count++;
 
+        ++weapon_generation;
+
         shrap->animation.t = 0.0f;
         shrap->animation.repeat = true;
         shrap->bounces_remaining = 0;
@@ -567,6 +934,12 @@ void WeaponManager::CreateExplosion(Weapon& weapon) {
         if (connection.map.IsSolid((u16)(shrap->x / 16000.0f), (u16)(shrap->y / 16000.0f), shrap->frequency)) {
           Event::Dispatch(WeaponDestroyEvent(*shrap));
           --weapon_count;
+        } else {
+          UpdateWeaponCell(shrap - weapons);
+
+          if (speed > max_weapon_speed) {
+            max_weapon_speed = speed;
+          }
         }
       }
 
@@ -733,6 +1106,9 @@ void WeaponManager::OnWeaponPacket(u8* pkt, size_t size) {
 bool WeaponManager::FireWeapons(Player& player, WeaponData weapon, u32 pos_x, u32 pos_y, s32 vel_x, s32 vel_y,
                                 u32 timestamp) {
   ShipSettings& ship_settings = connection.settings.ShipSettings[player.ship];
+
+  // The initial simulation of the new weapons checks for collisions outside of the update.
+  UpdateMaxShipRadius();
   WeaponType type = weapon.type;
 
   u8 direction = (u8)(player.orientation * 40.0f);
@@ -815,14 +1191,7 @@ bool WeaponManager::FireWeapons(Player& player, WeaponData weapon, u32 pos_x, u3
     }
 
     if (destroy_link) {
-      for (size_t i = 0; i < weapon_count; ++i) {
-        Weapon* weapon = weapons + i;
-        if (weapon->link_id == link_id) {
-          CreateExplosion(*weapon);
-          Event::Dispatch(WeaponDestroyEvent(*weapon));
-          weapons[i--] = weapons[--weapon_count];
-        }
-      }
+      DestroyLink(link_id);
     }
   } else if (type == WeaponType::Burst) {
     u8 count = connection.settings.ShipSettings[player.ship].BurstShrapnel;
@@ -847,6 +1216,8 @@ WeaponSimulateResult WeaponManager::GenerateWeapon(u16 player_id, WeaponData wea
                                                    u32 link_id) {
   Weapon* weapon = weapons + weapon_count++;
 
+  ++weapon_generation;
+
   // Shouldn't be necessary, but do it anyway in case something wasn't initialized.
   memset((void*)weapon, 0, sizeof(Weapon));
 
@@ -860,6 +1231,10 @@ WeaponSimulateResult WeaponManager::GenerateWeapon(u16 player_id, WeaponData wea
   weapon->prox_hit_player_id = 0xFFFF;
   weapon->last_tick = local_timestamp;
 
+  if (link_id != kInvalidLink) {
+    links.Insert((u16)(weapon - weapons), link_id);
+  }
+
   WeaponType type = weapon->data.type;
 
   Player* player = player_manager.GetPlayerById(player_id);
@@ -938,11 +1313,18 @@ WeaponSimulateResult WeaponManager::GenerateWeapon(u16 player_id, WeaponData wea
 
       CreateExplosion(*weapon);
       Event::Dispatch(WeaponDestroyEvent(*weapon));
-      --weapon_count;
+      // The explosion can create shrapnel after this weapon, so it can't just be popped off of the end.
+      RemoveWeapon(weapon - weapons);
       return result;
     }
   }
 
+  UpdateWeaponCell(weapon - weapons);
+
+  if (weapon->velocity.Length() > max_weapon_speed) {
+    max_weapon_speed = weapon->velocity.Length();
+  }
+
   weapon->rng_seed = CalculateRngSeed(pos_x, pos_y, weapon->velocity_x, weapon->velocity_y, weapon_data.shrap,
                                       weapon_data.level, player->frequency);
 
@@ -1050,6 +1432,22 @@ int WeaponManager::GetWeaponTotalAliveTime(WeaponType type, bool alternate) {
   return result;
 }
 
+void WeaponManager::GetWeaponsInRect(const Vector2f& min, const Vector2f& max, std::vector<Weapon*>& out) {
+  out.clear();
+
+  ForEachWeaponInRect(min, max, [&out](Weapon& weapon) { out.push_back(&weapon); });
+
+  std::sort(out.begin(), out.end());
+}
+
+void WeaponManager::GetWeaponsInRadius(const Vector2f& center, float radius, std::vector<Weapon*>& out) {
+  out.clear();
+
+  ForEachWeaponInRadius(center, radius, [&out](Weapon& weapon) { out.push_back(&weapon); });
+
+  std::sort(out.begin(), out.end());
+}
+
 void WeaponManager::GetMineCounts(Player& player, const Vector2f& check, size_t* player_count, size_t* team_count,
                                   bool* has_check_mine) {
   *player_count = 0;
@@ -1136,4 +1534,54 @@ int GetEstimatedWeaponDamage(Weapon& weapon, Connection& connection) {
   return damage;
 }
 
+void WeaponLinkIndex::Insert(u16 index, u32 link_id) {
+  u16* head = heads.Find(link_id);
+
+  previous[index] = kInvalidGridIndex;
+
+  if (head) {
+    next[index] = *head;
+    previous[*head] = index;
+    *head = index;
+  } else {
+    next[index] = kInvalidGridIndex;
+    heads.Insert(link_id, index);
+  }
+}
+
+void WeaponLinkIndex::Remove(u16 index, u32 link_id) {
+  u16 prev = previous[index];
+  u16 after = next[index];
+
+  if (prev != kInvalidGridIndex) {
+    next[prev] = after;
+  } else if (after != kInvalidGridIndex) {
+    *heads.Find(link_id) = after;
+  } else {
+    heads.Erase(link_id);
+  }
+
+  if (after != kInvalidGridIndex) {
+    previous[after] = prev;
+  }
+}
+
+void WeaponLinkIndex::Relocate(u16 from, u16 to, u32 link_id) {
+  u16 prev = previous[from];
+  u16 after = next[from];
+
+  previous[to] = prev;
+  next[to] = after;
+
+  if (prev != kInvalidGridIndex) {
+    next[prev] = to;
+  } else {
+    *heads.Find(link_id) = to;
+  }
+
+  if (after != kInvalidGridIndex) {
+    previous[after] = to;
+  }
+}
+
 }  // namespace zero
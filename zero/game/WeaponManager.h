@@ -3,8 +3,12 @@
 
 #include <zero/Types.h>
 #include <zero/game/Player.h>
+#include <zero/game/SpatialGrid.h>
+#include <zero/game/ThreadPool.h>
 #include <zero/game/render/Animation.h>
 
+#include <vector>
+
 namespace zero {
 
 constexpr u32 kInvalidLink = 0xFFFFFFFF;
@@ -13,8 +17,8 @@ constexpr u32 kInvalidLink = 0xFFFFFFFF;
 #define WEAPON_FLAG_BURST_ACTIVE (1 << 1)
 #define WEAPON_FLAG_INITIAL_SIM (1 << 2)
 
-// TODO: This weapon struct is pretty large. It could be broken into multiple pieces to increase iteration speed if
-// performance is ever a concern.
+// This is the full record of a weapon that is exposed to everything outside of the weapon manager.
+// The hot kinematic state is copied into WeaponLanes during an update when the weapon can be integrated in a batch.
 struct Weapon {
   u32 x;
   u32 y;
@@ -91,6 +95,140 @@ struct RadarVisibility {
 };
 
 constexpr size_t kMaxWeapons = 16383;
+constexpr size_t kWeaponLaneWidth = 4;
+// The broadphase and lanes cost more than they save unless the update covers this many ticks. The bot usually updates
+// once per tick, so they only run when a slow frame has to catch up.
+constexpr s32 kMinFastPathTicks = 3;
+
+// Structure of arrays of the hot kinematic state of the weapons that can't reach any enemy player or repel during the
+// update. These only need to be moved and checked against walls, so they are stepped kWeaponLaneWidth at a time and
+// written back to their weapon record once the update is done.
+struct WeaponLanes {
+  size_t count = 0;
+
+  u16 index[kMaxWeapons];
+  u16 frequency[kMaxWeapons];
+
+  u32 x[kMaxWeapons];
+  u32 y[kMaxWeapons];
+  s32 velocity_x[kMaxWeapons];
+  s32 velocity_y[kMaxWeapons];
+
+  u32 last_tick[kMaxWeapons];
+  u32 end_tick[kMaxWeapons];
+  s32 tick_count[kMaxWeapons];
+};
+
+// Area that a repel pushes enemy weapons out of during the current update.
+struct LaneRepel {
+  Vector2f min;
+  Vector2f max;
+  u16 frequency;
+};
+
+// Buckets the live weapons by the 16 tile cell that they are in.
+using WeaponGrid = SpatialGrid<kMaxWeapons, 16>;
+
+constexpr size_t kMaxCollisionPairs = 32768;
+constexpr u32 kNoCollisionCandidates = 0xFFFFFFFF;
+
+// The part of collision_pairs that one thread fills while finding collision candidates. The segments are packed down in
+// thread order afterwards, so the pairs end up in the same order as a single thread would produce.
+struct CollisionPairSegment {
+  size_t weapon_start;
+  size_t weapon_end;
+
+  size_t start;
+  size_t count;
+  size_t capacity;
+};
+
+// Open addressing map from a link id to a u16 value. Link ids are handed out sequentially, so they are spread across the
+// slots without any extra hashing.
+template <size_t kCapacity>
+struct WeaponLinkTable {
+  static_assert((kCapacity & (kCapacity - 1)) == 0, "Capacity must be power of 2");
+
+  u32 keys[kCapacity];
+  u16 values[kCapacity];
+
+  WeaponLinkTable() {
+    for (size_t i = 0; i < kCapacity; ++i) {
+      keys[i] = kInvalidLink;
+    }
+  }
+
+  inline u16* Find(u32 link_id) {
+    for (size_t slot = link_id & (kCapacity - 1);; slot = (slot + 1) & (kCapacity - 1)) {
+      if (keys[slot] == link_id) return values + slot;
+      if (keys[slot] == kInvalidLink) return nullptr;
+    }
+  }
+
+  // The link id must not already exist in the table.
+  void Insert(u32 link_id, u16 value) {
+    size_t slot = link_id & (kCapacity - 1);
+
+    while (keys[slot] != kInvalidLink) {
+      slot = (slot + 1) & (kCapacity - 1);
+    }
+
+    keys[slot] = link_id;
+    values[slot] = value;
+  }
+
+  void Erase(u32 link_id) {
+    size_t slot = link_id & (kCapacity - 1);
+
+    while (keys[slot] != link_id) {
+      if (keys[slot] == kInvalidLink) return;
+      slot = (slot + 1) & (kCapacity - 1);
+    }
+
+    // Shift the following entries back so no probe sequence is broken by the empty slot.
+    for (size_t next = (slot + 1) & (kCapacity - 1); keys[next] != kInvalidLink; next = (next + 1) & (kCapacity - 1)) {
+      size_t home = keys[next] & (kCapacity - 1);
+
+      // Entries whose home slot is cyclically within (slot, next] are still reachable, so they stay.
+      bool reachable = slot < next ? (home > slot && home <= next) : (home > slot || home <= next);
+
+      if (!reachable) {
+        keys[slot] = keys[next];
+        values[slot] = values[next];
+        slot = next;
+      }
+    }
+
+    keys[slot] = kInvalidLink;
+  }
+};
+
+// Indexes the live weapons by their link id so a whole link group can be found without looping over every weapon.
+// Each link is an intrusive list of indices into the weapons array.
+struct WeaponLinkIndex {
+  WeaponLinkTable<32768> heads;
+  u16 next[kMaxWeapons];
+  u16 previous[kMaxWeapons];
+
+  inline u16 GetFirst(u32 link_id) {
+    u16* head = heads.Find(link_id);
+
+    return head ? *head : kInvalidGridIndex;
+  }
+
+  void Insert(u16 index, u32 link_id);
+  void Remove(u16 index, u32 link_id);
+  // Moves the entry of the weapon at index from to index to. The entry at to must already be removed.
+  void Relocate(u16 from, u16 to, u32 link_id);
+};
+
+// Range of the players that a weapon can reach during the current update.
+struct WeaponCollisionCandidates {
+  // Index into the collision pairs or kNoCollisionCandidates if the swept bounds aren't known and the player grid must be
+  // queried every tick.
+  u32 offset;
+  u32 count;
+};
 
 struct WeaponManager {
   MemoryArena& temp_arena;
@@ -103,13 +241,50 @@ struct WeaponManager {
   u32 next_link_id = 0;
 
   size_t weapon_count = 0;
+  // Incremented whenever a weapon is added or removed. Anything built from the weapons can compare this to know that the
+  // set of weapons changed, even if the count is the same.
+  u32 weapon_generation = 0;
   Weapon weapons[kMaxWeapons];
 
+  // Only the first removal of each link is stored since that is the one that decides what happens to the link.
   size_t link_removal_count = 0;
   WeaponLinkRemoval link_removals[2048];
+  // Maps a link id to its index in link_removals.
+  WeaponLinkTable<4096> link_removal_lookup;
+  WeaponLinkIndex links;
+
+  WeaponLanes lanes;
+  // Repels that simulate during the current update. Weapons that can travel into their area don't use the lanes.
+  size_t lane_repel_count = 0;
+  LaneRepel lane_repels[64];
+  WeaponGrid grid;
+  // Fastest speed of any live weapon. This is used to find every weapon that can reach a position within some time.
+  float max_weapon_speed = 0.0f;
+  // Set for the weapons that need to go through the full simulation during the current update.
+  bool needs_simulation[kMaxWeapons];
+  // When disabled, every weapon goes through the full simulation and queries the player grid on each tick, the same as
+  // the update worked before the broadphase and lanes. The tests compare the fast paths against this.
+  bool fast_paths_enabled = true;
+  u32 last_update_tick = 0;
+
+  // Swept broadphase for the current update. Every weapon that exists at the start of the update has the players whose
+  // bounds overlap the area that the weapon can travel through, so each tick only checks those players.
+  size_t collision_candidate_count = 0;
+  WeaponCollisionCandidates collision_candidates[kMaxWeapons];
+  size_t collision_pair_count = 0;
+  Player* collision_pairs[kMaxCollisionPairs];
+  // Largest radius of any ship in the arena settings.
+  float max_ship_radius = 0.0f;
+
+  // Only the broadphase and the lane integration run on the pool. Anything that touches other weapons, players, or
+  // events stays on the calling thread and runs in weapon index order. The pool is owned by the bot and shared with
+  // every game that it creates.
+  ThreadPool& thread_pool;
+  CollisionPairSegment collision_segments[kMaxPoolThreads];
+  u32 collision_search_tick = 0;
 
   WeaponManager(MemoryArena& temp_arena, Connection& connection, PlayerManager& player_manager,
-                PacketDispatcher& dispatcher, AnimationSystem& animation);
+                PacketDispatcher& dispatcher, AnimationSystem& animation, ThreadPool& thread_pool);
 
   void Initialize(ShipController* ship_controller, Radar* radar) {
     this->ship_controller = ship_controller;
@@ -130,16 +305,91 @@ struct WeaponManager {
   void GetMineCounts(Player& player, const Vector2f& check, size_t* player_count, size_t* team_count,
                      bool* has_check_mine);
 
+  // These call fn with each weapon whose position is inside of the query shape.
+  // Weapons must not be created or removed from fn.
+  template <typename F>
+  void ForEachWeaponInRect(const Vector2f& min, const Vector2f& max, F&& fn) {
+    grid.ForEachInRect(min, max, [&](u16 index) {
+      Weapon& weapon = weapons[index];
+
+      if (BoxContainsPoint(min, max, weapon.position)) {
+        fn(weapon);
+      }
+    });
+  }
+
+  template <typename F>
+  void ForEachWeaponInRadius(const Vector2f& center, float radius, F&& fn) {
+    float radius_sq = radius * radius;
+
+    ForEachWeaponInRect(center - Vector2f(radius, radius), center + Vector2f(radius, radius), [&](Weapon& weapon) {
+      if (weapon.position.DistanceSq(center) <= radius_sq) {
+        fn(weapon);
+      }
+    });
+  }
+
+  // These clear out and fill it with the weapons inside of the query shape in weapon index order. The grid visits cells
+  // in order, so the ForEach queries visit weapons in an order that changes as weapons move between cells. Anything
+  // that depends on the order, such as running averages or the first weapon of a link, should use these.
+  void GetWeaponsInRect(const Vector2f& min, const Vector2f& max, std::vector<Weapon*>& out);
+  void GetWeaponsInRadius(const Vector2f& center, float radius, std::vector<Weapon*>& out);
+
+  // Finds the weapons within radius of the segment from start to end.
+  template <typename F>
+  void ForEachWeaponInCapsule(const Vector2f& start, const Vector2f& end, float radius, F&& fn) {
+    if (start == end) {
+      ForEachWeaponInRadius(start, radius, fn);
+      return;
+    }
+
+    Vector2f min(start.x < end.x ? start.x : end.x, start.y < end.y ? start.y : end.y);
+    Vector2f max(start.x > end.x ? start.x : end.x, start.y > end.y ? start.y : end.y);
+    float radius_sq = radius * radius;
+
+    min -= Vector2f(radius, radius);
+    max += Vector2f(radius, radius);
+
+    ForEachWeaponInRect(min, max, [&](Weapon& weapon) {
+      if (GetClosestLinePoint(start, end, weapon.position).DistanceSq(weapon.position) <= radius_sq) {
+        fn(weapon);
+      }
+    });
+  }
+
+  // Moves the weapon along one axis by one tick and reverses it if it hits a wall. Returns true if it bounced.
+  // This only touches the weapon that is passed in, so it can be used to step copies of weapons into the future.
+  bool SimulateAxis(Weapon& weapon, int axis);
+  // Distance in tiles from the weapon to the edge of a ship that it would hit, not counting the ship radius.
+  float GetCollisionRadius(const Weapon& weapon);
+
  private:
   WeaponSimulateResult Simulate(Weapon& weapon, u32 current_tick);
   WeaponSimulateResult SimulateRepel(Weapon& weapon);
   bool SimulateWormholeGravity(Weapon& weapon);
 
-  bool SimulateAxis(Weapon& weapon, int axis);
   WeaponSimulateResult SimulatePosition(Weapon& weapon);
 
+  bool CanUseLane(const Weapon& weapon, const WeaponCollisionCandidates& candidates, s32 tick_count);
+  // Returns false if there are too many repels for the weapons to be checked against.
+  bool FindLaneRepels(u32 current_tick);
+  void SimulateLanes();
+  void SimulateLaneBlocks(size_t start_block, size_t end_block);
+
+  void UpdateMaxShipRadius();
+  void FindAllCollisionCandidates(u32 current_tick);
+  void FindCollisionCandidates(size_t index, s32 tick_count, u32 current_tick, CollisionPairSegment& segment);
+
+  static void RunCollisionCandidateJob(void* user, size_t thread_index, size_t start, size_t end);
+  static void RunLaneJob(void* user, size_t thread_index, size_t start, size_t end);
+
+  void RemoveWeapon(size_t index);
+  void UpdateWeaponCell(size_t index);
+
   void AddLinkRemoval(u32 link_id, WeaponSimulateResult result);
   bool HasLinkRemoved(u32 link_id);
+  // Explodes and removes every weapon in the link.
+  void DestroyLink(u32 link_id);
 
   void CreateExplosion(Weapon& weapon);
   void SetWeaponSprite(Player& player, Weapon& weapon);
@@ -751,7 +751,16 @@ void Connection::SendArenaLogin(u8 ship, u16 audio, u16 xres, u16 yres, u16 aren
 void Connection::OnDownloadComplete(struct FileRequest* request, u8* data) {
   map_arena.Reset();
 
-  if (!data || !map.LoadFromMemory(map_arena, request->filename, data, request->size)) {
+  bool loaded = false;
+
+  if (request->cached) {
+    // The cached file was verified straight from this mapping, so the map keeps it instead of mapping the file again.
+    loaded = map.LoadMapped(map_arena, request->filename, data, request->size);
+  } else {
+    loaded = data && map.LoadFromMemory(map_arena, request->filename, data, request->size);
+  }
+
+  if (!loaded) {
     Log(LogLevel::Error, "Failed to load map %s.", request->filename);
     login_state = LoginState::Quit;
     return;
@@ -333,6 +333,7 @@ bool TileRenderer::CreateMapBuffer(MemoryArena& temp_arena, const char* filename
   // Store entire map tile id data on gpu
   glTexImage2D(GL_TEXTURE_2D, 0, GL_R32UI, 1024, 1024, 0, GL_RED_INTEGER, GL_UNSIGNED_INT, tiledata);
 
+  map.Unload();
   temp_arena.Revert(snapshot);
   return true;
 }
@@ -286,6 +286,11 @@ int main(int argc, char* argv[]) {
       zero::g_Settings.debug_behavior_tree = strtol(*print_behavior_tree, nullptr, 10) != 0;
     }
 
+    auto profile_behavior_tree = cfg->GetString("Debug", "ProfileBehaviorTree");
+    if (profile_behavior_tree) {
+      zero::g_Settings.debug_behavior_profile = strtol(*profile_behavior_tree, nullptr, 10) != 0;
+    }
+
     // Go through the servers that were configured and load the data.
     zero::ConfigGroup servers_group = cfg->GetOrCreateGroup("Servers");
     for (auto& kv : servers_group.map) {
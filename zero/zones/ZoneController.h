@@ -4,6 +4,7 @@
 #include <zero/ChatQueue.h>
 #include <zero/ZeroBot.h>
 #include <zero/behavior/Behavior.h>
+#include <zero/behavior/TextTree.h>
 #include <zero/game/GameEvent.h>
 
 namespace zero {
@@ -66,6 +67,7 @@ struct ZoneController : EventHandler<ZeroBot::JoinRequestEvent>,
 
     bot->commands->Reset();
     CreateBehaviors(event.name);
+    CreateTextBehaviors();
 
     std::string_view behavior_override = bot->args->GetValue({"behavior", "b"});
     if (!behavior_override.empty()) {
@@ -91,6 +93,17 @@ struct ZoneController : EventHandler<ZeroBot::JoinRequestEvent>,
   // Map is already loaded at this point, so it's safe to read its data.
   virtual void CreateBehaviors(const char* arena_name) = 0;
 
+  // Adds the text tree behaviors listed in the Behaviors group. These can replace the zone's behaviors by name.
+  void CreateTextBehaviors() {
+    auto group_iter = bot->config->groups.find("Behaviors");
+    if (group_iter == bot->config->groups.end()) return;
+
+    for (auto& kv : group_iter->second.map) {
+      Log(LogLevel::Info, "Registering text behavior %s from %s.", kv.first.data(), kv.second.data());
+      bot->bot_controller->behaviors.Add(kv.first, std::make_unique<behavior::TextBehavior>(kv.second));
+    }
+  }
+
   void SetBehavior(const char* name) {
     if (!bot) return;
 
@@ -53,7 +53,7 @@ struct GetTrackPosition : public behavior::BehaviorNode {
   }
 
   TrackQueryType query_type = TrackQueryType::Warper;
-  const char* output_key = nullptr;
+  behavior::BlackboardKey output_key;
 };
 
 struct InTrackRegion : public behavior::BehaviorNode {
@@ -84,6 +84,17 @@ std::unique_ptr<behavior::BehaviorNode> CreateJavTree(behavior::ExecuteContext&
                           .Child<RayRectangleInterceptNode>("bullet_fire_ray", "target_bounds")
                           .Child<InputActionNode>(InputAction::Bullet)
                           .End()
+                      .Sequence(CompositeDecorator::Success) // Fire a bomb when the heading lines up with a direct or bounce shot that the solver finds.
+                          .InvertChild<TileQueryNode>(kTileIdSafe)
+                          .InvertChild<ShipWeaponCooldownQueryNode>(WeaponType::Bomb)
+                          .Child<BestShotQueryNode>(WeaponType::Bomb, "bomb_target", "bomb_aimshot", 0.3f)
+                          .Child<ShotVelocityQueryNode>(WeaponType::Bomb, "bomb_fire_velocity")
+                          .Child<RayNode>("self_position", "bomb_fire_velocity", "bomb_fire_ray")
+                          .Child<PlayerBoundingBoxQueryNode>("bomb_target", "bomb_target_bounds", 1.0f)
+                          .Child<MoveRectangleNode>("bomb_target_bounds", "bomb_aimshot", "bomb_target_bounds")
+                          .Child<RayRectangleInterceptNode>("bomb_fire_ray", "bomb_target_bounds")
+                          .Child<InputActionNode>(InputAction::Bomb)
+                          .End()
                       .End()
                   .End()
               .End()
@@ -24,49 +24,6 @@ struct Particle {
         remaining_bounces(bounces) {}
 };
 
-struct ParticleSimulator {
-  Map& map;
-
-  ParticleSimulator(Map& map) : map(map) {}
-
-  // Returns false if particle sim is finished.
-  bool Simulate(Particle& particle) const {
-    const float dt = 1.0f / 100.0f;
-
-    bool x_collide = SimulateAxis(particle, 0);
-    bool y_collide = SimulateAxis(particle, 1);
-
-    if (x_collide || y_collide) {
-      if (--particle.remaining_bounces < 0) {
-        return false;
-      }
-    }
-
-    particle.alive_time -= dt;
-
-    return particle.alive_time > 0.0f;
-  }
-
-  // Returns true if weapon bounced.
-  inline bool SimulateAxis(Particle& particle, int axis) const {
-    const float dt = 1.0f / 100.0f;
-
-    float previous = particle.position[axis];
-
-    particle.position[axis] += particle.velocity[axis] * dt;
-
-    // TODO: Handle other special tiles here
-    if (map.IsSolid((u16)floorf(particle.position.x), (u16)floorf(particle.position.y), particle.frequency)) {
-      particle.position[axis] = previous;
-      particle.velocity[axis] = -particle.velocity[axis];
-
-      return true;
-    }
-
-    return false;
-  }
-};
-
 // Returns success if aiming in a way that will have the weapon shot collide with the enemy.
 struct BounceShotQueryNode : public behavior::BehaviorNode {
   BounceShotQueryNode(WeaponType weapon_type, const char* enemy_player_key, float radius_multiplier = 1.0f)
@@ -109,7 +66,7 @@ struct BounceShotQueryNode : public behavior::BehaviorNode {
 
     Vector2f velocity = self->velocity + self->GetHeading() * weapon_speed;
 
-    ParticleSimulator sim(ctx.bot->game->GetMap());
+    Map& map = ctx.bot->game->GetMap();
 
     if ((weapon_type == WeaponType::Bullet || weapon_type == WeaponType::BouncingBullet) &&
         settings.ShipSettings[self->ship].DoubleBarrel) {
@@ -118,18 +75,18 @@ struct BounceShotQueryNode : public behavior::BehaviorNode {
       Vector2f offset = perp * (settings.ShipSettings[self->ship].GetRadius() * 0.75f);
 
       Particle weapon1(self->position - offset, velocity, self->frequency, alive_time, bounces);
-      if (SimulateWeapon(sim, weapon1, collider)) {
+      if (SimulateWeapon(map, weapon1, collider)) {
         return behavior::ExecuteResult::Success;
       }
 
       Particle weapon2(self->position + offset, velocity, self->frequency, alive_time, bounces);
-      if (SimulateWeapon(sim, weapon2, collider)) {
+      if (SimulateWeapon(map, weapon2, collider)) {
         return behavior::ExecuteResult::Success;
       }
     } else {
       Particle weapon(self->position, velocity, self->frequency, alive_time, bounces);
 
-      if (SimulateWeapon(sim, weapon, collider)) {
+      if (SimulateWeapon(map, weapon, collider)) {
         return behavior::ExecuteResult::Success;
       }
     }
@@ -138,18 +95,84 @@ struct BounceShotQueryNode : public behavior::BehaviorNode {
   }
 
   // Returns true if the weapon collided
-  bool SimulateWeapon(ParticleSimulator sim, Particle particle, const Rectangle& collider) {
-    // Simulate the weapon through the map and check if it overlaps the enemy's collider every tick.
-    while (sim.Simulate(particle)) {
-      if (collider.ContainsInclusive(particle.position)) {
+  bool SimulateWeapon(const Map& map, Particle particle, const Rectangle& collider) {
+    // Trace the weapon from wall to wall and check if each straight path overlaps the enemy's collider.
+    while (particle.alive_time > 0.0f) {
+      if (collider.ContainsInclusive(particle.position)) return true;
+
+      float speed = particle.velocity.Length();
+      if (speed <= 0.0f) return false;
+
+      Vector2f direction = particle.velocity * (1.0f / speed);
+      CastResult cast = map.CastWalls(particle.position, direction, speed * particle.alive_time, particle.frequency);
+
+      float collider_distance;
+      if (RayBoxIntersect(particle.position, direction, collider.min, collider.max - collider.min, &collider_distance,
+                          nullptr) &&
+          collider_distance >= 0.0f && collider_distance <= cast.distance) {
         return true;
       }
+
+      if (!cast.hit || --particle.remaining_bounces < 0) return false;
+
+      // Casts that start inside of a wall don't have a normal to bounce off of.
+      if (cast.normal.x == 0.0f && cast.normal.y == 0.0f) return false;
+
+      particle.alive_time -= cast.distance / speed;
+      particle.position = cast.position;
+
+      bool flip_x = false;
+      bool flip_y = false;
+
+      GetBounceAxes(map, particle, cast, &flip_x, &flip_y);
+
+      // Move slightly away from each wall so the next cast doesn't start inside of it. A quarter of a pixel doesn't
+      // change where the shot lands, but it's still many times the float error of positions near the edge of the map.
+      constexpr float kWallOffset = 1.0f / 64.0f;
+
+      if (flip_x) {
+        particle.position.x -= particle.velocity.x > 0.0f ? kWallOffset : -kWallOffset;
+        particle.velocity.x = -particle.velocity.x;
+      }
+
+      if (flip_y) {
+        particle.position.y -= particle.velocity.y > 0.0f ? kWallOffset : -kWallOffset;
+        particle.velocity.y = -particle.velocity.y;
+      }
     }
 
     return false;
   }
 
-  const char* enemy_player_key = nullptr;
+  // The game moves weapons one axis at a time and bounces off of each axis that moved into a wall, so a weapon that
+  // reaches a corner exactly bounces back on both axes. The cast only reports one face, so the tiles around the hit are
+  // checked in the same order to find the axes.
+  static void GetBounceAxes(const Map& map, const Particle& particle, const CastResult& cast, bool* flip_x,
+                            bool* flip_y) {
+    constexpr float kProbe = 1.0f / 1024.0f;
+
+    float step_x = particle.velocity.x > 0.0f ? kProbe : -kProbe;
+    float step_y = particle.velocity.y > 0.0f ? kProbe : -kProbe;
+
+    // Back out of the wall on both axes so the probes start in the empty tile that the weapon came from.
+    float x = cast.position.x - step_x;
+    float y = cast.position.y - step_y;
+
+    *flip_x = particle.velocity.x != 0.0f &&
+              map.IsSolid((u16)floorf(x + step_x * 2.0f), (u16)floorf(y), particle.frequency);
+
+    if (!*flip_x) x += step_x * 2.0f;
+
+    *flip_y = particle.velocity.y != 0.0f &&
+              map.IsSolid((u16)floorf(x), (u16)floorf(y + step_y * 2.0f), particle.frequency);
+
+    if (!*flip_x && !*flip_y) {
+      *flip_x = cast.normal.x != 0.0f;
+      *flip_y = !*flip_x;
+    }
+  }
+
+  behavior::BlackboardKey enemy_player_key;
   float radius_multiplier = 1.0f;
   WeaponType weapon_type = WeaponType::BouncingBullet;
 };
@@ -38,7 +38,7 @@ struct GetAttachTargetNode : public behavior::BehaviorNode {
   }
 
   Rectangle ignore_rect;
-  const char* output_key = nullptr;
+  behavior::BlackboardKey output_key;
 };
 
 }  // namespace deva
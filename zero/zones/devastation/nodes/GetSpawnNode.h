@@ -33,7 +33,7 @@ struct GetSpawnNode : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Success;
   }
 
-  const char* output_key = nullptr;
+  behavior::BlackboardKey output_key;
   Type type = Type::Team;
 };
 
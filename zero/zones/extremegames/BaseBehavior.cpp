@@ -151,7 +151,7 @@ struct GameRoleDecideNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* output_key = nullptr;
+  behavior::BlackboardKey output_key;
 };
 
 struct GameRoleEqualityNode : public BehaviorNode {
@@ -168,7 +168,7 @@ struct GameRoleEqualityNode : public BehaviorNode {
   }
 
   GameRole role = GameRole::CollectFlags;
-  const char* role_key = nullptr;
+  behavior::BlackboardKey role_key;
 };
 
 enum class CombatRole {
@@ -256,9 +256,9 @@ struct CombatRoleDecideNode : public BehaviorNode {
     return best_anchor;
   }
 
-  const char* base_position_key = nullptr;
-  const char* output_key = nullptr;
-  const char* anchor_output_key = nullptr;
+  behavior::BlackboardKey base_position_key;
+  behavior::BlackboardKey output_key;
+  behavior::BlackboardKey anchor_output_key;
 };
 
 struct CombatRoleEqualityNode : public BehaviorNode {
@@ -275,7 +275,7 @@ struct CombatRoleEqualityNode : public BehaviorNode {
   }
 
   CombatRole role = CombatRole::Anchor;
-  const char* role_key = nullptr;
+  behavior::BlackboardKey role_key;
 };
 
 constexpr u32 kAttachCooldown = 100;
@@ -352,7 +352,7 @@ struct FindBestEnemyCenterNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* output_key = nullptr;
+  behavior::BlackboardKey output_key;
   float nonflagger_multiplier = 2.0f;
   float nonflagger_distance_req = 30.0f;
 };
@@ -3,6 +3,7 @@
 #include <time.h>
 #include <zero/ZeroBot.h>
 #include <zero/behavior/BehaviorTree.h>
+#include <zero/behavior/nodes/QueryNode.h>
 #include <zero/zones/extremegames/ExtremeGames.h>
 
 namespace zero {
@@ -10,10 +11,14 @@ namespace eg {
 
 using namespace behavior;
 
-struct InBaseNode : public BehaviorNode {
-  InBaseNode(const char* position_key) : position_key(position_key) {}
+// The bases are only built when the map loads, so the result only changes with the position.
+struct InBaseNode : public QueryNode {
+  InBaseNode(const char* position_key) : position_key(position_key) {
+    DependOnKey("eg");
+    DependOnKey(position_key);
+  }
 
-  ExecuteResult Execute(ExecuteContext& ctx) override {
+  ExecuteResult Query(ExecuteContext& ctx) override {
     auto opt_eg = ctx.blackboard.Value<ExtremeGames*>("eg");
     if (!opt_eg) return ExecuteResult::Failure;
 
@@ -31,7 +36,7 @@ struct InBaseNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* position_key = nullptr;
+  behavior::BlackboardKey position_key;
 };
 
 struct InFlagroomNode : public BehaviorNode {
@@ -56,7 +61,7 @@ struct InFlagroomNode : public BehaviorNode {
     return in_fr ? ExecuteResult::Success : ExecuteResult::Failure;
   }
 
-  const char* position_key = nullptr;
+  behavior::BlackboardKey position_key;
 };
 
 struct SameBaseNode : public BehaviorNode {
@@ -88,8 +93,8 @@ struct SameBaseNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* position_a_key = nullptr;
-  const char* position_b_key = nullptr;
+  behavior::BlackboardKey position_a_key;
+  behavior::BlackboardKey position_b_key;
 };
 
 // This determines which frequency is in control of the base by determining closest to flagroom.
@@ -117,8 +122,8 @@ struct BaseTeamControlQueryNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* position_key = nullptr;
-  const char* output_key = nullptr;
+  behavior::BlackboardKey position_key;
+  behavior::BlackboardKey output_key;
 };
 
 // Returns a position in the flagroom of the base that contains the provided position
@@ -145,8 +150,8 @@ struct BaseFlagroomPositionNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* position_key = nullptr;
-  const char* output_key = nullptr;
+  behavior::BlackboardKey position_key;
+  behavior::BlackboardKey output_key;
 };
 
 // Find the entrance position of our team's existing base.
@@ -194,7 +199,7 @@ struct FindTeamBaseEntranceNode : public BehaviorNode {
     return (hour * 67217 + portion * 12347) % base_count;
   }
 
-  const char* output_key = nullptr;
+  behavior::BlackboardKey output_key;
 };
 
 struct FindEnemyBaseEntranceNode : public BehaviorNode {
@@ -223,7 +228,7 @@ struct FindEnemyBaseEntranceNode : public BehaviorNode {
     return ExecuteResult::Failure;
   }
 
-  const char* output_key = nullptr;
+  behavior::BlackboardKey output_key;
 };
 
 struct SelectAttackingTeammateNode : public BehaviorNode {
@@ -293,9 +298,9 @@ struct SelectAttackingTeammateNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* in_base_position_key = nullptr;
-  const char* anchor_key = nullptr;
-  const char* output_key = nullptr;
+  behavior::BlackboardKey in_base_position_key;
+  behavior::BlackboardKey anchor_key;
+  behavior::BlackboardKey output_key;
 };
 
 struct SelectDefendingTeammateNode : public BehaviorNode {
@@ -323,8 +328,8 @@ struct SelectDefendingTeammateNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* anchor_key = nullptr;
-  const char* output_key = nullptr;
+  behavior::BlackboardKey anchor_key;
+  behavior::BlackboardKey output_key;
 };
 
 struct FindNearestEnemyInBaseNode : public BehaviorNode {
@@ -380,7 +385,7 @@ struct FindNearestEnemyInBaseNode : public BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* output_key = nullptr;
+  behavior::BlackboardKey output_key;
 };
 
 struct UpdateBaseStateNode : public BehaviorNode {
@@ -453,7 +458,7 @@ struct CalculateAnchorPositionNode : public BehaviorNode {
     return base.path.points[0];
   }
 
-  const char* output_key = nullptr;
+  behavior::BlackboardKey output_key;
 };
 
 }  // namespace eg
@@ -239,7 +239,7 @@ struct FindPassTarget : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Failure;
   }
 
-  const char* output_key = nullptr;
+  behavior::BlackboardKey output_key;
 };
 
 struct FindDefensePositionNode : public behavior::BehaviorNode {
@@ -359,9 +359,9 @@ struct FindDefensePositionNode : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Success;
   }
 
-  const char* goal_rect_key = nullptr;
-  const char* ball_key = nullptr;
-  const char* output_key = nullptr;
+  behavior::BlackboardKey goal_rect_key;
+  behavior::BlackboardKey ball_key;
+  behavior::BlackboardKey output_key;
 };
 
 std::unique_ptr<behavior::BehaviorNode> GoalieBehavior::CreateTree(behavior::ExecuteContext& ctx) {
@@ -70,8 +70,8 @@ struct FindPassWaitPosition : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Success;
   }
 
-  const char* carrier_player_key = nullptr;
-  const char* output_key = nullptr;
+  behavior::BlackboardKey carrier_player_key;
+  behavior::BlackboardKey output_key;
 };
 
 static std::unique_ptr<behavior::BehaviorNode> CreateShootTree(const char* nearest_target_key) {
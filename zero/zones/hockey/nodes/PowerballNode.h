@@ -32,8 +32,8 @@ struct PowerballCarrierQueryNode : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Success;
   }
 
-  const char* ball_key = nullptr;
-  const char* output_key = nullptr;
+  behavior::BlackboardKey ball_key;
+  behavior::BlackboardKey output_key;
 };
 struct PowerballPositionQueryNode : public behavior::BehaviorNode {
   PowerballPositionQueryNode(const char* ball_key, const char* output_key)
@@ -53,8 +53,8 @@ struct PowerballPositionQueryNode : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Success;
   }
 
-  const char* ball_key = nullptr;
-  const char* output_key = nullptr;
+  behavior::BlackboardKey ball_key;
+  behavior::BlackboardKey output_key;
 };
 
 struct PowerballTeamOwnedNode : public behavior::BehaviorNode {
@@ -85,7 +85,7 @@ struct PowerballTeamOwnedNode : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Failure;
   }
 
-  const char* ball_key = nullptr;
+  behavior::BlackboardKey ball_key;
 };
 
 // Finds the closest uncarried ball that's within the current rink.
@@ -126,7 +126,7 @@ struct GetNearestBallNode : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Failure;
   }
 
-  const char* output_key = nullptr;
+  behavior::BlackboardKey output_key;
   BallState required_state = BallState::Carried;
 };
 
@@ -39,7 +39,7 @@ struct RinkCenterNode : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Success;
   }
 
-  const char* output_key = nullptr;
+  behavior::BlackboardKey output_key;
 };
 
 struct RectangleCenterNode : public behavior::BehaviorNode {
@@ -57,8 +57,8 @@ struct RectangleCenterNode : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Success;
   }
 
-  const char* rect_key = nullptr;
-  const char* output_key = nullptr;
+  behavior::BlackboardKey rect_key;
+  behavior::BlackboardKey output_key;
 };
 
 struct FindEnemyGoalRectNode : public behavior::BehaviorNode {
@@ -96,7 +96,7 @@ struct FindEnemyGoalRectNode : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Success;
   }
 
-  const char* output_key = nullptr;
+  behavior::BlackboardKey output_key;
 };
 
 struct FindTeamGoalRectNode : public behavior::BehaviorNode {
@@ -134,7 +134,7 @@ struct FindTeamGoalRectNode : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Success;
   }
 
-  const char* output_key = nullptr;
+  behavior::BlackboardKey output_key;
 };
 
 }  // namespace hz
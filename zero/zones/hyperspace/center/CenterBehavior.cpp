@@ -48,8 +48,10 @@ std::unique_ptr<behavior::BehaviorNode> CenterBehavior::CreateTree(behavior::Exe
             .Child<ShipRequestNode>("request_ship")
             .End()
         .Sequence() // Switch to own frequency when possible.
-            .Child<PlayerFrequencyCountQueryNode>("self_freq_count")
-            .Child<ScalarThresholdNode<size_t>>("self_freq_count", 2)
+            .Sequence(CompositeDecorator::Scheduled) // Counting the frequency scans every player, so only recount at the strategic interval.
+                .Child<PlayerFrequencyCountQueryNode>("self_freq_count")
+                .Child<ScalarThresholdNode<size_t>>("self_freq_count", 2)
+                .End()
             .Child<PlayerEnergyPercentThresholdNode>(1.0f)
             .Child<TimerExpiredNode>("next_freq_change_tick")
             .Child<TimerSetNode>("next_freq_change_tick", 300)
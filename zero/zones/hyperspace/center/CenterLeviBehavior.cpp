@@ -34,8 +34,10 @@ std::unique_ptr<behavior::BehaviorNode> CenterLeviBehavior::CreateTree(behavior:
             .Child<ShipRequestNode>("request_ship")
             .End()
         .Sequence() // Switch to own frequency when possible.
-            .Child<PlayerFrequencyCountQueryNode>("self_freq_count")
-            .Child<ScalarThresholdNode<size_t>>("self_freq_count", 2)
+            .Sequence(CompositeDecorator::Scheduled)
+                .Child<PlayerFrequencyCountQueryNode>("self_freq_count")
+                .Child<ScalarThresholdNode<size_t>>("self_freq_count", 2)
+                .End()
             .Child<PlayerEnergyPercentThresholdNode>(1.0f)
             .Child<TimerExpiredNode>("next_freq_change_tick")
             .Child<TimerSetNode>("next_freq_change_tick", 300)
@@ -90,7 +90,7 @@ struct GlobalGoToNode : public behavior::BehaviorNode {
   }
 
   Vector2f position;
-  const char* position_key = nullptr;
+  behavior::BlackboardKey position_key;
 };
 
 }  // namespace hyperspace
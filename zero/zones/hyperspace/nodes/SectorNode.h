@@ -38,7 +38,7 @@ struct SectorUnclaimedFlagCountNode : public behavior::BehaviorNode {
   }
 
   size_t sector = 0;
-  const char* output_key = nullptr;
+  behavior::BlackboardKey output_key;
 };
 
 // Returns a position within the sector's flag room.
@@ -64,8 +64,8 @@ struct SectorFlagRoomQueryNode : public behavior::BehaviorNode {
   }
 
   size_t sector = 0;
-  const char* sector_key = nullptr;
-  const char* output_key = nullptr;
+  behavior::BlackboardKey sector_key;
+  behavior::BlackboardKey output_key;
 };
 
 // Finds the best sector for the flag game.
@@ -127,7 +127,7 @@ struct BestFlagSectorNode : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Success;
   }
 
-  const char* output_key = nullptr;
+  behavior::BlackboardKey output_key;
 };
 
 }  // namespace hyperspace
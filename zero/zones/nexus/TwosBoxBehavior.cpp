@@ -130,7 +130,7 @@ struct ShotSpreadNode : public behavior::BehaviorNode {
 
   inline float GetTime() { return GetMicrosecondTick() / (kTickDurationMicro * 10.0f); }
 
-  const char* aimshot_key = nullptr;
+  behavior::BlackboardKey aimshot_key;
   float spread = 0.0f;
   float period = 1.0f;
 };
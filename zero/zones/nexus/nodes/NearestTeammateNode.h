@@ -6,22 +6,11 @@
 #include <zero/behavior/BehaviorTree.h>
 #include <zero/game/Game.h>
 #include <zero/game/Logger.h>
-#include <stdexcept>
 #include <variant>
 
 namespace zero {
 namespace nexus {
 
-    struct teamList {
-        Player* player;
-        float distance;
-        bool operator<(const teamList& other) const {
-          return distance < other.distance;  // Sort based on 'distance' in ascending order
-        }
-        teamList(Player* player, float distance) : player(player), distance(distance) {}
-    };
-
-
 //Returns nearest teammate, optionally if factor is included can provide 2nd nearest temmate or 3rd, etc. as int 1 (for 1st closest), 2 for (2nd closest), etc.
   struct NearestTeammateNode : public behavior::BehaviorNode {
     NearestTeammateNode(const char* player_key) : player_key(player_key) {}
@@ -43,51 +32,31 @@ namespace nexus {
 
    private:
     Player* GetNearestTeammate(Game& game, Player& self, RegionRegistry& region_registry, size_t& player_factor) {
-      Player* best_teammate = nullptr;
-      std::vector<teamList> team;
-      size_t teamsize = 0;
+      if (player_factor == 0) return nullptr;
 
-      for (size_t i = 0; i < game.player_manager.player_count; ++i) {
-        Player* player = game.player_manager.players + i;
+      Player** team = memory_arena_push_type_count(&game.temp_arena, Player*, player_factor);
 
-        if (player->id == self.id) continue;
-        if (player->ship >= 8) continue;
-        if (player->frequency != self.frequency) continue;
-        if (player->IsRespawning()) continue;
-        if (player->position == Vector2f(0, 0)) continue;
-        if (!IsSynchronized(game, *player)) continue;
-        if (!region_registry.IsConnected(self.position, player->position)) continue;
+      size_t teamsize = game.player_manager.GetNearestPlayers(self.position, player_factor, team, [&](Player* player) {
+        if (player->id == self.id) return false;
+        if (player->ship >= 8) return false;
+        if (player->frequency != self.frequency) return false;
+        if (player->IsRespawning()) return false;
+        if (player->position == Vector2f(0, 0)) return false;
+        if (!IsSynchronized(game, *player)) return false;
+        if (!region_registry.IsConnected(self.position, player->position)) return false;
 
         bool in_safe = game.connection.map.GetTileId(player->position) == kTileIdSafe;
-        if (in_safe) continue;
-
-        float dist_sq = player->position.DistanceSq(self.position);
-        
-        //Insert the player and their distance
-        team.emplace_back(player, dist_sq);
-      }
-      
-      teamsize = team.size();
-      
-      //If no teamsize will return null leading to failed execute result
-      if (teamsize >= 1) {
-        // Sort the team based on distance then we can return the desired player based on the provided factor
-        std::sort(team.begin(), team.end());
+        if (in_safe) return false;
 
-        // Index starts from 0 not 1
-        size_t index = player_factor - 1;  //Assuming this sorted correctly and they are in order by distance 
+        return true;
+      });
 
-        if (index > teamsize - 1) {
-          index = teamsize - 1;
-        }
-        //Try the specified player otherwise return the furthest player (assuming if they specified the 3rd player and they no longer exist you'd get the 2nd player)
-        try {
-          best_teammate = team[index].player;
-        } catch (const std::out_of_range&) { }   
-      } 
-
-      return best_teammate;
+      //If no teamsize will return null leading to failed execute result
+      if (teamsize == 0) return nullptr;
 
+      //The players are sorted by distance, so return the desired player based on the provided factor or the furthest
+      //player found (assuming if they specified the 3rd player and they no longer exist you'd get the 2nd player)
+      return team[teamsize - 1];
   }
 
   inline bool IsSynchronized(Game& game, Player& player) {
@@ -102,7 +71,7 @@ namespace nexus {
   }
 
   size_t player_factor = 1;
-  const char* player_key = nullptr;
+  behavior::BlackboardKey player_key;
 };
 
 }  // namespace nexus
@@ -78,8 +78,8 @@ struct NearestTeammatePlayerPositionQueryNode : public behavior::BehaviorNode {
     // Try to path to where we last saw the player until their old position is in view.
     return true;
   }
-  const char* player_key;
-  const char* position_key;
+  behavior::BlackboardKey player_key;
+  behavior::BlackboardKey position_key;
 };
 
 }  // namespace nexus
@@ -30,8 +30,8 @@ struct PlayerByNameNode : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Success;
   }
 
-  const char* name_key = nullptr;
-  const char* output_key = nullptr;
+  behavior::BlackboardKey name_key;
+  behavior::BlackboardKey output_key;
 };
 
 }  // namespace nexus
@@ -46,8 +46,8 @@ struct PowerballTeamGoalQueryNode : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Success;
   }
 
-  const char* team_key = nullptr;
-  const char* output_key = nullptr;
+  behavior::BlackboardKey team_key;
+  behavior::BlackboardKey output_key;
 
  private:
   static std::optional<Vector2f> FindGoal(behavior::ExecuteContext& ctx, u16 team) {
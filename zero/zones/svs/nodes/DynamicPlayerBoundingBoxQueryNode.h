@@ -19,7 +19,7 @@ struct DynamicPlayerBoundingBoxQueryNode : public behavior::BehaviorNode {
   behavior::ExecuteResult Execute(behavior::ExecuteContext& ctx) override {
     Player* player = ctx.bot->game->player_manager.GetSelf();
 
-    if (player_key != nullptr) {
+    if (player_key) {
       auto player_opt = ctx.blackboard.Value<Player*>(player_key);
       if (!player_opt.has_value()) return behavior::ExecuteResult::Failure;
 
@@ -48,8 +48,8 @@ struct DynamicPlayerBoundingBoxQueryNode : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Success;
   }
 
-  const char* player_key;
-  const char* output_key;
+  behavior::BlackboardKey player_key;
+  behavior::BlackboardKey output_key;
   float max_radius_multiplier;
 };
 
@@ -36,7 +36,7 @@ struct FindNearestGreenNode : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Success;
   }
 
-  const char* output_key = nullptr;
+  behavior::BlackboardKey output_key;
 };
 
 }  // namespace svs
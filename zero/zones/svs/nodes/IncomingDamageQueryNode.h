@@ -7,6 +7,7 @@
 #include <zero/game/Game.h>
 
 #include <unordered_set>
+#include <vector>
 
 namespace zero {
 namespace svs {
@@ -33,14 +34,24 @@ struct IncomingDamageQueryNode : public behavior::BehaviorNode {
     if (player->ship >= 8) return behavior::ExecuteResult::Failure;
 
     float check_distance = distance;
-    if (distance_key != nullptr) {
+    if (distance_key) {
       auto opt_distance = ctx.blackboard.Value<float>(distance_key);
       if (!opt_distance) return behavior::ExecuteResult::Failure;
 
       check_distance = *opt_distance;
     }
 
-    float distance_sq = check_distance * check_distance;
+    auto& forecast = ctx.bot->game->danger_forecast;
+
+    // The forecast is only built for the self ship, so other players check the weapons that are heading at them.
+    if (player == ctx.bot->game->player_manager.GetSelf() && radius_multiplier == 1.0f &&
+        forecast.IsValid(player->frequency)) {
+      float damage = forecast.GetDamage(player->position, forecast.GetTravelTicks(check_distance));
+
+      ctx.blackboard.Set(output_key, damage);
+      return behavior::ExecuteResult::Success;
+    }
+
     float ship_radius = ctx.bot->game->connection.settings.ShipSettings[player->ship].GetRadius() * radius_multiplier;
     float bounds_extent = ship_radius * 2.0f;
 
@@ -51,14 +62,15 @@ struct IncomingDamageQueryNode : public behavior::BehaviorNode {
 
     links.clear();
 
-    auto& weapon_man = ctx.bot->game->weapon_manager;
-    for (size_t i = 0; i < weapon_man.weapon_count; ++i) {
-      Weapon& weapon = weapon_man.weapons[i];
+    // Only the first weapon of each link is checked, so they are visited in index order to always check the same one.
+    ctx.bot->game->weapon_manager.GetWeaponsInRadius(player->position, check_distance, weapons);
+
+    for (Weapon* candidate : weapons) {
+      Weapon& weapon = *candidate;
 
       if (weapon.frequency == player->frequency) continue;
       if (weapon.data.type == WeaponType::Repel || weapon.data.type == WeaponType::Decoy) continue;
       if (weapon.data.type == WeaponType::Burst && !(weapon.flags & WEAPON_FLAG_BURST_ACTIVE)) continue;
-      if (weapon.position.DistanceSq(player->position) > distance_sq) continue;
       if (links.find(weapon.link_id) != links.end()) continue;
 
       float dist = 0.0f;
@@ -87,12 +99,13 @@ struct IncomingDamageQueryNode : public behavior::BehaviorNode {
 
   float distance = 0.0f;
   float radius_multiplier = 1.0f;
-  const char* player_key = nullptr;
-  const char* distance_key = nullptr;
-  const char* output_key = nullptr;
+  behavior::BlackboardKey player_key;
+  behavior::BlackboardKey distance_key;
+  behavior::BlackboardKey output_key;
 
-  // Keep the links set here so the memory can be reused.
+  // Keep the links set and weapon list here so the memory can be reused.
   std::unordered_set<u32> links;
+  std::vector<Weapon*> weapons;
 };
 
 }  // namespace svs
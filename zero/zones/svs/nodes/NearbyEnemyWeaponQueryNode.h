@@ -78,55 +78,54 @@ struct NearbyEnemyWeaponQueryNode : public behavior::BehaviorNode {
     if (self->ship >= 8) return behavior::ExecuteResult::Failure;
 
     float check_distance = distance;
-    if (distance_key != nullptr) {
+    if (distance_key) {
       auto opt_distance = ctx.blackboard.Value<float>(distance_key);
       if (!opt_distance) return behavior::ExecuteResult::Failure;
 
       check_distance = *opt_distance;
     }
 
-    float distance_sq = check_distance * check_distance;
+    bool found = false;
 
     auto& weapon_man = ctx.bot->game->weapon_manager;
-    for (size_t i = 0; i < weapon_man.weapon_count; ++i) {
-      Weapon& weapon = weapon_man.weapons[i];
-
-      if (weapon.frequency == self->frequency) continue;
+    weapon_man.ForEachWeaponInRadius(self->position, check_distance, [&](Weapon& weapon) {
+      if (found) return;
+      if (weapon.frequency == self->frequency) return;
       if (weapon.data.type == WeaponType::Bomb || weapon.data.type == WeaponType::ProximityBomb) {
         // Check if it's exclusively mines
         if (weapon_types.Contains(ExtendedWeaponType::Mine) && !weapon_types.Contains(WeaponType::Bomb) &&
             !weapon_types.Contains(WeaponType::ProximityBomb)) {
           if (weapon.velocity.LengthSq() > 0.0f) {
-            continue;
+            return;
           }
         } else {
           if (!weapon_types.Contains(weapon.data.type)) {
-            continue;
+            return;
           }
 
           Vector2f to_weapon = weapon.position - self->position;
           // Ignore any bombs that are moving away from self.
           if (Normalize(weapon.velocity).Dot(Normalize(to_weapon)) > 0.0f) {
-            continue;
+            return;
           }
         }
       } else {
         if (!weapon_types.Contains(weapon.data.type)) {
-          continue;
+          return;
         }
       }
 
-      if (weapon.position.DistanceSq(self->position) <= distance_sq) {
-        return behavior::ExecuteResult::Success;
-      }
-    }
+      found = true;
+    });
+
+    if (found) return behavior::ExecuteResult::Success;
 
     return behavior::ExecuteResult::Failure;
   }
 
   WeaponTypeCombine weapon_types;
   float distance = 0.0f;
-  const char* distance_key = nullptr;
+  behavior::BlackboardKey distance_key;
 };
 
 }  // namespace svs
@@ -69,7 +69,7 @@ struct AimWiggleNode : public BehaviorNode {
 
   float arc_rads = 0.0f;
   float period = 1.0f;
-  const char* target_position_key = nullptr;
+  behavior::BlackboardKey target_position_key;
 };
 
 // Determines if a bomb explosion will hit the provided rect.
@@ -122,8 +122,7 @@ struct BombRectCollideQuery : BehaviorNode {
     float damage = GetBombDamage(game, *self, explosion_position, target_center);
 
 #if 0
-    game.line_renderer.PushCross(explosion_position, Vector3f(0, 1, 0), 3.0f);
-    game.line_renderer.Render(game.camera);
+    ctx.bot->bot_controller->tree_render.PushCross(game.camera, explosion_position, Vector3f(0, 1, 0), 3.0f);
 #endif
 
     if (damage < required_damage) return ExecuteResult::Failure;
@@ -247,8 +246,8 @@ struct BombRectCollideQuery : BehaviorNode {
     return result;
   }
 
-  const char* trajectory_key = nullptr;
-  const char* rect_key = nullptr;
+  behavior::BlackboardKey trajectory_key;
+  behavior::BlackboardKey rect_key;
   float required_damage = 1000.0f;
 };
 
@@ -286,7 +285,7 @@ struct NearestTeamTerrierPosition : BehaviorNode {
     return ExecuteResult::Success;
   }
 
-  const char* output_key = nullptr;
+  behavior::BlackboardKey output_key;
   const float max_distance_check = 30.0f;
 };
 
@@ -88,7 +88,7 @@ struct QueryMinesNode : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Success;
   }
 
-  const char* output_key = nullptr;
+  behavior::BlackboardKey output_key;
 };
 
 // Requires the mines from QueryMinesNode
@@ -124,7 +124,7 @@ struct FlagRequiresMinesNode : public behavior::BehaviorNode {
     return count < desired_mine_count ? behavior::ExecuteResult::Success : behavior::ExecuteResult::Failure;
   }
 
-  const char* mines_key = nullptr;
+  behavior::BlackboardKey mines_key;
   float search_distance_sq = 0.0f;
   size_t desired_mine_count = 3;
 };
@@ -171,8 +171,8 @@ struct FindBestMinePositionNode : public behavior::BehaviorNode {
   }
 
   float y_offset = 0.0f;
-  const char* mines_key = nullptr;
-  const char* output_key = nullptr;
+  behavior::BlackboardKey mines_key;
+  behavior::BlackboardKey output_key;
 };
 
 static std::unique_ptr<behavior::BehaviorNode> CreateDefensiveTree() {
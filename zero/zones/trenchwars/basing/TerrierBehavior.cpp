@@ -71,7 +71,7 @@ struct SafeRectNode : behavior::BehaviorNode {
   }
 
   u32 damage_threshold = 0;
-  const char* rect_key = nullptr;
+  behavior::BlackboardKey rect_key;
   Rectangle rect;
 };
 
@@ -261,7 +261,7 @@ struct EscapeBombExplodeQuadrantNode : behavior::BehaviorNode {
     return Rectangle(min_w, max_w);
   }
 
-  const char* partition_key = nullptr;
+  behavior::BlackboardKey partition_key;
 };
 
 // Returns success if we want to travel to a new partition. The Vector2f of the center of the quadrant will be put in
@@ -330,8 +330,8 @@ struct FindNewSafePositionNode : behavior::BehaviorNode {
     return behavior::ExecuteResult::Success;
   }
 
-  const char* partition_key = nullptr;
-  const char* output_key = nullptr;
+  behavior::BlackboardKey partition_key;
+  behavior::BlackboardKey output_key;
 };
 
 static std::unique_ptr<behavior::BehaviorNode> CreateDefensiveTree() {
@@ -464,7 +464,7 @@ static std::unique_ptr<behavior::BehaviorNode> CreateEntranceRushBehavior() {
       return ExecuteResult::Failure;
     }
 
-    const char* output_key = nullptr;
+    behavior::BlackboardKey output_key;
   };
 
   // clang-format off
@@ -505,7 +505,7 @@ static std::unique_ptr<behavior::BehaviorNode> CreateEntranceBehavior() {
       return ExecuteResult::Success;
     }
 
-    const char* output_key = nullptr;
+    behavior::BlackboardKey output_key;
   };
 
   // clang-format off
@@ -584,7 +584,7 @@ static std::unique_ptr<behavior::BehaviorNode> CreateEntranceWaitBehavior() {
     }
 
     EmptySideAreaNode::Side side = EmptySideAreaNode::Side::West;
-    const char* output_key = nullptr;
+    behavior::BlackboardKey output_key;
   };
 
   // clang-format off
@@ -641,7 +641,7 @@ static std::unique_ptr<behavior::BehaviorNode> CreateBelowEntranceBehavior() {
       return ExecuteResult::Success;
     }
 
-    const char* output_key = nullptr;
+    behavior::BlackboardKey output_key;
   };
 
   // clang-format off
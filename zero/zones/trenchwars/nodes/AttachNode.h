@@ -65,7 +65,7 @@ struct BestAttachQueryNode : public behavior::BehaviorNode {
   }
 
   bool require_closer_than_self = true;
-  const char* output_key = nullptr;
+  behavior::BlackboardKey output_key;
 };
 
 struct AttachParentValidNode : public behavior::BehaviorNode {
@@ -94,7 +94,7 @@ struct FindBaseEnemyNode : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Success;
   }
 
-  const char* output_key = nullptr;
+  behavior::BlackboardKey output_key;
 };
 
 // This checks the top area and the vertical shaft for enemies.
@@ -266,7 +266,7 @@ struct SelectBestEntranceSideNode : public behavior::BehaviorNode {
     return 0;
   }
 
-  const char* partition_key = nullptr;
+  behavior::BlackboardKey partition_key;
 };
 
 struct InFlagroomNode : public behavior::BehaviorNode {
@@ -284,7 +284,7 @@ struct InFlagroomNode : public behavior::BehaviorNode {
     return in_fr ? behavior::ExecuteResult::Success : behavior::ExecuteResult::Failure;
   }
 
-  const char* position_key = nullptr;
+  behavior::BlackboardKey position_key;
 };
 
 // Returns success if the target player has some number of teammates within the flag room, including self.
@@ -339,8 +339,8 @@ struct FlagroomPresenceNode : public behavior::BehaviorNode {
   }
 
   u32 count_check = 0;
-  const char* player_key = nullptr;
-  const char* count_key = nullptr;
+  behavior::BlackboardKey player_key;
+  behavior::BlackboardKey count_key;
 };
 
 // Returns success if our team fully controls the flagroom or it's empty.
@@ -410,7 +410,7 @@ struct FlagroomPartitionNode : public behavior::BehaviorNode {
     return behavior::ExecuteResult::Success;
   }
 
-  const char* output_key = nullptr;
+  behavior::BlackboardKey output_key;
 };
 
 }  // namespace tw
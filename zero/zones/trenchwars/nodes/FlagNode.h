@@ -1,5 +1,6 @@
 #pragma once
 
+#include <zero/BotController.h>
 #include <zero/ZeroBot.h>
 #include <zero/behavior/BehaviorBuilder.h>
 #include <zero/behavior/BehaviorTree.h>
@@ -17,19 +18,13 @@ struct RenderFlagroomNode : public behavior::BehaviorNode {
     if (!opt_tw) return behavior::ExecuteResult::Failure;
 
     auto tw = *opt_tw;
-    bool render = false;
 
     for (auto& pos : tw->fr_positions) {
       Vector2f start(pos.x, pos.y);
       Vector2f end(pos.x + 1.0f, pos.y + 1.0f);
       Vector3f color(0.0f, 1.0f, 0.0f);
 
-      ctx.bot->game->line_renderer.PushRect(start, end, color);
-      render = true;
-    }
-
-    if (render) {
-      ctx.bot->game->line_renderer.Render(world_camera);
+      ctx.bot->bot_controller->tree_render.PushRect(world_camera, start, end, color);
     }
 
     return behavior::ExecuteResult::Success;
@@ -67,7 +67,7 @@ std::unique_ptr<behavior::BehaviorNode> SoloBehavior::CreateTree(behavior::Execu
                   if (set.IsSet(i)) {
                     Vector2f end = start + Vector2f(offset.x, offset.y);
 
-                    game.line_renderer.PushLine(start, color, end, color);
+                    ctx.bot->bot_controller->tree_render.PushLine(game.camera, start, color, end, color);
                   }
                 }
               }
@@ -75,8 +75,6 @@ std::unique_ptr<behavior::BehaviorNode> SoloBehavior::CreateTree(behavior::Execu
 
             self->position = Vector2f(512, 269);
 
-            game.line_renderer.Render(game.camera);
-
             return ExecuteResult::Success;
         })
         .End();
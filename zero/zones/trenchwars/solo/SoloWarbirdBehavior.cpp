@@ -125,7 +125,7 @@ struct AvoidEnemyAimshotNode : public behavior::BehaviorNode {
 
     return behavior::ExecuteResult::Failure;
   }
-  const char* enemy_key = nullptr;
+  behavior::BlackboardKey enemy_key;
 };
 
 static std::unique_ptr<behavior::BehaviorNode> CreateAimTree(behavior::ExecuteContext& ctx) {